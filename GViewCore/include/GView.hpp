@@ -84,6 +84,7 @@ namespace Utils
         ~DataCache();
 
         bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize);
+        bool RefreshSize();
         BufferView Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead);
         inline BufferView GetEntireFile()
         {
@@ -680,6 +681,23 @@ namespace View
         {
             virtual bool GetColorForBuffer(uint64 offset, BufferView buf, BufferColor& result) = 0;
         };
+        struct BufferZone
+        {
+            uint64 start;
+            uint64 size;
+            ColorPair color;
+            FixSizeString<25> name;
+        };
+        struct CORE_EXPORT ZoneProviderInterface
+        {
+            // adds the zones (sorted by their start) that cover [start, end) - a zone can start before the range or end after it
+            virtual bool GetZones(uint64 start, uint64 end, std::vector<BufferZone>& zones) = 0;
+            // a provider whose zones change returns another version - the zones that were already requested are dropped
+            virtual uint32 GetZonesVersion()
+            {
+                return 0;
+            }
+        };
         struct CORE_EXPORT OffsetTranslateInterface
         {
             virtual uint64_t TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex) = 0;
@@ -695,6 +713,7 @@ namespace View
             void AddBookmark(uint8 bookmarkID, uint64 fileOffset);
             void SetOffsetTranslationList(std::initializer_list<std::string_view> list, Reference<OffsetTranslateInterface> cbk);
             void SetPositionToColorCallback(Reference<PositionToColorInterface> cbk);
+            void SetZoneProvider(Reference<ZoneProviderInterface> cbk);
             void SetEntryPointOffset(uint64_t offset);
         };
     }; // namespace BufferViewer
@@ -795,6 +814,40 @@ namespace View
             ExponentFormat        = 0x00000080,
             All                   = 0xFFFFFFFF, // all possible forms of numbers
         };
+        // the class (word, number, operator, ...) of every ASCII character - all other characters have the same class
+        // (there are at most 64 classes, so that a set of classes can be used as a mask)
+        class CharacterClasses
+        {
+            uint8 classes[128];
+            uint8 nonAsciiClass;
+
+          public:
+            constexpr CharacterClasses(uint8 defaultClass, uint8 _nonAsciiClass) : classes{}, nonAsciiClass(_nonAsciiClass)
+            {
+                for (auto& c : classes)
+                    c = defaultClass;
+            }
+            constexpr CharacterClasses& Set(string_view characters, uint8 charClass)
+            {
+                for (auto ch : characters)
+                    classes[static_cast<uint8>(ch) & 0x7F] = charClass;
+                return *this;
+            }
+            constexpr CharacterClasses& Set(char first, char last, uint8 charClass)
+            {
+                for (auto ch = static_cast<uint8>(first); ch <= static_cast<uint8>(last); ch++)
+                    classes[ch & 0x7F] = charClass;
+                return *this;
+            }
+            constexpr uint8 operator[](char16 ch) const
+            {
+                return ch < 128 ? classes[ch] : nonAsciiClass;
+            }
+            static constexpr uint64 Mask(uint8 charClass)
+            {
+                return 1ULL << charClass;
+            }
+        };
         class CORE_EXPORT TextParser
         {
             const char16* text;
@@ -824,7 +877,13 @@ namespace View
             uint32 ParseUntillStartOfNextLine(uint32 index) const;
             uint32 Parse(uint32 index, bool (*validate)(char16 character)) const;
             uint32 ParseBackwards(uint32 index, bool (*validate)(char16 character)) const;
+            uint32 Parse(uint32 index, const CharacterClasses& classes, uint64 classesMask) const;
+            uint32 ParseBackwards(uint32 index, const CharacterClasses& classes, uint64 classesMask) const;
+            // a directive (for example "#include ...") --> the end of its line ('validName' is true if its name starts with a
+            // character of 'nameClass' - the spaces and tabs after the first character are skipped)
+            uint32 ParseDirective(uint32 index, const CharacterClasses& classes, uint8 nameClass, bool& validName) const;
             uint32 ParseSameGroupID(uint32 index, uint32 (*charToID)(char16 character)) const;
+            uint32 ParseSameGroupID(uint32 index, const CharacterClasses& classes) const;
             uint32 ParseSpace(uint32 index, SpaceType type = SpaceType::SpaceAndTabs) const;
             uint32 ParseString(uint32 index, StringFormat format = StringFormat::All) const;
             uint32 ParseNumber(uint32 index, NumberFormat format = NumberFormat::All) const;
@@ -836,10 +895,259 @@ namespace View
             static uint64 ComputeHash64(u16string_view txt, bool ignoreCase);
             static bool ExtractContentFromString(u16string_view string, AppCUI::Utils::UnicodeStringBuilder& result, StringFormat format);
         };
+        struct LexicalEntry
+        {
+            string_view text; // ASCII only
+            uint32 id;
+        };
+        // maps a set of keywords / operators to their IDs (with one hash and one string comparison per lookup)
+        // the table is built at compile time (a hash-and-displace perfect hash: every bucket has its own seed that
+        // places all of its entries in free slots)
+        template <size_t Count>
+        class LexicalTable
+        {
+            static constexpr uint32 NextPrime(uint32 value)
+            {
+                for (uint32 div = 2; div * div <= value; div++)
+                {
+                    if (value % div == 0)
+                        return NextPrime(value + 1);
+                }
+                return value;
+            }
+            static constexpr uint32 BUCKETS  = Count / 4 + 1;
+            static constexpr uint32 SLOTS    = NextPrime(Count * 2 + 1);
+            static constexpr uint32 MAX_SEED = 0x10000;
+            static constexpr uint32 EMPTY    = 0xFFFFFFFF;
+
+            LexicalEntry entries[Count];
+            uint32 slots[SLOTS]; // index in entries or EMPTY
+            uint32 seeds[BUCKETS];
+            uint64 sizes; // bit N is set if there is an entry with N characters
+            uint32 minSize, maxSize;
+            bool ignoreCase;
+
+            static constexpr uint64 Mix(uint64 hash)
+            {
+                hash ^= hash >> 33;
+                hash *= 0xFF51AFD7ED558CCDULL;
+                hash ^= hash >> 33;
+                hash *= 0xC4CEB9FE1A85EC53ULL;
+                hash ^= hash >> 33;
+                return hash;
+            }
+            static constexpr char16 ToLower(char16 ch)
+            {
+                return ((ch >= 'A') && (ch <= 'Z')) ? (ch | 0x20) : ch;
+            }
+            template <typename T>
+            constexpr uint64 ComputeHash(const T* text, uint32 size) const
+            {
+                // FNV-1a over the characters (not over the bytes of the characters)
+                uint64 hash = 0xCBF29CE484222325ULL;
+                for (auto* e = text + size; text < e; text++)
+                    hash = (hash ^ (ignoreCase ? ToLower(static_cast<char16>(*text)) : static_cast<char16>(*text))) * 0x00000100000001B3ULL;
+                return hash;
+            }
+            // both indexes are computed from the same mixed hash - the seed of a bucket moves all of its entries with their own step
+            // (SLOTS is a prime number --> for every entry the first SLOTS seeds result in different slots)
+            static constexpr uint32 BucketIndex(uint64 mixedHash)
+            {
+                return static_cast<uint32>(mixedHash % BUCKETS);
+            }
+            static constexpr uint32 SlotIndex(uint64 mixedHash, uint32 seed)
+            {
+                const auto step = (mixedHash >> 32) % (SLOTS - 1) + 1;
+                return static_cast<uint32>(((mixedHash & 0xFFFFFFFF) + seed * step) % SLOTS);
+            }
+            static void Fail()
+            {
+                // not a constexpr function --> calling it while the table is built stops the compilation
+            }
+            constexpr bool Matches(const LexicalEntry& entry, const char16* text, uint32 size) const
+            {
+                if (entry.text.size() != size)
+                    return false;
+                for (uint32 idx = 0; idx < size; idx++)
+                {
+                    const auto ch = ignoreCase ? ToLower(text[idx]) : text[idx];
+                    if (ch != static_cast<char16>(ignoreCase ? ToLower(entry.text[idx]) : entry.text[idx]))
+                        return false;
+                }
+                return true;
+            }
+            constexpr bool Lookup(const char16* text, uint32 size, uint32& id) const
+            {
+                const auto hash  = Mix(ComputeHash(text, size));
+                const auto index = slots[SlotIndex(hash, seeds[BucketIndex(hash)])];
+                if ((index == EMPTY) || (!Matches(entries[index], text, size)))
+                    return false;
+                id = entries[index].id;
+                return true;
+            }
+
+          public:
+            consteval LexicalTable(const LexicalEntry (&list)[Count], bool _ignoreCase = false)
+                : entries{}, slots{}, seeds{}, sizes(0), minSize(0xFFFFFFFF), maxSize(0), ignoreCase(_ignoreCase)
+            {
+                uint64 hashes[Count]{};
+                uint32 bucketStart[BUCKETS + 1]{}; // entries of a bucket are order[bucketStart[bucket] .. bucketStart[bucket + 1]]
+                uint32 order[Count]{};
+                uint32 buckets[BUCKETS]{};
+                uint32 placed[Count]{}; // slots filled with the seed that is tried (emptied if the seed fails)
+                for (size_t idx = 0; idx < Count; idx++)
+                {
+                    const auto sz = static_cast<uint32>(list[idx].text.size());
+                    if ((sz == 0) || (sz >= 64))
+                        Fail(); // entries must have between 1 and 63 characters
+                    entries[idx] = list[idx];
+                    hashes[idx]  = Mix(ComputeHash(list[idx].text.data(), sz));
+                    bucketStart[BucketIndex(hashes[idx]) + 1]++;
+                    sizes |= 1ULL << sz;
+                    minSize = sz < minSize ? sz : minSize;
+                    maxSize = sz > maxSize ? sz : maxSize;
+                }
+                for (uint32 bucket = 0; bucket < BUCKETS; bucket++)
+                    bucketStart[bucket + 1] += bucketStart[bucket];
+                uint32 next[BUCKETS]{};
+                for (uint32 idx = 0; idx < static_cast<uint32>(Count); idx++)
+                {
+                    const auto bucket                           = BucketIndex(hashes[idx]);
+                    order[bucketStart[bucket] + next[bucket]++] = idx;
+                }
+                for (auto& s : slots)
+                    s = EMPTY;
+
+                // the largest buckets are placed first (while there are more free slots)
+                for (uint32 bucket = 0; bucket < BUCKETS; bucket++)
+                {
+                    auto pos = bucket;
+                    for (; (pos > 0) && (next[buckets[pos - 1]] < next[bucket]); pos--)
+                        buckets[pos] = buckets[pos - 1];
+                    buckets[pos] = bucket;
+                }
+                for (auto bucket : buckets)
+                {
+                    const auto first = bucketStart[bucket];
+                    const auto end   = bucketStart[bucket + 1];
+                    for (auto idx = first; idx < end; idx++)
+                    {
+                        for (auto other = idx + 1; other < end; other++)
+                        {
+                            if (hashes[order[idx]] == hashes[order[other]])
+                                Fail(); // duplicated entries
+                        }
+                    }
+                    auto seed = 0U;
+                    for (; seed < MAX_SEED; seed++)
+                    {
+                        auto count = 0U;
+                        for (auto idx = first; idx < end; idx++)
+                        {
+                            const auto slot = SlotIndex(hashes[order[idx]], seed);
+                            if (slots[slot] != EMPTY)
+                                break;
+                            slots[slot]     = order[idx];
+                            placed[count++] = slot;
+                        }
+                        if (count == end - first)
+                            break;
+                        for (auto idx = 0U; idx < count; idx++)
+                            slots[placed[idx]] = EMPTY;
+                    }
+                    if (seed == MAX_SEED)
+                        Fail(); // too many entries in the same bucket
+                    seeds[bucket] = seed;
+                }
+
+                // every entry must be found in the table
+                for (uint32 idx = 0; idx < static_cast<uint32>(Count); idx++)
+                {
+                    if (slots[SlotIndex(hashes[idx], seeds[BucketIndex(hashes[idx])])] != idx)
+                        Fail();
+                }
+            }
+
+            constexpr bool Find(u16string_view text, uint32& id) const
+            {
+                const auto sz = static_cast<uint32>(text.size());
+                if ((sz < minSize) || (sz > maxSize) || ((sizes & (1ULL << sz)) == 0))
+                    return false;
+                return Lookup(text.data(), sz, id);
+            }
+            constexpr bool FindLongestPrefix(u16string_view text, uint32& id, uint32& size) const
+            {
+                // operators: the longest entry that the text starts with
+                auto sz = text.size() < maxSize ? static_cast<uint32>(text.size()) : maxSize;
+                for (; sz >= minSize; sz--)
+                {
+                    if (((sizes & (1ULL << sz)) != 0) && (Lookup(text.data(), sz, id)))
+                    {
+                        size = sz;
+                        return true;
+                    }
+                }
+                return false;
+            }
+            // a word (the characters from the classes in 'wordClasses') --> its end ('id' is set only if the word is in the table)
+            uint32 ScanWord(const TextParser& text, uint32 index, const CharacterClasses& classes, uint64 wordClasses, uint32& id) const
+            {
+                const auto next = text.Parse(index, classes, wordClasses);
+                Find(text.GetSubString(index, next), id);
+                return next;
+            }
+            // an operator (the characters with the same class) --> the end of the longest entry that it starts with, or the end of
+            // all those characters if it does not start with any entry (false is returned)
+            bool ScanOperator(const TextParser& text, uint32 index, const CharacterClasses& classes, uint32& id, uint32& end) const
+            {
+                uint32 size;
+                end = text.ParseSameGroupID(index, classes);
+                if (!FindLongestPrefix(text.GetSubString(index, end), id, size))
+                    return false;
+                end = index + size;
+                return true;
+            }
+        };
         class CORE_EXPORT TextEditor
         {
           protected:
+            // edits that would move a large part of the text are kept as a list of pieces (from the text or from the
+            // 'added' buffer) and are applied all at once (in one pass) when the entire text is needed
+            struct Piece
+            {
+                uint32 start, size;
+                bool added;
+            };
+            std::vector<Piece> piecesBefore; // pieces before the cursor
+            std::vector<Piece> piecesAfter;  // pieces after the cursor (in reverse order)
+            std::vector<char16> added;
+            uint32 cursorOffset; // consecutive edits are usually close to each other --> only the pieces in between are moved
+
             bool Grow(size_t size);
+            void SeekPiece(uint32 offset);
+            void MoveCursor(uint32 offset);
+            bool Splice(uint32 offset, uint32 count, std::string_view text);
+            bool Splice(uint32 offset, uint32 count, std::u16string_view text);
+            bool SplicePieces(uint32 offset, uint32 count, uint32 addedStart, uint32 addedSize);
+            bool Flatten();
+            void ClearPieces();
+            inline bool HasPieces() const
+            {
+                return (!piecesBefore.empty()) || (!piecesAfter.empty());
+            }
+            char16& CharAt(uint32 index);
+
+            // every change (in the order they are made) - only if 'recordChanges' is set
+            // (a character modified through operator[] can not be tracked --> 'unknownChanges' is set)
+            struct Change
+            {
+                uint32 offset, removed, inserted;
+            };
+            std::vector<Change> changes;
+            bool recordChanges;
+            bool unknownChanges;
+
+            void RecordChange(uint32 offset, uint32 removed, uint32 inserted);
 
           protected:
             char16* text;
@@ -872,10 +1180,7 @@ namespace View
             {
                 return size;
             }
-            inline operator u16string_view() const
-            {
-                return { text, (size_t) size };
-            }
+            operator u16string_view();
         };
         enum class TokenDataType : uint8
         {
@@ -937,9 +1242,11 @@ namespace View
         };
         enum class BlockFlags : uint16
         {
-            None           = 0,
-            EndMarker      = 0x0001,
-            ManualCollapse = 0x0002,
+            None            = 0,
+            EndMarker       = 0x0001,
+            ManualCollapse  = 0x0002,
+            DeferredContent = 0x0004, // the block starts folded and its content (the tokens between its first and last token) is
+                                      // analyzed again (only that part of the text) when the block is expanded for the first time
         };
         class CORE_EXPORT Token;
         class CORE_EXPORT Block
@@ -1271,6 +1578,7 @@ namespace App
     OpenBuffer(BufferView buf, const ConstString& name, const ConstString& path, OpenMethod method, std::string_view typeName = "");
     Reference<GView::Object> CORE_EXPORT GetObject(uint32 index);
     uint32 CORE_EXPORT GetObjectsCount();
+    Reference<View::WindowInterface> CORE_EXPORT GetCurrentWindow();
     std::string_view CORE_EXPORT GetTypePluginName(uint32 index);
     std::string_view CORE_EXPORT GetTypePluginDescription(uint32 index);
     uint32 CORE_EXPORT GetTypePluginsCount();
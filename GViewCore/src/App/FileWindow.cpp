@@ -165,6 +165,20 @@ Reference<ViewControl> FileWindow::GetCurrentView()
 {
     return view->GetCurrentTab().ToObjectRef<ViewControl>();
 }
+uint32 FileWindow::GetViewsCount()
+{
+    return view->GetChildrenCount();
+}
+Reference<ViewControl> FileWindow::GetViewByIndex(uint32 index)
+{
+    CHECK(index < view->GetChildrenCount(), nullptr, "Invalid view index: %u", index);
+    return view->GetChild(index).ToObjectRef<ViewControl>();
+}
+bool FileWindow::SetCurrentViewByIndex(uint32 index)
+{
+    CHECK(index < view->GetChildrenCount(), false, "Invalid view index: %u", index);
+    return view->SetCurrentTabPageByIndex(index);
+}
 bool FileWindow::OnKeyEvent(AppCUI::Input::Key keyCode, char16_t unicode)
 {
     if (Window::OnKeyEvent(keyCode, unicode))
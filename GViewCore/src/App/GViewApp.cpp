@@ -154,6 +154,11 @@ uint32 GView::App::GetObjectsCount()
     CHECK(gviewAppInstance, 0U, "GView was not initialized !");
     return gviewAppInstance->GetObjectsCount();
 }
+Reference<GView::View::WindowInterface> GView::App::GetCurrentWindow()
+{
+    CHECK(gviewAppInstance, nullptr, "GView was not initialized !");
+    return gviewAppInstance->GetCurrentWindow();
+}
 std::string_view GView::App::GetTypePluginName(uint32 index)
 {
     CHECK(gviewAppInstance, nullptr, "GView was not initialized !");
@@ -139,8 +139,10 @@ bool Instance::BuildMainMenus()
 bool Instance::Init()
 {
     InitializationData initData;
+    // app-wide: every control gets frame updates, so the views can show the work of their background threads (or of a followed
+    // file) without user input
     initData.Flags = InitializationFlags::Menu | InitializationFlags::CommandBar | InitializationFlags::LoadSettingsFile |
-                     InitializationFlags::AutoHotKeyForWindow;
+                     InitializationFlags::AutoHotKeyForWindow | InitializationFlags::EnableFPSMode;
 
     CHECK(AppCUI::Application::Init(initData), false, "Fail to initialize AppCUI framework !");
     // reserve some space fo type
@@ -299,8 +301,9 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin(
     auto buf    = cache.Get(0, 0x8800, false);
     auto bomLen = 0U;
     auto enc    = GView::Utils::CharacterEncoding::AnalyzeBufferForEncoding(buf, true, bomLen);
-    auto text   = enc != GView::Utils::CharacterEncoding::Encoding::Binary ? GView::Utils::CharacterEncoding::ConvertToUnicode16(buf)
-                                                                           : GView::Utils::UnicodeString();
+    auto text   = enc != GView::Utils::CharacterEncoding::Encoding::Binary
+                        ? GView::Utils::CharacterEncoding::ConvertToUnicode16(buf, enc, bomLen)
+                        : GView::Utils::UnicodeString();
     auto tp     = GView::Type::Matcher::TextParser(text.text, text.size);
     auto sz     = cache.GetSize();
 
@@ -465,6 +468,14 @@ Reference<GView::Object> Instance::GetCurrentObject()
     CHECK(dsk.IsValid(), nullptr, "Fail to get Desktop object from AppCUI !");
     return dsk->GetFocusedChild().ToObjectRef<FileWindow>()->GetObject();
 }
+Reference<GView::View::WindowInterface> Instance::GetCurrentWindow()
+{
+    auto dsk = AppCUI::Application::GetDesktop();
+    CHECK(dsk.IsValid(), nullptr, "Fail to get Desktop object from AppCUI !");
+    auto win = dsk->GetFocusedChild().ToObjectRef<FileWindow>();
+    CHECK(win.IsValid(), nullptr, "No window is currently focused !");
+    return win.ToBase<GView::View::WindowInterface>();
+}
 uint32 Instance::GetTypePluginsCount()
 {
     return static_cast<uint32>(this->typePlugins.size());
@@ -1,7 +1,231 @@
 #include "Internal.hpp"
 
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define CHARACTER_ENCODING_SSE2
+#endif
+
 namespace GView::Utils::CharacterEncoding
 {
+namespace
+{
+    constexpr char16 REPLACEMENT_CHARACTER = 0xFFFD;
+    constexpr uint64 SWAR_HIGHS            = 0x8080808080808080ULL;
+
+    // returns the size of the UTF-8 sequence that starts at p (2, 3 or 4) or 0 if the sequence is not valid
+    // (same rules as ExpandedCharacter::FromUTF8Buffer, without logging every invalid byte)
+    inline uint32 UTF8SequenceLength(const uint8* p, const uint8* e)
+    {
+        const auto ch = *p;
+        if ((ch >> 5) == 6)
+            return ((p + 1 < e) && ((p[1] >> 6) == 2)) ? 2 : 0;
+        if ((ch >> 4) == 14)
+            return ((p + 2 < e) && ((p[1] >> 6) == 2) && ((p[2] >> 6) == 2)) ? 3 : 0;
+        if ((ch >> 3) == 30)
+            return ((p + 3 < e) && ((p[1] >> 6) == 2) && ((p[2] >> 6) == 2) && ((p[3] >> 6) == 2)) ? 4 : 0;
+        return 0;
+    }
+    // number of UTF-16 units needed for a valid UTF-8 sequence (a code point above 0xFFFF needs a surrogate pair)
+    inline uint32 UTF8SequenceUnits(const uint8* p, uint32 length)
+    {
+        if (length < 4)
+            return 1;
+        const auto cp = ((p[0] & 7U) << 18) | ((p[1] & 63U) << 12) | ((p[2] & 63U) << 6) | (p[3] & 63U);
+        return ((cp >= 0x10000) && (cp <= 0x10FFFF)) ? 2 : 1;
+    }
+    inline char16* WriteUTF8Sequence(const uint8* p, uint32 length, char16* out)
+    {
+        switch (length)
+        {
+        case 2:
+            *out = static_cast<char16>(((p[0] & 0x1FU) << 6) | (p[1] & 63U));
+            return out + 1;
+        case 3:
+            *out = static_cast<char16>(((p[0] & 0x0FU) << 12) | ((p[1] & 63U) << 6) | (p[2] & 63U));
+            return out + 1;
+        }
+        const auto cp = ((p[0] & 7U) << 18) | ((p[1] & 63U) << 12) | ((p[2] & 63U) << 6) | (p[3] & 63U);
+        if (cp < 0x10000)
+        {
+            *out = static_cast<char16>(cp); // overlong encoding
+            return out + 1;
+        }
+        if (cp > 0x10FFFF)
+        {
+            *out = REPLACEMENT_CHARACTER;
+            return out + 1;
+        }
+        out[0] = static_cast<char16>(0xD800 + ((cp - 0x10000) >> 10));
+        out[1] = static_cast<char16>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+        return out + 2;
+    }
+    // number of bytes lower than 0x80 from the start of [p, e)
+    inline size_t AsciiPrefixLength(const uint8* p, const uint8* e)
+    {
+        const auto* s = p;
+#ifdef CHARACTER_ENCODING_SSE2
+        for (; p + 16 <= e; p += 16)
+        {
+            const auto mask = static_cast<uint32>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+            if (mask)
+                return (p - s) + std::countr_zero(mask);
+        }
+#else
+        for (; p + 8 <= e; p += 8)
+        {
+            uint64 v;
+            memcpy(&v, p, 8);
+            if (v & SWAR_HIGHS)
+                break;
+        }
+#endif
+        while ((p < e) && ((*p) < 0x80))
+            p++;
+        return p - s;
+    }
+    // zero extends every byte from [p, p+count) to a UTF-16 unit
+    inline void WidenBytes(const uint8* p, size_t count, char16* out)
+    {
+        size_t idx = 0;
+#ifdef CHARACTER_ENCODING_SSE2
+        const auto zero = _mm_setzero_si128();
+        for (; idx + 16 <= count; idx += 16)
+        {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + idx), _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + idx + 8), _mm_unpackhi_epi8(v, zero));
+        }
+#endif
+        for (; idx < count; idx++)
+            out[idx] = p[idx];
+    }
+    // swaps the bytes of 'count' UTF-16 units (big endian to little endian)
+    inline void SwapUnits(const uint8* p, size_t count, char16* out)
+    {
+        size_t idx = 0;
+#ifdef CHARACTER_ENCODING_SSE2
+        for (; idx + 8 <= count; idx += 8)
+        {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx * 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + idx), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+        }
+#endif
+        for (; idx < count; idx++)
+            out[idx] = static_cast<char16>((p[idx * 2] << 8) | p[idx * 2 + 1]);
+    }
+    // number of UTF-16 units produced by ConvertUTF8 (so that the output can be allocated with the exact size)
+    size_t CountUTF8Units(const uint8* p, const uint8* e)
+    {
+        size_t count = 0;
+        while (p < e)
+        {
+            if ((*p) < 0x80)
+            {
+                const auto ascii = AsciiPrefixLength(p, e);
+                count += ascii;
+                p += ascii;
+                continue;
+            }
+            const auto len = UTF8SequenceLength(p, e);
+            if (len == 0)
+            {
+                count++; // invalid sequence --> one character (the value of the byte)
+                p++;
+                continue;
+            }
+            count += UTF8SequenceUnits(p, len);
+            p += len;
+        }
+        return count;
+    }
+    char16* ConvertUTF8(const uint8* p, const uint8* e, char16* out)
+    {
+        while (p < e)
+        {
+            if ((*p) < 0x80)
+            {
+                const auto ascii = AsciiPrefixLength(p, e);
+                WidenBytes(p, ascii, out);
+                out += ascii;
+                p += ascii;
+                continue;
+            }
+            const auto len = UTF8SequenceLength(p, e);
+            if (len == 0)
+            {
+                *out++ = *p++;
+                continue;
+            }
+            out = WriteUTF8Sequence(p, len, out);
+            p += len;
+        }
+        return out;
+    }
+    char16* ConvertChunk(const uint8* p, const uint8* e, Encoding encoding, char16* out)
+    {
+        const auto sz = static_cast<size_t>(e - p);
+        switch (encoding)
+        {
+        case Encoding::UTF8:
+            return ConvertUTF8(p, e, out);
+        case Encoding::Unicode16LE:
+            memcpy(out, p, (sz >> 1) * sizeof(char16));
+            out += sz >> 1;
+            break;
+        case Encoding::Unicode16BE:
+            SwapUnits(p, sz >> 1, out);
+            out += sz >> 1;
+            break;
+        default:
+            WidenBytes(p, sz, out);
+            return out + sz;
+        }
+        if (sz & 1)
+            *out++ = e[-1]; // an odd last byte is kept as one character
+        return out;
+    }
+    // number of bytes from the start of [p, e) that only contain complete characters (a character that is cut by the end
+    // of the buffer is left for the next one)
+    size_t CompleteCharactersLength(const uint8* p, const uint8* e, Encoding encoding)
+    {
+        const auto sz = static_cast<size_t>(e - p);
+        switch (encoding)
+        {
+        case Encoding::UTF8:
+            for (size_t idx = 1; idx <= std::min<size_t>(3, sz); idx++)
+            {
+                const auto ch = e[-static_cast<ptrdiff_t>(idx)];
+                if ((ch & 0xC0) == 0x80)
+                    continue; // continuation byte --> look for the first byte of the sequence
+                if (ch < 0xC0)
+                    return sz;
+                const size_t len = ch < 0xE0 ? 2 : (ch < 0xF0 ? 3 : 4);
+                return len > idx ? sz - idx : sz;
+            }
+            return sz;
+        case Encoding::Unicode16LE:
+        case Encoding::Unicode16BE:
+            return sz & (~static_cast<size_t>(1));
+        default:
+            return sz;
+        }
+    }
+#ifdef CHARACTER_ENCODING_SSE2
+    // bit i is set if byte i is a printable ASCII character or one of '\t', '\n', '\r' (see IsTextCharacter)
+    inline uint32 TextCharactersMask(__m128i v)
+    {
+        // signed compare: bytes >= 0x80 are negative, so they are never in [0x20, 0x7F)
+        const auto printable = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)), _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)));
+        const auto spaces    = _mm_or_si128(
+              _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+              _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+        return static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(printable, spaces)));
+    }
+#endif
+} // namespace
+
 bool ExpandedCharacter::FromUTF8Buffer(const uint8* p, const uint8* end)
 {
     // unicode encoding (based on the code described in https://en.wikipedia.org/wiki/UTF-8)
@@ -112,7 +336,19 @@ Encoding AnalyzeBufferForEncoding(BufferView buf, bool checkForBOM, uint32& BOML
         auto countU16LE = 0U;
         auto countU16BE = 0U;
         auto szUTF16    = sz - (sz & 1); // odd value
-        for (size_t idx = 0; idx < szUTF16; idx += 2)
+        size_t idx      = 0;
+#ifdef CHARACTER_ENCODING_SSE2
+        for (; idx + 16 <= szUTF16; idx += 16)
+        {
+            // even bits --> first byte of each pair, odd bits --> second byte of each pair
+            const auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf.GetData() + idx));
+            const auto text = TextCharactersMask(v);
+            const auto zero = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())));
+            countU16LE += std::popcount(text & (zero >> 1) & 0x5555U);
+            countU16BE += std::popcount(zero & (text >> 1) & 0x5555U);
+        }
+#endif
+        for (; idx < szUTF16; idx += 2)
         {
             if ((IsTextCharacter(buf[idx])) && (buf[idx + 1] == 0))
                 countU16LE++;
@@ -136,15 +372,31 @@ Encoding AnalyzeBufferForEncoding(BufferView buf, bool checkForBOM, uint32& BOML
         auto countUnknown = 0U;
         auto p            = buf.begin();
         auto e            = buf.end();
-        ExpandedCharacter ec;
         while (p < e)
         {
+#ifdef CHARACTER_ENCODING_SSE2
+            if (p + 16 <= e)
+            {
+                // count a run of ASCII bytes at once (up to the first byte >= 0x80)
+                const auto v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const auto high  = static_cast<uint32>(_mm_movemask_epi8(v));
+                const auto ascii = high ? static_cast<uint32>(std::countr_zero(high)) : 16U;
+                if (ascii > 0)
+                {
+                    const auto text = static_cast<uint32>(std::popcount(TextCharactersMask(v) & ((1U << ascii) - 1)));
+                    countAscii += text;
+                    countUnknown += ascii - text;
+                    p += ascii;
+                    continue;
+                }
+            }
+#endif
             if ((*p) >= 0x80)
             {
-                if (ec.FromUTF8Buffer(p, e))
+                if (const auto len = UTF8SequenceLength(p, e); len > 0)
                 {
                     countUTF8++;
-                    p += ec.Length();
+                    p += len;
                     continue;
                 }
             }
@@ -175,31 +427,107 @@ UnicodeString ConvertToUnicode16(BufferView buf)
 {
     if (buf.Empty())
         return UnicodeString();
+    uint32 bomLength;
+    auto enc = AnalyzeBufferForEncoding(buf, true, bomLength);
+    return ConvertToUnicode16(buf, enc, bomLength);
+}
+UnicodeString ConvertToUnicode16(BufferView buf, Encoding encoding, uint32 BOMLength)
+{
+    if (buf.GetLength() <= BOMLength)
+        return UnicodeString();
     if (buf.GetLength() > 0x80000000)
         return UnicodeString(); // buffer too big to be converted
+
+    const auto* start = buf.begin() + BOMLength;
+    const auto* end   = buf.end();
+    const auto sz     = static_cast<size_t>(end - start);
+
+    // the output is allocated with its exact size
+    size_t count;
+    switch (encoding)
+    {
+    case Encoding::UTF8:
+        count = CountUTF8Units(start, end);
+        break;
+    case Encoding::Unicode16LE:
+    case Encoding::Unicode16BE:
+        count = (sz >> 1) + (sz & 1); // an odd last byte is kept as one character
+        break;
+    default:
+        count = sz;
+        break;
+    }
+    char16* ptr = new char16[count];
+    ConvertChunk(start, end, encoding, ptr);
+    return UnicodeString(ptr, static_cast<uint32>(count), static_cast<uint32>(count));
+}
+UnicodeString ConvertToUnicode16(DataCache& cache)
+{
+    // the object is converted one cache window at a time --> it does not have to fit in the cache (only in memory)
+    const auto size      = cache.GetSize();
+    const auto chunkSize = std::max<uint32>(cache.GetCacheSize(), 16);
+    if (size == 0)
+        return UnicodeString();
+    auto buf = cache.Get(0, static_cast<uint32>(std::min<uint64>(size, chunkSize)), true);
+    CHECK(buf.IsValid(), UnicodeString(), "Fail to read the first %u bytes", chunkSize);
+    if (buf.GetLength() >= size)
+        return ConvertToUnicode16(buf); // everything is already in the cache
+
     uint32 bomLength;
-    auto enc    = AnalyzeBufferForEncoding(buf, true, bomLength);
-    char16* ptr = new char16[buf.GetLength()];
-    auto pos    = ptr;
-    auto start  = buf.begin() + bomLength;
-    auto end    = buf.end();
+    auto encoding = AnalyzeBufferForEncoding(buf, true, bomLength);
+    if (encoding == Encoding::Ascii)
+        encoding = Encoding::UTF8; // only the first window was analyzed (ASCII text is decoded in the same way)
 
-    ExpandedCharacter ch;
-    while (start<end)
+    // first pass: the exact number of characters (it only has to be counted for UTF-8)
+    uint64 count  = 0;
+    uint64 offset = bomLength;
+    switch (encoding)
     {
-        if (ch.FromEncoding(enc,start,end))
+    case Encoding::UTF8:
+        while (offset < size)
         {
-            *pos = ch.GetChar();
-            start += ch.Length();
+            const auto sz = static_cast<uint32>(std::min<uint64>(size - offset, chunkSize));
+            buf           = cache.Get(offset, sz, true);
+            CHECK(buf.IsValid(), UnicodeString(), "Fail to read %u bytes from offset %llu", sz, offset);
+            const auto last = offset + buf.GetLength() >= size;
+            const auto len  = last ? buf.GetLength() : CompleteCharactersLength(buf.begin(), buf.end(), encoding);
+            count += CountUTF8Units(buf.begin(), buf.begin() + len);
+            offset += len;
         }
-        else
+        break;
+    case Encoding::Unicode16LE:
+    case Encoding::Unicode16BE:
+        count = ((size - bomLength) >> 1) + ((size - bomLength) & 1);
+        break;
+    default:
+        count = size - bomLength;
+        break;
+    }
+    CHECK(count <= 0x80000000, UnicodeString(), "Object is too big to be converted (%llu characters)", count);
+
+    // second pass: convert every chunk directly into the result
+    char16* ptr     = new char16[count];
+    char16* out     = ptr;
+    const auto* end = ptr + count;
+    offset          = bomLength;
+    while (offset < size)
+    {
+        buf = cache.Get(offset, static_cast<uint32>(std::min<uint64>(size - offset, chunkSize)), true);
+        const auto len = buf.Empty()                        ? 0
+                         : (offset + buf.GetLength() >= size) ? buf.GetLength()
+                                                              : CompleteCharactersLength(buf.begin(), buf.end(), encoding);
+        // a chunk never produces more characters than bytes, but the object might have changed since it was counted
+        if ((len == 0) ||
+            ((static_cast<size_t>(end - out) < len) && (encoding == Encoding::UTF8) &&
+             (CountUTF8Units(buf.begin(), buf.begin() + len) > static_cast<size_t>(end - out))))
         {
-            *pos = *start;
-            start++;
+            delete[] ptr;
+            RETURNERROR(UnicodeString(), "Fail to convert %llu bytes from offset %llu", size - offset, offset);
         }
-        pos++;
+        out = ConvertChunk(buf.begin(), buf.begin() + len, encoding, out);
+        offset += len;
     }
-    return UnicodeString(ptr, static_cast<uint32>(pos - ptr), static_cast<uint32>(buf.GetLength()));
+    return UnicodeString(ptr, static_cast<uint32>(out - ptr), static_cast<uint32>(count));
 }
 
 } // namespace GView::Utils::CharacterEncoding
\ No newline at end of file
@@ -63,6 +63,20 @@ bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cache
 
     return true;
 }
+bool DataCache::RefreshSize()
+{
+    // returns true if the size of the underlying object has changed (e.g. a file that is still being written)
+    CHECK(this->fileObj, false, "File was not properly initialized !");
+    const auto newSize = this->fileObj->GetSize();
+    if (newSize == this->fileSize)
+        return false;
+    // the cached data can not be trusted anymore (the object might have been truncated and written again since the last check)
+    this->start      = 0;
+    this->end        = 0;
+    this->fileSize   = newSize;
+    this->currentPos = std::min<>(this->currentPos, newSize);
+    return true;
+}
 BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
 {
     CHECK(this->fileObj, BufferView(), "File was not properly initialized !");
@@ -2,6 +2,11 @@
 
 #include "Internal.hpp"
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace GView
 {
 namespace View
@@ -28,9 +33,37 @@ namespace View
         {
             FixSizeString<17> name;
         };
+        // The zones of a provider (a plugin callback) are requested one block at a time, only when an offset from that block is
+        // needed (painted or reached by the cursor). The last requested blocks are kept.
+        class ZoneProviderCache
+        {
+            struct Block
+            {
+                uint64 start{ GView::Utils::INVALID_OFFSET };
+                std::vector<GView::Utils::Zone> zones;
+            };
+
+            Reference<ZoneProviderInterface> provider;
+            std::array<Block, 8> blocks;
+            std::vector<BufferZone> request;
+            const GView::Utils::Zone* lastZone;
+            uint32 nextBlock;
+            uint32 version;
+
+            void Clear();
+            Block& GetBlock(uint64 start);
+
+          public:
+            ZoneProviderCache() : lastZone(nullptr), nextBlock(0), version(0)
+            {
+            }
+            void SetProvider(Reference<ZoneProviderInterface> provider);
+            const GView::Utils::Zone* OffsetToZone(uint64 offset);
+        };
         struct SettingsData
         {
             GView::Utils::ZonesList zList;
+            ZoneProviderCache zProvider;
             uint64 bookmarks[10];
             uint64 entryPointOffset;
             OffsetTranslationMethod translationMethods[16];
@@ -38,6 +71,9 @@ namespace View
             Reference<OffsetTranslateInterface> offsetTranslateCallback;
             Reference<PositionToColorInterface> positionToColorCallback;
             SettingsData();
+
+            // the zones added through the settings come first (the provider is asked only for the offsets outside them)
+            const GView::Utils::Zone* OffsetToZone(uint64 offset);
         };
         enum class MouseLocation : uint8
         {
@@ -56,6 +92,7 @@ namespace View
             {
                 ColorPair Ascii;
                 ColorPair Unicode;
+                ColorPair Difference;
             } Colors;
             struct
             {
@@ -65,6 +102,9 @@ namespace View
                 AppCUI::Input::Key GoToEntryPoint;
                 AppCUI::Input::Key ChangeSelectionType;
                 AppCUI::Input::Key ShowHideStrings;
+                AppCUI::Input::Key Compare;
+                AppCUI::Input::Key NextDifference;
+                AppCUI::Input::Key PreviousDifference;
             } Keys;
             bool Loaded;
 
@@ -72,6 +112,75 @@ namespace View
             void Initialize();
         };
 
+        class Instance;
+        struct DiffEntry
+        {
+            uint64 start[2]; // first byte of the range, for each compared object
+            uint64 end[2];   // first byte after the range (start == end for bytes that were inserted in the other object)
+        };
+        class CompareSource
+        {
+            AppCUI::OS::File file;
+            Buffer memory;
+            uint64 size;
+            bool useMemory;
+
+          public:
+            CompareSource() : size(0), useMemory(false)
+            {
+            }
+            bool Open(Reference<GView::Object> obj);
+            bool Read(uint64 offset, uint8* buffer, uint32 bufferSize);
+            inline uint64 GetSize() const
+            {
+                return size;
+            }
+        };
+        class CompareSession
+        {
+            CompareSource sources[2];
+            Instance* views[2];
+            std::thread worker;
+            std::mutex pendingLock;
+            std::vector<DiffEntry> pending;
+            std::atomic<uint64> processed;
+            std::atomic<bool> stop, finished, truncated;
+
+            void Run();
+            void AddDifference(DiffEntry& current, uint32& count, const uint64* from, const uint64* to);
+
+          public:
+            std::vector<DiffEntry> entries; // only accessed from the UI thread
+
+            CompareSession();
+            ~CompareSession();
+
+            bool Start(Instance* first, Instance* second);
+            void Stop();
+            void Detach(Instance* view);
+            bool Update();
+
+            inline Instance* GetView(uint32 side) const
+            {
+                return views[side & 1];
+            }
+            inline uint64 GetSize(uint32 side) const
+            {
+                return sources[side & 1].GetSize();
+            }
+            inline uint64 GetProcessed() const
+            {
+                return processed.load(std::memory_order_relaxed);
+            }
+            inline bool IsFinished() const
+            {
+                return finished.load(std::memory_order_acquire);
+            }
+            inline bool IsTruncated() const
+            {
+                return truncated.load();
+            }
+        };
         class Instance : public View::ViewControl
         {
             struct DrawLineInfo
@@ -139,6 +248,15 @@ namespace View
             String addressModesList;
             BufferColor bufColor;
             FixSizeString<29> name;
+            struct
+            {
+                std::shared_ptr<CompareSession> session;
+                uint32 side;
+                uint32 lastEntry;
+                uint32 shownEntries; // what the status shows (the differences and the progress of the compare)
+                uint32 shownPercent;
+                bool finishedShown;
+            } Compare;
 
             static Config config;
 
@@ -178,10 +296,26 @@ namespace View
 
             void OpenCurrentSelection();
 
+            void ShowCompareDialog();
+            void StopCompare();
+            bool IsDifference(uint64 offset);
+            void MoveToDifference(bool next);
+            void WriteCompareStatus(Renderer& renderer);
+            uint32 GetComparePercent() const;
+
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
+            virtual ~Instance();
+
+            void AttachCompareSession(std::shared_ptr<CompareSession> session, uint32 side);
+            void DetachCompareSession();
+            inline Reference<GView::Object> GetObject()
+            {
+                return obj;
+            }
 
             virtual void Paint(Renderer& renderer) override;
+            virtual bool OnFrameUpdate() override;
             virtual void OnAfterResize(int newWidth, int newHeight) override;
             virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
             virtual bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
@@ -235,6 +369,29 @@ namespace View
 
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
         };
+        struct CompareCandidate
+        {
+            Reference<GView::App::FileWindow> win;
+            Instance* view;
+            uint32 viewIndex;
+        };
+        class CompareDialog : public Window
+        {
+            Reference<ListView> lst;
+            const std::vector<CompareCandidate>& candidates;
+            uint32 selectedIndex;
+
+            void Validate();
+
+          public:
+            CompareDialog(const std::vector<CompareCandidate>& candidates);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline const CompareCandidate* GetSelectedCandidate() const
+            {
+                return selectedIndex < candidates.size() ? &candidates[selectedIndex] : nullptr;
+            }
+        };
         class GoToDialog : public Window
         {
             Reference<SettingsData> settings;
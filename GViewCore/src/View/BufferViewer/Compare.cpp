@@ -0,0 +1,318 @@
+#include "BufferViewer.hpp"
+
+#include <bit>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define BUFFERVIEW_COMPARE_SSE2
+#endif
+
+using namespace GView::View::BufferViewer;
+
+constexpr uint32 COMPARE_WINDOW_SIZE   = 0x400000; // 4M bytes are kept in memory for each object
+constexpr uint32 COMPARE_CHUNK_SIZE    = 0x10000;  // bytes compared on each aligned step
+constexpr uint32 RESYNC_WINDOW_SIZE    = 0x40000;  // how far ahead we look to re-align the two objects
+constexpr uint32 RESYNC_BLOCK_SIZE     = 32;       // size of a block hashed when looking for shifted content
+constexpr uint32 RESYNC_HASH_MULTIPLY  = 0x01000193;
+constexpr uint32 MAX_DIFF_ENTRIES      = 0x100000;
+constexpr uint32 MAX_MEMORY_OBJECT     = 0x10000000; // non-file objects are copied in memory (256M max)
+
+namespace
+{
+// returns the number of identical bytes from the start of the two buffers
+uint32 CountEqualBytes(const uint8* a, const uint8* b, uint32 size)
+{
+    uint32 idx = 0;
+#ifdef BUFFERVIEW_COMPARE_SSE2
+    for (; idx + 16 <= size; idx += 16)
+    {
+        auto va   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + idx));
+        auto vb   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + idx));
+        auto mask = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+        if (mask != 0xFFFF)
+            return idx + std::countr_one(mask);
+    }
+#else
+    for (; idx + 8 <= size; idx += 8)
+    {
+        uint64 va, vb;
+        memcpy(&va, a + idx, 8);
+        memcpy(&vb, b + idx, 8);
+        if (va != vb)
+            break;
+    }
+#endif
+    while ((idx < size) && (a[idx] == b[idx]))
+        idx++;
+    return idx;
+}
+inline uint32 BlockHash(const uint8* p)
+{
+    uint32 h = 0;
+    for (uint32 idx = 0; idx < RESYNC_BLOCK_SIZE; idx++)
+        h = h * RESYNC_HASH_MULTIPLY + p[idx];
+    return h;
+}
+constexpr uint32 ComputeRollingOutFactor()
+{
+    uint32 r = 1;
+    for (uint32 idx = 0; idx < RESYNC_BLOCK_SIZE; idx++)
+        r *= RESYNC_HASH_MULTIPLY;
+    return r;
+}
+constexpr uint32 ROLLING_OUT_FACTOR = ComputeRollingOutFactor();
+
+// sliding window over a compare source (only COMPARE_WINDOW_SIZE bytes are kept in memory)
+class CompareStream
+{
+    CompareSource& source;
+    std::unique_ptr<uint8[]> data;
+    uint64 start;
+    uint32 size;
+
+  public:
+    CompareStream(CompareSource& src) : source(src), data(new uint8[COMPARE_WINDOW_SIZE]), start(0), size(0)
+    {
+    }
+    // makes sure that [offset, offset+length) is loaded and returns how many bytes are available from offset
+    uint32 Load(uint64 offset, uint32 length)
+    {
+        const auto fileSize = source.GetSize();
+        if (offset >= fileSize)
+            return 0;
+        length = static_cast<uint32>(std::min<uint64>(length, fileSize - offset));
+        if ((offset >= start) && (offset + length <= start + size))
+            return length;
+        uint32 keep = 0;
+        if ((offset >= start) && (offset < start + size))
+        {
+            keep = static_cast<uint32>(start + size - offset);
+            memmove(data.get(), data.get() + (offset - start), keep);
+        }
+        auto toRead = static_cast<uint32>(std::min<uint64>(COMPARE_WINDOW_SIZE - keep, fileSize - (offset + keep)));
+        if ((toRead > 0) && (source.Read(offset + keep, data.get() + keep, toRead) == false))
+        {
+            start = size = 0;
+            return 0;
+        }
+        start = offset;
+        size  = keep + toRead;
+        return std::min(length, size);
+    }
+    inline const uint8* At(uint64 offset) const
+    {
+        return data.get() + (offset - start);
+    }
+};
+
+// Looks for the closest point (after a mismatch) where the two objects become identical again.
+// First we check if the bytes were replaced in place (same alignment), then we look for shifted
+// content (inserted or deleted bytes) by hashing fixed blocks from the first object and rolling
+// a hash of the same size over the second one.
+void FindResyncPoint(
+      CompareStream& a, CompareStream& b, const uint64* pos, uint64* next, std::unordered_map<uint32, uint32>& blocks)
+{
+    auto szA     = a.Load(pos[0], RESYNC_WINDOW_SIZE);
+    auto szB     = b.Load(pos[1], RESYNC_WINDOW_SIZE);
+    auto pa      = a.At(pos[0]);
+    auto pb      = b.At(pos[1]);
+    auto limit   = std::min(szA, szB);
+    auto bestA   = 0xFFFFFFFFU;
+    auto bestB   = 0xFFFFFFFFU;
+    auto bestLen = 0xFFFFFFFFU; // bytes that are considered different (from both objects)
+
+    // 1. same alignment
+    for (uint32 idx = 0, run = 0; idx < limit; idx++)
+    {
+        if (pa[idx] != pb[idx])
+        {
+            run = 0;
+            continue;
+        }
+        if (++run == RESYNC_BLOCK_SIZE)
+        {
+            bestA = bestB = idx + 1 - RESYNC_BLOCK_SIZE;
+            bestLen       = bestA * 2;
+            break;
+        }
+    }
+    // 2. shifted content (only if the in-place replacement is not obvious)
+    if ((bestLen > RESYNC_BLOCK_SIZE * 2) && (szA >= RESYNC_BLOCK_SIZE) && (szB >= RESYNC_BLOCK_SIZE))
+    {
+        blocks.clear();
+        for (uint32 idx = 0; idx + RESYNC_BLOCK_SIZE <= szA; idx += RESYNC_BLOCK_SIZE)
+            blocks.try_emplace(BlockHash(pa + idx), idx);
+
+        auto h = BlockHash(pb);
+        for (uint32 idx = 0; (idx + RESYNC_BLOCK_SIZE <= szB) && (idx < bestLen); idx++)
+        {
+            if (idx > 0)
+                h = h * RESYNC_HASH_MULTIPLY + pb[idx + RESYNC_BLOCK_SIZE - 1] - pb[idx - 1] * ROLLING_OUT_FACTOR;
+            auto it = blocks.find(h);
+            if ((it == blocks.end()) || (it->second + idx >= bestLen))
+                continue;
+            if (memcmp(pa + it->second, pb + idx, RESYNC_BLOCK_SIZE) != 0)
+                continue;
+            bestA   = it->second;
+            bestB   = idx;
+            bestLen = bestA + bestB;
+        }
+    }
+    if (bestLen == 0xFFFFFFFFU)
+    {
+        // nothing similar in the window --> consider the entire window as replaced
+        next[0] = pos[0] + limit;
+        next[1] = pos[1] + limit;
+        return;
+    }
+    // a block match can start after the real synchronization point
+    while ((bestA > 0) && (bestB > 0) && (pa[bestA - 1] == pb[bestB - 1]))
+    {
+        bestA--;
+        bestB--;
+    }
+    next[0] = pos[0] + bestA;
+    next[1] = pos[1] + bestB;
+}
+} // namespace
+
+bool CompareSource::Open(Reference<GView::Object> obj)
+{
+    CHECK(obj.IsValid(), false, "Expecting a valid object !");
+    this->size = obj->GetData().GetSize();
+    if (obj->GetObjectType() == GView::Object::Type::File)
+    {
+        // the data cache of the object is not thread safe --> use a separate handle
+        this->useMemory = false;
+        CHECK(file.OpenRead(std::filesystem::path(obj->GetPath())), false, "Fail to open file for compare");
+        return true;
+    }
+    CHECK(this->size <= MAX_MEMORY_OBJECT, false, "Object is too large to be compared (%llu bytes)", this->size);
+    this->useMemory = true;
+    if (this->size == 0)
+        return true;
+    this->memory = obj->GetData().CopyToBuffer(0, static_cast<uint32>(this->size), true);
+    CHECK(this->memory.IsValid(), false, "Fail to copy %llu bytes for compare", this->size);
+    return true;
+}
+bool CompareSource::Read(uint64 offset, uint8* buffer, uint32 bufferSize)
+{
+    CHECK(offset + bufferSize <= this->size, false, "Invalid read (%u bytes from %llu)", bufferSize, offset);
+    if (this->useMemory)
+    {
+        memcpy(buffer, this->memory.GetData() + offset, bufferSize);
+        return true;
+    }
+    CHECK(file.SetCurrentPos(offset), false, "Fail to move to offset %llu", offset);
+    return file.Read(buffer, bufferSize);
+}
+
+CompareSession::CompareSession() : processed(0), stop(false), finished(false), truncated(false)
+{
+    views[0] = views[1] = nullptr;
+}
+CompareSession::~CompareSession()
+{
+    Stop();
+}
+bool CompareSession::Start(Instance* first, Instance* second)
+{
+    CHECK(first && second, false, "Expecting two valid views !");
+    CHECK(worker.joinable() == false, false, "Compare session already started !");
+    CHECK(sources[0].Open(first->GetObject()), false, "");
+    CHECK(sources[1].Open(second->GetObject()), false, "");
+    views[0] = first;
+    views[1] = second;
+    worker   = std::thread(&CompareSession::Run, this);
+    return true;
+}
+void CompareSession::Stop()
+{
+    stop = true;
+    if (worker.joinable())
+        worker.join();
+}
+void CompareSession::Detach(Instance* view)
+{
+    if (views[0] == view)
+        views[0] = nullptr;
+    if (views[1] == view)
+        views[1] = nullptr;
+    // nothing to compare against anymore
+    Stop();
+}
+bool CompareSession::Update()
+{
+    std::scoped_lock lock(pendingLock);
+    if (pending.empty())
+        return false;
+    entries.insert(entries.end(), pending.begin(), pending.end());
+    pending.clear();
+    return true;
+}
+void CompareSession::AddDifference(DiffEntry& current, uint32& count, const uint64* from, const uint64* to)
+{
+    if (current.start[0] != GView::Utils::INVALID_OFFSET)
+    {
+        // merge with the previous one if adjacent (or if we can not store more entries)
+        if (((current.end[0] == from[0]) && (current.end[1] == from[1])) || (count + 1 >= MAX_DIFF_ENTRIES))
+        {
+            if (count + 1 >= MAX_DIFF_ENTRIES)
+                truncated = true;
+            current.end[0] = to[0];
+            current.end[1] = to[1];
+            return;
+        }
+        std::scoped_lock lock(pendingLock);
+        pending.push_back(current);
+        count++;
+    }
+    current.start[0] = from[0];
+    current.start[1] = from[1];
+    current.end[0]   = to[0];
+    current.end[1]   = to[1];
+}
+void CompareSession::Run()
+{
+    CompareStream a(sources[0]);
+    CompareStream b(sources[1]);
+    std::unordered_map<uint32, uint32> blocks;
+    const uint64 size[2] = { sources[0].GetSize(), sources[1].GetSize() };
+    uint64 pos[2]        = { 0, 0 };
+    uint64 next[2];
+    uint32 count = 0;
+    DiffEntry current;
+    current.start[0] = current.start[1] = GView::Utils::INVALID_OFFSET;
+    current.end[0] = current.end[1] = GView::Utils::INVALID_OFFSET;
+
+    while ((pos[0] < size[0]) && (pos[1] < size[1]) && (!stop))
+    {
+        auto sz = static_cast<uint32>(std::min<uint64>({ COMPARE_CHUNK_SIZE, size[0] - pos[0], size[1] - pos[1] }));
+        if ((a.Load(pos[0], sz) != sz) || (b.Load(pos[1], sz) != sz))
+        {
+            LOG_ERROR("Fail to read %u bytes for compare (offsets: %llu / %llu)", sz, pos[0], pos[1]);
+            break;
+        }
+        auto eq = CountEqualBytes(a.At(pos[0]), b.At(pos[1]), sz);
+        pos[0] += eq;
+        pos[1] += eq;
+        if (eq < sz)
+        {
+            FindResyncPoint(a, b, pos, next, blocks);
+            AddDifference(current, count, pos, next);
+            pos[0] = next[0];
+            pos[1] = next[1];
+        }
+        processed.store(pos[0], std::memory_order_relaxed);
+    }
+    if ((!stop) && ((pos[0] < size[0]) || (pos[1] < size[1])))
+        AddDifference(current, count, pos, size); // the rest of the larger object
+    if (current.start[0] != GView::Utils::INVALID_OFFSET)
+    {
+        std::scoped_lock lock(pendingLock);
+        pending.push_back(current);
+    }
+    processed.store(size[0], std::memory_order_relaxed);
+    finished.store(true, std::memory_order_release);
+}
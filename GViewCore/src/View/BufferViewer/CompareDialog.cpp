@@ -0,0 +1,65 @@
+#include "BufferViewer.hpp"
+
+using namespace GView::View::BufferViewer;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK          = 1;
+constexpr int32 BTN_ID_CANCEL      = 2;
+constexpr uint32 INVALID_CANDIDATE = 0xFFFFFFFF;
+
+CompareDialog::CompareDialog(const std::vector<CompareCandidate>& _candidates)
+    : Window("Compare with", "d:c,w:80,h:16", WindowFlags::ProcessReturn), candidates(_candidates)
+{
+    LocalString<32> tmp;
+    this->selectedIndex = INVALID_CANDIDATE;
+
+    lst = Factory::ListView::Create(
+          this, "l:1,t:0,r:1,b:3", { "n:Name,a:l,w:30", "n:Size,a:r,w:14", "n:Path,a:l,w:200" }, ListViewFlags::HideSearchBar);
+    for (auto idx = 0U; idx < candidates.size(); idx++)
+    {
+        auto o    = candidates[idx].win->GetObject();
+        auto item = lst->AddItem({ o->GetName(), tmp.Format("%llu", o->GetData().GetSize()), o->GetPath() });
+        item.SetData(idx);
+    }
+
+    Factory::Button::Create(this, "&OK", "l:25,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:40,b:0,w:13", BTN_ID_CANCEL);
+    lst->SetFocus();
+}
+
+void CompareDialog::Validate()
+{
+    selectedIndex = static_cast<uint32>(lst->GetCurrentItem().GetData(INVALID_CANDIDATE));
+    if (selectedIndex == INVALID_CANDIDATE)
+        return;
+    Exit(Dialogs::Result::Ok);
+}
+
+bool CompareDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+        break;
+    case Event::ListViewItemPressed:
+        Validate();
+        return true;
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
@@ -11,12 +11,16 @@ void Config::Update(IniSection sect)
     sect.UpdateValue("Key.GoToEntryPoint", Key::F7, true);
     sect.UpdateValue("Key.ChangeSelectionType", Key::F9, true);
     sect.UpdateValue("Key.ShowHideStrings", Key::F4 | Key::Alt, true);
+    sect.UpdateValue("Key.Compare", Key::Ctrl | Key::F6, true);
+    sect.UpdateValue("Key.NextDifference", Key::F8, true);
+    sect.UpdateValue("Key.PreviousDifference", Key::Ctrl | Key::F8, true);
 }
 
 void Config::Initialize()
 {
-    this->Colors.Ascii   = ColorPair{ Color::Red, Color::DarkBlue };
-    this->Colors.Unicode = ColorPair{ Color::Yellow, Color::DarkBlue };
+    this->Colors.Ascii      = ColorPair{ Color::Red, Color::DarkBlue };
+    this->Colors.Unicode    = ColorPair{ Color::Yellow, Color::DarkBlue };
+    this->Colors.Difference = ColorPair{ Color::White, Color::DarkRed };
 
     auto ini = AppCUI::Application::GetAppSettings();
     if (ini)
@@ -28,6 +32,9 @@ void Config::Initialize()
         this->Keys.GoToEntryPoint        = sect.GetValue("Key.GoToEntryPoint").ToKey(Key::F7);
         this->Keys.ChangeSelectionType   = sect.GetValue("Key.ChangeSelectionType").ToKey(Key::F9);
         this->Keys.ShowHideStrings       = sect.GetValue("Key.ShowHideStrings").ToKey(Key::Alt | Key::F3);
+        this->Keys.Compare               = sect.GetValue("Key.Compare").ToKey(Key::Ctrl | Key::F6);
+        this->Keys.NextDifference        = sect.GetValue("Key.NextDifference").ToKey(Key::F8);
+        this->Keys.PreviousDifference    = sect.GetValue("Key.PreviousDifference").ToKey(Key::Ctrl | Key::F8);
     }
     else
     {
@@ -37,6 +44,9 @@ void Config::Initialize()
         this->Keys.GoToEntryPoint        = Key::F7;
         this->Keys.ChangeSelectionType   = Key::F9;
         this->Keys.ShowHideStrings       = Key::Alt | Key::F3;
+        this->Keys.Compare               = Key::Ctrl | Key::F6;
+        this->Keys.NextDifference        = Key::F8;
+        this->Keys.PreviousDifference    = Key::Ctrl | Key::F8;
     }
 
     this->Loaded = true;
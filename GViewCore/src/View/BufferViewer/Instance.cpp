@@ -37,6 +37,9 @@ constexpr int BUFFERVIEW_CMD_GOTOEP            = 0xBF03;
 constexpr int BUFFERVIEW_CMD_CHANGECODEPAGE    = 0xBF04;
 constexpr int BUFFERVIEW_CMD_CHANGESELECTION   = 0xBF05;
 constexpr int BUFFERVIEW_CMD_HIDESTRINGS       = 0xBF06;
+constexpr int BUFFERVIEW_CMD_COMPARE           = 0xBF07;
+constexpr int BUFFERVIEW_CMD_NEXTDIFF          = 0xBF08;
+constexpr int BUFFERVIEW_CMD_PREVDIFF          = 0xBF09;
 
 Config Instance::config;
 
@@ -69,6 +72,11 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
     this->CurrentSelection.end       = GView::Utils::INVALID_OFFSET;
     this->CurrentSelection.highlight = true;
     this->codePage                   = CodePageID::DOS_437;
+    this->Compare.side               = 0;
+    this->Compare.lastEntry          = 0;
+    this->Compare.shownEntries       = 0;
+    this->Compare.shownPercent       = 0;
+    this->Compare.finishedShown      = false;
 
     memcpy(this->StringInfo.AsciiMask, DefaultAsciiMask, 256);
 
@@ -91,6 +99,10 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
     if (config.Loaded == false)
         config.Initialize();
 }
+Instance::~Instance()
+{
+    DetachCompareSession();
+}
 
 void Instance::OpenCurrentSelection()
 {
@@ -320,7 +332,7 @@ void Instance::MoveTillEndBlock(bool selected)
 }
 void Instance::MoveToZone(bool startOfZone, bool select)
 {
-    const auto* z = settings->zList.OffsetToZone(this->Cursor.currentPos);
+    const auto* z = settings->OffsetToZone(this->Cursor.currentPos);
     if (z)
     {
         if (startOfZone)
@@ -481,7 +493,7 @@ bool Instance::SetStringAsciiMask(string_view stringRepresentation)
 
 ColorPair Instance::OffsetToColorZone(uint64 offset)
 {
-    auto* z = this->settings->zList.OffsetToZone(offset);
+    auto* z = this->settings->OffsetToZone(offset);
     if (z == nullptr)
         return Cfg.Text.Inactive;
     else
@@ -509,6 +521,9 @@ ColorPair Instance::OffsetToColor(uint64 offset)
             }
         }
     }
+    // differences (compare mode)
+    if ((this->Compare.session) && (IsDifference(offset)))
+        return config.Colors.Difference;
     // color
     if ((showTypeObjects) && (settings) && (settings->positionToColorCallback))
     {
@@ -683,6 +698,8 @@ void Instance::WriteHeaders(Renderer& renderer)
     params.X     = this->Layout.xText;
     params.Width = this->Layout.charactersPerLine;
     renderer.WriteText("Text", params);
+    if (this->Compare.session)
+        WriteCompareStatus(renderer);
 }
 void Instance::WriteLineAddress(DrawLineInfo& dli)
 {
@@ -695,7 +712,7 @@ void Instance::WriteLineAddress(DrawLineInfo& dli)
     {
         c = OffsetToColorZone(dli.offset);
     }
-    z = this->settings->zList.OffsetToZone(dli.offset);
+    z = this->settings->OffsetToZone(dli.offset);
 
     if (this->Layout.lineNameSize > 0)
     {
@@ -1132,6 +1149,18 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
             commandBar.SetCommand(config.Keys.ShowHideStrings, "Strings:OFF", BUFFERVIEW_CMD_HIDESTRINGS);
     }
 
+    // Compare
+    if (this->Compare.session)
+    {
+        commandBar.SetCommand(config.Keys.Compare, "Compare:Stop", BUFFERVIEW_CMD_COMPARE);
+        commandBar.SetCommand(config.Keys.NextDifference, "NextDiff", BUFFERVIEW_CMD_NEXTDIFF);
+        commandBar.SetCommand(config.Keys.PreviousDifference, "PrevDiff", BUFFERVIEW_CMD_PREVDIFF);
+    }
+    else
+    {
+        commandBar.SetCommand(config.Keys.Compare, "Compare", BUFFERVIEW_CMD_COMPARE);
+    }
+
     return false;
 }
 bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 charCode)
@@ -1358,6 +1387,18 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
             this->StringInfo.showAscii = this->StringInfo.showUnicode = true;
         }
         return true;
+    case BUFFERVIEW_CMD_COMPARE:
+        if (this->Compare.session)
+            StopCompare();
+        else
+            ShowCompareDialog();
+        return true;
+    case BUFFERVIEW_CMD_NEXTDIFF:
+        MoveToDifference(true);
+        return true;
+    case BUFFERVIEW_CMD_PREVDIFF:
+        MoveToDifference(false);
+        return true;
     }
     return false;
 }
@@ -1382,6 +1423,191 @@ std::string_view Instance::GetName()
 {
     return this->name;
 }
+//======================================================================[Compare]=============================
+namespace
+{
+Instance* ToBufferView(Reference<GView::View::ViewControl> view)
+{
+    // a window can host any type of view --> only buffer views can be paired
+    if (view.IsValid() == false)
+        return nullptr;
+    return dynamic_cast<Instance*>(&(*view));
+}
+} // namespace
+void Instance::AttachCompareSession(std::shared_ptr<CompareSession> session, uint32 side)
+{
+    DetachCompareSession();
+    this->Compare.session       = session;
+    this->Compare.side          = side;
+    this->Compare.lastEntry     = 0;
+    this->Compare.shownEntries  = 0;
+    this->Compare.shownPercent  = 0;
+    this->Compare.finishedShown = false;
+}
+void Instance::DetachCompareSession()
+{
+    if (this->Compare.session)
+    {
+        this->Compare.session->Detach(this);
+        this->Compare.session.reset();
+    }
+}
+void Instance::StopCompare()
+{
+    auto session = this->Compare.session;
+    if (!session)
+        return;
+    auto first  = session->GetView(0);
+    auto second = session->GetView(1);
+    if (first)
+        first->DetachCompareSession();
+    if (second)
+        second->DetachCompareSession();
+    DetachCompareSession();
+}
+void Instance::ShowCompareDialog()
+{
+    std::vector<CompareCandidate> candidates;
+    auto dsk = AppCUI::Application::GetDesktop();
+    CHECKRET(dsk.IsValid(), "Fail to get Desktop object from AppCUI !");
+    auto count = dsk->GetChildrenCount();
+    for (auto idx = 0U; idx < count; idx++)
+    {
+        auto win = dsk->GetChild(idx).ToObjectRef<GView::App::FileWindow>();
+        if (win.IsValid() == false)
+            continue;
+        auto viewsCount = win->GetViewsCount();
+        for (auto viewIdx = 0U; viewIdx < viewsCount; viewIdx++)
+        {
+            auto bv = ToBufferView(win->GetViewByIndex(viewIdx));
+            if (bv == nullptr)
+                continue;
+            if (bv != this)
+                candidates.push_back({ win, bv, viewIdx });
+            break;
+        }
+    }
+    if (candidates.empty())
+    {
+        AppCUI::Dialogs::MessageBox::ShowNotification("Compare", "There is no other object opened in a buffer view !");
+        return;
+    }
+    CompareDialog dlg(candidates);
+    if (dlg.Show() != Dialogs::Result::Ok)
+        return;
+    auto sel = dlg.GetSelectedCandidate();
+    if (sel == nullptr)
+        return;
+
+    auto session = std::make_shared<CompareSession>();
+    if (session->Start(this, sel->view) == false)
+    {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "Fail to start comparing the two objects !");
+        return;
+    }
+    this->AttachCompareSession(session, 0);
+    sel->view->AttachCompareSession(session, 1);
+    // place the two objects side by side
+    sel->win->SetCurrentViewByIndex(sel->viewIndex);
+    AppCUI::Application::ArrangeWindows(AppCUI::Application::ArrangeWindowsMethod::Vertical);
+    sel->view->MoveTo(this->Cursor.currentPos, false);
+}
+bool Instance::IsDifference(uint64 offset)
+{
+    const auto& entries = this->Compare.session->entries;
+    const auto side     = this->Compare.side;
+    const auto count    = static_cast<uint32>(entries.size());
+    auto idx            = this->Compare.lastEntry;
+
+    if (count == 0)
+        return false;
+    // most of the calls are for consecutive offsets --> check the last entry that was used first
+    if ((idx >= count) || (offset < entries[idx].start[side]) || ((idx + 1 < count) && (offset >= entries[idx + 1].start[side])))
+    {
+        auto it = std::upper_bound(
+              entries.begin(), entries.end(), offset, [side](uint64 value, const DiffEntry& entry) { return value < entry.start[side]; });
+        if (it == entries.begin())
+            return false;
+        idx                     = static_cast<uint32>(it - entries.begin()) - 1;
+        this->Compare.lastEntry = idx;
+    }
+    return offset < entries[idx].end[side];
+}
+void Instance::MoveToDifference(bool next)
+{
+    if (!this->Compare.session)
+        return;
+    this->Compare.session->Update();
+    const auto& entries = this->Compare.session->entries;
+    const auto side     = this->Compare.side;
+    const auto pos      = this->Cursor.currentPos;
+
+    const DiffEntry* result = nullptr;
+    if (next)
+    {
+        // first difference that starts after the cursor
+        auto it = std::upper_bound(
+              entries.begin(), entries.end(), pos, [side](uint64 value, const DiffEntry& entry) { return value < entry.start[side]; });
+        if (it != entries.end())
+            result = &(*it);
+    }
+    else
+    {
+        // last difference that starts before the cursor
+        auto it = std::lower_bound(
+              entries.begin(), entries.end(), pos, [side](const DiffEntry& entry, uint64 value) { return entry.start[side] < value; });
+        if (it != entries.begin())
+            result = &(*(it - 1));
+    }
+    if (result == nullptr)
+        return;
+    MoveTo(result->start[side], false);
+    // keep the other object in sync
+    auto peer = this->Compare.session->GetView(side ^ 1);
+    if (peer)
+        peer->MoveTo(result->start[side ^ 1], false);
+}
+bool Instance::OnFrameUpdate()
+{
+    // called periodically from the UI thread --> the differences found in background (and the progress of the compare)
+    // are shown without any user input
+    auto session = this->Compare.session.get();
+    if ((!session) || (this->Compare.finishedShown))
+        return false;
+    const auto finished = session->IsFinished(); // read first --> every difference of a finished compare is published below
+    session->Update();                           // the entries are shared --> the other view might have published them already
+    const auto entries = static_cast<uint32>(session->entries.size());
+    const auto percent = GetComparePercent();
+    if ((!finished) && (entries == this->Compare.shownEntries) && (percent == this->Compare.shownPercent))
+        return false;
+    this->Compare.shownEntries  = entries;
+    this->Compare.shownPercent  = percent;
+    this->Compare.finishedShown = finished;
+    return true;
+}
+uint32 Instance::GetComparePercent() const
+{
+    auto session = this->Compare.session.get();
+    auto size    = std::max<uint64>(session->GetSize(0), 1);
+    return static_cast<uint32>(session->GetProcessed() * 100ULL / size);
+}
+void Instance::WriteCompareStatus(Renderer& renderer)
+{
+    LocalString<64> tmp;
+    auto session = this->Compare.session.get();
+    if (session->IsFinished())
+    {
+        tmp.Format("Diffs:%u%s", static_cast<uint32>(session->entries.size()), session->IsTruncated() ? "+" : "");
+    }
+    else
+    {
+        tmp.Format("Diffs:%u (%u%%)", static_cast<uint32>(session->entries.size()), GetComparePercent());
+    }
+    auto x = static_cast<int>(this->GetWidth()) - static_cast<int>(tmp.Len()) - 1;
+    if (x > static_cast<int>(this->Layout.xText) + 5)
+        renderer.WriteSingleLineText(x, 0, tmp.ToStringView(), config.Colors.Difference);
+}
+
 //======================================================================[Cursor information]==================
 int Instance::PrintSelectionInfo(uint32 selectionID, int x, int y, uint32 width, Renderer& r)
 {
@@ -1428,7 +1654,7 @@ int Instance::PrintCursorPosInfo(int x, int y, uint32 width, bool addSeparator,
 }
 int Instance::PrintCursorZone(int x, int y, uint32 width, Renderer& r)
 {
-    auto zone = this->settings->zList.OffsetToZone(this->Cursor.currentPos);
+    auto zone = this->settings->OffsetToZone(this->Cursor.currentPos);
     if (zone)
     {
         r.WriteSingleLineText(x, y, width, zone->name, this->CursorColors.Highlighted);
@@ -1837,7 +2063,10 @@ enum class PropertyID : uint32
     ChangeAddressMode,
     GoToEntryPoint,
     ChangeSelectionType,
-    ShowHideStrings
+    ShowHideStrings,
+    Compare,
+    NextDifference,
+    PreviousDifference
 };
 #define BT(t) static_cast<uint32>(t)
 
@@ -1920,6 +2149,15 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PropertyID::ShowHideStrings:
         value = config.Keys.ShowHideStrings;
         return true;
+    case PropertyID::Compare:
+        value = config.Keys.Compare;
+        return true;
+    case PropertyID::NextDifference:
+        value = config.Keys.NextDifference;
+        return true;
+    case PropertyID::PreviousDifference:
+        value = config.Keys.PreviousDifference;
+        return true;
     case PropertyID::AddressType:
         value = this->currentAdrressMode;
         return true;
@@ -2021,6 +2259,15 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
     case PropertyID::ShowHideStrings:
         config.Keys.ShowHideStrings = std::get<AppCUI::Input::Key>(value);
         return true;
+    case PropertyID::Compare:
+        config.Keys.Compare = std::get<AppCUI::Input::Key>(value);
+        return true;
+    case PropertyID::NextDifference:
+        config.Keys.NextDifference = std::get<AppCUI::Input::Key>(value);
+        return true;
+    case PropertyID::PreviousDifference:
+        config.Keys.PreviousDifference = std::get<AppCUI::Input::Key>(value);
+        return true;
     case PropertyID::AddressType:
         this->currentAdrressMode = (uint32) std::get<uint64>(value);
         return true;
@@ -2105,7 +2352,10 @@ const vector<Property> Instance::GetPropertiesList()
         { BT(PropertyID::ChangeColumnsView), "Shortcuts", "Change nr. of columns", PropertyType::Key },
         { BT(PropertyID::GoToEntryPoint), "Shortcuts", "Go To Entry Point", PropertyType::Key },
         { BT(PropertyID::ChangeSelectionType), "Shortcuts", "Change selection type", PropertyType::Key },
-        { BT(PropertyID::ShowHideStrings), "Shortcuts", "Show/Hide strings", PropertyType::Key }
+        { BT(PropertyID::ShowHideStrings), "Shortcuts", "Show/Hide strings", PropertyType::Key },
+        { BT(PropertyID::Compare), "Shortcuts", "Compare with another object", PropertyType::Key },
+        { BT(PropertyID::NextDifference), "Shortcuts", "Go to next difference", PropertyType::Key },
+        { BT(PropertyID::PreviousDifference), "Shortcuts", "Go to previous difference", PropertyType::Key }
     };
 }
 #undef BT
@@ -11,6 +11,13 @@ SettingsData::SettingsData()
     this->entryPointOffset        = GView::Utils::INVALID_OFFSET;
 }
 
+const GView::Utils::Zone* SettingsData::OffsetToZone(uint64 offset)
+{
+    if (const auto* z = this->zList.OffsetToZone(offset); z != nullptr)
+        return z;
+    return this->zProvider.OffsetToZone(offset);
+}
+
 Settings::Settings()
 {
     this->data = new SettingsData();
@@ -52,6 +59,11 @@ void Settings::SetPositionToColorCallback(Reference<PositionToColorInterface> cb
     ((SettingsData*) (this->data))->positionToColorCallback = cbk;
 }
 
+void Settings::SetZoneProvider(Reference<ZoneProviderInterface> cbk)
+{
+    ((SettingsData*) (this->data))->zProvider.SetProvider(cbk);
+}
+
 void Settings::SetEntryPointOffset(uint64_t offset)
 {
     ((SettingsData*) (this->data))->entryPointOffset = offset;
@@ -0,0 +1,69 @@
+#include "BufferViewer.hpp"
+
+#include <algorithm>
+
+using namespace GView::View::BufferViewer;
+
+constexpr uint64 ZONE_BLOCK_SIZE = 0x10000; // the zones are requested for 64K bytes at once
+
+void ZoneProviderCache::SetProvider(Reference<ZoneProviderInterface> _provider)
+{
+    this->provider = _provider;
+    this->version  = _provider.IsValid() ? _provider->GetZonesVersion() : 0;
+    Clear();
+}
+void ZoneProviderCache::Clear()
+{
+    this->lastZone  = nullptr;
+    this->nextBlock = 0;
+    for (auto& b : this->blocks)
+    {
+        b.start = GView::Utils::INVALID_OFFSET;
+        b.zones.clear();
+    }
+}
+ZoneProviderCache::Block& ZoneProviderCache::GetBlock(uint64 start)
+{
+    for (auto& b : this->blocks)
+        if (b.start == start)
+            return b;
+
+    // the oldest block is replaced (the painted bytes are at most a few blocks apart)
+    auto& b         = this->blocks[this->nextBlock];
+    this->nextBlock = (this->nextBlock + 1) % static_cast<uint32>(this->blocks.size());
+    this->lastZone  = nullptr; // it could point in the replaced block
+    b.start         = start;
+    b.zones.clear();
+    this->request.clear();
+    CHECK(this->provider->GetZones(start, start + ZONE_BLOCK_SIZE, this->request), b, "Fail to get the zones from offset %llu", start);
+    for (const auto& z : this->request)
+    {
+        if (z.size == 0)
+            continue;
+        b.zones.emplace_back().Set(z.start, z.start + z.size - 1, z.color, std::string_view(z.name.GetText(), z.name.Len()));
+    }
+    return b;
+}
+const GView::Utils::Zone* ZoneProviderCache::OffsetToZone(uint64 offset)
+{
+    if (!this->provider.IsValid())
+        return nullptr;
+    // the zones of the provider have changed --> the cached blocks are requested again
+    if (const auto v = this->provider->GetZonesVersion(); v != this->version)
+    {
+        this->version = v;
+        Clear();
+    }
+    // most calls are for the next bytes of the same zone
+    if ((this->lastZone) && (offset >= this->lastZone->start) && (offset <= this->lastZone->end))
+        return this->lastZone;
+
+    // the last zone that starts before the offset (the zones are sorted by their start)
+    const auto& b = GetBlock(offset - offset % ZONE_BLOCK_SIZE);
+    auto it       = std::upper_bound(
+          b.zones.begin(), b.zones.end(), offset, [](uint64 value, const GView::Utils::Zone& z) { return value < z.start; });
+    if ((it == b.zones.begin()) || (offset > (it - 1)->end))
+        return nullptr;
+    this->lastZone = &*(it - 1);
+    return this->lastZone;
+}
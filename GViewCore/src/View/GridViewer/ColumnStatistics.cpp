@@ -0,0 +1,399 @@
+#include "GridViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+using namespace GView::View::GridViewer;
+
+constexpr uint32 STATS_READ_SIZE     = 0x100000;   // rows are read 1M bytes at a time (a longer row is truncated)
+constexpr uint64 MAX_MEMORY_OBJECT   = 0x10000000; // non-file objects are copied in memory (256M max)
+constexpr uint32 MAX_STATS_COLUMNS   = 256;
+constexpr uint32 MAX_VALUE_CHARS     = 64;   // longer values are truncated (for min/max and top values)
+constexpr uint32 MAX_NUMBER_DIGITS   = 768;  // a value halfway between two doubles has at most 767 significant digits
+constexpr uint32 HLL_PRECISION       = 12;   // 4096 registers per column (about 1.6% error for the distinct values)
+constexpr uint32 TOP_VALUES_COUNTERS = 32;   // Space-Saving counters per column
+constexpr uint32 TOP_VALUES_SHOWN    = 5;
+constexpr uint32 PUBLISH_CHECK_ROWS  = 4096; // the clock is checked every time this many rows are processed
+constexpr auto PUBLISH_INTERVAL      = std::chrono::milliseconds(250);
+
+namespace
+{
+enum class ValueKind : uint8
+{
+    Integer,
+    Float,
+    Boolean,
+    Text
+};
+inline bool EqualsNoCase(std::string_view value, std::string_view text)
+{
+    if (value.size() != text.size())
+        return false;
+    for (auto idx = 0U; idx < value.size(); idx++)
+        if ((value[idx] | 0x20) != text[idx])
+            return false;
+    return true;
+}
+ValueKind GetValueKind(std::string_view value, double& number)
+{
+    if (EqualsNoCase(value, "true") || EqualsNoCase(value, "false"))
+        return ValueKind::Boolean;
+    if (!ParseNumber(value, number))
+        return ValueKind::Text;
+    const auto digits  = value.substr((value[0] == '+') || (value[0] == '-') ? 1 : 0);
+    const auto integer = std::all_of(digits.begin(), digits.end(), [](char ch) { return (ch >= '0') && (ch <= '9'); });
+    return integer ? ValueKind::Integer : ValueKind::Float;
+}
+inline uint64 HashValue(std::string_view value)
+{
+    // FNV-1a (the bits are mixed afterwards, because the registers are selected by the high bits)
+    auto hash = 0xcbf29ce484222325ULL;
+    for (auto ch : value)
+    {
+        hash ^= static_cast<uint8>(ch);
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+} // namespace
+
+bool GView::View::GridViewer::ParseNumber(std::string_view text, double& number)
+{
+    // the text is validated here and only "<digits>e<exponent>" is converted with strtod (there is no decimal point, so the
+    // result does not depend on the locale) - the digits after the first MAX_NUMBER_DIGITS ones are replaced by a single
+    // digit that is not zero (if any of them is not zero) --> the result is rounded in the same way
+    char buffer[MAX_NUMBER_DIGITS + 32];
+    auto len        = 0U;
+    auto idx        = 0U;
+    auto digits     = 0U;
+    auto kept       = 0U;
+    auto dropped    = false;
+    int64 exponent  = 0;
+    const auto size = static_cast<uint32>(text.size());
+    if ((idx < size) && ((text[idx] == '+') || (text[idx] == '-')))
+    {
+        if (text[idx] == '-')
+            buffer[len++] = '-';
+        idx++;
+    }
+    auto addDigit = [&](char ch, bool fraction)
+    {
+        digits++;
+        if ((kept == 0) && (ch == '0'))
+        {
+            exponent -= fraction ? 1 : 0; // leading zeros
+            return;
+        }
+        if (kept < MAX_NUMBER_DIGITS)
+        {
+            buffer[len++] = ch;
+            kept++;
+            exponent -= fraction ? 1 : 0;
+            return;
+        }
+        exponent += fraction ? 0 : 1;
+        dropped |= (ch != '0');
+    };
+    for (; (idx < size) && (text[idx] >= '0') && (text[idx] <= '9'); idx++)
+        addDigit(text[idx], false);
+    if ((idx < size) && (text[idx] == '.'))
+    {
+        for (idx++; (idx < size) && (text[idx] >= '0') && (text[idx] <= '9'); idx++)
+            addDigit(text[idx], true);
+    }
+    if (digits == 0)
+        return false;
+    if ((idx < size) && ((text[idx] == 'e') || (text[idx] == 'E')))
+    {
+        idx++;
+        const auto negative = (idx < size) && (text[idx] == '-');
+        if ((idx < size) && ((text[idx] == '+') || (text[idx] == '-')))
+            idx++;
+        if ((idx >= size) || (text[idx] < '0') || (text[idx] > '9'))
+            return false;
+        int64 value = 0;
+        for (; (idx < size) && (text[idx] >= '0') && (text[idx] <= '9'); idx++)
+            value = std::min<int64>(value * 10 + (text[idx] - '0'), 1000000); // way past the range of a double
+        exponent += negative ? -value : value;
+    }
+    if (idx != size)
+        return false;
+    if (kept == 0)
+    {
+        buffer[len++] = '0';
+    }
+    else if (dropped)
+    {
+        buffer[len++] = '1';
+        exponent--;
+    }
+    buffer[len++] = 'e';
+    len           = static_cast<uint32>(std::to_chars(buffer + len, buffer + sizeof(buffer) - 1, exponent).ptr - buffer);
+    buffer[len]   = 0;
+
+    char* end = nullptr;
+    number    = std::strtod(buffer, &end);
+    return (end == buffer + len) && (std::isfinite(number));
+}
+
+ColumnStatistics::ColumnStatistics()
+    : rowOffsets(nullptr), firstRow(0), rowsCount(0), separator(','), useMemory(false), version(0), processedRows(0), stop(false),
+      finished(true), failed(false), canceled(false)
+{
+}
+ColumnStatistics::~ColumnStatistics()
+{
+    Stop();
+}
+bool ColumnStatistics::Start(
+      Reference<GView::Object> obj, const std::vector<uint64>& _rowOffsets, uint64 _firstRow, uint32 columnsCount, char _separator)
+{
+    Stop();
+    CHECK(_rowOffsets.size() > _firstRow, false, "Invalid first row: %llu", _firstRow);
+
+    // the worker reads the object with its own handle (the data cache of the object is not thread safe)
+    this->useMemory = obj->GetObjectType() != GView::Object::Type::File;
+    const auto size = obj->GetData().GetSize();
+    if (this->useMemory)
+    {
+        CHECK(size <= MAX_MEMORY_OBJECT, false, "Object is too large (%llu bytes)", size);
+        if (size > 0)
+        {
+            this->memory = obj->GetData().CopyToBuffer(0, static_cast<uint32>(size), true);
+            CHECK(this->memory.IsValid(), false, "Fail to copy %llu bytes", size);
+        }
+    }
+    else
+    {
+        this->path = std::filesystem::path(obj->GetPath());
+    }
+
+    this->rowOffsets = &_rowOffsets;
+    this->firstRow   = _firstRow;
+    this->rowsCount  = _rowOffsets.size() - 1 - _firstRow;
+    this->separator  = _separator;
+    this->columns.clear();
+    this->columns.resize(std::min<>(columnsCount, MAX_STATS_COLUMNS));
+    this->summaries.clear();
+    this->version       = 0;
+    this->processedRows = 0;
+    this->stop          = false;
+    this->failed        = false;
+    this->canceled      = false;
+    this->finished      = false;
+    this->worker        = std::thread(&ColumnStatistics::Run, this);
+    return true;
+}
+void ColumnStatistics::Stop()
+{
+    this->canceled = this->canceled || (!this->finished);
+    this->stop     = true;
+    if (this->worker.joinable())
+        this->worker.join();
+}
+bool ColumnStatistics::GetSummaries(std::vector<ColumnSummary>& output, uint32& outputVersion)
+{
+    // copies the last published summaries (only if they changed since 'outputVersion')
+    std::lock_guard<std::mutex> lock(this->summariesLock);
+    if (outputVersion == this->version)
+        return false;
+    output        = this->summaries;
+    outputVersion = this->version;
+    return true;
+}
+void ColumnStatistics::Run()
+{
+    RowIndexSource source;
+    std::vector<uint8> buffer(STATS_READ_SIZE);
+    std::vector<std::string_view> cells;
+    std::string value;
+    auto lastPublish = std::chrono::steady_clock::now();
+
+    if (this->useMemory)
+        source.Open(this->memory);
+    else if (!source.Open(this->path, this->rowOffsets->back()))
+        this->failed = true;
+
+    // a read starts with a row and contains all the rows that fit in the buffer (at least one)
+    const auto& offsets = *this->rowOffsets;
+    const auto lastRow  = this->firstRow + this->rowsCount;
+    auto row            = this->firstRow;
+    while ((row < lastRow) && (!this->stop) && (!this->failed))
+    {
+        const auto start = offsets[row];
+        auto end         = row + 1;
+        while ((end < lastRow) && (offsets[end + 1] - start <= STATS_READ_SIZE))
+            end++;
+        const auto size = static_cast<uint32>(std::min<uint64>(offsets[end] - start, STATS_READ_SIZE));
+        if (!source.Read(start, buffer.data(), size))
+        {
+            this->failed = true;
+            break;
+        }
+        for (; row < end; row++)
+        {
+            const auto rowStart = static_cast<uint32>(offsets[row] - start);
+            const auto rowEnd   = static_cast<uint32>(std::min<uint64>(offsets[row + 1] - start, size));
+            std::string_view text{ reinterpret_cast<const char*>(buffer.data()) + rowStart, rowEnd - rowStart };
+            while ((!text.empty()) && ((text.back() == '\n') || (text.back() == '\r')))
+                text.remove_suffix(1);
+            SplitRow(text, this->separator, cells);
+            for (auto idx = 0U; idx < this->columns.size(); idx++)
+                AddValue(this->columns[idx], idx < cells.size() ? GetCellValue(cells[idx], value) : std::string_view{});
+            if (((row - this->firstRow + 1) % PUBLISH_CHECK_ROWS == 0) &&
+                (std::chrono::steady_clock::now() - lastPublish >= PUBLISH_INTERVAL))
+            {
+                this->processedRows = row - this->firstRow + 1;
+                Publish();
+                lastPublish = std::chrono::steady_clock::now();
+            }
+        }
+        this->processedRows = row - this->firstRow;
+    }
+    Publish();
+    this->memory   = Buffer();
+    this->finished = true;
+}
+void ColumnStatistics::AddValue(Column& column, std::string_view text)
+{
+    if (text.empty())
+    {
+        column.nulls++;
+        return;
+    }
+    auto number = 0.0;
+    switch (GetValueKind(text, number))
+    {
+    case ValueKind::Integer:
+        column.integers++;
+        break;
+    case ValueKind::Float:
+        column.floats++;
+        break;
+    case ValueKind::Boolean:
+        column.booleans++;
+        break;
+    default:
+        column.texts++;
+        break;
+    }
+    if (column.integers + column.floats > column.numbers)
+    {
+        column.minNumber = column.numbers == 0 ? number : std::min<>(column.minNumber, number);
+        column.maxNumber = column.numbers == 0 ? number : std::max<>(column.maxNumber, number);
+        column.numbers++;
+    }
+
+    text = text.substr(0, MAX_VALUE_CHARS);
+    if ((column.minText.empty()) || (text < column.minText))
+        column.minText = text;
+    if (text > column.maxText)
+        column.maxText = text;
+
+    // distinct values (HyperLogLog): the high bits select a register that keeps the longest run of zero bits seen after them
+    const auto hash         = HashValue(text);
+    const auto index        = static_cast<uint32>(hash >> (64 - HLL_PRECISION));
+    const auto rank         = static_cast<uint8>(std::countl_zero((hash << HLL_PRECISION) | (1ULL << (HLL_PRECISION - 1))) + 1);
+    column.registers[index] = std::max<>(column.registers[index], rank);
+
+    // top values (Space-Saving): a value that is not counted replaces the one with the smallest count (and inherits it)
+    auto minIndex = 0U;
+    for (auto idx = 0U; idx < column.top.size(); idx++)
+    {
+        auto& counter = column.top[idx];
+        if ((counter.hash == hash) && (counter.value == text))
+        {
+            counter.count++;
+            return;
+        }
+        if (counter.count < column.top[minIndex].count)
+            minIndex = idx;
+    }
+    if (column.top.size() < TOP_VALUES_COUNTERS)
+    {
+        column.top.push_back(TopValue{ hash, 1, 0, std::string(text) });
+        return;
+    }
+    auto& counter = column.top[minIndex];
+    counter.hash  = hash;
+    counter.value = text;
+    counter.error = counter.count;
+    counter.count++;
+}
+uint64 ColumnStatistics::EstimateDistinct(const Column& column)
+{
+    constexpr auto registersCount = static_cast<double>(1U << HLL_PRECISION);
+    constexpr auto alpha          = 0.7213 / (1.0 + 1.079 / registersCount);
+    auto sum                      = 0.0;
+    auto zeros                    = 0U;
+    for (auto value : column.registers)
+    {
+        sum += std::ldexp(1.0, -static_cast<int32>(value));
+        zeros += value == 0 ? 1 : 0;
+    }
+    auto estimate = alpha * registersCount * registersCount / sum;
+    // for a small number of values, the empty registers give a better estimate (linear counting)
+    if ((estimate <= 2.5 * registersCount) && (zeros > 0))
+        estimate = registersCount * std::log(registersCount / zeros);
+    return static_cast<uint64>(std::llround(estimate));
+}
+void ColumnStatistics::Publish()
+{
+    std::vector<ColumnSummary> result;
+    LocalString<128> tmp;
+    result.reserve(this->columns.size());
+    for (const auto& column : this->columns)
+    {
+        auto& summary  = result.emplace_back();
+        summary.nulls  = column.nulls;
+        summary.values = column.integers + column.floats + column.booleans + column.texts;
+        if (summary.values == 0)
+            summary.type = "Empty";
+        else if ((column.texts > 0) || ((column.booleans > 0) && (column.numbers > 0)))
+            summary.type = "Text";
+        else if (column.booleans > 0)
+            summary.type = "Boolean";
+        else
+            summary.type = column.floats > 0 ? "Float" : "Integer";
+
+        // a column with numbers compares them as numbers (text and boolean columns compare their values as text)
+        if ((summary.type == "Integer") || (summary.type == "Float"))
+        {
+            summary.min = tmp.Format("%.15g", column.minNumber);
+            summary.max = tmp.Format("%.15g", column.maxNumber);
+        }
+        else
+        {
+            summary.min = column.minText;
+            summary.max = column.maxText;
+        }
+        summary.distinct = summary.values == 0 ? 0 : std::min<>(std::max<uint64>(EstimateDistinct(column), 1), summary.values);
+
+        // only the values that were surely found more than once are shown
+        std::vector<const TopValue*> top;
+        for (const auto& counter : column.top)
+            if (counter.count - counter.error > 1)
+                top.push_back(&counter);
+        std::sort(top.begin(), top.end(), [](const TopValue* a, const TopValue* b) { return a->count > b->count; });
+        for (auto idx = 0U; idx < std::min<size_t>(top.size(), TOP_VALUES_SHOWN); idx++)
+        {
+            if (idx > 0)
+                summary.top += ", ";
+            summary.top += top[idx]->value;
+            summary.top += tmp.Format(" (%llu)", top[idx]->count);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(this->summariesLock);
+    this->summaries = std::move(result);
+    this->version++;
+}
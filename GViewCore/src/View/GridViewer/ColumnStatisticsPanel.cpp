@@ -0,0 +1,104 @@
+#include "GridViewer.hpp"
+
+using namespace GView::View::GridViewer;
+using namespace AppCUI::Input;
+
+constexpr uint32 NO_PERCENT = 0xFFFFFFFF;
+
+enum class ColumnStatisticsAction : int32
+{
+    Stop = 1
+};
+
+ColumnStatisticsPanel::ColumnStatisticsPanel() : TabPage("S&tatistics"), version(0), shownPercent(NO_PERCENT), finishedShown(false)
+{
+    status = Factory::Label::Create(this, "", "l:0,t:0,r:0,h:1");
+    list   = Factory::ListView::Create(
+          this,
+          "l:0,t:1,r:0,b:0",
+          { "n:Column,a:l,w:20",
+            "n:Type,a:l,w:9",
+            "n:Values,a:r,w:14",
+            "n:Empty,a:r,w:14",
+            "n:Distinct (~),a:r,w:14",
+            "n:Min,a:l,w:20",
+            "n:Max,a:l,w:20",
+            "n:Top values,a:l,w:200" },
+          ListViewFlags::None);
+}
+void ColumnStatisticsPanel::SetStatistics(std::shared_ptr<ColumnStatistics> _statistics, std::vector<std::string> _names)
+{
+    statistics = _statistics;
+    names      = std::move(_names);
+    version       = 0;
+    shownPercent  = NO_PERCENT;
+    finishedShown = false;
+    summaries.clear();
+    list->DeleteAllItems();
+    Update();
+}
+bool ColumnStatisticsPanel::Update()
+{
+    // called periodically (from the UI thread) - the list is filled again only if new summaries were published
+    // returns true if something changed (new summaries, the progress or the final state of the computation)
+    CHECK(statistics, false, "");
+    if (finishedShown)
+        return false;
+    const auto finished  = statistics->IsFinished(); // read first --> the summaries of a finished computation are published below
+    const auto published = statistics->GetSummaries(summaries, version);
+
+    LocalString<128> tmp;
+    NumericFormatter n;
+    if (published)
+    {
+        list->DeleteAllItems();
+        for (auto idx = 0U; idx < summaries.size(); idx++)
+        {
+            const auto& s = summaries[idx];
+            auto item     = list->AddItem(idx < names.size() ? std::string_view(names[idx]) : tmp.Format("%u", idx + 1));
+            item.SetText(1, s.type);
+            item.SetText(2, n.ToDec(s.values));
+            item.SetText(3, n.ToDec(s.nulls));
+            item.SetText(4, n.ToDec(s.distinct));
+            item.SetText(5, s.min);
+            item.SetText(6, s.max);
+            item.SetText(7, s.top);
+        }
+    }
+
+    const auto rows      = statistics->GetRowsCount();
+    const auto processed = statistics->GetProcessedRows();
+    const auto percent   = rows == 0 ? 100U : static_cast<uint32>(processed * 100 / rows);
+    if ((!published) && (!finished) && (percent == shownPercent))
+        return false;
+    shownPercent  = percent;
+    finishedShown = finished;
+    if (!finished)
+        status->SetText(tmp.Format("Computing ... %u%% (%llu of %llu rows)", percent, processed, rows));
+    else if (statistics->IsCanceled())
+        status->SetText(tmp.Format("Stopped (only %llu of %llu rows were processed)", processed, rows));
+    else if (statistics->HasFailed())
+        status->SetText(tmp.Format("Failed to read the object (only %llu of %llu rows were processed)", processed, rows));
+    else
+        status->SetText(tmp.Format("%llu rows", rows));
+    return true;
+}
+bool ColumnStatisticsPanel::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    if ((statistics) && (!statistics->IsFinished()))
+        commandBar.SetCommand(Key::F8, "Stop", static_cast<int32_t>(ColumnStatisticsAction::Stop));
+    return true;
+}
+bool ColumnStatisticsPanel::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
+
+    if ((evnt == Event::Command) && (static_cast<ColumnStatisticsAction>(controlID) == ColumnStatisticsAction::Stop))
+    {
+        if (statistics)
+            statistics->Stop();
+        Update();
+        return true;
+    }
+    return false;
+}
@@ -6,12 +6,20 @@ using namespace AppCUI::Input;
 constexpr Key KEY_REPLACE_HEADER_WITH_1ST_ROW = Key::Space;
 constexpr Key KEY_TOGGLE_HORIZONTAL_LINES     = Key::H;
 constexpr Key KEY_TOGGLE_VERTICAL_LINES       = Key::V;
+constexpr Key KEY_SHOW_STATISTICS             = Key::S;
+constexpr Key KEY_SORT_ROWS                   = Key::O;
+constexpr Key KEY_FILTER_ROWS                 = Key::F;
+constexpr Key KEY_FILE_ORDER                  = Key::R;
 
 void Config::Update(IniSection sect)
 {
     sect.UpdateValue("Key.ReplaceHeaderWith1stRow", KEY_REPLACE_HEADER_WITH_1ST_ROW, true);
     sect.UpdateValue("Key.ToggleHorizontalLines", KEY_TOGGLE_HORIZONTAL_LINES, true);
     sect.UpdateValue("Key.ToggleVerticalLines", KEY_TOGGLE_VERTICAL_LINES, true);
+    sect.UpdateValue("Key.ShowStatistics", KEY_SHOW_STATISTICS, true);
+    sect.UpdateValue("Key.SortRows", KEY_SORT_ROWS, true);
+    sect.UpdateValue("Key.FilterRows", KEY_FILTER_ROWS, true);
+    sect.UpdateValue("Key.FileOrder", KEY_FILE_ORDER, true);
 }
 
 void Config::Initialize()
@@ -23,12 +31,20 @@ void Config::Initialize()
         this->keys.replaceHeaderWith1stRow = sect.GetValue("Key.ReplaceHeaderWith1stRow").ToKey(KEY_REPLACE_HEADER_WITH_1ST_ROW);
         this->keys.toggleHorizontalLines   = sect.GetValue("Key.ToggleHorizontalLines").ToKey(KEY_TOGGLE_HORIZONTAL_LINES);
         this->keys.toggleVerticalLines     = sect.GetValue("Key.ToggleVerticalLines").ToKey(KEY_TOGGLE_VERTICAL_LINES);
+        this->keys.showStatistics          = sect.GetValue("Key.ShowStatistics").ToKey(KEY_SHOW_STATISTICS);
+        this->keys.sortRows                = sect.GetValue("Key.SortRows").ToKey(KEY_SORT_ROWS);
+        this->keys.filterRows              = sect.GetValue("Key.FilterRows").ToKey(KEY_FILTER_ROWS);
+        this->keys.fileOrder               = sect.GetValue("Key.FileOrder").ToKey(KEY_FILE_ORDER);
     }
     else
     {
         this->keys.replaceHeaderWith1stRow = KEY_REPLACE_HEADER_WITH_1ST_ROW;
         this->keys.toggleHorizontalLines   = KEY_TOGGLE_HORIZONTAL_LINES;
         this->keys.toggleVerticalLines     = KEY_TOGGLE_VERTICAL_LINES;
+        this->keys.showStatistics          = KEY_SHOW_STATISTICS;
+        this->keys.sortRows                = KEY_SORT_ROWS;
+        this->keys.filterRows              = KEY_FILTER_ROWS;
+        this->keys.fileOrder               = KEY_FILE_ORDER;
     }
 
     loaded = true;
@@ -2,6 +2,11 @@
 
 #include "Internal.hpp"
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace GView
 {
 namespace View
@@ -10,8 +15,7 @@ namespace View
     {
         struct SettingsData
         {
-            std::map<uint64, std::pair<uint64, uint64>> lines;
-            std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
+            std::vector<uint64> rowOffsets; // the offset of every row (the last one is the end of the file)
             char separator[2]{ "," };
             uint64 rows           = 0;
             uint64 cols           = 0;
@@ -19,6 +23,308 @@ namespace View
             SettingsData();
         };
 
+        class RowIndexSource
+        {
+            AppCUI::OS::File file;
+            const Buffer* memory;
+            uint64 size;
+
+          public:
+            RowIndexSource() : memory(nullptr), size(0)
+            {
+            }
+            bool Open(const std::filesystem::path& path, uint64 size);
+            void Open(const Buffer& buffer);
+            bool Read(uint64 offset, uint8* buffer, uint32 bufferSize);
+        };
+        // Finds the rows of a CSV/TSV object (a new line between quotes does not end a row). Big objects are split in chunks that
+        // are classified on several threads; the rows of a chunk are only known after the quotes of all previous chunks are counted.
+        class RowIndexer
+        {
+            struct Chunk
+            {
+                uint64 start{ 0 };
+                uint64 end{ 0 };
+                std::vector<uint64> newLines[2]; // (offset << 1) | isCR, if the chunk starts outside [0] or inside [1] quotes
+                bool oddQuotes{ false };
+                bool speculative{ false };       // the quotes before the chunk are not known while it is classified
+            };
+
+            std::vector<Chunk> chunks;
+            std::filesystem::path path;
+            Buffer memory;
+            uint64 size{ 0 };
+            bool useMemory{ false };
+            std::atomic<uint64> nextChunk{ 0 };
+            std::atomic<bool> failed{ false };
+
+            void Run();
+            void ClassifyData(Chunk& chunk, const uint8* p, uint32 size, uint64 offset);
+            void JoinChunks(std::vector<uint64>& rowOffsets);
+
+          public:
+            bool Build(Reference<GView::Object> obj, std::vector<uint64>& rowOffsets);
+        };
+        // splits a row in cells (a separator between quotes is part of a cell)
+        void SplitRow(std::string_view row, char separator, std::vector<std::string_view>& cells);
+        // the quotes around a cell are removed (and two quotes between them become one)
+        std::string_view GetCellValue(std::string_view cell, std::string& buffer);
+        // a decimal number (with an optional sign, fraction and exponent)
+        bool ParseNumber(std::string_view text, double& number);
+
+        struct ColumnSummary
+        {
+            uint64 values{ 0 }; // cells that are not empty
+            uint64 nulls{ 0 };
+            uint64 distinct{ 0 }; // an estimation (HyperLogLog)
+            std::string type;
+            std::string min;
+            std::string max;
+            std::string top; // the most frequent values (with their approximate count)
+        };
+        // Computes the statistics of every column in one pass over the rows, on a background thread. The memory used by a column
+        // does not depend on the number of rows: the distinct values are estimated with a HyperLogLog sketch and the most
+        // frequent ones are found with a fixed number of Space-Saving counters. The summaries are published every 250ms.
+        class ColumnStatistics
+        {
+            struct TopValue
+            {
+                uint64 hash;
+                uint64 count;
+                uint64 error; // the count of the value that was replaced (the real count is at least count - error)
+                std::string value;
+            };
+            struct Column
+            {
+                uint64 integers{ 0 }, floats{ 0 }, booleans{ 0 }, texts{ 0 }, nulls{ 0 }, numbers{ 0 };
+                double minNumber{ 0 }, maxNumber{ 0 };
+                std::string minText, maxText;
+                std::array<uint8, 4096> registers{}; // 1 << HLL_PRECISION
+                std::vector<TopValue> top;
+            };
+
+            // only used by the worker thread while it runs
+            std::vector<Column> columns;
+            const std::vector<uint64>* rowOffsets;
+            uint64 firstRow, rowsCount;
+            char separator;
+            std::filesystem::path path;
+            Buffer memory;
+            bool useMemory;
+
+            std::thread worker;
+            std::mutex summariesLock;
+            std::vector<ColumnSummary> summaries;
+            uint32 version;
+            std::atomic<uint64> processedRows;
+            std::atomic<bool> stop, finished, failed;
+            bool canceled;
+
+            void Run();
+            void AddValue(Column& column, std::string_view text);
+            void Publish();
+            static uint64 EstimateDistinct(const Column& column);
+
+          public:
+            ColumnStatistics();
+            ~ColumnStatistics();
+
+            // the row offsets must not change (or be destroyed) until the statistics are stopped
+            bool Start(
+                  Reference<GView::Object> obj,
+                  const std::vector<uint64>& rowOffsets,
+                  uint64 firstRow,
+                  uint32 columnsCount,
+                  char separator);
+            void Stop();
+            bool GetSummaries(std::vector<ColumnSummary>& output, uint32& outputVersion);
+
+            inline uint64 GetProcessedRows() const
+            {
+                return processedRows.load(std::memory_order_relaxed);
+            }
+            inline uint64 GetRowsCount() const
+            {
+                return rowsCount;
+            }
+            inline bool IsFinished() const
+            {
+                return finished.load(std::memory_order_acquire);
+            }
+            inline bool HasFailed() const
+            {
+                return failed.load();
+            }
+            inline bool IsCanceled() const
+            {
+                return canceled;
+            }
+        };
+        class ColumnStatisticsPanel : public AppCUI::Controls::TabPage
+        {
+            Reference<AppCUI::Controls::Label> status;
+            Reference<AppCUI::Controls::ListView> list;
+            std::shared_ptr<ColumnStatistics> statistics;
+            std::vector<std::string> names;
+            std::vector<ColumnSummary> summaries;
+            uint32 version;
+            uint32 shownPercent;
+            bool finishedShown;
+
+          public:
+            ColumnStatisticsPanel();
+
+            void SetStatistics(std::shared_ptr<ColumnStatistics> statistics, std::vector<std::string> names);
+            bool Update();
+            bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+            bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+        };
+
+        enum class FilterOperator : uint8
+        {
+            Contains = 0,
+            Equals,
+            NotEquals,
+            Less,
+            LessOrEqual,
+            Greater,
+            GreaterOrEqual,
+            Empty,
+            NotEmpty
+        };
+        struct RowFilter
+        {
+            uint32 column{ 0 };
+            FilterOperator op{ FilterOperator::Contains };
+            std::string value;
+            double number{ 0 };
+            bool isNumber{ false }; // the cells are compared as numbers (the value is a number)
+
+            bool Matches(std::string_view text) const;
+        };
+        struct RowSort
+        {
+            uint32 column{ 0 };
+            bool numeric{ false };
+            bool descending{ false };
+        };
+        // Sorts and filters rows (given by their index) by the value of a column. Only the indexes are sorted (or selected), the
+        // rows stay where they are. The work is done on a background thread: the cells are read (and the keys are sorted) on
+        // several threads, and the keys that do not fit in the memory budget are sorted in runs that are kept in temporary files
+        // and merged at the end.
+        class RowOrder
+        {
+            Reference<GView::Object> obj;
+            const std::vector<uint64>& rowOffsets;
+            char separator;
+            uint32 threadsCount;
+            std::filesystem::path path;
+            Buffer memory;
+            bool useMemory;
+
+            // only used by the worker thread while it runs
+            std::vector<uint64> rows;
+            RowSort sort;
+            RowFilter filter;
+            bool sorting;
+
+            std::thread worker;
+            uint64 progressTotal;
+            std::atomic<uint64> progress;
+            std::atomic<bool> stop, finished, failed;
+            bool canceled;
+
+            bool Start(std::vector<uint64> rows, bool sorting);
+            void Run();
+            bool Prepare();
+            template <typename T>
+            bool ReadCells(const uint64* rows, size_t count, uint32 column, T&& onCell);
+            bool Filter();
+            bool Sort();
+
+          public:
+            // the row offsets must not change (or be destroyed) until the task is stopped
+            RowOrder(Reference<GView::Object> obj, const std::vector<uint64>& rowOffsets, char separator);
+            ~RowOrder();
+
+            // keeps the rows that match the filter (in the same order)
+            bool StartFilter(std::vector<uint64> rows, const RowFilter& filter);
+            // rows with equal keys keep their order from the file
+            bool StartSort(std::vector<uint64> rows, const RowSort& sort);
+            void Stop();
+
+            // the sorted (or filtered) rows, once the task is finished
+            inline std::vector<uint64>& GetRows()
+            {
+                return rows;
+            }
+            inline const RowSort& GetSort() const
+            {
+                return sort;
+            }
+            inline const RowFilter& GetFilter() const
+            {
+                return filter;
+            }
+            inline bool IsSorting() const
+            {
+                return sorting;
+            }
+            inline uint32 GetPercent() const
+            {
+                const auto done = std::min<>(progress.load(std::memory_order_relaxed), progressTotal);
+                return progressTotal == 0 ? 100U : static_cast<uint32>(done * 100 / progressTotal);
+            }
+            inline bool IsFinished() const
+            {
+                return finished.load(std::memory_order_acquire);
+            }
+            inline bool HasFailed() const
+            {
+                return failed.load();
+            }
+            inline bool IsCanceled() const
+            {
+                return canceled;
+            }
+        };
+        class SortDialog : public Window
+        {
+            Reference<ComboBox> cbColumn;
+            Reference<CheckBox> cbNumeric;
+            Reference<CheckBox> cbDescending;
+            RowSort sort;
+
+            void Validate();
+
+          public:
+            SortDialog(const std::vector<std::string>& columns, const RowSort& sort);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline const RowSort& GetSort() const
+            {
+                return sort;
+            }
+        };
+        class FilterDialog : public Window
+        {
+            Reference<ComboBox> cbColumn;
+            Reference<ComboBox> cbOperator;
+            Reference<TextField> txValue;
+            RowFilter filter;
+
+            void Validate();
+
+          public:
+            FilterDialog(const std::vector<std::string>& columns, const RowFilter& filter);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline const RowFilter& GetFilter() const
+            {
+                return filter;
+            }
+        };
+
         struct Config
         {
             struct
@@ -26,6 +332,10 @@ namespace View
                 AppCUI::Input::Key replaceHeaderWith1stRow;
                 AppCUI::Input::Key toggleHorizontalLines;
                 AppCUI::Input::Key toggleVerticalLines;
+                AppCUI::Input::Key showStatistics;
+                AppCUI::Input::Key sortRows;
+                AppCUI::Input::Key filterRows;
+                AppCUI::Input::Key fileOrder;
             } keys;
             struct
             {
@@ -51,10 +361,38 @@ namespace View
             Reference<AppCUI::Controls::Grid> grid;
             Pointer<SettingsData> settings;
 
+            // the rows of the grid that have their cells set (only the ones around the visible rows)
+            uint64 windowStart;
+            uint64 windowEnd;
+
+            // the grid does not report its first visible row --> the window follows the location that moved last
+            uint64 anchorRow;
+            int32 lastSelectedRow;
+            int32 lastHoveredRow;
+
+            // the rows (from the file) that the grid shows, if they are sorted or filtered (otherwise the grid shows all of them)
+            struct
+            {
+                std::vector<uint64> rows;
+                bool active;
+                RowSort sort;
+                RowFilter filter;
+                std::unique_ptr<RowOrder> task; // the sort (or filter) that runs in background
+                uint32 shownPercent;
+                std::string_view message; // why the last task did not change the rows
+            } Order;
+
+            struct
+            {
+                std::shared_ptr<ColumnStatistics> statistics;
+                Reference<ColumnStatisticsPanel> panel;
+            } Statistics;
+
             static Config config;
 
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
+            ~Instance();
 
             bool GoTo(uint64 offset) override;
             bool Select(uint64 offset, uint64 size) override;
@@ -68,6 +406,8 @@ namespace View
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
 
             virtual void OnStart() override;
+            virtual void Paint(AppCUI::Graphics::Renderer& renderer) override;
+            virtual bool OnFrameUpdate() override;
 
             // property interface
             bool GetPropertyValue(uint32 id, PropertyValue& value) override;
@@ -79,12 +419,27 @@ namespace View
           private:
             void PopulateGrid();
             void ProcessContent();
+            uint64 GetGridRowsCount() const;
+            std::string_view GetRow(uint64 index);
+            void UpdateVisibleRows();
+            void UpdateRows(uint64 start, uint64 end, bool clear);
+            bool ShowStatistics();
+            uint64 GetFileRow(uint64 gridRow) const;
+            std::vector<uint64> GetShownRows() const;
+            std::vector<std::string> GetColumnNames();
+            bool ShowSortDialog();
+            bool ShowFilterDialog();
+            void ResetOrder();
+            bool StartOrderTask(std::unique_ptr<RowOrder> task);
+            bool UpdateOrderTask();
+            void StopOrderTask();
             void PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationHeight(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationCells(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationCurrentLocation(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationSelection(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationSeparator(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
+            void PaintCursorInformationOrder(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
         };
     } // namespace GridViewer
 } // namespace View
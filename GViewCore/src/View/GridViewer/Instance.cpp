@@ -6,17 +6,31 @@ using namespace AppCUI::Input;
 constexpr uint32 PROP_ID_REPLACE_HEADER_WITH_1ST_ROW = 0;
 constexpr uint32 PROP_ID_TOGGLE_HORIZONTAL_LINES     = 1;
 constexpr uint32 PROP_ID_TOGGLE_VERTICAL_LINES       = 2;
+constexpr uint32 PROP_ID_SHOW_STATISTICS             = 3;
+constexpr uint32 PROP_ID_SORT_ROWS                   = 4;
+constexpr uint32 PROP_ID_FILTER_ROWS                 = 5;
+constexpr uint32 PROP_ID_FILE_ORDER                  = 6;
 
 constexpr uint32 COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW = 0x1000;
 constexpr uint32 COMMAND_ID_TOGGLE_HORIZONTAL_LINES     = 0x1001;
 constexpr uint32 COMMAND_ID_TOGGLE_VERTICAL_LINES       = 0x1002;
+constexpr uint32 COMMAND_ID_SHOW_STATISTICS             = 0x1003;
+constexpr uint32 COMMAND_ID_SORT_ROWS                   = 0x1004;
+constexpr uint32 COMMAND_ID_FILTER_ROWS                 = 0x1005;
+constexpr uint32 COMMAND_ID_FILE_ORDER                  = 0x1006;
+constexpr uint32 COMMAND_ID_STOP_ORDER                  = 0x1007;
+
+constexpr uint64 WINDOW_PAGES = 3; // the cells are set for this many pages of rows above and below the visible ones
 
 Config Instance::config;
 
-Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* _settings) : settings(nullptr)
+Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* _settings)
+    : settings(nullptr), windowStart(0), windowEnd(0), anchorRow(0), lastSelectedRow(-1), lastHoveredRow(-1)
 {
-    this->obj  = obj;
-    this->name = name;
+    Order.active       = false;
+    Order.shownPercent = 0;
+    this->obj          = obj;
+    this->name         = name;
 
     // settings
     if ((_settings) && (_settings->data))
@@ -38,7 +52,7 @@ Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, S
               "d:c,w:100%,h:100%",
               static_cast<uint32>(settings->cols),
               static_cast<uint32>(settings->rows),
-              AppCUI::Controls::GridFlags::Sort | AppCUI::Controls::GridFlags::Filter | GridFlags::DisableDuplicates);
+              GridFlags::DisableDuplicates);
 
         grid->SetSeparator(settings->separator);
     }
@@ -47,6 +61,14 @@ Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, S
         config.Initialize();
 }
 
+Instance::~Instance()
+{
+    // the statistics (and the sort or filter that runs) use the row offsets from the settings
+    Order.task.reset();
+    if (Statistics.statistics)
+        Statistics.statistics->Stop();
+}
+
 std::string_view Instance::GetName()
 {
     return name;
@@ -98,6 +120,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& renderer, unsi
         PaintCursorInformationCurrentLocation(renderer, x4, y);
         PaintCursorInformationSeparator(renderer, x5 - 1, y);
         PaintCursorInformationSelection(renderer, x5, y);
+        PaintCursorInformationSeparator(renderer, x6 - 1, y);
+        PaintCursorInformationOrder(renderer, x6, y);
     }
     else if (height > 1)
     {
@@ -117,6 +141,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& renderer, unsi
         PaintCursorInformationCurrentLocation(renderer, x4, y2);
         PaintCursorInformationSeparator(renderer, x4 - 1, y1);
         PaintCursorInformationSelection(renderer, x5, y1);
+        PaintCursorInformationOrder(renderer, x5, y2);
     }
 }
 
@@ -125,6 +150,19 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
     commandBar.SetCommand(config.keys.replaceHeaderWith1stRow, "ReplaceHeader", COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW);
     commandBar.SetCommand(config.keys.toggleHorizontalLines, "ToggleHorizontalLines", COMMAND_ID_TOGGLE_HORIZONTAL_LINES);
     commandBar.SetCommand(config.keys.toggleVerticalLines, "ToggleVerticalLines", COMMAND_ID_TOGGLE_VERTICAL_LINES);
+    commandBar.SetCommand(config.keys.showStatistics, "Statistics", COMMAND_ID_SHOW_STATISTICS);
+    if (Order.task)
+    {
+        // a sort (or filter) that runs can only be stopped
+        commandBar.SetCommand(Order.task->IsSorting() ? config.keys.sortRows : config.keys.filterRows, "Stop", COMMAND_ID_STOP_ORDER);
+    }
+    else
+    {
+        commandBar.SetCommand(config.keys.sortRows, "Sort", COMMAND_ID_SORT_ROWS);
+        commandBar.SetCommand(config.keys.filterRows, "Filter", COMMAND_ID_FILTER_ROWS);
+    }
+    if (Order.active)
+        commandBar.SetCommand(config.keys.fileOrder, "FileOrder", COMMAND_ID_FILE_ORDER);
     return false;
 }
 
@@ -134,7 +172,11 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
     {
         if (ID == COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW)
         {
+            // the header row could be part of the sorted (or filtered) rows --> the rows are shown in file order again
+            StopOrderTask();
             settings->firstRowAsHeader = !settings->firstRowAsHeader;
+            Order.active               = false;
+            Order.rows                 = {};
             PopulateGrid();
             return true;
         }
@@ -148,6 +190,28 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
             grid->ToggleVerticalLines();
             return true;
         }
+        else if (ID == COMMAND_ID_SHOW_STATISTICS)
+        {
+            return ShowStatistics();
+        }
+        else if (ID == COMMAND_ID_SORT_ROWS)
+        {
+            return ShowSortDialog();
+        }
+        else if (ID == COMMAND_ID_FILTER_ROWS)
+        {
+            return ShowFilterDialog();
+        }
+        else if (ID == COMMAND_ID_FILE_ORDER)
+        {
+            ResetOrder();
+            return true;
+        }
+        else if (ID == COMMAND_ID_STOP_ORDER)
+        {
+            StopOrderTask();
+            return true;
+        }
     }
 
     return false;
@@ -156,25 +220,57 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
 void Instance::OnStart()
 {
     ProcessContent();
-    grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows) });
     PopulateGrid();
 }
 
+void Instance::Paint(AppCUI::Graphics::Renderer& renderer)
+{
+    // the grid is painted after this control --> the rows that it shows have their cells set by now
+    UpdateVisibleRows();
+}
+
+bool Instance::OnFrameUpdate()
+{
+    // called periodically from the UI thread --> the summaries (and the rows) computed in background are shown without any
+    // user input
+    auto changed = false;
+    if (Order.task)
+        changed = UpdateOrderTask();
+    if ((Statistics.statistics) && (Statistics.panel.IsValid()))
+        changed = Statistics.panel->Update() || changed;
+    return changed;
+}
+
+uint64 Instance::GetGridRowsCount() const
+{
+    if (Order.active)
+        return Order.rows.size();
+    return settings->rows > 0 && settings->firstRowAsHeader ? settings->rows - 1 : settings->rows;
+}
+
+uint64 Instance::GetFileRow(uint64 gridRow) const
+{
+    if (Order.active)
+        return Order.rows[gridRow];
+    return settings->firstRowAsHeader ? gridRow + 1 : gridRow;
+}
+
 void Instance::PopulateGrid()
 {
-    const auto& content = settings->tokens;
-    auto it             = content.begin();
+    // the first row can become (or stop being) the header --> every row of the grid changes
+    UpdateRows(windowStart, windowEnd, true);
+    windowStart = windowEnd = 0;
 
-    if (settings->firstRowAsHeader)
+    if (settings->firstRowAsHeader && settings->rows > 0)
     {
-        const auto& header = it->second;
+        std::vector<std::string_view> cells;
+        std::vector<std::string> values;
+        SplitRow(GetRow(0), settings->separator[0], cells);
+        values.resize(cells.size());
+
         std::vector<AppCUI::Utils::ConstString> headerCS;
-        for (const auto& [start, end] : header)
-        {
-            const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
-            headerCS.push_back(token);
-        }
-        std::advance(it, 1);
+        for (auto j = 0U; j < cells.size(); j++)
+            headerCS.push_back(GetCellValue(cells[j], values[j]));
         grid->UpdateHeaderValues(headerCS);
     }
     else
@@ -182,120 +278,263 @@ void Instance::PopulateGrid()
         grid->SetDefaultHeaderValues();
     }
 
-    const auto dimensions = grid->GetGridDimensions();
-    if (static_cast<uint32>(settings->rows - settings->firstRowAsHeader) != dimensions.Height)
+    grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(GetGridRowsCount()) });
+    UpdateVisibleRows();
+}
+
+std::string_view Instance::GetRow(uint64 index)
+{
+    // a row is read at once (a row bigger than the cache is truncated) - the result is valid until the next read
+    const auto start = settings->rowOffsets[index];
+    const auto size  = std::min<uint64>(settings->rowOffsets[index + 1] - start, obj->GetData().GetCacheSize());
+    const auto buf   = obj->GetData().Get(start, static_cast<uint32>(size), false);
+    std::string_view row{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
+    while (!row.empty() && (row.back() == '\n' || row.back() == '\r'))
+        row.remove_suffix(1);
+    return row;
+}
+
+void Instance::UpdateVisibleRows()
+{
+    const auto rowsCount = GetGridRowsCount();
+    if (rowsCount == 0)
+        return;
+
+    // the grid scrolls with the selected cell (keys) and the hovered cell is under the mouse (wheel) --> the visible rows are at
+    // most one page away from the one that moved last (a selection that stays off screen no longer pulls the window back)
+    const auto selected = grid->GetSelectionLocationsStart().Y;
+    const auto hovered  = grid->GetHoveredLocation().Y;
+    if (selected >= 0 && selected != lastSelectedRow)
+        anchorRow = selected;
+    else if (hovered >= 0 && hovered != lastHoveredRow)
+        anchorRow = hovered;
+    lastSelectedRow = selected;
+    lastHoveredRow  = hovered;
+    const auto anchor = std::min<>(anchorRow, rowsCount - 1);
+    const auto page  = static_cast<uint64>(std::max<int32>(grid->GetHeight(), 1));
+    const auto above = windowStart == 0 || anchor >= windowStart + page;
+    const auto below = windowEnd == rowsCount || anchor + page <= windowEnd;
+    if (windowEnd > windowStart && above && below)
+        return;
+
+    const auto start = anchor > page * WINDOW_PAGES ? anchor - page * WINDOW_PAGES : 0;
+    const auto end   = std::min<>(anchor + page * WINDOW_PAGES, rowsCount);
+
+    // the rows that are no longer around the visible ones are cleared (only the new ones are read from the file)
+    if (end <= windowStart || start >= windowEnd)
     {
-        grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows - settings->firstRowAsHeader) });
+        UpdateRows(windowStart, windowEnd, true);
+        UpdateRows(start, end, false);
     }
+    else
+    {
+        UpdateRows(windowStart, start, true);
+        UpdateRows(end, windowEnd, true);
+        UpdateRows(start, windowStart, false);
+        UpdateRows(windowEnd, end, false);
+    }
+    windowStart = start;
+    windowEnd   = end;
+}
 
-    while (it != content.end())
+void Instance::UpdateRows(uint64 start, uint64 end, bool clear)
+{
+    std::vector<std::string_view> cells;
+    std::string value;
+    for (auto i = start; i < end; i++)
     {
-        const auto i    = it->first;
-        const auto& row = it->second;
-        for (auto itRow = row.begin(); itRow != row.end(); itRow++)
+        if (clear)
         {
-            const auto j     = row.size() - std::abs(std::distance(row.end(), itRow));
-            const auto token = obj->GetData().Get(itRow->first, static_cast<uint32>(itRow->second - itRow->first), false);
-            const ConstString value{ token };
-            grid->UpdateCell(static_cast<uint32>(j), static_cast<uint32>(i - settings->firstRowAsHeader), value);
+            for (auto j = 0U; j < settings->cols; j++)
+                grid->UpdateCell(j, static_cast<uint32>(i), "");
+            continue;
         }
-        std::advance(it, 1);
-    }
 
-    grid->Sort();
+        // the cells after the columns of the first row are not shown
+        SplitRow(GetRow(GetFileRow(i)), settings->separator[0], cells);
+        for (auto j = 0U; j < std::min<uint64>(cells.size(), settings->cols); j++)
+            grid->UpdateCell(j, static_cast<uint32>(i), GetCellValue(cells[j], value));
+    }
 }
 
 void GView::View::GridViewer::Instance::ProcessContent()
 {
-    std::map<uint64, std::pair<uint64, uint64>> lines;
-    std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
+    // only the offsets of the rows are kept (the cells of a row are split when the row is shown)
+    RowIndexer indexer;
+    settings->rowOffsets.clear();
+    settings->rows = 0;
+    settings->cols = 0;
+    CHECKRET(indexer.Build(obj, settings->rowOffsets), "Fail to find the rows of the object");
+    settings->rows = settings->rowOffsets.size() - 1;
+
+    // the columns are the cells of the first row
+    if (settings->rows > 0)
+    {
+        std::vector<std::string_view> cells;
+        SplitRow(GetRow(0), settings->separator[0], cells);
+        settings->cols = cells.size();
+    }
+}
 
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = obj->GetData().GetCacheSize();
+bool Instance::ShowStatistics()
+{
+    // the statistics are computed again (the first row might have become a header since the last time)
+    const auto firstRow = settings->firstRowAsHeader ? 1ULL : 0ULL;
+    CHECK(settings->rows > firstRow, true, "No rows to compute the statistics for");
 
-    auto oSizeProcessed = 0ULL;
-    auto lineStart      = 0ULL;
-    auto currentLine    = 0ULL;
+    std::vector<std::string> names;
+    if (settings->firstRowAsHeader)
+    {
+        std::vector<std::string_view> cells;
+        std::string value;
+        SplitRow(GetRow(0), settings->separator[0], cells);
+        for (const auto& cell : cells)
+            names.emplace_back(GetCellValue(cell, value));
+    }
 
-    do
+    auto statistics = std::make_shared<ColumnStatistics>();
+    if (!statistics->Start(obj, settings->rowOffsets, firstRow, static_cast<uint32>(settings->cols), settings->separator[0]))
     {
-        const auto buf = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(cSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
+        Dialogs::MessageBox::ShowError("Error", "Fail to start computing the statistics of the columns !");
+        return true;
+    }
+    if (Statistics.statistics)
+        Statistics.statistics->Stop();
+    Statistics.statistics = statistics;
 
-        auto nPos       = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
+    // the panel is created once (the first time the statistics are computed) and reused afterwards
+    if (!Statistics.panel.IsValid())
+    {
+        auto win = GView::App::GetCurrentWindow();
+        CHECK(win.IsValid(), false, "No window to add the statistics into !");
+        auto panel       = new ColumnStatisticsPanel();
+        Statistics.panel = panel;
+        win->AddPanel(Pointer<TabPage>(panel), false);
+    }
+    Statistics.panel->SetStatistics(statistics, std::move(names));
+    return true;
+}
 
-        const auto oldOSizeProcessed = oSizeProcessed;
+std::vector<uint64> Instance::GetShownRows() const
+{
+    if (Order.active)
+        return Order.rows;
+    std::vector<uint64> rows(GetGridRowsCount());
+    for (auto idx = 0ULL; idx < rows.size(); idx++)
+        rows[idx] = GetFileRow(idx);
+    return rows;
+}
 
-        if (nPos < rPos)
-        {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r')
-            {
-                oSizeProcessed += nPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += nPos + 1;
-            }
-        }
-        else if (nPos > rPos)
-        {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n')
-            {
-                oSizeProcessed += rPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += rPos + 1;
-            }
-        }
+std::vector<std::string> Instance::GetColumnNames()
+{
+    std::vector<std::string> names;
+    std::vector<std::string_view> cells;
+    std::string value;
+    LocalString<32> tmp;
+    if ((settings->firstRowAsHeader) && (settings->rows > 0))
+        SplitRow(GetRow(0), settings->separator[0], cells);
+    for (auto idx = 0U; idx < settings->cols; idx++)
+    {
+        if ((idx < cells.size()) && (!cells[idx].empty()))
+            names.emplace_back(GetCellValue(cells[idx], value));
         else
-        {
-            nPos = oSize - oldOSizeProcessed;
-            oSizeProcessed += nPos;
-        }
+            names.emplace_back(tmp.Format("Column %u", idx + 1));
+    }
+    return names;
+}
 
-        lines.insert({ currentLine, { lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed } });
-        const std::string_view line{ reinterpret_cast<const char*>(buf.GetData() + lineStart), nPos };
+bool Instance::ShowSortDialog()
+{
+    CHECK(settings->cols > 0, true, "No columns to sort by");
+    SortDialog dlg(GetColumnNames(), Order.sort);
+    if (dlg.Show() != Dialogs::Result::Ok)
+        return true;
 
-        std::vector<uint64> separators;
-        {
-            size_t pos = line.find(settings->separator[0]);
-            while (pos != std::string::npos)
-            {
-                separators.push_back(pos + oldOSizeProcessed);
-                pos = line.find(settings->separator[0], pos + 1);
-            }
-            separators.push_back(line.size() + oldOSizeProcessed);
-        }
+    // the rows that are shown (all of them or the filtered ones) are sorted - the grid only gets a new order for them
+    auto task = std::make_unique<RowOrder>(obj, settings->rowOffsets, settings->separator[0]);
+    if (!task->StartSort(GetShownRows(), dlg.GetSort()))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Fail to sort the rows !");
+        return true;
+    }
+    return StartOrderTask(std::move(task));
+}
 
-        std::vector<std::pair<uint64, uint64>> lTokens;
-        if (separators.size() == 0)
-        {
-            lTokens.push_back({ lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed });
-        }
+bool Instance::ShowFilterDialog()
+{
+    CHECK(settings->cols > 0, true, "No columns to filter by");
+    FilterDialog dlg(GetColumnNames(), Order.filter);
+    if (dlg.Show() != Dialogs::Result::Ok)
+        return true;
 
-        {
-            auto tStart = oldOSizeProcessed;
-            auto tEnd   = oldOSizeProcessed;
-            for (const auto& i : separators)
-            {
-                tEnd = i;
-                lTokens.push_back({ tStart, tEnd });
-                tStart = tEnd + 1;
-            }
-        }
+    // a filter applies to the rows that are shown (filters can be added one after another) and keeps their order
+    auto task = std::make_unique<RowOrder>(obj, settings->rowOffsets, settings->separator[0]);
+    if (!task->StartFilter(GetShownRows(), dlg.GetFilter()))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Fail to filter the rows !");
+        return true;
+    }
+    return StartOrderTask(std::move(task));
+}
 
-        tokens.insert({ currentLine, std::move(lTokens) });
+void Instance::ResetOrder()
+{
+    // the row index was never changed --> the file order is shown again without reading anything
+    StopOrderTask();
+    CHECKRET(Order.active, "");
+    Order.active = false;
+    Order.rows   = {};
+    PopulateGrid();
+}
+
+bool Instance::StartOrderTask(std::unique_ptr<RowOrder> task)
+{
+    // the grid keeps the rows it shows until the task is done (see UpdateOrderTask)
+    Order.task         = std::move(task);
+    Order.shownPercent = Order.task->GetPercent();
+    Order.message      = {};
+    return true;
+}
 
-        currentLine++;
+bool Instance::UpdateOrderTask()
+{
+    // called periodically - returns true if the progress (or the rows) changed
+    if (!Order.task->IsFinished())
+    {
+        const auto percent = Order.task->GetPercent();
+        if (percent == Order.shownPercent)
+            return false;
+        Order.shownPercent = percent;
+        return true;
+    }
 
-    } while (oSizeProcessed < oSize);
+    const auto task = std::move(Order.task);
+    if (task->IsCanceled())
+    {
+        Order.message = task->IsSorting() ? "Sort stopped" : "Filter stopped";
+        return true;
+    }
+    if (task->HasFailed())
+    {
+        Order.message = task->IsSorting() ? "Sort failed" : "Filter failed";
+        return true;
+    }
+    if (task->IsSorting())
+        Order.sort = task->GetSort();
+    else
+        Order.filter = task->GetFilter();
+    Order.rows   = std::move(task->GetRows());
+    Order.active = true;
+    PopulateGrid();
+    return true;
+}
 
-    settings->rows   = lines.size();
-    settings->cols   = tokens.size() > 0 ? tokens.begin()->second.size() : 0;
-    settings->lines  = std::move(lines);
-    settings->tokens = std::move(tokens);
+void Instance::StopOrderTask()
+{
+    // the rows that are shown do not change (unless the task was already done)
+    CHECKRET(Order.task, "");
+    Order.task->Stop();
+    UpdateOrderTask();
 }
 
 void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
@@ -416,6 +655,30 @@ void GView::View::GridViewer::Instance::PaintCursorInformationSeparator(
     renderer.DrawVerticalLine(x, y, y + 4, config.color.cursorInformation.value);
 }
 
+void GView::View::GridViewer::Instance::PaintCursorInformationOrder(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+{
+    WriteTextParams params{ WriteTextFlags::SingleLine };
+    params.Color = config.color.cursorInformation.name;
+    params.X     = x;
+    params.Y     = y;
+    params.Width = config.cursorInformationCellSpace;
+    params.Align = TextAlignament::Left;
+
+    LocalString<32> ls;
+    if (Order.task)
+    {
+        renderer.WriteText(Order.task->IsSorting() ? "Sorting:" : "Filtering:", params);
+        params.Color = config.color.cursorInformation.value;
+        params.X += 11;
+        ls.Format("%u%%", Order.shownPercent);
+        renderer.WriteText(ls, params);
+    }
+    else if (!Order.message.empty())
+    {
+        renderer.WriteText(Order.message, params);
+    }
+}
+
 enum class PropertyID : uint32
 {
     None
@@ -434,6 +697,18 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PROP_ID_TOGGLE_VERTICAL_LINES:
         value = config.keys.toggleVerticalLines;
         return true;
+    case PROP_ID_SHOW_STATISTICS:
+        value = config.keys.showStatistics;
+        return true;
+    case PROP_ID_SORT_ROWS:
+        value = config.keys.sortRows;
+        return true;
+    case PROP_ID_FILTER_ROWS:
+        value = config.keys.filterRows;
+        return true;
+    case PROP_ID_FILE_ORDER:
+        value = config.keys.fileOrder;
+        return true;
     default:
         break;
     }
@@ -453,6 +728,18 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
     case PROP_ID_TOGGLE_VERTICAL_LINES:
         config.keys.toggleVerticalLines = std::get<Key>(value);
         return true;
+    case PROP_ID_SHOW_STATISTICS:
+        config.keys.showStatistics = std::get<Key>(value);
+        return true;
+    case PROP_ID_SORT_ROWS:
+        config.keys.sortRows = std::get<Key>(value);
+        return true;
+    case PROP_ID_FILTER_ROWS:
+        config.keys.filterRows = std::get<Key>(value);
+        return true;
+    case PROP_ID_FILE_ORDER:
+        config.keys.fileOrder = std::get<Key>(value);
+        return true;
     default:
         break;
     }
@@ -474,5 +761,9 @@ const vector<Property> Instance::GetPropertiesList()
         { PROP_ID_REPLACE_HEADER_WITH_1ST_ROW, "Content", "Replace header with first row", PropertyType::Key },
         { PROP_ID_TOGGLE_HORIZONTAL_LINES, "Look", "Hide/Show horizontal lines", PropertyType::Key },
         { PROP_ID_TOGGLE_VERTICAL_LINES, "Look", "Hide/Show vertical lines", PropertyType::Key },
+        { PROP_ID_SHOW_STATISTICS, "Content", "Show the statistics of the columns", PropertyType::Key },
+        { PROP_ID_SORT_ROWS, "Content", "Sort the rows by a column", PropertyType::Key },
+        { PROP_ID_FILTER_ROWS, "Content", "Filter the rows by a column", PropertyType::Key },
+        { PROP_ID_FILE_ORDER, "Content", "Show all rows in file order", PropertyType::Key },
     };
 }
@@ -0,0 +1,293 @@
+#include "GridViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define GRIDVIEWER_INDEXER_SSE2
+#endif
+
+using namespace GView::View::GridViewer;
+
+constexpr uint64 INDEX_CHUNK_SIZE  = 0x1000000;  // 16M bytes per chunk (smaller objects are indexed on the calling thread)
+constexpr uint32 INDEX_READ_SIZE   = 0x100000;   // a chunk is read (and classified) 1M bytes at a time
+constexpr uint64 MAX_MEMORY_OBJECT = 0x10000000; // non-file objects are copied in memory (256M max)
+constexpr uint32 CLASSIFY_SIZE     = 64;         // bytes classified at once (one bit for each of them)
+
+namespace
+{
+struct BlockMasks
+{
+    uint64 quotes;
+    uint64 newLines;
+    uint64 separators;
+};
+BlockMasks ClassifyBlock(const uint8* p, uint32 count, uint8 separator)
+{
+    BlockMasks masks{ 0, 0, 0 };
+    auto idx = 0U;
+#ifdef GRIDVIEWER_INDEXER_SSE2
+    const auto vQuote = _mm_set1_epi8('"');
+    const auto vLF    = _mm_set1_epi8('\n');
+    const auto vCR    = _mm_set1_epi8('\r');
+    const auto vSep   = _mm_set1_epi8(static_cast<char>(separator));
+    for (; idx + 16 <= count; idx += 16)
+    {
+        const auto v        = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx));
+        const auto newLines = _mm_or_si128(_mm_cmpeq_epi8(v, vLF), _mm_cmpeq_epi8(v, vCR));
+        masks.quotes |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vQuote)))) << idx;
+        masks.newLines |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(newLines))) << idx;
+        masks.separators |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vSep)))) << idx;
+    }
+#endif
+    for (; idx < count; idx++)
+    {
+        const auto ch = p[idx];
+        if (ch == '"')
+            masks.quotes |= 1ULL << idx;
+        else if ((ch == '\n') || (ch == '\r'))
+            masks.newLines |= 1ULL << idx;
+        else if (ch == separator)
+            masks.separators |= 1ULL << idx;
+    }
+    return masks;
+}
+// a bit is set if there is an odd number of quotes up to (and including) its byte --> the byte is between quotes
+inline uint64 QuotedMask(uint64 quotes)
+{
+    quotes ^= quotes << 1;
+    quotes ^= quotes << 2;
+    quotes ^= quotes << 4;
+    quotes ^= quotes << 8;
+    quotes ^= quotes << 16;
+    quotes ^= quotes << 32;
+    return quotes;
+}
+} // namespace
+
+bool RowIndexSource::Open(const std::filesystem::path& path, uint64 _size)
+{
+    // the data cache of the object is not thread safe --> every worker uses its own handle
+    this->size   = _size;
+    this->memory = nullptr;
+    file.Close();
+    return file.OpenRead(path);
+}
+void RowIndexSource::Open(const Buffer& buffer)
+{
+    this->size   = buffer.GetLength();
+    this->memory = &buffer;
+}
+bool RowIndexSource::Read(uint64 offset, uint8* buffer, uint32 bufferSize)
+{
+    CHECK(offset + bufferSize <= this->size, false, "Invalid read (%u bytes from %llu)", bufferSize, offset);
+    if (this->memory)
+    {
+        memcpy(buffer, this->memory->GetData() + offset, bufferSize);
+        return true;
+    }
+    CHECK(file.SetCurrentPos(offset), false, "Fail to move to offset %llu", offset);
+    return file.Read(buffer, bufferSize);
+}
+
+void RowIndexer::ClassifyData(Chunk& chunk, const uint8* p, uint32 size, uint64 offset)
+{
+    // the new lines are kept as (offset << 1) | isCR --> the chunks can be joined without reading them again
+    for (auto idx = 0U; idx < size; idx += CLASSIFY_SIZE)
+    {
+        const auto count  = std::min<>(CLASSIFY_SIZE, size - idx);
+        const auto masks  = ClassifyBlock(p + idx, count, '"'); // the separators are not needed to find the rows
+        const auto quoted = QuotedMask(masks.quotes) ^ (chunk.oddQuotes ? ~0ULL : 0ULL);
+        chunk.oddQuotes   = (quoted >> 63) != 0;
+        for (auto newLines = masks.newLines; newLines; newLines &= newLines - 1)
+        {
+            const auto bit = static_cast<uint32>(std::countr_zero(newLines));
+            const auto pos = ((offset + idx + bit) << 1) | (p[idx + bit] == '\r' ? 1 : 0);
+            if ((quoted & (1ULL << bit)) == 0)
+                chunk.newLines[0].push_back(pos);
+            else if (chunk.speculative)
+                chunk.newLines[1].push_back(pos);
+        }
+    }
+}
+void RowIndexer::Run()
+{
+    RowIndexSource source;
+    std::vector<uint8> buffer(INDEX_READ_SIZE);
+
+    if (this->useMemory)
+        source.Open(this->memory);
+    else if (!source.Open(this->path, this->size))
+        this->failed = true;
+    while (!this->failed)
+    {
+        const auto index = this->nextChunk.fetch_add(1);
+        if (index >= this->chunks.size())
+            break;
+        auto& chunk = this->chunks[index];
+        for (auto offset = chunk.start; offset < chunk.end; offset += INDEX_READ_SIZE)
+        {
+            const auto size = static_cast<uint32>(std::min<uint64>(INDEX_READ_SIZE, chunk.end - offset));
+            if (!source.Read(offset, buffer.data(), size))
+            {
+                this->failed = true;
+                break;
+            }
+            ClassifyData(chunk, buffer.data(), size, offset);
+        }
+    }
+}
+void RowIndexer::JoinChunks(std::vector<uint64>& rowOffsets)
+{
+    // the quotes of the previous chunks decide which new lines of a chunk end a row ("\r\n" or "\n\r" end a single row)
+    auto count = 1ULL;
+    for (const auto& chunk : this->chunks)
+        count += std::max<>(chunk.newLines[0].size(), chunk.newLines[1].size());
+    rowOffsets.clear();
+    rowOffsets.reserve(count + 1);
+    rowOffsets.push_back(0);
+
+    auto oddQuotes = false;
+    auto lastPos   = 0ULL;
+    auto lastCR    = false;
+    auto lastAdded = false;
+    for (auto& chunk : this->chunks)
+    {
+        for (const auto value : chunk.newLines[oddQuotes ? 1 : 0])
+        {
+            const auto pos  = value >> 1;
+            const auto isCR = (value & 1) != 0;
+            if (lastAdded && (lastPos + 1 == pos) && (lastCR != isCR))
+            {
+                rowOffsets.back() = pos + 1;
+                lastAdded         = false;
+            }
+            else
+            {
+                rowOffsets.push_back(pos + 1);
+                lastAdded = true;
+                lastCR    = isCR;
+            }
+            lastPos = pos;
+        }
+        oddQuotes ^= chunk.oddQuotes;
+        chunk.newLines[0] = {};
+        chunk.newLines[1] = {};
+    }
+    if (rowOffsets.back() < this->size)
+        rowOffsets.push_back(this->size);
+}
+bool RowIndexer::Build(Reference<GView::Object> obj, std::vector<uint64>& rowOffsets)
+{
+    /*
+    A new line between quotes is part of a cell, so a row can only be found if the number of quotes before it is known.
+    Every chunk is classified (on several threads) as if it started outside quotes and keeps the new lines for both cases:
+    - the ones after an even number of quotes (from the start of the chunk) if the chunk starts outside quotes
+    - the ones after an odd number of quotes if it starts inside them
+    When all chunks are done, the quotes of the previous chunks decide which list is used (the first chunk starts outside quotes).
+    */
+    this->size      = obj->GetData().GetSize();
+    this->failed    = false;
+    this->nextChunk = 0;
+    this->chunks.clear();
+
+    const auto threadsCount = std::max<uint32>(1, std::thread::hardware_concurrency());
+    const auto chunksCount  = (this->size + INDEX_CHUNK_SIZE - 1) / INDEX_CHUNK_SIZE;
+    this->useMemory         = obj->GetObjectType() != GView::Object::Type::File;
+    auto parallel           = (threadsCount > 1) && (chunksCount > 1) && ((!this->useMemory) || (this->size <= MAX_MEMORY_OBJECT));
+    if (parallel && this->useMemory)
+    {
+        this->memory = obj->GetData().CopyToBuffer(0, static_cast<uint32>(this->size), true);
+        parallel     = this->memory.IsValid();
+    }
+    else if (parallel)
+    {
+        this->path = std::filesystem::path(obj->GetPath());
+    }
+
+    if (parallel)
+    {
+        for (auto idx = 0ULL; idx < chunksCount; idx++)
+        {
+            auto& chunk       = this->chunks.emplace_back();
+            chunk.start       = idx * INDEX_CHUNK_SIZE;
+            chunk.end         = std::min<>(chunk.start + INDEX_CHUNK_SIZE, this->size);
+            chunk.speculative = idx > 0;
+        }
+        std::vector<std::thread> workers;
+        for (auto idx = 0U; idx < std::min<uint64>(threadsCount, chunksCount); idx++)
+            workers.emplace_back(&RowIndexer::Run, this);
+        for (auto& w : workers)
+            w.join();
+        this->memory = Buffer();
+        if (this->failed)
+        {
+            LOG_ERROR("Fail to read the object on %u threads (it will be indexed again on a single thread)", threadsCount);
+            this->chunks.clear();
+        }
+    }
+
+    if (this->chunks.empty())
+    {
+        // the data cache of the object is only used from this thread
+        auto& chunk      = this->chunks.emplace_back();
+        chunk.start      = 0;
+        chunk.end        = this->size;
+        const auto cSize = obj->GetData().GetCacheSize();
+        for (auto offset = 0ULL; offset < this->size;)
+        {
+            const auto size = std::min<uint64>(cSize, this->size - offset);
+            const auto buf  = obj->GetData().Get(offset, static_cast<uint32>(size), false);
+            CHECK(buf.GetLength() > 0, false, "Fail to read %llu bytes from offset %llu", size, offset);
+            ClassifyData(chunk, buf.GetData(), static_cast<uint32>(buf.GetLength()), offset);
+            offset += buf.GetLength();
+        }
+    }
+    JoinChunks(rowOffsets);
+    this->chunks.clear();
+    return true;
+}
+
+namespace GView::View::GridViewer
+{
+void SplitRow(std::string_view row, char separator, std::vector<std::string_view>& cells)
+{
+    // a separator between quotes is part of a cell
+    const auto* p   = reinterpret_cast<const uint8*>(row.data());
+    const auto size = static_cast<uint32>(row.size());
+    auto oddQuotes  = false;
+    auto cellStart  = 0U;
+    cells.clear();
+    for (auto idx = 0U; idx < size; idx += CLASSIFY_SIZE)
+    {
+        const auto masks  = ClassifyBlock(p + idx, std::min<>(CLASSIFY_SIZE, size - idx), static_cast<uint8>(separator));
+        const auto quoted = QuotedMask(masks.quotes) ^ (oddQuotes ? ~0ULL : 0ULL);
+        oddQuotes         = (quoted >> 63) != 0;
+        for (auto separators = masks.separators & (~quoted); separators; separators &= separators - 1)
+        {
+            const auto pos = idx + static_cast<uint32>(std::countr_zero(separators));
+            cells.push_back(row.substr(cellStart, pos - cellStart));
+            cellStart = pos + 1;
+        }
+    }
+    cells.push_back(row.substr(cellStart));
+}
+std::string_view GetCellValue(std::string_view cell, std::string& buffer)
+{
+    // "a ""b"" c" --> a "b" c
+    if ((cell.size() < 2) || (cell.front() != '"') || (cell.back() != '"'))
+        return cell;
+    cell = cell.substr(1, cell.size() - 2);
+    if (cell.find('"') == std::string_view::npos)
+        return cell;
+    buffer.clear();
+    for (auto idx = 0U; idx < cell.size(); idx++)
+    {
+        buffer.push_back(cell[idx]);
+        if ((cell[idx] == '"') && (idx + 1 < cell.size()) && (cell[idx + 1] == '"'))
+            idx++;
+    }
+    return buffer;
+}
+} // namespace GView::View::GridViewer
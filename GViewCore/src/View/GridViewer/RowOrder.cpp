@@ -0,0 +1,485 @@
+#include "GridViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <queue>
+
+using namespace GView::View::GridViewer;
+
+constexpr uint32 ORDER_READ_SIZE    = 0x100000;   // rows are read 1M bytes at a time (a longer row is truncated)
+constexpr uint64 MAX_MEMORY_OBJECT  = 0x10000000; // non-file objects are copied in memory (256M max)
+constexpr uint64 SORT_MEMORY_BUDGET = 0x10000000; // keys that need more memory are sorted in runs (kept in temporary files)
+constexpr uint32 MAX_SORT_KEY_SIZE  = 256;        // longer values are compared only by their first bytes
+constexpr size_t MIN_PARALLEL_ROWS  = 0x10000;    // fewer rows are processed on the calling thread
+
+namespace
+{
+// the first 8 bytes of a key (big endian, so that they can be compared as a number) and the rest of it
+struct SortEntry
+{
+    uint64 prefix;
+    uint64 row;
+    const char* rest;
+    uint32 size;
+};
+struct SortEntryCompare
+{
+    bool descending;
+
+    inline bool operator()(const SortEntry& a, const SortEntry& b) const
+    {
+        auto result = 0;
+        if (a.prefix != b.prefix)
+            result = a.prefix < b.prefix ? -1 : 1;
+        else if ((a.size > 8) && (b.size > 8))
+            result = memcmp(a.rest, b.rest, std::min<>(a.size, b.size) - 8);
+        if ((result == 0) && (a.size != b.size))
+            result = a.size < b.size ? -1 : 1;
+        // equal keys keep the order of the rows in the file
+        if (result == 0)
+            return a.row < b.row;
+        return descending ? result > 0 : result < 0;
+    }
+};
+// a double --> an unsigned number with the same order (reversed for a descending sort). The values that are not numbers are
+// bigger than all numbers --> they are the last ones in both directions (a number never gets the key ~0).
+inline uint64 NumberKey(std::string_view text, bool descending)
+{
+    double number;
+    if (!ParseNumber(text, number))
+        return ~0ULL;
+    if (number == 0)
+        number = 0; // -0 and 0 are the same number
+    const auto bits = std::bit_cast<uint64>(number);
+    const auto key  = (bits & (1ULL << 63)) ? ~bits : bits | (1ULL << 63);
+    return descending ? ~key : key;
+}
+inline uint64 TextPrefix(std::string_view text)
+{
+    auto prefix = 0ULL;
+    for (auto idx = 0U; idx < 8; idx++)
+        prefix = (prefix << 8) | (idx < text.size() ? static_cast<uint8>(text[idx]) : 0);
+    return prefix;
+}
+template <typename T>
+void RunInParallel(size_t count, uint32 threadsCount, T&& task)
+{
+    // task(threadIndex, start, end) is called for consecutive ranges of [0, count)
+    if ((threadsCount <= 1) || (count < MIN_PARALLEL_ROWS))
+    {
+        task(0U, static_cast<size_t>(0), count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (auto idx = 0U; idx < threadsCount; idx++)
+        workers.emplace_back(task, idx, count * idx / threadsCount, count * (idx + 1) / threadsCount);
+    for (auto& w : workers)
+        w.join();
+}
+void ParallelSort(std::vector<SortEntry>& entries, SortEntryCompare compare, uint32 threadsCount)
+{
+    // every part is sorted on its own thread and then the parts are merged two by two (also in parallel)
+    if ((threadsCount <= 1) || (entries.size() < MIN_PARALLEL_ROWS))
+    {
+        std::sort(entries.begin(), entries.end(), compare);
+        return;
+    }
+    std::vector<size_t> bounds;
+    for (auto idx = 0U; idx <= threadsCount; idx++)
+        bounds.push_back(entries.size() * idx / threadsCount);
+    RunInParallel(
+          entries.size(),
+          threadsCount,
+          [&](uint32 index, size_t, size_t)
+          { std::sort(entries.begin() + bounds[index], entries.begin() + bounds[index + 1], compare); });
+
+    std::vector<SortEntry> merged(entries.size());
+    while (bounds.size() > 2)
+    {
+        std::vector<size_t> next;
+        std::vector<std::thread> workers;
+        for (auto idx = 0U; idx + 1 < bounds.size(); idx += 2)
+        {
+            next.push_back(bounds[idx]);
+            if (idx + 2 >= bounds.size())
+            {
+                // an odd part is only copied
+                std::copy(entries.begin() + bounds[idx], entries.begin() + bounds[idx + 1], merged.begin() + bounds[idx]);
+                continue;
+            }
+            workers.emplace_back(
+                  [&, idx]()
+                  {
+                      std::merge(
+                            entries.begin() + bounds[idx],
+                            entries.begin() + bounds[idx + 1],
+                            entries.begin() + bounds[idx + 1],
+                            entries.begin() + bounds[idx + 2],
+                            merged.begin() + bounds[idx],
+                            compare);
+                  });
+        }
+        for (auto& w : workers)
+            w.join();
+        next.push_back(entries.size());
+        bounds = std::move(next);
+        entries.swap(merged);
+    }
+}
+// a sorted run written in a temporary file: row, prefix, size and the rest of the key
+class SortRun
+{
+    std::ifstream file;
+    std::string rest;
+
+  public:
+    SortEntry entry{};
+
+    bool Open(const std::filesystem::path& path)
+    {
+        file.open(path, std::ios::binary);
+        return file.good();
+    }
+    bool Next()
+    {
+        if (!file.read(reinterpret_cast<char*>(&entry.row), sizeof(entry.row)))
+            return false;
+        file.read(reinterpret_cast<char*>(&entry.prefix), sizeof(entry.prefix));
+        file.read(reinterpret_cast<char*>(&entry.size), sizeof(entry.size));
+        rest.resize(entry.size > 8 ? entry.size - 8 : 0);
+        file.read(rest.data(), rest.size());
+        entry.rest = rest.data();
+        return file.good();
+    }
+    static bool Write(const std::filesystem::path& path, const std::vector<SortEntry>& entries)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for (const auto& e : entries)
+        {
+            out.write(reinterpret_cast<const char*>(&e.row), sizeof(e.row));
+            out.write(reinterpret_cast<const char*>(&e.prefix), sizeof(e.prefix));
+            out.write(reinterpret_cast<const char*>(&e.size), sizeof(e.size));
+            if (e.size > 8)
+                out.write(e.rest, e.size - 8);
+        }
+        return out.good();
+    }
+};
+} // namespace
+
+bool RowFilter::Matches(std::string_view text) const
+{
+    switch (op)
+    {
+    case FilterOperator::Empty:
+        return text.empty();
+    case FilterOperator::NotEmpty:
+        return !text.empty();
+    case FilterOperator::Contains:
+        return text.find(value) != std::string_view::npos;
+    default:
+        break;
+    }
+
+    // a number is compared with a number (and a text with a text)
+    auto result = 0;
+    double number;
+    if (isNumber)
+    {
+        if (!ParseNumber(text, number))
+            return op == FilterOperator::NotEquals;
+        result = number < this->number ? -1 : (number > this->number ? 1 : 0);
+    }
+    else
+    {
+        result = text.compare(value);
+    }
+    switch (op)
+    {
+    case FilterOperator::Equals:
+        return result == 0;
+    case FilterOperator::NotEquals:
+        return result != 0;
+    case FilterOperator::Less:
+        return result < 0;
+    case FilterOperator::LessOrEqual:
+        return result <= 0;
+    case FilterOperator::Greater:
+        return result > 0;
+    case FilterOperator::GreaterOrEqual:
+        return result >= 0;
+    default:
+        return false;
+    }
+}
+
+RowOrder::RowOrder(Reference<GView::Object> _obj, const std::vector<uint64>& _rowOffsets, char _separator)
+    : obj(_obj), rowOffsets(_rowOffsets), separator(_separator), useMemory(false), sorting(false), progressTotal(0), progress(0),
+      stop(false), finished(true), failed(false), canceled(false)
+{
+    threadsCount = std::max<uint32>(1, std::thread::hardware_concurrency());
+}
+RowOrder::~RowOrder()
+{
+    Stop();
+}
+bool RowOrder::StartFilter(std::vector<uint64> _rows, const RowFilter& _filter)
+{
+    Stop();
+    this->filter        = _filter;
+    this->progressTotal = _rows.size();
+    return Start(std::move(_rows), false);
+}
+bool RowOrder::StartSort(std::vector<uint64> _rows, const RowSort& _sort)
+{
+    // the keys are read and then the rows are placed in their new order
+    Stop();
+    this->sort          = _sort;
+    this->progressTotal = _rows.size() * 2;
+    return Start(std::move(_rows), true);
+}
+bool RowOrder::Start(std::vector<uint64> _rows, bool _sorting)
+{
+    CHECK(Prepare(), false, "");
+    this->rows     = std::move(_rows);
+    this->sorting  = _sorting;
+    this->progress = 0;
+    this->stop     = false;
+    this->failed   = false;
+    this->canceled = false;
+    this->finished = false;
+    this->worker   = std::thread(&RowOrder::Run, this);
+    return true;
+}
+void RowOrder::Stop()
+{
+    this->canceled = this->canceled || (!this->finished);
+    this->stop     = true;
+    if (this->worker.joinable())
+        this->worker.join();
+}
+void RowOrder::Run()
+{
+    // a stopped task only leaves (its rows are not used)
+    const auto result = this->sorting ? Sort() : Filter();
+    if ((!result) && (!this->stop))
+        this->failed = true;
+    this->finished.store(true, std::memory_order_release);
+}
+bool RowOrder::Prepare()
+{
+    // every thread reads the object with its own handle (the data cache of the object is not thread safe) - called from the UI
+    // thread, before the worker starts
+    this->useMemory = obj->GetObjectType() != GView::Object::Type::File;
+    if (!this->useMemory)
+    {
+        this->path = std::filesystem::path(obj->GetPath());
+        return true;
+    }
+    const auto size = obj->GetData().GetSize();
+    CHECK(size <= MAX_MEMORY_OBJECT, false, "Object is too large (%llu bytes)", size);
+    if ((size > 0) && (!this->memory.IsValid()))
+    {
+        this->memory = obj->GetData().CopyToBuffer(0, static_cast<uint32>(size), true);
+        CHECK(this->memory.IsValid(), false, "Fail to copy %llu bytes", size);
+    }
+    return true;
+}
+template <typename T>
+bool RowOrder::ReadCells(const uint64* rows, size_t count, uint32 column, T&& onCell)
+{
+    // the rows are in file order --> the ones that are close are read at once
+    RowIndexSource source;
+    std::vector<uint8> buffer(ORDER_READ_SIZE);
+    std::vector<std::string_view> cells;
+    std::string value;
+
+    if (this->useMemory)
+        source.Open(this->memory);
+    else
+        CHECK(source.Open(this->path, this->rowOffsets.back()), false, "Fail to open the object");
+    for (size_t idx = 0; (idx < count) && (!this->stop);)
+    {
+        const auto start = rowOffsets[rows[idx]];
+        auto end         = idx + 1;
+        while ((end < count) && (rows[end] > rows[end - 1]) && (rowOffsets[rows[end] + 1] - start <= ORDER_READ_SIZE))
+            end++;
+        const auto size = static_cast<uint32>(std::min<uint64>(rowOffsets[rows[end - 1] + 1] - start, ORDER_READ_SIZE));
+        CHECK(source.Read(start, buffer.data(), size), false, "Fail to read %u bytes from offset %llu", size, start);
+        this->progress.fetch_add(end - idx, std::memory_order_relaxed);
+        for (; idx < end; idx++)
+        {
+            const auto rowStart = static_cast<uint32>(std::min<uint64>(rowOffsets[rows[idx]] - start, size));
+            const auto rowEnd   = static_cast<uint32>(std::min<uint64>(rowOffsets[rows[idx] + 1] - start, size));
+            std::string_view text{ reinterpret_cast<const char*>(buffer.data()) + rowStart, rowEnd - rowStart };
+            while ((!text.empty()) && ((text.back() == '\n') || (text.back() == '\r')))
+                text.remove_suffix(1);
+            SplitRow(text, this->separator, cells);
+            onCell(rows[idx], column < cells.size() ? GetCellValue(cells[column], value) : std::string_view{});
+        }
+    }
+    return true;
+}
+bool RowOrder::Filter()
+{
+    // sorted rows are read in file order (the rows that match keep the order they had)
+    const auto sorted = std::is_sorted(rows.begin(), rows.end());
+    std::vector<uint64> fileOrder;
+    if (!sorted)
+    {
+        fileOrder = rows;
+        std::sort(fileOrder.begin(), fileOrder.end());
+    }
+    const auto& source = sorted ? rows : fileOrder;
+
+    // every thread keeps the rows that match from its own range (the ranges are joined in order)
+    std::vector<std::vector<uint64>> results(threadsCount);
+    RunInParallel(
+          source.size(),
+          threadsCount,
+          [&](uint32 index, size_t start, size_t end)
+          {
+              auto& result = results[index];
+              auto onCell  = [&](uint64 row, std::string_view text)
+              {
+                  if (filter.Matches(text))
+                      result.push_back(row);
+              };
+              if (!ReadCells(source.data() + start, end - start, filter.column, onCell))
+                  this->failed = true;
+          });
+    if (this->stop)
+        return false;
+    CHECK(!this->failed, false, "Fail to read the rows");
+
+    std::vector<uint64> output;
+    for (auto& result : results)
+        output.insert(output.end(), result.begin(), result.end());
+    if (!sorted)
+    {
+        std::vector<uint64> matches;
+        matches.swap(output);
+        for (const auto row : rows)
+            if (std::binary_search(matches.begin(), matches.end(), row))
+                output.push_back(row);
+    }
+    this->rows.swap(output);
+    return true;
+}
+bool RowOrder::Sort()
+{
+    /*
+    The keys of the rows are read in batches that fit in SORT_MEMORY_BUDGET (a key can not be bigger than its row):
+    - every batch is read (and sorted) on several threads
+    - if all rows fit in one batch, the sorted batch is the result
+    - otherwise every batch is written in a temporary file and the files are merged at the end
+    Only the order of the rows changes (the rows keep their offsets).
+    */
+    std::sort(rows.begin(), rows.end()); // the keys are read in file order
+
+    // the numeric keys are already reversed for a descending sort (the values that are not numbers stay the last ones)
+    const SortEntryCompare compare{ sort.descending && (!sort.numeric) };
+    std::vector<std::filesystem::path> runs;
+    std::vector<SortEntry> entries;
+    std::vector<std::string> arenas(threadsCount);
+    auto result = true;
+    for (size_t start = 0; (start < rows.size()) && (result) && (!this->stop);)
+    {
+        auto end    = start;
+        auto budget = 0ULL;
+        while ((end < rows.size()) && ((end == start) || (budget < SORT_MEMORY_BUDGET)))
+        {
+            budget += sizeof(SortEntry) + std::min<uint64>(rowOffsets[rows[end] + 1] - rowOffsets[rows[end]], MAX_SORT_KEY_SIZE);
+            end++;
+        }
+
+        std::vector<std::vector<SortEntry>> parts(threadsCount);
+        RunInParallel(
+              end - start,
+              threadsCount,
+              [&](uint32 index, size_t first, size_t last)
+              {
+                  auto& part  = parts[index];
+                  auto& arena = arenas[index];
+                  arena.clear();
+                  auto onCell = [&](uint64 row, std::string_view text)
+                  {
+                      if (sort.numeric)
+                      {
+                          part.push_back(SortEntry{ NumberKey(text, sort.descending), row, nullptr, 8 });
+                          return;
+                      }
+                      text = text.substr(0, MAX_SORT_KEY_SIZE);
+                      // the offset of the rest of the key is kept until the arena stops growing
+                      part.push_back(SortEntry{ TextPrefix(text), row, reinterpret_cast<const char*>(arena.size()), (uint32) text.size() });
+                      if (text.size() > 8)
+                          arena.append(text.substr(8));
+                  };
+                  if (!ReadCells(rows.data() + start + first, last - first, sort.column, onCell))
+                      this->failed = true;
+                  for (auto& e : part)
+                      e.rest = e.size > 8 ? arena.data() + reinterpret_cast<size_t>(e.rest) : nullptr;
+              });
+        if ((this->failed) || (this->stop))
+        {
+            result = false;
+            break;
+        }
+        entries.clear();
+        for (auto& part : parts)
+            entries.insert(entries.end(), part.begin(), part.end());
+        parts.clear();
+        ParallelSort(entries, compare, threadsCount);
+
+        if ((start == 0) && (end == rows.size()))
+        {
+            for (size_t idx = 0; idx < entries.size(); idx++)
+                rows[idx] = entries[idx].row;
+            this->progress.fetch_add(rows.size(), std::memory_order_relaxed);
+            return true;
+        }
+        const auto run = std::filesystem::temp_directory_path() /
+                         (std::string("gview-sort-") + std::to_string(reinterpret_cast<uintptr_t>(this)) + "-" +
+                          std::to_string(runs.size()) + ".tmp");
+        runs.push_back(run);
+        result = SortRun::Write(run, entries);
+        start  = end;
+    }
+    entries = {};
+    arenas  = {};
+
+    // the runs are merged (a heap keeps the run with the smallest current key on top)
+    if (result)
+    {
+        std::vector<SortRun> readers(runs.size());
+        auto heapCompare = [&](uint32 a, uint32 b) { return compare(readers[b].entry, readers[a].entry); };
+        std::priority_queue<uint32, std::vector<uint32>, decltype(heapCompare)> heap(heapCompare);
+        for (auto idx = 0U; (idx < readers.size()) && (result); idx++)
+        {
+            result = readers[idx].Open(runs[idx]);
+            if ((result) && (readers[idx].Next()))
+                heap.push(idx);
+        }
+        size_t count = 0;
+        while ((result) && (!heap.empty()) && (!this->stop))
+        {
+            const auto idx = heap.top();
+            heap.pop();
+            rows[count++] = readers[idx].entry.row;
+            this->progress.fetch_add(1, std::memory_order_relaxed);
+            if (readers[idx].Next())
+                heap.push(idx);
+        }
+        result = result && (count == rows.size());
+    }
+    for (const auto& run : runs)
+    {
+        std::error_code ec;
+        std::filesystem::remove(run, ec);
+    }
+    if (this->stop)
+        return false;
+    CHECK(result, false, "Fail to sort %llu rows (with %u temporary files)", (uint64) rows.size(), (uint32) runs.size());
+    return true;
+}
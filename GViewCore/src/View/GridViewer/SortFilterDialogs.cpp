@@ -0,0 +1,132 @@
+#include "GridViewer.hpp"
+
+using namespace GView::View::GridViewer;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+namespace
+{
+void AddColumns(Reference<ComboBox> combo, const std::vector<std::string>& columns, uint32 current)
+{
+    for (auto idx = 0U; idx < columns.size(); idx++)
+        combo->AddItem(columns[idx], idx);
+    if (current < columns.size())
+        combo->SetCurentItemIndex(current);
+}
+bool ProcessDialogEvent(Window* dialog, Event eventType, int ID, bool& validate)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            dialog->Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            validate = true;
+            return true;
+        }
+        break;
+    case Event::WindowAccept:
+        validate = true;
+        return true;
+    case Event::WindowClose:
+        dialog->Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+    return false;
+}
+} // namespace
+
+SortDialog::SortDialog(const std::vector<std::string>& columns, const RowSort& _sort)
+    : Window("Sort rows", "d:c,w:60,h:10", WindowFlags::ProcessReturn), sort(_sort)
+{
+    Factory::Label::Create(this, "C&olumn", "x:1,y:1,w:8");
+    cbColumn     = Factory::ComboBox::Create(this, "x:10,y:1,w:46");
+    cbNumeric    = Factory::CheckBox::Create(this, "Compare as &numbers", "x:10,y:3,w:46");
+    cbDescending = Factory::CheckBox::Create(this, "&Descending", "x:10,y:4,w:46");
+
+    Factory::Button::Create(this, "&OK", "l:16,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:31,b:0,w:13", BTN_ID_CANCEL);
+
+    AddColumns(cbColumn, columns, sort.column);
+    cbNumeric->SetChecked(sort.numeric);
+    cbDescending->SetChecked(sort.descending);
+    cbColumn->SetFocus();
+}
+void SortDialog::Validate()
+{
+    if (cbColumn->GetCurrentItemIndex() == ComboBox::NO_ITEM_SELECTED)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Please select the column to sort by !");
+        cbColumn->SetFocus();
+        return;
+    }
+    sort.column     = cbColumn->GetCurrentItemIndex();
+    sort.numeric    = cbNumeric->IsChecked();
+    sort.descending = cbDescending->IsChecked();
+    Exit(Dialogs::Result::Ok);
+}
+bool SortDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    auto validate = false;
+    if (!ProcessDialogEvent(this, eventType, ID, validate))
+        return false;
+    if (validate)
+        Validate();
+    return true;
+}
+
+FilterDialog::FilterDialog(const std::vector<std::string>& columns, const RowFilter& _filter)
+    : Window("Filter rows", "d:c,w:60,h:11", WindowFlags::ProcessReturn), filter(_filter)
+{
+    Factory::Label::Create(this, "C&olumn", "x:1,y:1,w:8");
+    cbColumn = Factory::ComboBox::Create(this, "x:10,y:1,w:46");
+    Factory::Label::Create(this, "&Rows", "x:1,y:3,w:8");
+    cbOperator = Factory::ComboBox::Create(
+          this, "x:10,y:3,w:46", "contain the value,are equal to,are not equal to,are less than,are less or equal to,"
+                                 "are greater than,are greater or equal to,are empty,are not empty");
+    Factory::Label::Create(this, "&Value", "x:1,y:5,w:8");
+    txValue = Factory::TextField::Create(this, filter.value, "x:10,y:5,w:46");
+
+    Factory::Button::Create(this, "&OK", "l:16,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:31,b:0,w:13", BTN_ID_CANCEL);
+
+    AddColumns(cbColumn, columns, filter.column);
+    cbOperator->SetCurentItemIndex(static_cast<uint32>(filter.op));
+    txValue->SetFocus();
+}
+void FilterDialog::Validate()
+{
+    LocalString<256> value;
+    if (cbColumn->GetCurrentItemIndex() == ComboBox::NO_ITEM_SELECTED)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Please select the column to filter by !");
+        cbColumn->SetFocus();
+        return;
+    }
+    if (value.Set(txValue->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid value (expecting ascii characters) !");
+        txValue->SetFocus();
+        return;
+    }
+    filter.column = cbColumn->GetCurrentItemIndex();
+    filter.op     = static_cast<FilterOperator>(cbOperator->GetCurrentItemIndex());
+    filter.value  = value.ToStringView();
+    // the cells are compared as numbers only if the value is a number (otherwise they are compared as text)
+    filter.isNumber = ParseNumber(filter.value, filter.number);
+    Exit(Dialogs::Result::Ok);
+}
+bool FilterDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    auto validate = false;
+    if (!ProcessDialogEvent(this, eventType, ID, validate))
+        return false;
+    if (validate)
+        Validate();
+    return true;
+}
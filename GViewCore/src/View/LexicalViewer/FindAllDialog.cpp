@@ -9,7 +9,7 @@ constexpr int32 BTN_ID_OK             = 1;
 constexpr int32 BTN_ID_CANCEL         = 2;
 constexpr uint32 INVALID_TOKEN_NUMBER = 0xFFFFFFFF;
 
-FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<TokenObject>& tokens, const char16* txt)
+FindAllDialog::FindAllDialog(uint32 currentTokenIndex, const Instance& instance)
     : Window("All apearences", "d:c,w:80,h:20", WindowFlags::ProcessReturn)
 {
     LocalString<128> tmp;
@@ -18,17 +18,18 @@ FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<
 
     lst = Factory::ListView::Create(this, "l:1,t:0,r:1,b:3", { "n:Line,a:l,w:6", "n:Content,a:l,w:200" }, ListViewFlags::HideSearchBar);
     // add all lines
-    auto len      = static_cast<uint32>(tokens.size());
-    auto lastLine = 0xFFFFFFFFU;
-    auto ctokSize = static_cast<uint32>(currentToken.GetText(txt).size());
+    const auto& tokens       = instance.tokens;
+    const auto& currentToken = tokens[currentTokenIndex];
+    auto len                 = static_cast<uint32>(tokens.size());
+    auto lastLine            = 0xFFFFFFFFU;
+    auto ctokSize            = static_cast<uint32>(instance.GetTokenText(currentTokenIndex).size());
     uint32 indexes[64];
     uint32 indexesCount;
 
-    for (auto idx = 0U; idx < len; idx++)
+    // only the similar tokens (and the lines they are on) are visited
+    for (auto idx : instance.GetSimilarTokens(currentToken.hash))
     {
         const auto& tok = tokens[idx];
-        if (tok.hash != currentToken.hash)
-            continue;
         if (tok.lineNo == lastLine)
             continue;
         auto item = lst->AddItem(tmp.Format("%d", tok.lineNo));
@@ -39,9 +40,8 @@ FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<
         if (tokens[start].lineNo != tok.lineNo)
             start++;
         auto end = idx;
-        while ((end > 0) && (tokens[end].lineNo == tok.lineNo))
+        while ((end < len) && (tokens[end].lineNo == tok.lineNo))
             end++;
-        end--;
         // between start and end a new line is found
         content.Clear();
         auto lastX   = 0U;
@@ -62,7 +62,7 @@ FindAllDialog::FindAllDialog(const TokenObject& currentToken, const std::vector<
                 indexes[indexesCount++] = content.Len();
             }
 
-            content.Add(tokens[start].GetText(txt));
+            content.Add(instance.GetTokenText(start));
             lastX = tokens[start].end;
             start++;
         }
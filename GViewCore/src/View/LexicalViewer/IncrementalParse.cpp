@@ -0,0 +1,713 @@
+#include "LexicalViewer.hpp"
+
+#include <algorithm>
+
+namespace GView::View::LexicalViewer
+{
+constexpr uint32 REPARSE_SYNC_TOKENS     = 8;    // tokens (after an edit) that are parsed again at first to find a synchronization point
+constexpr uint32 REPARSE_MAX_SYNC_TOKENS = 1024; // if there is no synchronization point after this many tokens, the entire text is parsed
+constexpr uint32 REPARSE_MIN_SYNC_TOKENS = 2;    // tokens that must be identical (after an edit) for the two token streams to be in sync
+constexpr uint32 REPLACED_TOKEN          = 0x80000000;
+
+namespace
+{
+    bool TokenEndsBefore(const TokenObject& tok, uint32 offset)
+    {
+        return tok.end < offset;
+    }
+    bool TokenStartsAfter(uint32 offset, const TokenObject& tok)
+    {
+        return offset < tok.start;
+    }
+    bool IsSameToken(const TokenObject& tok, int64 shift, const TokenObject& original)
+    {
+        return (static_cast<int64>(tok.start) + shift == static_cast<int64>(original.start)) &&
+               (static_cast<int64>(tok.end) + shift == static_cast<int64>(original.end)) && (tok.type == original.type) &&
+               (tok.dataType == original.dataType) && (tok.align == original.align) && (tok.color == original.color) &&
+               (tok.CanChangeValue() == original.CanChangeValue()) && (tok.IsSizeable() == original.IsSizeable());
+    }
+    bool IsBlocksFragment(const ParsedContent& fragment, uint32 inserted)
+    {
+        // the blocks linked to the first 'inserted' tokens of the fragment must be made only of those tokens (the other tokens of
+        // the fragment are the old ones and keep their blocks)
+        for (auto idx = 0U; idx < static_cast<uint32>(fragment.tokens.size()); idx++)
+        {
+            const auto& tok = fragment.tokens[idx];
+            if (!tok.HasBlock())
+                continue;
+            if (tok.blockID >= fragment.blocks.size())
+                return false;
+            const auto& block = fragment.blocks[tok.blockID];
+            if ((idx < inserted) != (block.tokenStart < inserted))
+                return false;
+            // the content of a deferred block starts folded (it is analyzed only when it is expanded)
+            if ((block.tokenStart < inserted) && ((block.tokenEnd >= inserted) || (block.HasDeferredContent())))
+                return false;
+        }
+        return true;
+    }
+} // namespace
+
+std::vector<TextEdit> ParsedContent::ComputeTextEdits(const UnicodeString& newText) const
+{
+    // the text between the common prefix and the common suffix of the two texts
+    std::vector<TextEdit> edits;
+    const auto minSize = std::min<>(this->text.size, newText.size);
+    uint32 prefix      = 0;
+    uint32 suffix      = 0;
+    while ((prefix < minSize) && (this->text.text[prefix] == newText.text[prefix]))
+        prefix++;
+    while ((suffix < minSize - prefix) && (this->text.text[this->text.size - suffix - 1] == newText.text[newText.size - suffix - 1]))
+        suffix++;
+    if ((prefix != this->text.size) || (prefix != newText.size))
+        edits.push_back({ prefix, this->text.size - suffix, prefix, newText.size - suffix });
+    return edits;
+}
+bool Instance::ReparseEdits(UnicodeString& newText, const std::vector<TextEdit>& edits)
+{
+    if ((this->parsing) || (this->tokens.empty()))
+        return false;
+    std::vector<TokensSplice> splices;
+    if (!ComputeTokensSplices(newText, edits, splices))
+        return false;
+    ApplyTokensSplices(newText, edits, splices);
+    return true;
+}
+bool ParsedContent::ComputeTokensSplices(const UnicodeString& newText, std::vector<TextEdit> edits, std::vector<TokensSplice>& splices)
+{
+    /*
+    For every edit:
+    - parsing starts from the token before the first one touched by the edit (a token start is a safe restart point
+      only if the old text parsed from there results in the same tokens)
+    - parsing ends after the edit, when the last tokens are identical with the old ones (only shifted)
+    - the tokens in between are replaced (the blocks they contain must be entire blocks --> they are replaced as well)
+    */
+    const auto count = static_cast<uint32>(this->tokens.size());
+    std::vector<std::pair<uint32, uint32>> blockEnds; // blocks without an end marker end on a regular token (last and first token)
+    for (const auto& block : this->blocks)
+    {
+        if (!block.HasEndMarker())
+            blockEnds.emplace_back(block.tokenEnd, block.tokenStart);
+    }
+    std::sort(blockEnds.begin(), blockEnds.end());
+
+    ParsedContent oldFragment, newFragment;
+    auto nextToken = 0U; // tokens before this one were already handled
+    for (size_t idx = 0; idx < edits.size(); idx++)
+    {
+        auto edit    = edits[idx];
+        auto restart = std::lower_bound(this->tokens.begin(), this->tokens.end(), edit.oldStart, TokenEndsBefore);
+        if (restart != this->tokens.begin())
+            restart--;
+        const auto first = std::max<>(static_cast<uint32>(restart - this->tokens.begin()), nextToken);
+        auto extra       = REPARSE_SYNC_TOKENS;
+        auto replacedEnd = count;
+        while (true)
+        {
+            const auto afterEdit = std::upper_bound(this->tokens.begin() + first, this->tokens.end(), edit.oldEnd, TokenStartsAfter);
+            const auto after     = static_cast<uint32>(afterEdit - this->tokens.begin());
+            const auto tailEnd   = static_cast<uint32>(std::min<uint64>(count, static_cast<uint64>(after) + extra));
+
+            // the tokens after the edit must not reach the next edit --> the two edits are parsed together
+            if ((idx + 1 < edits.size()) && ((tailEnd == count) || (this->tokens[tailEnd - 1].end >= edits[idx + 1].oldStart)))
+            {
+                edit.oldEnd = edits[idx + 1].oldEnd;
+                edit.newEnd = edits[idx + 1].newEnd;
+                idx++;
+                continue;
+            }
+
+            const auto oldStart = std::min<>(this->tokens[first].start, edit.oldStart);
+            const auto oldEnd   = tailEnd == count ? this->text.size : std::max<>(this->tokens[tailEnd - 1].end, edit.oldEnd);
+            const auto newStart = static_cast<uint32>(static_cast<int64>(oldStart) + edit.newStart - edit.oldStart);
+            const auto newEnd   = static_cast<uint32>(static_cast<int64>(oldEnd) + edit.newEnd - edit.oldEnd);
+
+            // the old text must be parsed in the same way (otherwise the tokens depend on what is before the restart point)
+            if (!oldFragment.AnalyzeFragment(this->settings, { this->text.text + oldStart, oldEnd - oldStart }))
+                return false;
+            if (oldFragment.tokens.size() != tailEnd - first)
+                return false;
+            for (auto tokIdx = first; tokIdx < tailEnd; tokIdx++)
+            {
+                if (!IsSameToken(oldFragment.tokens[tokIdx - first], oldStart, this->tokens[tokIdx]))
+                    return false;
+            }
+
+            if (!newFragment.AnalyzeFragment(this->settings, { newText.text + newStart, newEnd - newStart }))
+                return false;
+            const auto newCount = static_cast<uint32>(newFragment.tokens.size());
+            const auto shift    = static_cast<int64>(newStart) - (static_cast<int64>(edit.newEnd) - edit.oldEnd);
+            auto synced         = 0U;
+            while ((synced < newCount) && (synced < tailEnd - after) &&
+                   (IsSameToken(newFragment.tokens[newCount - 1 - synced], shift, this->tokens[tailEnd - 1 - synced])))
+                synced++;
+            if ((tailEnd < count) && (synced < std::min<>(REPARSE_MIN_SYNC_TOKENS, tailEnd - after)))
+            {
+                // not in sync yet --> parse more tokens
+                if (extra >= REPARSE_MAX_SYNC_TOKENS)
+                    return false;
+                extra *= 2;
+                continue;
+            }
+
+            // the replaced tokens (old or new) can only contain entire blocks
+            replacedEnd         = tailEnd - synced;
+            const auto inserted = newCount - synced;
+            for (auto blockEnd = std::lower_bound(blockEnds.begin(), blockEnds.end(), std::make_pair(first, 0U));
+                 (blockEnd != blockEnds.end()) && (blockEnd->first < replacedEnd);
+                 blockEnd++)
+            {
+                if (blockEnd->second < first)
+                    return false;
+            }
+            if ((!CanReplaceBlocks(oldFragment, first, replacedEnd, tailEnd)) || (!IsBlocksFragment(newFragment, inserted)))
+                return false;
+
+            auto& splice = splices.emplace_back();
+            splice.first = first;
+            splice.count = replacedEnd - first;
+            splice.tokens.assign(newFragment.tokens.begin(), newFragment.tokens.begin() + inserted);
+            for (auto& tok : splice.tokens)
+            {
+                tok.start += newStart;
+                tok.end += newStart;
+            }
+            for (const auto& [index, error] : newFragment.tokenErrors)
+            {
+                if (index < inserted)
+                    splice.errors[index].Set(error.ToStringView());
+            }
+
+            // the blocks of the new tokens (in the order of their first token) --> the tokens are linked to them
+            std::vector<uint32> order;
+            for (auto blockID = 0U; blockID < static_cast<uint32>(newFragment.blocks.size()); blockID++)
+            {
+                if (newFragment.blocks[blockID].tokenStart < inserted)
+                    order.push_back(blockID);
+            }
+            std::sort(
+                  order.begin(),
+                  order.end(),
+                  [&newFragment](uint32 a, uint32 b) { return newFragment.blocks[a].tokenStart < newFragment.blocks[b].tokenStart; });
+            std::vector<uint32> blockIndex(newFragment.blocks.size(), BlockObject::INVALID_ID);
+            for (auto blockID : order)
+            {
+                blockIndex[blockID] = static_cast<uint32>(splice.blocks.size());
+                splice.blocks.push_back(std::move(newFragment.blocks[blockID]));
+            }
+            for (auto& tok : splice.tokens)
+            {
+                tok.hash = 0;
+                if (tok.HasBlock())
+                    tok.blockID = blockIndex[tok.blockID];
+            }
+            break;
+        }
+        nextToken = replacedEnd;
+    }
+    return true;
+}
+bool ParsedContent::CanReplaceBlocks(const ParsedContent& oldFragment, uint32 first, uint32 replacedEnd, uint32 tailEnd) const
+{
+    /*
+    The blocks of the replaced tokens [first, replacedEnd) are replaced by the ones of the new tokens. This is possible if:
+    - every block linked to a replaced token is made only of replaced tokens (and no other token is linked to it)
+    - the old text (parsed without the tokens around it) results in the same blocks --> the new one is parsed in the same way
+    */
+    auto isReplacedBlock = [this, first, replacedEnd](uint32 blockID)
+    {
+        return (blockID < this->blocks.size()) && (this->blocks[blockID].tokenStart >= first) &&
+               (this->blocks[blockID].tokenStart < replacedEnd);
+    };
+    for (auto idx = first; idx < replacedEnd; idx++)
+    {
+        const auto& tok  = this->tokens[idx];
+        const auto& same = oldFragment.tokens[idx - first];
+        if ((tok.HasBlock() != same.HasBlock()) || (tok.IsBlockStarter() != same.IsBlockStarter()))
+            return false;
+        if (!tok.HasBlock())
+            continue;
+        if ((!isReplacedBlock(tok.blockID)) || (this->blocks[tok.blockID].tokenEnd >= replacedEnd) ||
+            (same.blockID >= oldFragment.blocks.size()))
+            return false;
+        const auto& block     = this->blocks[tok.blockID];
+        const auto& sameBlock = oldFragment.blocks[same.blockID];
+        if ((block.tokenStart - first != sameBlock.tokenStart) || (block.tokenEnd - first != sameBlock.tokenEnd) ||
+            (block.flags != sameBlock.flags) || (block.align != sameBlock.align))
+            return false;
+    }
+    // the tokens around the replaced ones (a token that is linked to a block is usually right before or right after it)
+    if ((first > 0) && (this->tokens[first - 1].HasBlock()) && (isReplacedBlock(this->tokens[first - 1].blockID)))
+        return false;
+    for (auto idx = replacedEnd; idx < tailEnd; idx++)
+    {
+        if ((this->tokens[idx].HasBlock()) && (isReplacedBlock(this->tokens[idx].blockID)))
+            return false;
+    }
+    return true;
+}
+void ParsedContent::SpliceTokens(
+      UnicodeString& newText, const std::vector<TextEdit>& edits, std::vector<TokensSplice>& splices, uint32& tokenIndex)
+{
+    // only the tokens are updated (sizes, hashes and blocks) - the layout is not computed
+    const auto count = static_cast<uint32>(this->tokens.size());
+    auto newCount    = static_cast<size_t>(count);
+    for (const auto& splice : splices)
+        newCount = newCount - splice.count + splice.tokens.size();
+    auto isReplaced = [&splices](uint32 index)
+    {
+        const auto splice = std::upper_bound(
+              splices.begin(), splices.end(), index, [](uint32 value, const TokensSplice& s) { return value < s.first; });
+        return (splice != splices.begin()) && (index < (splice - 1)->first + (splice - 1)->count);
+    };
+
+    // the blocks of the replaced tokens are removed (the other ones keep their order, with consecutive IDs) and the blocks of
+    // the new tokens are added after them
+    const auto blocksCount = static_cast<uint32>(this->blocks.size());
+    std::vector<uint32> blockRemap(blocksCount);
+    auto keptBlocks = 0U;
+    for (auto blockID = 0U; blockID < blocksCount; blockID++)
+        blockRemap[blockID] = isReplaced(this->blocks[blockID].tokenStart) ? BlockObject::INVALID_ID : keptBlocks++;
+    auto remapBlock = [&blockRemap, blocksCount](uint32 blockID)
+    { return blockID < blocksCount ? blockRemap[blockID] : BlockObject::INVALID_ID; };
+
+    // the innermost block that contains the new tokens of a splice: one that contains the token before them and that ends
+    // after them (it can not be a replaced one)
+    std::vector<uint32> containers;
+    for (const auto& splice : splices)
+    {
+        auto blockID = splice.first > 0 ? this->tokenBlocks[splice.first - 1] : BlockObject::INVALID_ID;
+        while ((blockID < blocksCount) && (this->blocks[blockID].tokenEnd < splice.first))
+            blockID = this->blockParents[blockID];
+        containers.push_back(remapBlock(blockID));
+    }
+
+    // the tokens that were not replaced are shifted with the size difference of the edits before them
+    std::vector<TokenObject> result;
+    std::vector<uint32> remap(count);
+    std::vector<uint32> resultTokenBlocks;
+    std::vector<uint32> addedBlockParents;
+    std::vector<std::pair<uint32, uint32>> inserted;
+    std::unordered_map<uint32, UnicodeStringBuilder> errors;
+    result.reserve(newCount);
+    resultTokenBlocks.reserve(newCount);
+    int64 delta      = 0;
+    size_t editIdx   = 0;
+    size_t spliceIdx = 0;
+    auto nextBlockID = keptBlocks;
+    for (auto idx = 0U; idx < count;)
+    {
+        if ((spliceIdx < splices.size()) && (splices[spliceIdx].first == idx))
+        {
+            auto& splice = splices[spliceIdx];
+            const auto s = static_cast<uint32>(result.size());
+            for (const auto& [index, error] : splice.errors)
+                errors[s + index].Set(error.ToStringView());
+
+            // the new tokens are linked to the new blocks (the blocks are opened and closed in the order of their tokens)
+            std::vector<uint32> openBlocks;
+            addedBlockParents.resize(nextBlockID - keptBlocks + splice.blocks.size(), BlockObject::INVALID_ID);
+            for (auto tokIdx = 0U; tokIdx < static_cast<uint32>(splice.tokens.size()); tokIdx++)
+            {
+                auto& tok = result.emplace_back(splice.tokens[tokIdx]);
+                while ((!openBlocks.empty()) && (splice.blocks[openBlocks.back()].GetEndIndex() <= tokIdx))
+                    openBlocks.pop_back();
+                const auto container = openBlocks.empty() ? containers[spliceIdx] : openBlocks.back() + nextBlockID;
+                if ((tok.IsBlockStarter()) && (tok.blockID < splice.blocks.size()))
+                {
+                    addedBlockParents[tok.blockID + nextBlockID - keptBlocks] = container;
+                    openBlocks.push_back(tok.blockID);
+                }
+                if (tok.HasBlock())
+                    tok.blockID += nextBlockID;
+                resultTokenBlocks.push_back(openBlocks.empty() ? containers[spliceIdx] : openBlocks.back() + nextBlockID);
+            }
+            inserted.emplace_back(s, static_cast<uint32>(result.size()));
+            nextBlockID += static_cast<uint32>(splice.blocks.size());
+
+            // a replaced token is mapped to the last new token (or to the one before them)
+            const auto target = result.empty() ? 0U : static_cast<uint32>(result.size() - 1);
+            for (auto tokIdx = 0U; tokIdx < splice.count; tokIdx++)
+                remap[idx + tokIdx] = target | REPLACED_TOKEN;
+            idx += splice.count;
+            spliceIdx++;
+            continue;
+        }
+        auto& tok = this->tokens[idx];
+        while ((editIdx < edits.size()) && (edits[editIdx].oldEnd <= tok.start))
+        {
+            const auto& edit = edits[editIdx++];
+            delta += (static_cast<int64>(edit.newEnd) - edit.newStart) - (static_cast<int64>(edit.oldEnd) - edit.oldStart);
+        }
+        tok.start = static_cast<uint32>(tok.start + delta);
+        tok.end   = static_cast<uint32>(tok.end + delta);
+        tok.SetNewValueFlag(false);
+        if (tok.HasBlock())
+            tok.blockID = remapBlock(tok.blockID);
+        remap[idx] = static_cast<uint32>(result.size());
+        result.push_back(tok);
+        resultTokenBlocks.push_back(remapBlock(this->tokenBlocks[idx]));
+        idx++;
+    }
+
+    for (const auto& [index, error] : this->tokenErrors)
+    {
+        if ((remap[index] & REPLACED_TOKEN) == 0)
+            errors[remap[index]].Set(error.ToStringView());
+    }
+
+    // the blocks that were kept are shifted (the tokens they contain were not replaced), the new ones are added after them
+    std::vector<BlockObject> resultBlocks;
+    std::vector<uint32> resultBlockParents;
+    std::vector<BlockLayout> resultBlockLayouts;
+    const auto hasLayouts = this->blockLayouts.size() == blocksCount;
+    resultBlocks.reserve(nextBlockID);
+    resultBlockParents.reserve(nextBlockID);
+    for (auto blockID = 0U; blockID < blocksCount; blockID++)
+    {
+        if (blockRemap[blockID] == BlockObject::INVALID_ID)
+            continue;
+        auto& block      = resultBlocks.emplace_back(std::move(this->blocks[blockID]));
+        block.tokenStart = remap[block.tokenStart] & (~REPLACED_TOKEN);
+        block.tokenEnd   = remap[block.tokenEnd] & (~REPLACED_TOKEN);
+        resultBlockParents.push_back(remapBlock(this->blockParents[blockID]));
+        if (hasLayouts)
+            resultBlockLayouts.push_back(this->blockLayouts[blockID]);
+    }
+    for (auto idx = 0U; idx < static_cast<uint32>(splices.size()); idx++)
+    {
+        for (auto& block : splices[idx].blocks)
+        {
+            block.tokenStart += inserted[idx].first;
+            block.tokenEnd += inserted[idx].first;
+            resultBlocks.push_back(std::move(block));
+        }
+    }
+    resultBlockParents.insert(resultBlockParents.end(), addedBlockParents.begin(), addedBlockParents.end());
+    if (hasLayouts)
+        resultBlockLayouts.resize(nextBlockID); // the new blocks were never laid out (their version is not a valid one)
+
+    // the blocks in the order of their first token --> the new ones are merged with the ones that were kept
+    std::vector<uint32> resultBlocksByStart;
+    resultBlocksByStart.reserve(nextBlockID);
+    for (auto blockID : this->blocksByStart)
+    {
+        if (remapBlock(blockID) != BlockObject::INVALID_ID)
+            resultBlocksByStart.push_back(blockRemap[blockID]);
+    }
+    const auto middle = static_cast<std::ptrdiff_t>(resultBlocksByStart.size());
+    for (auto blockID = keptBlocks; blockID < nextBlockID; blockID++)
+        resultBlocksByStart.push_back(blockID);
+    std::inplace_merge(
+          resultBlocksByStart.begin(),
+          resultBlocksByStart.begin() + middle,
+          resultBlocksByStart.end(),
+          [&resultBlocks](uint32 a, uint32 b) { return resultBlocks[a].tokenStart < resultBlocks[b].tokenStart; });
+
+    // the layout of the blocks is kept (a replaced token is mapped to the first new one) so that only the blocks with new
+    // tokens have to be laid out again
+    auto remapLayoutIndex = [&](uint32& index)
+    {
+        if (index > count)
+            return; // not a token
+        if (index == count)
+            index = static_cast<uint32>(result.size());
+        else if ((remap[index] & REPLACED_TOKEN) == 0)
+            index = remap[index];
+        else
+        {
+            const auto splice = std::upper_bound(
+                  splices.begin(), splices.end(), index, [](uint32 value, const TokensSplice& s) { return value < s.first; });
+            index = inserted[splice - splices.begin() - 1].first;
+        }
+    };
+    for (auto& layout : resultBlockLayouts)
+    {
+        remapLayoutIndex(layout.afterIndex);
+        for (auto* state : { &layout.stateBefore, &layout.stateAfter })
+        {
+            remapLayoutIndex(state->idxStart);
+            remapLayoutIndex(state->lastSameColumnToken);
+        }
+    }
+
+    // the replaced tokens are removed from the lists of similar tokens (the indexes of the other ones are moved only if the
+    // number of tokens before them changed)
+    const auto sameIndexes = std::all_of(splices.begin(), splices.end(), [](const TokensSplice& s) { return s.tokens.size() == s.count; });
+    if (sameIndexes)
+    {
+        for (const auto& splice : splices)
+        {
+            for (auto idx = splice.first; idx < splice.first + splice.count; idx++)
+            {
+                const auto it = this->hashTokens.find(this->tokens[idx].hash);
+                if ((this->tokens[idx].hash == 0) || (it == this->hashTokens.end()))
+                    continue;
+                const auto pos = std::lower_bound(it->second.begin(), it->second.end(), idx);
+                if ((pos != it->second.end()) && (*pos == idx))
+                    it->second.erase(pos);
+                if (it->second.empty())
+                    this->hashTokens.erase(it);
+            }
+        }
+    }
+    else
+    {
+        for (auto it = this->hashTokens.begin(); it != this->hashTokens.end();)
+        {
+            auto& list = it->second;
+            std::erase_if(list, [&remap](uint32 index) { return (remap[index] & REPLACED_TOKEN) != 0; });
+            for (auto& index : list)
+                index = remap[index];
+            it = list.empty() ? this->hashTokens.erase(it) : std::next(it);
+        }
+    }
+
+    for (auto idx = 0U; idx < static_cast<uint32>(splices.size()); idx++)
+        splices[idx].first = inserted[idx].first;
+    if (tokenIndex < count)
+        tokenIndex = remap[tokenIndex] & (~REPLACED_TOKEN);
+    this->tokens.swap(result);
+    this->tokenBlocks.swap(resultTokenBlocks);
+    this->blocks.swap(resultBlocks);
+    this->blockParents.swap(resultBlockParents);
+    this->blocksByStart.swap(resultBlocksByStart);
+    if (hasLayouts)
+        this->blockLayouts.swap(resultBlockLayouts);
+    else
+        this->blockLayouts.clear();
+    this->tokenErrors.swap(errors);
+    this->tokenValues.clear();
+    this->deletedTokens.clear();
+    this->text.Destroy();
+    this->text = newText;
+    newText    = UnicodeString();
+
+    // sizes and hashes of the new tokens (they are added to the lists of similar tokens)
+    std::vector<uint32> added;
+    for (const auto& [start, end] : inserted)
+    {
+        for (auto idx = start; idx < end; idx++)
+            added.push_back(idx);
+    }
+    UpdateTokensInformation(added);
+}
+bool ParsedContent::LayOutSplicedTokens(const std::vector<TokensSplice>& splices, uint32& firstChangedToken)
+{
+    /*
+    Only the innermost blocks that contain the new tokens are laid out again (like a block whose fold status was changed);
+    the tokens after such a block are moved with the rows it added or removed and their line numbers with the lines it added
+    or removed. The line numbers are computed with everything expanded, so this is possible if:
+    - the new tokens are part of a block (the other ones are laid out only with all tokens)
+    - all tokens until the end of that block are visible and no block before its end is folded (the layout is the one the
+      line numbers are computed for)
+    Returns false if all tokens have to be laid out again (and their line numbers computed again).
+    */
+    const auto count = static_cast<uint32>(this->tokens.size());
+    auto checked     = 0U; // tokens before this one (except for the new ones) are visible and not folded
+    auto laidOut     = 0U; // tokens before this one were already laid out again
+    auto spliceIdx   = 0U;
+    firstChangedToken = count;
+    for (const auto& splice : splices)
+    {
+        // a splice from a block that was already laid out again
+        const auto first = splice.first;
+        if (first < laidOut)
+            continue;
+        CHECK(first < count, false, "");
+
+        // the innermost block that contains the new tokens (or the place of the removed ones)
+        auto blockID = this->tokenBlocks[first];
+        if ((blockID != BlockObject::INVALID_ID) && (this->blocks[blockID].tokenStart == first))
+            blockID = this->blockParents[blockID];
+        CHECK(blockID != BlockObject::INVALID_ID, false, "");
+        const auto start      = this->blocks[blockID].tokenStart;
+        const auto afterIndex = this->blockLayouts[blockID].afterIndex;
+        CHECK((start >= laidOut) && (afterIndex <= count), false, "");
+
+        // the new tokens are skipped (they were not laid out yet)
+        for (; checked < afterIndex; checked++)
+        {
+            while ((spliceIdx < splices.size()) && (splices[spliceIdx].first + splices[spliceIdx].tokens.size() <= checked))
+                spliceIdx++;
+            if ((spliceIdx < splices.size()) && (checked >= splices[spliceIdx].first))
+                continue;
+            CHECK((this->tokens[checked].IsVisible()) && (!this->tokens[checked].IsFolded()), false, "");
+        }
+        CHECK(PrettyFormatChangedBlock(blockID), false, "");
+        for (auto idx = start; idx < afterIndex; idx++)
+        {
+            CHECK(this->tokens[idx].IsVisible(), false, ""); // a new meta data token is hidden
+        }
+
+        // line numbers of the tokens from the block and of the first one after it --> the others are moved with the same number of lines
+        auto lastY  = start > 0 ? this->tokens[start - 1].pos.y : -1;
+        auto lineNo = start > 0 ? this->tokens[start - 1].lineNo : 0U;
+        for (auto idx = start; idx < std::min<>(afterIndex + 1, count); idx++)
+        {
+            auto& tok = this->tokens[idx];
+            if (tok.pos.y != lastY)
+            {
+                lineNo++;
+                lastY = tok.pos.y;
+            }
+            if (idx == afterIndex)
+            {
+                const auto dLines = static_cast<int32>(lineNo) - static_cast<int32>(tok.lineNo);
+                if (dLines != 0)
+                {
+                    for (auto next = afterIndex; next < count; next++)
+                        this->tokens[next].lineNo += dLines;
+                }
+                this->lastLineNumber += dLines;
+            }
+            else
+            {
+                tok.lineNo = lineNo;
+            }
+        }
+        if (afterIndex == count)
+            this->lastLineNumber = lineNo;
+        firstChangedToken = std::min<>(firstChangedToken, start);
+        laidOut           = afterIndex;
+    }
+    return true;
+}
+void Instance::ApplyTokensSplices(UnicodeString& newText, const std::vector<TextEdit>& edits, std::vector<TokensSplice>& splices)
+{
+    SpliceTokens(newText, edits, splices, this->currentTokenIndex);
+    this->selection.Clear();
+
+    // only the blocks with new tokens are laid out again (if possible)
+    auto firstChangedToken = 0U;
+    if ((!this->prettyFormat) || (!LayOutSplicedTokens(splices, firstChangedToken)))
+    {
+        RecomputeLayoutAndLineNumbers();
+        return;
+    }
+    this->rowIndex.Update(this->tokens, firstChangedToken);
+    EnsureCurrentItemIsVisible();
+    if (!this->noItemsVisible)
+        MoveToClosestVisibleToken(this->currentTokenIndex, false);
+    UpdateLineNumberWidth();
+}
+void Instance::RecomputeLayoutAndLineNumbers()
+{
+    // line numbers are computed with everything expanded (just like after a full parse)
+    std::vector<uint32> folded;
+    for (auto idx = 0U; idx < static_cast<uint32>(this->tokens.size()); idx++)
+    {
+        if (this->tokens[idx].IsFolded())
+        {
+            folded.push_back(idx);
+            this->tokens[idx].SetFolded(false);
+        }
+    }
+    const auto originalShowMetaDataValue = this->showMetaData;
+    this->showMetaData                   = true;
+    ComputeLayout();
+    ComputeLineNumbers();
+    this->showMetaData = originalShowMetaDataValue;
+    for (auto idx : folded)
+        this->tokens[idx].SetFolded(true);
+
+    RecomputeTokenPositions();
+    if (!this->noItemsVisible)
+        MoveToClosestVisibleToken(this->currentTokenIndex, false);
+    UpdateLineNumberWidth();
+}
+bool ParsedContent::FoldDeferredBlocks()
+{
+    auto folded = false;
+    for (const auto& block : this->blocks)
+    {
+        if (block.HasDeferredContent())
+        {
+            this->tokens[block.tokenStart].SetFolded(true);
+            folded = true;
+        }
+    }
+    return folded;
+}
+bool Instance::ParseDeferredBlock(uint32 blockID)
+{
+    // the text between the first and the last token of the block is analyzed and its tokens (and blocks) replace the ones
+    // the block had until now
+    CHECK(blockID < this->blocks.size(), false, "Invalid block ID: %u", blockID);
+    CHECK(this->blocks[blockID].HasEndMarker(), false, "A block with a deferred content must have an end marker");
+    const auto first = this->blocks[blockID].tokenStart + 1;
+    const auto last  = this->blocks[blockID].tokenEnd;
+    const auto start = this->tokens[first - 1].end;
+    const auto end   = this->tokens[last].start;
+    CHECK(start <= end, false, "Invalid block content: [%u..%u)", start, end);
+    for (auto idx = first; idx < last; idx++)
+    {
+        CHECK((!this->tokens[idx].HasBlock()) && (!this->tokens[idx].IsBlockStarter()),
+              false,
+              "A block with a deferred content can not contain other blocks");
+    }
+
+    ParsedContent content;
+    if (!content.AnalyzeFragment(this->settings, { this->text.text + start, end - start }))
+        return false;
+    const auto blocksCount = static_cast<uint32>(this->blocks.size());
+    const auto added       = static_cast<uint32>(content.tokens.size());
+    const auto shift       = [first, last, added](uint32 index) { return index >= last ? index - (last - first) + added : index; };
+
+    for (auto& tok : content.tokens)
+    {
+        tok.start += start;
+        tok.end += start;
+        if (tok.HasBlock())
+            tok.blockID += blocksCount;
+    }
+    for (auto& block : this->blocks)
+    {
+        block.tokenStart = shift(block.tokenStart);
+        block.tokenEnd   = shift(block.tokenEnd);
+    }
+    for (auto& block : content.blocks)
+    {
+        block.tokenStart += first;
+        block.tokenEnd += first;
+        this->blocks.push_back(std::move(block));
+    }
+    auto& block = this->blocks[blockID];
+    block.flags = static_cast<BlockFlags>(static_cast<uint16>(block.flags) & (~static_cast<uint16>(BlockFlags::DeferredContent)));
+
+    std::unordered_map<uint32, UnicodeStringBuilder> errors, values;
+    for (const auto& [index, error] : this->tokenErrors)
+    {
+        if ((index < first) || (index >= last))
+            errors[shift(index)].Set(error.ToStringView());
+    }
+    for (const auto& [index, value] : this->tokenValues)
+    {
+        if ((index < first) || (index >= last))
+            values[shift(index)].Set(value.ToStringView());
+    }
+    for (const auto& [index, error] : content.tokenErrors)
+        errors[first + index].Set(error.ToStringView());
+    this->tokenErrors.swap(errors);
+    this->tokenValues.swap(values);
+    this->tokens.erase(this->tokens.begin() + first, this->tokens.begin() + last);
+    this->tokens.insert(this->tokens.begin() + first, content.tokens.begin(), content.tokens.end());
+    for (auto idx = first; idx < first + added; idx++)
+    {
+        const auto value = GetTokenText(idx);
+        this->tokens[idx].UpdateSizes(value);
+        this->tokens[idx].UpdateHash(value, this->settings->ignoreCase);
+    }
+    if ((this->currentTokenIndex >= first) && (this->currentTokenIndex < last))
+        this->currentTokenIndex = first - 1;
+    else
+        this->currentTokenIndex = shift(this->currentTokenIndex);
+    this->selection.Clear();
+
+    ComputeHashIndex();
+    ComputeBlockIndex();
+    FoldDeferredBlocks();
+    RecomputeLayoutAndLineNumbers();
+    return true;
+}
+} // namespace GView::View::LexicalViewer
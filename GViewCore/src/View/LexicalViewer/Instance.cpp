@@ -13,6 +13,7 @@ constexpr int32 CMD_ID_CHANGE_SELECTION = 0xBF03;
 constexpr int32 CMD_ID_FOLD_ALL         = 0xBF04;
 constexpr int32 CMD_ID_EXPAND_ALL       = 0xBF05;
 constexpr int32 CMD_ID_SHOW_PLUGINS     = 0xBF06;
+constexpr int32 CMD_ID_STOP_PARSING     = 0xBF07;
 constexpr uint32 INVALID_LINE_NUMBER    = 0xFFFFFFFF;
 
 /*
@@ -77,7 +78,7 @@ inline std::string_view TokenDataTypeToString(TokenDataType dataType)
 }
 
 Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj, Settings* _settings)
-    : settings(nullptr), ViewControl(UserControlFlags::ShowVerticalScrollBar | UserControlFlags::ScrollBarOutsideControl)
+    : settingsData(nullptr), ViewControl(UserControlFlags::ShowVerticalScrollBar | UserControlFlags::ScrollBarOutsideControl)
 {
     this->obj  = _obj;
     this->name = _name;
@@ -86,52 +87,180 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
     if ((_settings) && (_settings->data))
     {
         // move settings data pointer
-        this->settings.reset((SettingsData*) _settings->data);
+        this->settingsData.reset((SettingsData*) _settings->data);
         _settings->data = nullptr;
     }
     else
     {
         // default setup
-        this->settings.reset(new SettingsData());
+        this->settingsData.reset(new SettingsData());
     }
+    this->settings = this->settingsData.ToReference();
 
     if (config.Loaded == false)
         config.Initialize();
 
-    // load the entire data into a file
-    auto buf                     = obj->GetData().GetEntireFile();
-    this->text                   = GView::Utils::CharacterEncoding::ConvertToUnicode16(buf);
+    // convert the entire object (it is read in chunks --> it does not have to fit in the cache)
+    this->text                   = GView::Utils::CharacterEncoding::ConvertToUnicode16(obj->GetData());
     this->prettyFormat           = true;
     this->highlightSimilarTokens = true;
+    this->parsing                = false;
+    this->parseCanceled          = false;
 
     this->Parse();
 
     // TestTextEditor();
 }
 
-void Instance::RecomputeTokenPositions()
+void ParsedContent::ComputeLayout()
 {
     this->noItemsVisible = true;
+    this->layoutVersion++; // the layout of the blocks from the previous layout can not be used anymore
     UpdateVisibilityStatus(0, (uint32) this->tokens.size(), true);
-    UpdateTokensWidthAndHeight();
+    UpdateTokensWidthAndHeight(0, (uint32) this->tokens.size());
     if (this->prettyFormat)
         PrettyFormat();
     else
         ComputeOriginalPositions();
+}
+void Instance::RecomputeTokenPositions()
+{
+    ComputeLayout();
+    this->rowIndex.Build(this->tokens);
+    EnsureCurrentItemIsVisible();
+}
+void Instance::RecomputeBlockPositions(uint32 blockID)
+{
+    // the fold status of a block was changed --> only that block is laid out again (if possible)
+    if (!PrettyFormatChangedBlock(blockID))
+    {
+        RecomputeTokenPositions();
+        return;
+    }
+    // the rows before the block did not change
+    this->rowIndex.Update(this->tokens, this->blocks[blockID].tokenStart);
     EnsureCurrentItemIsVisible();
 }
-void Instance::UpdateTokensInformation()
+void ParsedContent::UpdateTokensInformation()
 {
     /*
     Computes:
     - height
     - hashing
+    - the index of tokens with the same hash
     */
+    auto idx = 0U;
     for (auto& tok : this->tokens)
     {
-        tok.UpdateSizes(this->text.text);
-        tok.UpdateHash(this->text.text, this->settings->ignoreCase);
+        const auto content = GetTokenText(idx++);
+        tok.UpdateSizes(content);
+        tok.UpdateHash(content, this->settings->ignoreCase);
+    }
+    ComputeHashIndex();
+}
+void ParsedContent::UpdateTokensInformation(const std::vector<uint32>& indexes)
+{
+    // same as UpdateTokensInformation but only for some tokens (sorted) --> only the lists of the changed hashes are updated
+    std::unordered_map<uint64, std::vector<uint32>> removed, added;
+    for (auto index : indexes)
+    {
+        CHECKRET((size_t) index < this->tokens.size(), "Invalid token index: %u", index);
+        auto& tok          = this->tokens[index];
+        const auto oldHash = tok.hash;
+        const auto content = GetTokenText(index);
+        tok.UpdateSizes(content);
+        tok.UpdateHash(content, this->settings->ignoreCase);
+        if (tok.hash == oldHash)
+            continue;
+        if (oldHash != 0)
+            removed[oldHash].push_back(index);
+        if (tok.hash != 0)
+            added[tok.hash].push_back(index);
     }
+    for (const auto& [hash, list] : removed)
+    {
+        auto it = this->hashTokens.find(hash);
+        if (it == this->hashTokens.end())
+            continue;
+        std::erase_if(it->second, [&list](uint32 index) { return std::binary_search(list.begin(), list.end(), index); });
+        if (it->second.empty())
+            this->hashTokens.erase(it);
+    }
+    for (const auto& [hash, list] : added)
+    {
+        auto& similar     = this->hashTokens[hash];
+        const auto middle = static_cast<std::ptrdiff_t>(similar.size());
+        similar.insert(similar.end(), list.begin(), list.end());
+        std::inplace_merge(similar.begin(), similar.begin() + middle, similar.end());
+    }
+}
+void ParsedContent::ComputeHashIndex()
+{
+    // tokens are added in order --> every list is sorted
+    this->hashTokens.clear();
+    for (auto idx = 0U; idx < static_cast<uint32>(this->tokens.size()); idx++)
+    {
+        if (this->tokens[idx].hash != 0)
+            this->hashTokens[this->tokens[idx].hash].push_back(idx);
+    }
+}
+const std::vector<uint32>& ParsedContent::GetSimilarTokens(uint64 hash) const
+{
+    static const std::vector<uint32> noTokens;
+    const auto it = this->hashTokens.find(hash);
+    if ((hash == 0) || (it == this->hashTokens.end()))
+        return noTokens;
+    return it->second;
+}
+u16string_view ParsedContent::GetTokenText(uint32 index) const
+{
+    const auto& tok = this->tokens[index];
+    if (tok.HasNewValue())
+    {
+        const auto it = this->tokenValues.find(index);
+        if (it != this->tokenValues.end())
+            return it->second.ToStringView();
+    }
+    return tok.GetOriginalText(this->text.text);
+}
+u16string_view ParsedContent::GetTokenError(uint32 index) const
+{
+    const auto it = this->tokenErrors.find(index);
+    if (it == this->tokenErrors.end())
+        return {};
+    return it->second.ToStringView();
+}
+bool ParsedContent::SetTokenValue(uint32 index, const ConstString& value)
+{
+    CHECK((size_t) index < this->tokens.size(), false, "Invalid token index: %u", index);
+    auto& str = this->tokenValues[index];
+    CHECK(str.Set(value), false, "Fail to set the value of token %u", index);
+    // an empty value means that the original text is used
+    this->tokens[index].SetNewValueFlag(str.Len() > 0);
+    if (str.Len() == 0)
+        this->tokenValues.erase(index);
+    return true;
+}
+bool ParsedContent::SetTokenError(uint32 index, const ConstString& error)
+{
+    CHECK((size_t) index < this->tokens.size(), false, "Invalid token index: %u", index);
+    auto& str = this->tokenErrors[index];
+    CHECK(str.Set(error), false, "Fail to set the error of token %u", index);
+    if (str.Len() == 0)
+        this->tokenErrors.erase(index);
+    return true;
+}
+void ParsedContent::ClearTokenError(uint32 index)
+{
+    this->tokenErrors.erase(index);
+}
+void ParsedContent::MarkTokenForDeletion(uint32 index)
+{
+    CHECKRET((size_t) index < this->tokens.size(), "Invalid token index: %u", index);
+    if (this->tokens[index].IsMarkForDeletion())
+        return;
+    this->tokens[index].SetShouldDeleteFlag();
+    this->deletedTokens.push_back(index);
 }
 void Instance::MoveToClosestVisibleToken(uint32 startIndex, bool selected)
 {
@@ -172,7 +301,7 @@ void Instance::MoveToClosestVisibleToken(uint32 startIndex, bool selected)
             MoveToToken(beforeIndex, false, false);
     }
 }
-void Instance::ComputeOriginalPositions()
+void ParsedContent::ComputeOriginalPositions()
 {
     int32 x         = 0;
     int32 y         = 0;
@@ -236,7 +365,7 @@ void Instance::ComputeOriginalPositions()
         }
     }
 }
-void Instance::PrettyFormatIncreaseUntilNewLineXWithValue(uint32 idxStart, uint32 idxEnd, int32 currentLineYOffset, int32 diff)
+void ParsedContent::PrettyFormatIncreaseUntilNewLineXWithValue(uint32 idxStart, uint32 idxEnd, int32 currentLineYOffset, int32 diff)
 {
     auto idx                 = idxStart;
     bool foundSameColumnFlag = false;
@@ -271,7 +400,7 @@ void Instance::PrettyFormatIncreaseUntilNewLineXWithValue(uint32 idxStart, uint3
         tok.pos.x += diffToAdd;
     }
 }
-void Instance::PrettyFormatIncreaseAllXWithValue(uint32 idxStart, uint32 idxEnd, int32 dif)
+void ParsedContent::PrettyFormatIncreaseAllXWithValue(uint32 idxStart, uint32 idxEnd, int32 dif)
 {
     for (auto idx = idxStart; idx < idxEnd; idx++)
     {
@@ -296,7 +425,7 @@ void Instance::PrettyFormatIncreaseAllXWithValue(uint32 idxStart, uint32 idxEnd,
         }
     }
 }
-void Instance::PrettyFormatAlignToSameColumn(uint32 idxStart, uint32 idxEnd, int32 columnXOffset)
+void ParsedContent::PrettyFormatAlignToSameColumn(uint32 idxStart, uint32 idxEnd, int32 columnXOffset)
 {
     auto idx                     = idxStart;
     auto dif                     = 0;
@@ -365,210 +494,260 @@ void Instance::PrettyFormatAlignToSameColumn(uint32 idxStart, uint32 idxEnd, int
         }
     }
 }
-void Instance::PrettyFormatForBlock(uint32 idxStart, uint32 idxEnd, int32 leftMargin, int32 topMargin, PrettyFormatLayoutManager& manager)
+bool ParsedContent::PrettyFormatForBlock(
+      uint32 idxStart, uint32 idxEnd, int32 leftMargin, int32 topMargin, PrettyFormatLayoutManager& manager)
 {
-    auto idx                     = idxStart;
-    auto partOfFoldedBlock       = false;
-    auto indent                  = 0U;
-    auto sameColumnCount         = 0;
-    auto maxXOffsetForSameColumn = 0;
-    auto sameColumnDifferences   = false;
-    auto lastSameColumnLine      = 0;
+    PrettyFormatBlockState state;
+    state.idxStart                = idxStart;
+    state.leftMargin              = leftMargin;
+    state.topMargin               = topMargin;
+    state.indent                  = 0;
+    state.sameColumnCount         = 0;
+    state.maxXOffsetForSameColumn = 0;
+    state.lastSameColumnLine      = 0;
+    state.lastSameColumnToken     = 0xFFFFFFFF;
+    state.partOfFoldedBlock       = false;
+    state.sameColumnDifferences   = false;
 
+    auto idx          = idxStart;
+    auto pendingBlock = BlockObject::INVALID_ID; // a block whose end marker was not laid out yet
     while (idx < idxEnd)
     {
-        auto& tok = this->tokens[idx];
-        if (tok.IsVisible() == false)
+        const auto next = PrettyFormatToken(idx, state, manager);
+        // keep the layout of the block from after its last token (including the end marker)
+        if ((pendingBlock != BlockObject::INVALID_ID) && (next > this->blocks[pendingBlock].tokenEnd))
         {
-            idx++;
-            continue;
+            auto& layout        = this->blockLayouts[pendingBlock];
+            layout.stateAfter   = state;
+            layout.managerAfter = manager;
+            layout.afterIndex   = next;
+            pendingBlock        = BlockObject::INVALID_ID;
         }
-        if (!partOfFoldedBlock)
+        const auto& tok = this->tokens[idx];
+        if ((tok.IsBlockStarter()) && (tok.IsVisible()))
         {
-            // indent flags (before)
-            if ((tok.align & TokenAlignament::IncrementIndentBeforePaint) != TokenAlignament::None)
-                indent++;
-            if (((tok.align & TokenAlignament::DecrementIndentBeforePaint) != TokenAlignament::None) && (indent > 0))
-                indent--;
-            if ((tok.align & TokenAlignament::ClearIndentBeforePaint) != TokenAlignament::None)
-                indent = 0;
-
-            // new line flags
-            if (((tok.align & TokenAlignament::NewLineBefore) != TokenAlignament::None) && (manager.y > topMargin))
+            if (next > this->blocks[tok.blockID].tokenEnd)
             {
-                manager.x              = leftMargin + indent * settings->indentWidth;
-                manager.spaceAdded     = true;
-                manager.firstOnNewLine = true;
-                if (manager.y == manager.lastY)
-                    manager.y += 2;
-                else
-                    manager.y++;
+                auto& layout        = this->blockLayouts[tok.blockID];
+                layout.stateAfter   = state;
+                layout.managerAfter = manager;
+                layout.afterIndex   = next;
             }
-            if (((tok.align & TokenAlignament::StartsOnNewLine) != TokenAlignament::None) && (!manager.firstOnNewLine))
-            {
-                manager.x              = leftMargin + indent * settings->indentWidth;
-                manager.spaceAdded     = true;
-                manager.firstOnNewLine = true;
-                manager.y++;
-            }
-            if ((tok.align & TokenAlignament::AfterPreviousToken) != TokenAlignament::None)
+            else
             {
-                if (manager.y == manager.lastY)
-                {
-                    if ((manager.spaceAdded) && (manager.x > leftMargin))
-                        manager.x--;
-                }
-                else
-                {
-                    if (idx > idxStart)
-                    {
-                        auto& previous = tokens[idx - 1];
-                        manager.y      = previous.pos.y + previous.pos.height - 1;
-                        manager.x      = previous.pos.x + previous.pos.width;
-                    }
-                }
-                manager.spaceAdded = false;
+                pendingBlock = tok.blockID;
             }
-            if (((tok.align & TokenAlignament::AddSpaceBefore) != TokenAlignament::None) && (!manager.spaceAdded))
-                manager.x++;
         }
-
-        // assign position to curent token
-        tok.pos.x               = manager.x;
-        tok.pos.y               = manager.y;
-        manager.firstOnNewLine  = false;
-        const auto blockStarter = tok.IsBlockStarter();
-        const auto folded       = tok.IsFolded();
-        if ((blockStarter) && (folded))
-        {
-            const auto& block = this->blocks[tok.blockID];
-            if (block.foldMessage.empty())
-                manager.x += tok.pos.width + 3; // for ...
+        idx = next;
+    }
+    if (pendingBlock != BlockObject::INVALID_ID)
+    {
+        auto& layout        = this->blockLayouts[pendingBlock];
+        layout.stateAfter   = state;
+        layout.managerAfter = manager;
+        layout.afterIndex   = idx;
+    }
+    // recompute same column only if differences were found
+    if (state.sameColumnDifferences)
+    {
+        PrettyFormatAlignToSameColumn(idxStart, idxEnd, state.maxXOffsetForSameColumn);
+    }
+    return state.sameColumnDifferences;
+}
+uint32 ParsedContent::PrettyFormatToken(uint32 idx, PrettyFormatBlockState& state, PrettyFormatLayoutManager& manager)
+{
+    // lays out the token (and the block that starts with it) --> returns the index of the next token from the same block
+    auto& tok = this->tokens[idx];
+    if (tok.IsVisible() == false)
+        return idx + 1;
+    if (tok.IsBlockStarter())
+    {
+        auto& layout          = this->blockLayouts[tok.blockID];
+        layout.stateBefore    = state;
+        layout.managerBefore  = manager;
+        layout.version        = this->layoutVersion;
+        layout.alignedContent = false;
+    }
+    const auto leftMargin = state.leftMargin;
+    if (!state.partOfFoldedBlock)
+    {
+        // indent flags (before)
+        if ((tok.align & TokenAlignament::IncrementIndentBeforePaint) != TokenAlignament::None)
+            state.indent++;
+        if (((tok.align & TokenAlignament::DecrementIndentBeforePaint) != TokenAlignament::None) && (state.indent > 0))
+            state.indent--;
+        if ((tok.align & TokenAlignament::ClearIndentBeforePaint) != TokenAlignament::None)
+            state.indent = 0;
+
+        // new line flags
+        if (((tok.align & TokenAlignament::NewLineBefore) != TokenAlignament::None) && (manager.y > state.topMargin))
+        {
+            manager.x              = leftMargin + state.indent * settings->indentWidth;
+            manager.spaceAdded     = true;
+            manager.firstOnNewLine = true;
+            if (manager.y == manager.lastY)
+                manager.y += 2;
             else
-                manager.x += tok.pos.width + (int32) block.foldMessage.size();
-            partOfFoldedBlock = block.HasEndMarker(); // only limit the alignament for end marker
+                manager.y++;
         }
-        else
+        if (((tok.align & TokenAlignament::StartsOnNewLine) != TokenAlignament::None) && (!manager.firstOnNewLine))
         {
-            manager.x += tok.pos.width;
-            manager.y += tok.pos.height - 1;
-            partOfFoldedBlock = false;
+            manager.x              = leftMargin + state.indent * settings->indentWidth;
+            manager.spaceAdded     = true;
+            manager.firstOnNewLine = true;
+            manager.y++;
         }
-        manager.lastY      = manager.y;
-        manager.spaceAdded = false;
-        if (!partOfFoldedBlock)
+        if ((tok.align & TokenAlignament::AfterPreviousToken) != TokenAlignament::None)
         {
-            // Same column logic
-            if ((tok.align & TokenAlignament::SameColumn) != TokenAlignament::None)
-            {
-                sameColumnCount++;
-                if (sameColumnCount == 1)
-                {
-                    // first one
-                    maxXOffsetForSameColumn = tok.pos.x;
-                    lastSameColumnLine      = tok.pos.y;
-                }
-                else
-                {
-                    if (tok.pos.y != lastSameColumnLine)
-                    {
-                        // a new item on a differnt line
-                        maxXOffsetForSameColumn = std::max<>(maxXOffsetForSameColumn, tok.pos.x);
-                        sameColumnDifferences   = true;      // set the marker
-                        lastSameColumnLine      = tok.pos.y; // update last line
-                    }
-                }
-            }
-            // indent
-            if ((tok.align & TokenAlignament::IncrementIndentAfterPaint) != TokenAlignament::None)
-                indent++;
-            if (((tok.align & TokenAlignament::DecrementIndentAfterPaint) != TokenAlignament::None) && (indent > 0))
-                indent--;
-            if ((tok.align & TokenAlignament::ClearIndentAfterPaint) != TokenAlignament::None)
-                indent = 0;
-
-            if ((tok.align & TokenAlignament::AddSpaceAfter) != TokenAlignament::None)
-            {
-                manager.x++;
-                manager.spaceAdded = true;
-            }
-            if ((tok.align & TokenAlignament::NewLineAfter) != TokenAlignament::None)
+            if (manager.y == manager.lastY)
             {
-                manager.x              = leftMargin + indent * settings->indentWidth;
-                manager.spaceAdded     = true;
-                manager.firstOnNewLine = true;
-                manager.y++;
+                if ((manager.spaceAdded) && (manager.x > leftMargin))
+                    manager.x--;
             }
-            if (((tok.align & TokenAlignament::WrapToNextLine) != TokenAlignament::None) && (manager.x > (int) this->settings->maxWidth))
+            else
             {
-                manager.x              = leftMargin + indent * settings->indentWidth;
-                manager.spaceAdded     = true;
-                manager.firstOnNewLine = true;
-                manager.y++;
+                // the position of a hidden token is not computed
+                if ((idx > state.idxStart) && (this->tokens[idx - 1].IsVisible()))
+                {
+                    auto& previous = tokens[idx - 1];
+                    manager.y      = previous.pos.y + previous.pos.height - 1;
+                    manager.x      = previous.pos.x + previous.pos.width;
+                }
             }
+            manager.spaceAdded = false;
         }
-        if (tok.IsBlockStarter())
+        if (((tok.align & TokenAlignament::AddSpaceBefore) != TokenAlignament::None) && (!manager.spaceAdded))
+            manager.x++;
+    }
+
+    // assign position to curent token
+    tok.pos.x               = manager.x;
+    tok.pos.y               = manager.y;
+    manager.firstOnNewLine  = false;
+    const auto blockStarter = tok.IsBlockStarter();
+    const auto folded       = tok.IsFolded();
+    if ((blockStarter) && (folded))
+    {
+        const auto& block = this->blocks[tok.blockID];
+        if (block.foldMessage.empty())
+            manager.x += tok.pos.width + 3; // for ...
+        else
+            manager.x += tok.pos.width + (int32) block.foldMessage.size();
+        state.partOfFoldedBlock = block.HasEndMarker(); // only limit the alignament for end marker
+    }
+    else
+    {
+        manager.x += tok.pos.width;
+        manager.y += tok.pos.height - 1;
+        state.partOfFoldedBlock = false;
+    }
+    manager.lastY      = manager.y;
+    manager.spaceAdded = false;
+    if (!state.partOfFoldedBlock)
+    {
+        // Same column logic
+        if ((tok.align & TokenAlignament::SameColumn) != TokenAlignament::None)
         {
-            auto& block           = this->blocks[tok.blockID];
-            auto endToken         = block.HasEndMarker() ? block.tokenEnd : block.tokenEnd + 1;
-            int32 blockMarginTop  = 0;
-            int32 blockMarginLeft = 0;
-            switch (block.align)
+            state.sameColumnCount++;
+            if (state.sameColumnCount == 1)
             {
-            case BlockAlignament::ParentBlock:
-                blockMarginTop            = manager.y;
-                blockMarginLeft           = leftMargin;
-                block.leftHighlightMargin = leftMargin;
-                break;
-            case BlockAlignament::ParentBlockWithIndent:
-                blockMarginTop            = manager.y;
-                blockMarginLeft           = leftMargin + (indent + 1) * settings->indentWidth;
-                block.leftHighlightMargin = leftMargin + indent * settings->indentWidth;
-                break;
-            case BlockAlignament::CurrentToken:
-                blockMarginTop            = manager.y;
-                blockMarginLeft           = manager.x;
-                block.leftHighlightMargin = manager.x;
-                break;
-            case BlockAlignament::CurrentTokenWithIndent:
-                blockMarginTop            = manager.y;
-                blockMarginLeft           = manager.x + settings->indentWidth;
-                block.leftHighlightMargin = manager.x;
-                break;
-            default:
-                blockMarginTop            = manager.y;
-                blockMarginLeft           = manager.x;
-                block.leftHighlightMargin = 0;
-                break;
+                // first one
+                state.maxXOffsetForSameColumn = tok.pos.x;
+                state.lastSameColumnLine      = tok.pos.y;
+                state.lastSameColumnToken     = idx;
             }
-            if (((idx + 1) < endToken) && (tok.IsFolded() == false))
+            else
             {
-                // not an empty block and not folded
-                if (manager.firstOnNewLine)
+                if (tok.pos.y != state.lastSameColumnLine)
                 {
-                    // of the new token has already been moved to the next like, make sure that the "x" offset is alligned to the new block
-                    // position
-                    manager.x = blockMarginLeft;
+                    // a new item on a differnt line
+                    state.maxXOffsetForSameColumn = std::max<>(state.maxXOffsetForSameColumn, tok.pos.x);
+                    state.sameColumnDifferences   = true;      // set the marker
+                    state.lastSameColumnLine      = tok.pos.y; // update last line
+                    state.lastSameColumnToken     = idx;
                 }
-                manager.y = blockMarginTop;
-                PrettyFormatForBlock(idx + 1, endToken, blockMarginLeft, blockMarginTop, manager);
-                if (manager.x == blockMarginLeft)
-                    manager.x = leftMargin + indent * settings->indentWidth;
             }
-            idx = endToken;
         }
-        else
+        // indent
+        if ((tok.align & TokenAlignament::IncrementIndentAfterPaint) != TokenAlignament::None)
+            state.indent++;
+        if (((tok.align & TokenAlignament::DecrementIndentAfterPaint) != TokenAlignament::None) && (state.indent > 0))
+            state.indent--;
+        if ((tok.align & TokenAlignament::ClearIndentAfterPaint) != TokenAlignament::None)
+            state.indent = 0;
+
+        if ((tok.align & TokenAlignament::AddSpaceAfter) != TokenAlignament::None)
+        {
+            manager.x++;
+            manager.spaceAdded = true;
+        }
+        if ((tok.align & TokenAlignament::NewLineAfter) != TokenAlignament::None)
+        {
+            manager.x              = leftMargin + state.indent * settings->indentWidth;
+            manager.spaceAdded     = true;
+            manager.firstOnNewLine = true;
+            manager.y++;
+        }
+        if (((tok.align & TokenAlignament::WrapToNextLine) != TokenAlignament::None) && (manager.x > (int) this->settings->maxWidth))
         {
-            idx++; // next token
+            manager.x              = leftMargin + state.indent * settings->indentWidth;
+            manager.spaceAdded     = true;
+            manager.firstOnNewLine = true;
+            manager.y++;
         }
     }
-    // recompute same column only if differences were found
-    if (sameColumnDifferences)
+    if (!blockStarter)
+        return idx + 1; // next token
+
+    auto& block           = this->blocks[tok.blockID];
+    auto endToken         = block.HasEndMarker() ? block.tokenEnd : block.tokenEnd + 1;
+    int32 blockMarginTop  = 0;
+    int32 blockMarginLeft = 0;
+    switch (block.align)
     {
-        PrettyFormatAlignToSameColumn(idxStart, idxEnd, maxXOffsetForSameColumn);
+    case BlockAlignament::ParentBlock:
+        blockMarginTop            = manager.y;
+        blockMarginLeft           = leftMargin;
+        block.leftHighlightMargin = leftMargin;
+        break;
+    case BlockAlignament::ParentBlockWithIndent:
+        blockMarginTop            = manager.y;
+        blockMarginLeft           = leftMargin + (state.indent + 1) * settings->indentWidth;
+        block.leftHighlightMargin = leftMargin + state.indent * settings->indentWidth;
+        break;
+    case BlockAlignament::CurrentToken:
+        blockMarginTop            = manager.y;
+        blockMarginLeft           = manager.x;
+        block.leftHighlightMargin = manager.x;
+        break;
+    case BlockAlignament::CurrentTokenWithIndent:
+        blockMarginTop            = manager.y;
+        blockMarginLeft           = manager.x + settings->indentWidth;
+        block.leftHighlightMargin = manager.x;
+        break;
+    default:
+        blockMarginTop            = manager.y;
+        blockMarginLeft           = manager.x;
+        block.leftHighlightMargin = 0;
+        break;
     }
+    if (((idx + 1) < endToken) && (tok.IsFolded() == false))
+    {
+        // not an empty block and not folded
+        if (manager.firstOnNewLine)
+        {
+            // of the new token has already been moved to the next like, make sure that the "x" offset is alligned to the new block
+            // position
+            manager.x = blockMarginLeft;
+        }
+        manager.y = blockMarginTop;
+        this->blockLayouts[tok.blockID].alignedContent = PrettyFormatForBlock(idx + 1, endToken, blockMarginLeft, blockMarginTop, manager);
+        if (manager.x == blockMarginLeft)
+            manager.x = leftMargin + state.indent * settings->indentWidth;
+    }
+    return endToken;
 }
-void Instance::PrettyFormat()
+void ParsedContent::PrettyFormat()
 {
     PrettyFormatLayoutManager manager;
     manager.x              = 0;
@@ -576,9 +755,152 @@ void Instance::PrettyFormat()
     manager.lastY          = 0;
     manager.firstOnNewLine = true;
     manager.spaceAdded     = true;
-    PrettyFormatForBlock(0, (uint32) this->tokens.size(), 0, 0, manager);
+    this->blockLayouts.resize(this->blocks.size());
+    this->layoutAligned = PrettyFormatForBlock(0, (uint32) this->tokens.size(), 0, 0, manager);
+}
+bool ParsedContent::PrettyFormatChangedBlock(uint32 blockID)
+{
+    /*
+    The fold status (or the tokens) of a block was changed --> the block is laid out again (starting from the layout of the block that
+    contains it) and the tokens after it are moved with the number of rows that were added or removed. This is possible if:
+    - the layout after the block is the same as before (except for the rows)
+    - the blocks that contain it were not aligned to the same column (the alignament depends on all their tokens)
+    Returns false if all tokens have to be laid out again.
+    */
+    if ((!this->prettyFormat) || (this->layoutAligned) || ((size_t) blockID >= this->blockLayouts.size()) ||
+        ((size_t) blockID >= this->blockParents.size()) || (this->blocksByStart.size() != this->blocks.size()))
+        return false;
+    const auto& block   = this->blocks[blockID];
+    const auto& starter = this->tokens[block.tokenStart];
+    auto& layout        = this->blockLayouts[blockID];
+    if ((layout.version != this->layoutVersion) || (!starter.IsVisible()))
+        return false;
+    for (auto parent = this->blockParents[blockID]; parent != BlockObject::INVALID_ID; parent = this->blockParents[parent])
+    {
+        if ((this->blockLayouts[parent].version != this->layoutVersion) || (this->blockLayouts[parent].alignedContent))
+            return false;
+    }
+
+    const auto oldLayout  = layout;
+    const auto afterIndex = oldLayout.afterIndex;
+    const auto endToken   = block.HasEndMarker() ? block.tokenEnd : block.tokenEnd + 1;
+    const auto count      = static_cast<uint32>(this->tokens.size());
+
+    // the last token of the block (the next token might be placed right after it)
+    const auto lastToken        = this->tokens[afterIndex - 1].pos;
+    const auto lastTokenVisible = this->tokens[afterIndex - 1].IsVisible();
+    const auto afterLastToken   = (afterIndex < count) && (this->tokens[afterIndex].IsVisible()) &&
+                                  ((this->tokens[afterIndex].align & TokenAlignament::AfterPreviousToken) != TokenAlignament::None);
+
+    // the blocks from this block are laid out again (the layout of the ones that remain hidden can not be used anymore)
+    for (auto idx = block.tokenStart + 1; idx < endToken; idx++)
+    {
+        if (this->tokens[idx].IsBlockStarter())
+            this->blockLayouts[this->tokens[idx].blockID].version = 0;
+    }
+    UpdateVisibilityStatus(block.tokenStart + 1, endToken, !starter.IsFolded());
+    UpdateTokensWidthAndHeight(block.tokenStart + 1, endToken);
+
+    // aligning the tokens from the block to the same column might also move the ones from the first row after the block
+    // (those are laid out again after the block when all tokens are laid out --> their positions are restored)
+    std::vector<std::pair<uint32, TokenPosition>> firstRow;
+    for (auto idx = afterIndex; idx < count; idx++)
+    {
+        const auto& tok = this->tokens[idx];
+        if (tok.IsVisible() == false)
+            continue;
+        if ((!firstRow.empty()) && (tok.pos.y != firstRow.front().second.y))
+            break;
+        firstRow.emplace_back(idx, tok.pos);
+    }
+
+    auto state   = oldLayout.stateBefore;
+    auto manager = oldLayout.managerBefore;
+    auto idx     = PrettyFormatToken(block.tokenStart, state, manager);
+    if (idx <= block.tokenEnd)
+    {
+        // the end marker is laid out by the block that contains this block
+        if (this->tokens[idx].IsBlockStarter())
+            return false;
+        idx = PrettyFormatToken(idx, state, manager);
+    }
+    for (const auto& [index, pos] : firstRow)
+        this->tokens[index].pos = pos;
+    if (idx != afterIndex)
+        return false;
+
+    // the tokens after the block are laid out in the same way only if the layout after the block is the same
+    // (if the end marker was aligned to the same column, the last row with such a token was moved as well)
+    const auto& oldState      = oldLayout.stateAfter;
+    const auto& oldManager    = oldLayout.managerAfter;
+    const auto dy             = manager.y - oldManager.y;
+    const auto sameColumnDiff = ((oldState.sameColumnCount > 0) && (oldState.lastSameColumnToken > block.tokenStart)) ? dy : 0;
+    if ((manager.x != oldManager.x) || (manager.lastY != oldManager.lastY + dy) || (manager.firstOnNewLine != oldManager.firstOnNewLine) ||
+        (manager.spaceAdded != oldManager.spaceAdded))
+        return false;
+    const auto& newLastToken = this->tokens[afterIndex - 1].pos;
+    if ((afterLastToken) && ((this->tokens[afterIndex - 1].IsVisible() != lastTokenVisible) ||
+                             (newLastToken.x + newLastToken.width != lastToken.x + lastToken.width) ||
+                             (newLastToken.y + newLastToken.height != lastToken.y + lastToken.height + dy)))
+        return false;
+    if ((state.indent != oldState.indent) || (state.partOfFoldedBlock != oldState.partOfFoldedBlock) ||
+        (state.sameColumnCount != oldState.sameColumnCount) || (state.maxXOffsetForSameColumn != oldState.maxXOffsetForSameColumn) ||
+        (state.sameColumnDifferences != oldState.sameColumnDifferences) || (state.lastSameColumnToken != oldState.lastSameColumnToken) ||
+        (state.lastSameColumnLine != oldState.lastSameColumnLine + sameColumnDiff))
+        return false;
+    if (dy != 0)
+    {
+        // rows before the block are compared with the rows after it (the result must be the same after they are moved)
+        if ((manager.y > state.topMargin) != (oldManager.y > state.topMargin))
+            return false;
+        if ((state.sameColumnCount > 0) && (sameColumnDiff == 0) &&
+            (state.lastSameColumnLine >= std::min<>(std::min<>(manager.y, manager.lastY), std::min<>(oldManager.y, oldManager.lastY))))
+            return false;
+    }
+    layout.stateAfter   = state;
+    layout.managerAfter = manager;
+    if (dy == 0)
+        return true;
+
+    // everything after the block is moved (including the layout of the blocks after it)
+    for (idx = afterIndex; idx < count; idx++)
+        this->tokens[idx].pos.y += dy;
+    auto moveRows = [&](PrettyFormatBlockState& s, PrettyFormatLayoutManager& m, bool topMarginMoved)
+    {
+        m.y += dy;
+        m.lastY += dy;
+        if (topMarginMoved)
+            s.topMargin += dy;
+        if ((s.sameColumnCount > 0) && (s.lastSameColumnToken > block.tokenStart))
+            s.lastSameColumnLine += dy;
+    };
+    auto moveBlock = [&](uint32 id)
+    {
+        auto& l           = this->blockLayouts[id];
+        const auto& b     = this->blocks[id];
+        const auto parent = this->blockParents[id];
+        if (l.version != this->layoutVersion)
+            return;
+        // the top margin belongs to the block that contains the block
+        const auto topMarginMoved = (parent != BlockObject::INVALID_ID) && (this->blocks[parent].tokenStart >= afterIndex);
+        if (b.tokenStart >= afterIndex)
+            moveRows(l.stateBefore, l.managerBefore, topMarginMoved);
+        if (l.afterIndex >= afterIndex)
+            moveRows(l.stateAfter, l.managerAfter, topMarginMoved);
+    };
+    // only the blocks that contain the block end after it (the other ones that start before it also end before it)
+    for (auto parent = this->blockParents[blockID]; parent != BlockObject::INVALID_ID; parent = this->blockParents[parent])
+        moveBlock(parent);
+    auto next = std::lower_bound(
+          this->blocksByStart.begin(),
+          this->blocksByStart.end(),
+          afterIndex,
+          [this](uint32 id, uint32 index) { return this->blocks[id].tokenStart < index; });
+    for (; next != this->blocksByStart.end(); next++)
+        moveBlock(*next);
+    return true;
 }
-void Instance::UpdateVisibilityStatus(uint32 start, uint32 end, bool visible)
+void ParsedContent::UpdateVisibilityStatus(uint32 start, uint32 end, bool visible)
 {
     auto pos = start;
     while (pos < end)
@@ -609,10 +931,11 @@ void Instance::UpdateVisibilityStatus(uint32 start, uint32 end, bool visible)
         }
     }
 }
-void Instance::UpdateTokensWidthAndHeight()
+void ParsedContent::UpdateTokensWidthAndHeight(uint32 start, uint32 end)
 {
-    for (auto& tok : this->tokens)
+    for (; start < end; start++)
     {
+        auto& tok = this->tokens[start];
         if (tok.IsVisible() == false)
             continue;
         if (tok.IsSizeable())
@@ -632,42 +955,22 @@ void Instance::UpdateTokensWidthAndHeight()
 }
 uint32 Instance::TokenToBlock(uint32 tokenIndex)
 {
-    if ((size_t) tokenIndex >= tokens.size())
+    if ((size_t) tokenIndex >= this->tokenBlocks.size())
         return BlockObject::INVALID_ID;
-    const auto blocksCount = static_cast<uint32>(blocks.size());
-    auto pos               = tokenIndex;
-    while (pos > 0)
-    {
-        const auto& tok = this->tokens[pos];
-        if ((tok.IsBlockStarter()) && (tok.blockID < blocksCount))
-        {
-            const auto& block = this->blocks[tok.blockID];
-            if (tokenIndex < block.GetEndIndex())
-                return tok.blockID;
-        }
-        pos--;
-    }
-    const auto& tok = this->tokens[0];
-    if ((tok.IsBlockStarter()) && (tok.blockID < blocksCount))
-    {
-        const auto& block = this->blocks[tok.blockID];
-        if (tokenIndex < block.GetEndIndex())
-            return tok.blockID;
-    }
-    // finally --> check the first position
-    return BlockObject::INVALID_ID;
+    return this->tokenBlocks[tokenIndex];
+}
+uint32 Instance::GetParentBlock(uint32 blockID)
+{
+    if ((size_t) blockID >= this->blockParents.size())
+        return BlockObject::INVALID_ID;
+    return this->blockParents[blockID];
 }
 uint32 Instance::CountSimilarTokens(uint32 start, uint32 end, uint64 hash)
 {
-    if ((size_t) end > this->tokens.size())
+    if (((size_t) end > this->tokens.size()) || (start >= end))
         return 0;
-    uint32 count = 0;
-    for (; start < end; start++)
-    {
-        if (tokens[start].hash == hash)
-            count++;
-    }
-    return count;
+    const auto& list = GetSimilarTokens(hash);
+    return static_cast<uint32>(std::lower_bound(list.begin(), list.end(), end) - std::lower_bound(list.begin(), list.end(), start));
 }
 
 void Instance::MakeTokenVisible(uint32 index)
@@ -678,12 +981,12 @@ void Instance::MakeTokenVisible(uint32 index)
     auto blockID = BlockObject::INVALID_ID;
     if (tok.IsBlockStarter())
     {
-        tok.SetFolded(false);
+        // the content of a block that was not analyzed yet remains hidden
+        if (!this->blocks[tok.blockID].HasDeferredContent())
+            tok.SetFolded(false);
         tok.SetVisible(true);
-        if (index == 0)
-            return;
-        // find the block that contains the current block (start with the precedent token)
-        blockID = TokenToBlock(index - 1);
+        // find the block that contains the current block
+        blockID = GetParentBlock(tok.blockID);
     }
     else
     {
@@ -721,64 +1024,173 @@ void Instance::EnsureCurrentItemIsVisible()
 }
 void Instance::Parse()
 {
+    this->parseTask.Stop();
     this->Scroll.x          = 0;
     this->Scroll.y          = 0;
     this->currentTokenIndex = 0;
     this->lineNrWidth       = 0;
-    this->lastLineNumber    = 0;
     this->currentHash       = 0;
-    this->noItemsVisible    = true;
-    this->showMetaData      = true; // has to be true at this point to proper compute line numbers
+    this->parsing           = false;
+    this->parseCanceled     = false;
 
-    this->tokens.clear();
-    this->blocks.clear();
+    Clear();
     this->selection.Clear();
+    this->rowIndex.Clear();
+    this->plainTextLines.clear();
 
     if (this->settings->parser)
     {
-        // step 1 (run the preprocessor)
-        TextEditorBuilder ted(this->text);
-        this->settings->parser->PreprocessText(ted);
-        this->text = ted.Release();
-
-        // step 2 (run the analyzer)
-        TokensListBuilder tokensList(this);
-        BlocksListBuilder blockList(this);
-        TextParser textParser(this->text.text, this->text.size);
-        SyntaxManager syntax(textParser, tokensList, blockList);
-        this->settings->parser->AnalyzeText(syntax);
-        UpdateTokensInformation();
-        RecomputeTokenPositions();
-        MoveToClosestVisibleToken(0, false);
-
-        // step 3 (recompute line numbers)
-        // the list of tokens and blocks has been cleared so we know for sure that everything is expanded
-        auto lastY  = -1;
-        auto lineNo = 0;
-        for (auto& tok : this->tokens)
+        // the text is shown as it is (plain text) until the worker finishes
+        this->plainTextLines.push_back(0);
+        for (uint32 idx = 0; idx < this->text.size; idx++)
         {
-            if (tok.pos.y != lastY)
+            const auto ch = this->text.text[idx];
+            if ((ch == '\n') || (ch == '\r'))
             {
-                lineNo++;
-                lastY = tok.pos.y;
+                if ((idx + 1 < this->text.size) && ((this->text.text[idx + 1] == '\n') || (this->text.text[idx + 1] == '\r')) &&
+                    (this->text.text[idx + 1] != ch))
+                    idx++; // CRLF or LFCR
+                this->plainTextLines.push_back(idx + 1);
             }
-            tok.lineNo = lineNo;
-        }
-        // at the end --> lineNo is the highest line number
-        this->lineNrWidth    = 0;
-        this->lastLineNumber = lineNo;
-
-        if (lastLineNumber < 100)
-            this->lineNrWidth = 4;
-        else if (lastLineNumber < 1000)
-            this->lineNrWidth = 5;
-        else if (lastLineNumber < 10000)
-            this->lineNrWidth = 6;
-        else if (lastLineNumber < 100000)
-            this->lineNrWidth = 7;
-        else
-            this->lineNrWidth = 8;
+        }
+        this->parsing = this->parseTask.Start(this->text, this->settings, this->prettyFormat);
+        if (!this->parsing)
+            AppCUI::Dialogs::MessageBox::ShowError("Error", "Fail to start parsing the text !");
+    }
+}
+void Instance::ApplyParseResult()
+{
+    auto result = this->parseTask.TakeResult();
+    if (!result)
+    {
+        this->parseCanceled = true;
+        return;
+    }
+    // the first line shown as plain text remains the first one shown (from the token that contains its start)
+    const auto topLine   = static_cast<size_t>(std::max<>(0, this->Scroll.y));
+    const auto topOffset = topLine < this->plainTextLines.size() ? this->plainTextLines[topLine] : 0U;
+
+    // the text shown until now is replaced by the parsed one (with its tokens, blocks and layout)
+    Swap(*result);
+    result.reset();
+    this->parsing = false;
+    this->plainTextLines.clear();
+    this->plainTextLines.shrink_to_fit();
+    this->Scroll.x = 0;
+    this->Scroll.y = 0;
+
+    this->rowIndex.Build(this->tokens);
+    const auto topToken = std::partition_point(
+          this->tokens.begin(), this->tokens.end(), [topOffset](const TokenObject& tok) { return tok.end <= topOffset; });
+    const auto topIndex = static_cast<uint32>(topToken - this->tokens.begin());
+    MoveToClosestVisibleToken(topIndex < this->tokens.size() ? topIndex : static_cast<uint32>(this->tokens.size()) - 1, false);
+    if (this->currentTokenIndex < this->tokens.size())
+        this->Scroll.y = this->tokens[this->currentTokenIndex].pos.y;
+    EnsureCurrentItemIsVisible();
+    UpdateLineNumberWidth();
+}
+void Instance::UpdateLineNumberWidth()
+{
+    if (lastLineNumber < 100)
+        this->lineNrWidth = 4;
+    else if (lastLineNumber < 1000)
+        this->lineNrWidth = 5;
+    else if (lastLineNumber < 10000)
+        this->lineNrWidth = 6;
+    else if (lastLineNumber < 100000)
+        this->lineNrWidth = 7;
+    else
+        this->lineNrWidth = 8;
+}
+void Instance::PaintPlainText(Graphics::Renderer& renderer)
+{
+    // shown while the text is parsed on a worker thread
+    const auto col     = Cfg.Text.Normal;
+    const auto height  = static_cast<uint32>(std::max<int32>(0, this->GetHeight()));
+    const auto width   = static_cast<uint32>(std::max<int32>(0, this->GetWidth()));
+    const auto scrollX = static_cast<uint32>(this->Scroll.x);
+    const auto count   = static_cast<uint32>(this->plainTextLines.size());
+
+    for (uint32 y = 0; y < height; y++)
+    {
+        const auto lineIndex = static_cast<uint32>(this->Scroll.y) + y;
+        if (lineIndex >= count)
+            break;
+        const auto start = this->plainTextLines[lineIndex];
+        auto end         = lineIndex + 1 < count ? this->plainTextLines[lineIndex + 1] : this->text.size;
+        while ((end > start) && ((this->text.text[end - 1] == '\n') || (this->text.text[end - 1] == '\r')))
+            end--;
+        if (end - start <= scrollX)
+            continue;
+        const auto sz = std::min<uint32>(end - start - scrollX, width);
+        renderer.WriteSingleLineText(0, y, u16string_view{ this->text.text + start + scrollX, sz }, col);
     }
+
+    LocalString<64> tmp;
+    if (this->parseCanceled)
+        tmp.Set(" Parsing was canceled ");
+    else
+    {
+        switch (this->parseTask.GetStage())
+        {
+        case ParseStage::Preprocess:
+            tmp.Set(" Parsing (preprocessing) ... ");
+            break;
+        case ParseStage::Analyze:
+            tmp.Set(" Parsing (analyzing) ... ");
+            break;
+        default:
+            tmp.Set(" Parsing (computing layout) ... ");
+            break;
+        }
+    }
+    renderer.WriteSingleLineText(std::max<int32>(0, (int32) this->GetWidth() - (int32) tmp.Len()), 0, tmp, Cfg.Text.Highlighted);
+}
+bool Instance::OnPlainTextKeyEvent(AppCUI::Input::Key keyCode)
+{
+    const auto lastLine = static_cast<int32>(this->plainTextLines.empty() ? 0 : this->plainTextLines.size() - 1);
+    switch (keyCode)
+    {
+    case Key::Up:
+    case Key::Up | Key::Ctrl:
+        this->Scroll.y--;
+        break;
+    case Key::Down:
+    case Key::Down | Key::Ctrl:
+        this->Scroll.y++;
+        break;
+    case Key::PageUp:
+        this->Scroll.y -= this->GetHeight();
+        break;
+    case Key::PageDown:
+        this->Scroll.y += this->GetHeight();
+        break;
+    case Key::Left:
+        this->Scroll.x = std::max<>(0, this->Scroll.x - 1);
+        return true;
+    case Key::Right:
+        this->Scroll.x++;
+        return true;
+    case Key::Home:
+        this->Scroll.x = 0;
+        return true;
+    case Key::Ctrl | Key::Home:
+        this->Scroll.y = 0;
+        break;
+    case Key::Ctrl | Key::End:
+        this->Scroll.y = lastLine;
+        break;
+    case Key::Escape:
+        if ((!this->parseTask.IsRunning()) || (this->parseCanceled))
+            return false;
+        this->parseTask.Cancel();
+        this->parseCanceled = true;
+        return true;
+    default:
+        return false;
+    }
+    this->Scroll.y = std::max<>(0, std::min<>(this->Scroll.y, lastLine));
+    return true;
 }
 void Instance::Reparse(bool openInNewWindow)
 {
@@ -788,35 +1200,64 @@ void Instance::Reparse(bool openInNewWindow)
     }
     else
     {
-        TextEditorBuilder ted(this->text);
-        auto res   = RebuildTextFromTokens(ted);
-        this->text = ted.Release();
-        if (!res)
+        UnicodeString newText;
+        std::vector<TextEdit> edits;
+        if (!RebuildTextFromTokens(newText, edits))
         {
-            this->noItemsVisible = true; // hide all text
             AppCUI::Dialogs::MessageBox::ShowError("Error", "Fail to reparse current text !");
+            return;
         }
+        // only the modified parts are parsed again (if not possible --> the entire text is parsed on the worker thread)
+        if (ReparseEdits(newText, edits))
+            return;
+        this->text.Destroy();
+        this->text = newText;
         this->Parse();
     }
 }
-bool Instance::RebuildTextFromTokens(TextEditor& editor)
+bool ParsedContent::RebuildTextFromTokens(UnicodeString& newText, std::vector<TextEdit>& edits)
 {
-    auto it  = this->tokens.crbegin();
-    auto end = this->tokens.crend();
-    for (; it != end; it++)
+    // deleted tokens are removed and the ones with a new value are replaced (consecutive modified tokens form one edit)
+    auto size = static_cast<size_t>(this->text.size);
+    for (const auto& [index, value] : this->tokenValues)
+        size += value.Len();
+    CHECK(size < 0xFFFFFFFF, false, "New text is too large (%llu characters)", (uint64) size);
+
+    // only the modified tokens are visited (the text between them is copied as it is)
+    std::vector<uint32> modified = this->deletedTokens;
+    for (const auto& [index, value] : this->tokenValues)
     {
-        if (it->IsMarkForDeletion())
+        if (((size_t) index < this->tokens.size()) && (this->tokens[index].HasNewValue()))
+            modified.push_back(index);
+    }
+    std::sort(modified.begin(), modified.end());
+    modified.erase(std::unique(modified.begin(), modified.end()), modified.end());
+
+    newText           = UnicodeString(new char16[size + 1], 0, static_cast<uint32>(size + 1));
+    auto pos          = 0U;
+    auto lastModified = static_cast<uint32>(this->tokens.size());
+    edits.clear();
+    for (auto idx : modified)
+    {
+        const auto& tok = this->tokens[idx];
+        const auto gap = tok.start - pos;
+        memcpy(newText.text + newText.size, this->text.text + pos, gap * sizeof(char16));
+        if ((edits.empty()) || (lastModified + 1 != idx))
+            edits.push_back({ tok.start, tok.end, newText.size + gap, 0 });
+        newText.size += gap;
+        if (!tok.IsMarkForDeletion())
         {
-            editor.Delete(it->start, it->end - it->start);
-            continue;
-        }
-        if (it->value.Len() > 0)
-        {
-            if (!editor.Replace(it->start, it->end - it->start, it->value.ToStringView()))
-                return false;
-            continue;
+            const auto value = GetTokenText(idx);
+            memcpy(newText.text + newText.size, value.data(), value.size() * sizeof(char16));
+            newText.size += static_cast<uint32>(value.size());
         }
+        pos                 = tok.end;
+        lastModified        = idx;
+        edits.back().oldEnd = tok.end;
+        edits.back().newEnd = newText.size;
     }
+    memcpy(newText.text + newText.size, this->text.text + pos, (this->text.size - pos) * sizeof(char16));
+    newText.size += this->text.size - pos;
     return true;
 }
 void Instance::BakupTokensPositions()
@@ -839,6 +1280,8 @@ void Instance::RestoreTokensPositionsFromBackup()
         tok.pos = this->backupedTokenPositionList[index];
         index++;
     }
+    this->rowIndex.Build(this->tokens);
+    this->layoutVersion++; // the layout of the blocks is not the one from the restored positions
     backupedTokenPositionList.clear();
 }
 
@@ -881,7 +1324,7 @@ void Instance::FillBlockSpace(Graphics::Renderer& renderer, const BlockObject& b
 
 void Instance::PaintToken(Graphics::Renderer& renderer, const TokenObject& tok, uint32 index)
 {
-    u16string_view txt = tok.GetText(this->text.text);
+    u16string_view txt = GetTokenText(index);
     ColorPair col;
     bool onCursor    = index == this->currentTokenIndex;
     bool onSelection = this->selection.Contains(index);
@@ -989,8 +1432,27 @@ void Instance::PaintToken(Graphics::Renderer& renderer, const TokenObject& tok,
         }
     }
 }
+bool Instance::OnFrameUpdate()
+{
+    // called periodically from the UI thread --> the result of a background parse is used as soon as it is ready (until then
+    // the plain text is repainted, to show the current stage of the parsing) - a canceled parse is only discarded
+    if (!this->parsing)
+        return false;
+    if (this->parseTask.IsFinished())
+    {
+        ApplyParseResult();
+        return true;
+    }
+    return !this->parseCanceled;
+}
 void Instance::Paint(Graphics::Renderer& renderer)
 {
+    if (this->parsing)
+    {
+        PaintPlainText(renderer);
+        return;
+    }
+
     auto state           = this->HasFocus() ? ControlState::Focused : ControlState::Normal;
     auto lineMarkerColor = Cfg.LineMarker.GetColor(state);
 
@@ -1033,26 +1495,21 @@ void Instance::Paint(Graphics::Renderer& renderer)
 
     const int32 scroll_right  = Scroll.x + (int32) this->GetWidth() - 1;
     const int32 scroll_bottom = Scroll.y + (int32) this->GetHeight() - 1;
-    uint32 idx                = 0;
     int32 lastY               = -1;
 
-    for (auto& t : this->tokens)
+    // only the (visible) tokens from the rows on the screen are checked
+    for (auto idx : this->rowIndex.GetTokens(Scroll.y, scroll_bottom))
     {
-        // skip hidden and current token
-        if ((!t.IsVisible()) || (idx == this->currentTokenIndex))
-        {
-            idx++;
+        // skip current token
+        if ((idx == this->currentTokenIndex) || (idx >= this->tokens.size()))
             continue;
-        }
+        const auto& t        = this->tokens[idx];
         const auto tk_right  = t.pos.x + (int32) t.pos.width - 1;
         const auto tk_bottom = t.pos.y + (int32) t.pos.height - 1;
 
         // if token not in visible screen => skip it
         if ((t.pos.x > scroll_right) || (t.pos.y > scroll_bottom) || (tk_right < Scroll.x) || (tk_bottom < Scroll.y))
-        {
-            idx++;
             continue;
-        }
         renderer.SetClipMargins(this->lineNrWidth, 0, 0, 0);
         PaintToken(renderer, t, idx);
         if (t.pos.y != lastY)
@@ -1062,13 +1519,18 @@ void Instance::Paint(Graphics::Renderer& renderer)
             renderer.WriteText(num.ToDec(t.lineNo), params);
             lastY = t.pos.y;
         }
-        idx++;
     }
     renderer.ResetClip();
     foldColumn.Paint(renderer, this->lineNrWidth - 1, this);
 }
 bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
 {
+    if (this->parsing)
+    {
+        if ((this->parseTask.IsRunning()) && (!this->parseCanceled))
+            commandBar.SetCommand(Key::Escape, "Stop parsing", CMD_ID_STOP_PARSING);
+        return false;
+    }
     if (this->showMetaData)
         commandBar.SetCommand(config.Keys.showMetaData, "ShowMetaData:ON", CMD_ID_SHOW_METADATA);
     else
@@ -1286,23 +1748,23 @@ void Instance::MoveToNextSimilarToken(int32 direction)
     if (tok.hash == 0)
     {
         AppCUI::Dialogs::MessageBox::ShowError("Error", "This type of token has similarity search disabled !");
+        return;
     }
-    do
+    // the next (or previous) token from the list of similar tokens (the search continues from the other end of the list)
+    const auto& list = GetSimilarTokens(tok.hash);
+    if (!list.empty())
     {
         if (direction == 1)
         {
-            index++;
-            if (index >= this->tokens.size())
-                index = 0;
+            auto it = std::upper_bound(list.begin(), list.end(), index);
+            index   = it == list.end() ? list.front() : *it;
         }
         else
         {
-            if (index == 0)
-                index = static_cast<uint32>(this->tokens.size() - 1);
-            else
-                index--;
+            auto it = std::lower_bound(list.begin(), list.end(), index);
+            index   = it == list.begin() ? list.back() : *(it - 1);
         }
-    } while ((index != this->currentTokenIndex) && (this->tokens[index].hash != tok.hash));
+    }
     if (index == this->currentTokenIndex)
     {
         AppCUI::Dialogs::MessageBox::ShowNotification("Similar tokens", "There aren't any similar tokens to this one !");
@@ -1319,10 +1781,21 @@ void Instance::SetFoldStatus(uint32 index, FoldStatus foldStatus, bool recursive
         return;
     if ((size_t) index >= this->tokens.size())
         return;
-    auto& tok = this->tokens[index];
-    if (tok.IsBlockStarter())
+    if (this->tokens[index].IsBlockStarter())
     {
-        bool foldValue = foldStatus == FoldStatus::Folded ? true : (foldStatus == FoldStatus::Expanded ? false : (!tok.IsFolded()));
+        const auto isFolded = this->tokens[index].IsFolded();
+        bool foldValue      = foldStatus == FoldStatus::Folded ? true : (foldStatus == FoldStatus::Expanded ? false : (!isFolded));
+
+        // the content of the block is analyzed the first time it is expanded (the tokens are replaced)
+        if ((!foldValue) && (this->blocks[this->tokens[index].blockID].HasDeferredContent()))
+        {
+            if (!ParseDeferredBlock(this->tokens[index].blockID))
+            {
+                AppCUI::Dialogs::MessageBox::ShowError("Error", "Fail to analyze the content of this block !");
+                return;
+            }
+        }
+        auto& tok = this->tokens[index];
         tok.SetFolded(foldValue);
         if (recursive)
         {
@@ -1333,18 +1806,21 @@ void Instance::SetFoldStatus(uint32 index, FoldStatus foldStatus, bool recursive
                 if (currentTok.IsBlockStarter())
                 {
                     const auto& currentBlock = this->blocks[currentTok.blockID];
-                    // skip block that can only be folded manually
+                    // skip block that can only be folded manually (or whose content was not analyzed yet)
                     if ((foldValue) && (currentBlock.CanOnlyBeFoldedManually()))
                         continue;
+                    if ((!foldValue) && (currentBlock.HasDeferredContent()))
+                        continue;
                     currentTok.SetFolded(foldValue);
                 }
             }
         }
-        RecomputeTokenPositions();
+        RecomputeBlockPositions(tok.blockID);
     }
     else
     {
         // if current token is not the block starter, but reference a block, fold that block
+        const auto& tok = this->tokens[index];
         if (tok.HasBlock())
             SetFoldStatus(this->blocks[tok.blockID].tokenStart, foldStatus, recursive);
         else
@@ -1361,27 +1837,53 @@ void Instance::SetFoldStatus(uint32 index, FoldStatus foldStatus, bool recursive
         }
     }
 }
+void Instance::RecomputeFoldedBlocksPositions(uint32 changedBlocks, uint32 lastChangedBlock)
+{
+    // nothing to lay out if no block was changed and only that block if just one was changed
+    if (changedBlocks == 0)
+        return;
+    if (changedBlocks == 1)
+        RecomputeBlockPositions(lastChangedBlock);
+    else
+        RecomputeTokenPositions();
+}
 void Instance::ExpandAll()
 {
-    for (const auto& block : this->blocks)
+    // blocks with a deferred content are expanded one by one (otherwise the entire text would be analyzed)
+    auto changed   = 0U;
+    auto lastBlock = BlockObject::INVALID_ID;
+    for (auto idx = 0U; idx < static_cast<uint32>(this->blocks.size()); idx++)
     {
-        this->tokens[block.tokenStart].SetFolded(false);
+        auto& starter = this->tokens[this->blocks[idx].tokenStart];
+        if ((!this->blocks[idx].HasDeferredContent()) && (starter.IsFolded()))
+        {
+            starter.SetFolded(false);
+            lastBlock = idx;
+            changed++;
+        }
     }
-    RecomputeTokenPositions();
+    RecomputeFoldedBlocksPositions(changed, lastBlock);
 }
 void Instance::FoldAll()
 {
-    for (const auto& block : this->blocks)
+    auto changed   = 0U;
+    auto lastBlock = BlockObject::INVALID_ID;
+    for (auto idx = 0U; idx < static_cast<uint32>(this->blocks.size()); idx++)
     {
-        if (block.CanOnlyBeFoldedManually() == false)
-            this->tokens[block.tokenStart].SetFolded(true);
+        auto& starter = this->tokens[this->blocks[idx].tokenStart];
+        if ((this->blocks[idx].CanOnlyBeFoldedManually() == false) && (!starter.IsFolded()))
+        {
+            starter.SetFolded(true);
+            lastBlock = idx;
+            changed++;
+        }
     }
-    RecomputeTokenPositions();
+    RecomputeFoldedBlocksPositions(changed, lastBlock);
     MoveToClosestVisibleToken(this->currentTokenIndex, false);
 }
 void Instance::ShowStringOpDialog(TokenObject& tok)
 {
-    StringOpDialog dlg(tok, this->text.text, settings->parser);
+    StringOpDialog dlg(tok.GetOriginalText(this->text.text), GetTokenText(this->currentTokenIndex), settings->parser);
     if (dlg.Show() != Dialogs::Result::Ok)
         return;
     if (dlg.ShouldOpenANewWindow())
@@ -1413,7 +1915,9 @@ void Instance::ShowStringOpDialog(TokenObject& tok)
     else
     {
         // update value
-        UpdateTokensInformation();
+        SetTokenValue(this->currentTokenIndex, dlg.GetNewValue());
+        ClearTokenError(this->currentTokenIndex);
+        UpdateTokensInformation({ this->currentTokenIndex });
         RecomputeTokenPositions();
     }
 }
@@ -1427,7 +1931,9 @@ void Instance::ShowRefactorDialog(TokenObject& tok)
 
     // all good -> edit the token
     auto containerBlock = TokenToBlock(this->currentTokenIndex);
-    NameRefactorDialog dlg(tok, this->text.text, selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
+    const auto newValue = tok.HasNewValue() ? GetTokenText(this->currentTokenIndex) : u16string_view{};
+    NameRefactorDialog dlg(
+          tok.GetOriginalText(this->text.text), newValue, selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         auto method = dlg.GetApplyMethod();
@@ -1462,20 +1968,24 @@ void Instance::ShowRefactorDialog(TokenObject& tok)
             if (AppCUI::Dialogs::MessageBox::ShowOkCancel("Rename", tmp.Format("Rename %u tokens ?", count)) != AppCUI::Dialogs::Result::Ok)
                 return;
         }
-        for (auto idx = start; idx < end; idx++)
-        {
-            if (tokens[idx].hash == tok.hash)
-                tokens[idx].value = dlg.GetNewValue();
-        }
+        LocalUnicodeStringBuilder<256> value;
+        value.Set(dlg.GetNewValue());
+        // only the similar tokens are changed (a copy is needed as the list changes once their hash is updated)
+        const auto& list = GetSimilarTokens(tok.hash);
+        std::vector<uint32> renamed(std::lower_bound(list.begin(), list.end(), start), std::lower_bound(list.begin(), list.end(), end));
         // Update the original as well
-        tok.value = dlg.GetNewValue();
+        const auto pos = std::lower_bound(renamed.begin(), renamed.end(), this->currentTokenIndex);
+        if ((pos == renamed.end()) || (*pos != this->currentTokenIndex))
+            renamed.insert(pos, this->currentTokenIndex);
+        for (auto idx : renamed)
+            SetTokenValue(idx, value.ToStringView());
         if (dlg.ShouldReparse())
         {
             this->Reparse(false);
         }
         else
         {
-            UpdateTokensInformation();
+            UpdateTokensInformation(renamed);
             RecomputeTokenPositions();
         }
     }
@@ -1490,9 +2000,10 @@ void Instance::EditCurrentToken()
     auto& tok = this->tokens[this->currentTokenIndex];
     if (!tok.IsVisible())
         return;
-    if (tok.error.Len() > 0)
+    const auto error = GetTokenError(this->currentTokenIndex);
+    if (error.size() > 0)
     {
-        AppCUI::Dialogs::MessageBox::ShowError("Error", tok.error);
+        AppCUI::Dialogs::MessageBox::ShowError("Error", error);
     }
     if (tok.dataType == TokenDataType::String)
         ShowStringOpDialog(tok);
@@ -1510,7 +2021,7 @@ void Instance::DeleteTokens()
 
     // all good -> edit the token
     auto containerBlock = TokenToBlock(this->currentTokenIndex);
-    DeleteDialog dlg(tok, this->text.text, selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
+    DeleteDialog dlg(GetTokenText(this->currentTokenIndex), selection.HasSelection(0), containerBlock != BlockObject::INVALID_ID);
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         auto method = dlg.GetApplyMethod();
@@ -1535,12 +2046,14 @@ void Instance::DeleteTokens()
             return;
         }
         for (; start < end; start++)
-            this->tokens[start].SetShouldDeleteFlag();
+            MarkTokenForDeletion(start);
         this->Reparse(false);
     }
 }
 bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
 {
+    if (this->parsing)
+        return OnPlainTextKeyEvent(keyCode);
     switch (keyCode)
     {
     case Key::Up:
@@ -1683,8 +2196,12 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 {
     if (eventType != Event::Command)
         return false;
+    if ((this->parsing) && (ID != CMD_ID_STOP_PARSING))
+        return false;
     switch (ID)
     {
+    case CMD_ID_STOP_PARSING:
+        return OnPlainTextKeyEvent(Key::Escape);
     case CMD_ID_SHOW_METADATA:
         this->showMetaData = !this->showMetaData;
         this->RecomputeTokenPositions();
@@ -1716,7 +2233,9 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 }
 void Instance::OnUpdateScrollBars()
 {
-    if (this->noItemsVisible)
+    if (this->parsing)
+        this->UpdateVScrollBar(this->Scroll.y, this->plainTextLines.size());
+    else if (this->noItemsVisible)
         this->UpdateVScrollBar(0, 0);
     else
         this->UpdateVScrollBar(this->currentTokenIndex, this->tokens.size());
@@ -1775,14 +2294,15 @@ void Instance::ShowPlugins()
     // we need to clone the existing text as we don't want to modify the text while showing it
     auto textClone = text.Clone();
     TextEditorBuilder ted(textClone);
-    TokensListBuilder tokensList(this);
-    BlocksListBuilder blockList(this);
+    TokensListBuilder tokensList(static_cast<ParsedContent*>(this));
+    BlocksListBuilder blockList(static_cast<ParsedContent*>(this));
     PluginData pd(ted, tokensList, blockList);
     pd.currentTokenIndex = this->currentTokenIndex;
 
     // selection and block infos
     uint32 selectionStart = 0, selectionEnd = 0, blockStart = 0, blockEnd = 0;
     auto tokensCount = static_cast<uint32>(this->tokens.size());
+    auto blocksCount = this->blocks.size();
     if (this->selection.HasSelection(0))
     {
         selectionStart = static_cast<uint32>(this->selection.GetSelectionStart(0));
@@ -1807,7 +2327,7 @@ void Instance::ShowPlugins()
         }
     }
 
-    PluginDialog dlg(pd, this->settings.ToReference(), selectionStart, selectionEnd, blockStart, blockEnd);
+    PluginDialog dlg(pd, this->settings, selectionStart, selectionEnd, blockStart, blockEnd);
     auto result = static_cast<AppCUI::Dialogs::Result>(dlg.Show());
     textClone   = ted.Release();
     if (result == Dialogs::Result::Cancel)
@@ -1815,6 +2335,22 @@ void Instance::ShowPlugins()
         textClone.Destroy();
         return;
     }
+    if (!dlg.GetPipeline().empty())
+    {
+        // the text is parsed (and laid out) only once, after all plugins were executed
+        textClone.Destroy();
+        PluginPipeline pipeline(*this, pd.startIndex, pd.endIndex);
+        pipeline.Run(dlg.GetPipeline(), dlg.RepeatPipeline());
+        if (pipeline.HasChanges())
+        {
+            this->text.Destroy();
+            this->text = pipeline.ReleaseText();
+            this->Parse();
+        }
+        PluginPipelineDialog report(pipeline, this->settings);
+        report.Show();
+        return;
+    }
     switch (dlg.GetAfterActionRequest())
     {
     case PluginAfterActionRequest::None:
@@ -1823,9 +2359,16 @@ void Instance::ShowPlugins()
     case PluginAfterActionRequest::Refresh:
         textClone.Destroy();
         UpdateTokensInformation();
+        ComputeBlockIndex();
         RecomputeTokenPositions();
         break;
     case PluginAfterActionRequest::Rescan:
+        // tokens or blocks added by the plugin can not be mapped to the old ones
+        if ((this->tokens.size() == tokensCount) && (this->blocks.size() == blocksCount))
+        {
+            if (ReparseEdits(textClone, ComputeTextEdits(textClone)))
+                break;
+        }
         this->text.Destroy();
         this->text = textClone;
         this->Parse();
@@ -1873,7 +2416,10 @@ void Instance::ShowSaveAsDialog()
     BakupTokensPositions();
     auto originalShowMetaDataValue = this->showMetaData;
     this->showMetaData             = true;
-    ExpandAll();
+    // (the blocks whose content was not analyzed yet are expanded as well --> their unparsed token is written as it is)
+    for (const auto& block : this->blocks)
+        this->tokens[block.tokenStart].SetFolded(false);
+    RecomputeTokenPositions(); // a full layout (the meta data tokens are shown now)
 
     // Step 2 --> create a buffer for the entire text
     Buffer b;
@@ -1886,8 +2432,10 @@ void Instance::ShowSaveAsDialog()
     auto bom     = dlg.HasBOM() ? CharacterEncoding::GetBOMForEncoding(enc) : BufferView();
 
     b.Add(bom);
+    auto idx = 0U;
     for (const auto& tok : this->tokens)
     {
+        const auto tokIndex = idx++;
         if (tok.IsVisible() == false)
             continue;
         if (y < tok.pos.y)
@@ -1901,7 +2449,7 @@ void Instance::ShowSaveAsDialog()
             b.AddMultipleTimes(" ", tok.pos.x - x);
             x = tok.pos.x;
         }
-        auto txt    = tok.GetText(this->text.text);
+        auto txt    = GetTokenText(tokIndex);
         auto lastCH = static_cast<char16>(0);
         for (auto ch : txt)
         {
@@ -1971,7 +2519,7 @@ void Instance::ShowFindAllDialog()
         return;
     }
 
-    FindAllDialog dlg(tok, this->tokens, this->text.text);
+    FindAllDialog dlg(this->currentTokenIndex, *this);
 
     if (dlg.Show() == Dialogs::Result::Ok)
     {
@@ -1985,26 +2533,24 @@ std::string_view Instance::GetName()
 //======================================================================[Mouse coords]========================
 uint32 Instance::MousePositionToTokenID(int x, int y)
 {
-    auto idx = 0U;
-    for (const auto& tok : this->tokens)
+    for (auto idx : this->rowIndex.GetTokens(y + Scroll.y, y + Scroll.y))
     {
-        if (tok.IsVisible() == false)
-        {
-            idx++;
+        if (idx >= this->tokens.size())
             continue;
-        }
-        auto tokLeft   = tok.pos.x + lineNrWidth - Scroll.x;
-        auto tokTop    = tok.pos.y - Scroll.y;
-        auto tokRight  = tokLeft + static_cast<int32>(tok.pos.width);
-        auto tokBottom = tokTop + static_cast<int32>(tok.pos.height);
+        const auto& tok = this->tokens[idx];
+        auto tokLeft    = tok.pos.x + lineNrWidth - Scroll.x;
+        auto tokTop     = tok.pos.y - Scroll.y;
+        auto tokRight   = tokLeft + static_cast<int32>(tok.pos.width);
+        auto tokBottom  = tokTop + static_cast<int32>(tok.pos.height);
         if ((x >= tokLeft) && (x < tokRight) && (y >= tokTop) && (y < tokBottom))
             return idx;
-        idx++;
     }
     return Token::INVALID_INDEX;
 }
 void Instance::OnMousePressed(int x, int y, AppCUI::Input::MouseButton button)
 {
+    if (this->parsing)
+        return;
     if (x == (this->lineNrWidth - 1))
     {
         auto blockID = foldColumn.MouseToBlockIndex(y);
@@ -2034,6 +2580,8 @@ void Instance::OnMouseReleased(int x, int y, AppCUI::Input::MouseButton button)
 }
 bool Instance::OnMouseDrag(int x, int y, AppCUI::Input::MouseButton button)
 {
+    if (this->parsing)
+        return false;
     if (x >= this->lineNrWidth)
     {
         auto tokIDX = MousePositionToTokenID(x, y);
@@ -2059,6 +2607,8 @@ bool Instance::OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction)
 }
 bool Instance::OnMouseOver(int x, int y)
 {
+    if (this->parsing)
+        return false;
     if (x == (this->lineNrWidth - 1))
         return foldColumn.UpdateMouseHoverIndex(y);
     else
@@ -2115,12 +2665,18 @@ int Instance::PrintError(std::u16string_view error, int x, int y, uint32 width,
 
 void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 width, uint32 height)
 {
+    if (this->parsing)
+    {
+        r.WriteSingleLineText(0, 0, this->parseCanceled ? "Parsing was canceled" : "Parsing ...", Cfg.Text.Inactive);
+        return;
+    }
     if (this->noItemsVisible)
     {
         r.WriteSingleLineText(0, 0, "No information available", Cfg.Text.Inactive);
         return;
     }
-    const auto& tok = this->tokens[this->currentTokenIndex];
+    const auto& tok  = this->tokens[this->currentTokenIndex];
+    const auto error = GetTokenError(this->currentTokenIndex);
     LocalString<128> tmp;
     auto xPoz = 0;
     switch (height)
@@ -2136,8 +2692,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 16, "Line:", tmp.Format("%d/%d", tok.lineNo, this->lastLineNumber));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 9, "Col:", tmp.Format("%d", tok.pos.x + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 18, "Char ofs:", tmp.Format("%u", tok.start));
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 0, 50, r);
+        if (error.size() > 0)
+            xPoz = PrintError(error, xPoz, 0, 50, r);
         else
             xPoz = this->PrintTokenTypeInfo(tok.type, xPoz, 0, 30, r);
         break;
@@ -2150,9 +2706,9 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 16, "Col : ", tmp.Format("%d", tok.pos.x + 1));
         this->WriteCursorInfo(r, xPoz, 0, 18, "Char ofs: ", tmp.Format("%u", tok.start));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 18, "Tokens  : ", tmp.Format("%u", (size_t) tokens.size()));
-        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", tok.GetText(this->text.text));
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 1, 35, r);
+        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", GetTokenText(this->currentTokenIndex));
+        if (error.size() > 0)
+            xPoz = PrintError(error, xPoz, 1, 35, r);
         else
             xPoz = this->PrintTokenTypeInfo(tok.type, xPoz, 1, 35, r);
         break;
@@ -2163,10 +2719,10 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         PrintSelectionInfo(3, xPoz, 0, 16, r);
         this->WriteCursorInfo(r, xPoz, 1, 16, "Line: ", tmp.Format("%d/%d", tok.lineNo, this->lastLineNumber));
         xPoz = this->WriteCursorInfo(r, xPoz, 2, 16, "Col : ", tmp.Format("%d", tok.pos.x + 1));
-        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", tok.GetText(this->text.text));
+        this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", GetTokenText(this->currentTokenIndex));
         this->PrintTokenTypeInfo(tok.type, xPoz, 1, 35, r);
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 2, 35, r);
+        if (error.size() > 0)
+            xPoz = PrintError(error, xPoz, 2, 35, r);
         else
             xPoz = this->PrintDataTypeInfo(tok.dataType, xPoz, 2, 35, r);
         break;
@@ -2183,11 +2739,11 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 3, 20, "Tokens  : ", tmp.Format("%u", (size_t) tokens.size()));
 
         // Third column
-        this->WriteCursorInfo(r, xPoz, 0, 40, "Token     : ", tok.GetText(this->text.text));
+        this->WriteCursorInfo(r, xPoz, 0, 40, "Token     : ", GetTokenText(this->currentTokenIndex));
         this->WriteCursorInfo(r, xPoz, 1, 40, "Original  : ", tok.GetOriginalText(this->text.text));
         this->PrintTokenTypeInfo(tok.type, xPoz, 2, 40, r);
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 3, 40, r);
+        if (error.size() > 0)
+            xPoz = PrintError(error, xPoz, 3, 40, r);
         else
             xPoz = this->PrintDataTypeInfo(tok.dataType, xPoz, 3, 40, r);
 
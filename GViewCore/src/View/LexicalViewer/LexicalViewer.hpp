@@ -2,6 +2,11 @@
 
 #include "Internal.hpp"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
 namespace GView
 {
 namespace View
@@ -27,6 +32,7 @@ namespace View
             DisableSimilarityHighlight = 0x08, // hash will not be computed for this token
             ShouldDelete               = 0x10, // token should be deleted on next reparse
             SizeableSize               = 0x20, // token size (width and height) can be modified
+            NewValue                   = 0x40, // token has a new value (stored in Instance::tokenValues)
         };
         class TokensListBuilder : public TokensList
         {
@@ -65,6 +71,7 @@ namespace View
             }
             GView::Utils::UnicodeString Release()
             {
+                Flatten();
                 GView::Utils::UnicodeString result(this->text, this->size, this->allocated);
                 this->text      = nullptr;
                 this->size      = 0;
@@ -72,6 +79,21 @@ namespace View
                 return result;
             }
             bool Set(const CharacterBuffer& chars);
+
+            using Change = TextEditor::Change;
+            void RecordChanges()
+            {
+                this->changes.clear();
+                this->recordChanges  = true;
+                this->unknownChanges = false;
+            }
+            // nullptr if the changes were not recorded (or some of them are not known)
+            const std::vector<Change>* GetChanges() const
+            {
+                if ((!this->recordChanges) || (this->unknownChanges))
+                    return nullptr;
+                return &this->changes;
+            }
         };
         struct BlockObject
         {
@@ -98,6 +120,10 @@ namespace View
             {
                 return (flags & BlockFlags::ManualCollapse) != BlockFlags::None;
             }
+            inline bool HasDeferredContent() const
+            {
+                return (flags & BlockFlags::DeferredContent) != BlockFlags::None;
+            }
         };
         struct TokenPosition
         {
@@ -107,8 +133,6 @@ namespace View
         };
         struct TokenObject
         {
-            UnicodeStringBuilder value;
-            UnicodeStringBuilder error;
             uint64 hash;
             uint32 start, end, type;
             uint32 blockID; // for blocks
@@ -143,6 +167,10 @@ namespace View
             {
                 return (static_cast<uint8>(pos.status) & static_cast<uint8>(TokenStatus::ShouldDelete)) != 0;
             }
+            inline bool HasNewValue() const
+            {
+                return (static_cast<uint8>(pos.status) & static_cast<uint8>(TokenStatus::NewValue)) != 0;
+            }
             inline void SetVisible(bool value)
             {
                 if (value)
@@ -162,6 +190,13 @@ namespace View
             {
                 pos.status = static_cast<TokenStatus>(static_cast<uint8>(pos.status) | static_cast<uint8>(TokenStatus::SizeableSize));
             }
+            inline void SetNewValueFlag(bool value)
+            {
+                if (value)
+                    pos.status = static_cast<TokenStatus>(static_cast<uint8>(pos.status) | static_cast<uint8>(TokenStatus::NewValue));
+                else
+                    pos.status = static_cast<TokenStatus>(static_cast<uint8>(pos.status) & (~static_cast<uint8>(TokenStatus::NewValue)));
+            }
             inline void SetFolded(bool value)
             {
                 if (value)
@@ -178,30 +213,20 @@ namespace View
                 pos.status = static_cast<TokenStatus>(
                       static_cast<uint8>(pos.status) | static_cast<uint8>(TokenStatus::DisableSimilarityHighlight));
             }
-            void UpdateSizes(const char16* text);
-            inline void UpdateHash(const char16* text, bool ignoreCase)
+            void UpdateSizes(u16string_view content);
+            inline void UpdateHash(u16string_view content, bool ignoreCase)
             {
                 if ((static_cast<uint8>(pos.status) & static_cast<uint8>(TokenStatus::DisableSimilarityHighlight)) != 0)
                 {
                     this->hash = 0;
                     return;
                 }
-                if (this->value.Len() == 0)
-                    this->hash = TextParser::ComputeHash64({ text + start, (size_t) (end - start) }, ignoreCase);
-                else
-                    this->hash = TextParser::ComputeHash64(this->value.ToStringView(), ignoreCase);
+                this->hash = TextParser::ComputeHash64(content, ignoreCase);
             }
             inline u16string_view GetOriginalText(const char16* text) const
             {
                 return { text + start, (size_t) (end - start) };
             }
-            inline u16string_view GetText(const char16* text) const
-            {
-                if (this->value.Len() == 0)
-                    return { text + start, (size_t) (end - start) };
-                else
-                    return this->value.ToStringView();
-            }
         };
 
         struct SettingsData
@@ -273,27 +298,253 @@ namespace View
                 return BlockObject::INVALID_ID;
             }
         };
+        class RowIndex
+        {
+            // visible tokens (in the order from the tokens list) and, for every row, the range of them that can be painted on it
+            std::vector<uint32> visibleTokens;
+            std::vector<uint32> firstOnRow; // first visible token that ends on this row or after it
+            std::vector<uint32> endOnRow;   // one past the last visible token that starts on this row or before it
+
+          public:
+            void Build(const std::vector<TokenObject>& tokens);
+            void Update(const std::vector<TokenObject>& tokens, uint32 firstToken);
+            void Clear();
+            std::span<const uint32> GetTokens(int32 firstRow, int32 lastRow) const;
+        };
         struct PrettyFormatLayoutManager
         {
             int x, y, lastY;
             bool firstOnNewLine;
             bool spaceAdded;
         };
-        class Instance : public View::ViewControl
+        // the tokens of a block are laid out one by one (this is what is known about the block while that happens)
+        struct PrettyFormatBlockState
+        {
+            uint32 idxStart;
+            int32 leftMargin, topMargin;
+            uint32 indent;
+            int32 sameColumnCount;
+            int32 maxXOffsetForSameColumn;
+            int32 lastSameColumnLine;
+            uint32 lastSameColumnToken;
+            bool partOfFoldedBlock;
+            bool sameColumnDifferences;
+        };
+        // the layout of the block that contains a block, right before the first token of the block and right after its last one
+        // (used to lay out again only that block when its fold status changes)
+        struct BlockLayout
+        {
+            PrettyFormatBlockState stateBefore, stateAfter;
+            PrettyFormatLayoutManager managerBefore, managerAfter;
+            uint32 afterIndex; // the first token after the block
+            uint32 version;    // must be the same as the version of the layout
+            bool alignedContent;
+        };
+        // a part of the text that was changed: [oldStart, oldEnd) from the parsed text was replaced by [newStart, newEnd) in the new one
+        struct TextEdit
+        {
+            uint32 oldStart, oldEnd;
+            uint32 newStart, newEnd;
+        };
+        // tokens obtained by parsing again only a part of the text (they replace 'count' tokens starting with 'first') - once
+        // the tokens are spliced, 'first' is the index of the first new token
+        struct TokensSplice
+        {
+            uint32 first, count;
+            std::vector<TokenObject> tokens;
+            std::vector<BlockObject> blocks; // the blocks of the new tokens (their token indexes are indexes in 'tokens')
+            std::unordered_map<uint32, UnicodeStringBuilder> errors; // the key is the index in 'tokens'
+        };
+        // everything a parse produces (the text, its tokens and blocks and their layout) - it can be built on a worker thread
+        class ParsedContent
+        {
+          protected:
+            Reference<SettingsData> settings;
+            UnicodeString text;
+            int32 lastLineNumber;
+            bool noItemsVisible;
+            bool showMetaData;
+            bool prettyFormat;
+
+            // the layout of every block (from the last time the tokens were laid out)
+            std::vector<BlockLayout> blockLayouts;
+            uint32 layoutVersion;
+            bool layoutAligned; // the tokens that are not part of a block were aligned to the same column
+
+            void UpdateTokensWidthAndHeight(uint32 start, uint32 end);
+            void ComputeOriginalPositions();
+            void PrettyFormatIncreaseUntilNewLineXWithValue(uint32 idxStart, uint32 idxEnd, int32 currentLineYOffset, int32 diff);
+            void PrettyFormatIncreaseAllXWithValue(uint32 idxStart, uint32 idxEnd, int32 diff);
+            void PrettyFormatAlignToSameColumn(uint32 idxStart, uint32 idxEnd, int32 columnXOffset);
+            bool PrettyFormatForBlock(
+                  uint32 idxStart, uint32 idxEnd, int32 leftMargin, int32 topMargin, PrettyFormatLayoutManager& manager);
+            uint32 PrettyFormatToken(uint32 idx, PrettyFormatBlockState& state, PrettyFormatLayoutManager& manager);
+            void PrettyFormat();
+            bool PrettyFormatChangedBlock(uint32 blockID);
+            void UpdateVisibilityStatus(uint32 start, uint32 end, bool visible);
+            void UpdateTokensInformation();
+            void UpdateTokensInformation(const std::vector<uint32>& indexes);
+            void ComputeHashIndex();
+            void ComputeLayout();
+            void ComputeLineNumbers();
+            void ComputeBlockIndex();
+            bool FoldDeferredBlocks();
+            void AnalyzeText();
+
+            bool RebuildTextFromTokens(UnicodeString& newText, std::vector<TextEdit>& edits);
+            std::vector<TextEdit> ComputeTextEdits(const UnicodeString& newText) const;
+            bool ComputeTokensSplices(const UnicodeString& newText, std::vector<TextEdit> edits, std::vector<TokensSplice>& splices);
+            bool CanReplaceBlocks(const ParsedContent& oldFragment, uint32 first, uint32 replacedEnd, uint32 tailEnd) const;
+            void SpliceTokens(
+                  UnicodeString& newText, const std::vector<TextEdit>& edits, std::vector<TokensSplice>& splices, uint32& tokenIndex);
+            bool LayOutSplicedTokens(const std::vector<TokensSplice>& splices, uint32& firstChangedToken);
+
+          public:
+            std::vector<TokenObject> tokens;
+            std::vector<BlockObject> blocks;
+
+            // new values and errors are rarely set --> they are kept outside of the tokens (the key is the token index)
+            std::unordered_map<uint32, UnicodeStringBuilder> tokenValues;
+            std::unordered_map<uint32, UnicodeStringBuilder> tokenErrors;
+            std::vector<uint32> deletedTokens; // the tokens marked for deletion (the text is rebuilt only from the modified tokens)
+
+            // the innermost block that contains a token, the block that contains a block and the blocks in the order of their
+            // first token (computed after the blocks are built)
+            std::vector<uint32> tokenBlocks;
+            std::vector<uint32> blockParents;
+            std::vector<uint32> blocksByStart;
+
+            // the indexes (sorted) of the tokens with the same hash (tokens with similarity search disabled are not indexed)
+            std::unordered_map<uint64, std::vector<uint32>> hashTokens;
+
+            ParsedContent();
+            ParsedContent(const ParsedContent&)            = delete;
+            ParsedContent& operator=(const ParsedContent&) = delete;
+            ~ParsedContent();
+
+            void Swap(ParsedContent& content);
+            void Clear();
+
+            inline uint32 GetUnicodeTextLen() const
+            {
+                return text.size;
+            }
+            inline char16* GetUnicodeText() const
+            {
+                return text.text;
+            }
+
+            u16string_view GetTokenText(uint32 index) const;
+            u16string_view GetTokenError(uint32 index) const;
+            const std::vector<uint32>& GetSimilarTokens(uint64 hash) const;
+            bool SetTokenValue(uint32 index, const ConstString& value);
+            bool SetTokenError(uint32 index, const ConstString& error);
+            void ClearTokenError(uint32 index);
+            void MarkTokenForDeletion(uint32 index);
+
+            bool AnalyzeFragment(Reference<SettingsData> settings, u16string_view fragment);
+
+            friend class ParseTask;
+            friend class PluginPipeline;
+        };
+        enum class ParseStage : uint8
+        {
+            Preprocess,
+            Analyze,
+            Layout,
+            Done
+        };
+        class ParseTask
+        {
+            std::thread worker;
+            std::unique_ptr<ParsedContent> content;
+            std::atomic<ParseStage> stage;
+            std::atomic<bool> stop, finished;
+
+            void Run();
+
+          public:
+            ParseTask();
+            ~ParseTask();
+
+            bool Start(UnicodeString& text, Reference<SettingsData> settings, bool prettyFormat);
+            void Stop();
+            void Cancel();
+            std::unique_ptr<ParsedContent> TakeResult();
+
+            inline bool IsRunning() const
+            {
+                return worker.joinable() && (!finished.load(std::memory_order_acquire));
+            }
+            inline bool IsFinished() const
+            {
+                return worker.joinable() && finished.load(std::memory_order_acquire);
+            }
+            inline ParseStage GetStage() const
+            {
+                return stage.load(std::memory_order_relaxed);
+            }
+        };
+        // what happened when a plugin from a pipeline was executed (times are in microseconds)
+        struct PluginPipelineStage
+        {
+            uint32 round;
+            uint32 plugin; // index in SettingsData::plugins
+            uint32 edits;  // parts of the text modified by the plugin
+            bool applied;  // false if the plugin can not be applied on the tokens from that moment
+            bool fullScan; // the tokens were obtained by parsing the entire text (not only the modified parts)
+            uint64 executeTime;
+            uint64 tokenizeTime;
+        };
+        // runs several plugins one after another over a copy of the tokens - after every plugin that modifies the text only the
+        // tokens are obtained again (there is no layout) and the text is parsed (entirely) only once, when the pipeline ends
+        class PluginPipeline
+        {
+            ParsedContent content;
+            uint32 rangeStart, rangeEnd; // the plugins are executed over the tokens from this part of the text
+            std::vector<PluginPipelineStage> stages;
+            bool changed, finished;
+
+            bool RunStage(uint32 round, uint32 pluginIndex);
+            void UpdateTokens(UnicodeString& newText, const std::vector<TextEdit>& edits, bool sameTokens, PluginPipelineStage& stage);
+
+          public:
+            PluginPipeline(const ParsedContent& source, uint32 startIndex, uint32 endIndex);
+
+            void Run(const std::vector<uint32>& plugins, bool repeat);
+            UnicodeString ReleaseText();
+
+            inline bool HasChanges() const
+            {
+                return changed;
+            }
+            inline bool IsFinished() const
+            {
+                return finished;
+            }
+            inline const std::vector<PluginPipelineStage>& GetStages() const
+            {
+                return stages;
+            }
+        };
+        class Instance : public View::ViewControl, public ParsedContent
         {
             FoldColumn foldColumn;
+            RowIndex rowIndex;
+            ParseTask parseTask;
             FixSizeString<29> name;
             Utils::Selection selection;
-            Pointer<SettingsData> settings;
+            Pointer<SettingsData> settingsData;
             Reference<GView::Object> obj;
             uint64 currentHash;
-            UnicodeString text;           
             uint32 currentTokenIndex;
-            int32 lineNrWidth, lastLineNumber;
-            bool noItemsVisible;
-            bool showMetaData;
-            bool prettyFormat;
+            int32 lineNrWidth;
             bool highlightSimilarTokens;
+            bool parsing; // the text is parsed on a worker thread (until then it is shown as plain text)
+            bool parseCanceled;
+
+            // line starts of the text (used to show it while it is parsed)
+            std::vector<uint32> plainTextLines;
 
             std::vector<TokenPosition> backupedTokenPositionList;
 
@@ -304,18 +555,9 @@ namespace View
 
             static Config config;
 
-            void UpdateTokensWidthAndHeight();
-            void ComputeOriginalPositions();
-            void PrettyFormatIncreaseUntilNewLineXWithValue(uint32 idxStart, uint32 idxEnd, int32 currentLineYOffset, int32 diff);
-            void PrettyFormatIncreaseAllXWithValue(uint32 idxStart, uint32 idxEnd, int32 diff);
-            void PrettyFormatAlignToSameColumn(uint32 idxStart, uint32 idxEnd, int32 columnXOffset);
-            void PrettyFormatForBlock(
-                  uint32 idxStart, uint32 idxEnd, int32 leftMargin, int32 topMargin, PrettyFormatLayoutManager& manager);
-            void PrettyFormat();
             void EnsureCurrentItemIsVisible();
             void RecomputeTokenPositions();
-            void UpdateVisibilityStatus(uint32 start, uint32 end, bool visible);
-            void UpdateTokensInformation();
+            void RecomputeBlockPositions(uint32 blockID);
             void MoveToClosestVisibleToken(uint32 startIndex, bool selected);
 
             void FillBlockSpace(Graphics::Renderer& renderer, const BlockObject& block);
@@ -331,10 +573,12 @@ namespace View
             void MoveToNextSimilarToken(int32 direction);
 
             void SetFoldStatus(uint32 index, FoldStatus foldStatus, bool recursive);
+            void RecomputeFoldedBlocksPositions(uint32 changedBlocks, uint32 lastChangedBlock);
             void ExpandAll();
             void FoldAll();
 
             uint32 TokenToBlock(uint32 tokenIndex);
+            uint32 GetParentBlock(uint32 blockID);
             uint32 CountSimilarTokens(uint32 start, uint32 end, uint64 hash);
             void BakupTokensPositions();
             void RestoreTokensPositionsFromBackup();
@@ -348,32 +592,27 @@ namespace View
             void ShowRefactorDialog(TokenObject& tok);
             void ShowStringOpDialog(TokenObject& tok);
 
-            bool RebuildTextFromTokens(TextEditor& edidor);
             void Parse();
             void Reparse(bool openInNewWindow);
+            bool ReparseEdits(UnicodeString& newText, const std::vector<TextEdit>& edits);
+            void ApplyTokensSplices(UnicodeString& newText, const std::vector<TextEdit>& edits, std::vector<TokensSplice>& splices);
+            bool ParseDeferredBlock(uint32 blockID);
+            void RecomputeLayoutAndLineNumbers();
+            void ApplyParseResult();
+            void UpdateLineNumberWidth();
+            void PaintPlainText(Graphics::Renderer& renderer);
+            bool OnPlainTextKeyEvent(AppCUI::Input::Key keyCode);
 
             int PrintSelectionInfo(uint32 selectionID, int x, int y, uint32 width, Renderer& r);
             int PrintTokenTypeInfo(uint32 tokenTypeID, int x, int y, uint32 width, Renderer& r);
             int PrintDataTypeInfo(TokenDataType dataType, int x, int y, uint32 width, Renderer& r);
             int PrintError(std::u16string_view error, int x, int y, uint32 width, Renderer& r);
 
-          public:
-            std::vector<TokenObject> tokens;
-            std::vector<BlockObject> blocks;
-
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
 
-            inline uint32 GetUnicodeTextLen() const
-            {
-                return text.size;
-            }
-            inline char16* GetUnicodeText() const
-            {
-                return text.text;
-            }
-
             virtual void Paint(Graphics::Renderer& renderer) override;
+            virtual bool OnFrameUpdate() override;
             virtual bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
             virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
@@ -413,13 +652,12 @@ namespace View
         };
         class NameRefactorDialog : public Window
         {
-            TokenObject& tok;
             Reference<TextField> txNewValue;
             Reference<RadioBox> rbApplyOnCurrent, rbApplyOnAll, rbApplyOnBlock, rbApplyOnSelection;
             Reference<CheckBox> cbReparse;
 
           public:
-            NameRefactorDialog(TokenObject& tok, const char16* text, bool hasSelection, bool belongsToABlock);
+            NameRefactorDialog(u16string_view originalText, u16string_view newValue, bool hasSelection, bool belongsToABlock);
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
 
             inline bool ShouldReparse()
@@ -452,18 +690,18 @@ namespace View
         }
         class StringOpDialog : public Window
         {
-            TokenObject& tok;
+            u16string_view originalText, currentText;
+            UnicodeStringBuilder newValue;
             Reference<TextArea> txValue;
             Reference<ParseInterface> parser;
             TextEditorBuilder editor;
-            const char16* text;
             bool openInANewWindow;
             
             void UpdateValue(bool original);
             void UpdateTokenValue();
             void RunStringOperation(uint32 commandID);
           public:
-            StringOpDialog(TokenObject& tok, const char16* text, Reference<ParseInterface> parser);
+            StringOpDialog(u16string_view originalText, u16string_view currentText, Reference<ParseInterface> parser);
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline bool ShouldOpenANewWindow() const
             {
@@ -473,13 +711,17 @@ namespace View
             {
                 return txValue->GetText();
             }
+            inline u16string_view GetNewValue() const
+            {
+                return newValue.ToStringView();
+            }
         };
         class DeleteDialog : public Window
         {
             Reference<RadioBox> rbApplyOnCurrent, rbApplyOnBlock, rbApplyOnSelection;
 
           public:
-            DeleteDialog(TokenObject& tok, const char16* text, bool hasSelection, bool belongsToABlock);
+            DeleteDialog(u16string_view tokenText, bool hasSelection, bool belongsToABlock);
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline ApplyMethod GetApplyMethod()
             {
@@ -496,13 +738,15 @@ namespace View
             PluginData& pluginData;
             Reference<ListView> lstPlugins;
             Reference<RadioBox> rbRunOnSelection, rbRunOnCurrentBlock, rbRunOnEntireFile;
-            Reference<CheckBox> cbOpenInNewWindow;
+            Reference<CheckBox> cbOpenInNewWindow, cbRepeatPipeline;
             Reference<SettingsData> settings;
             PluginAfterActionRequest afterActionRequest;
             uint32 selectionStart, selectionEnd, blockStart, blockEnd;
+            std::vector<uint32> pipeline;
 
             void UpdatePluginData();
             void RunPlugin();
+            void RunPipeline();
 
           public:
             PluginDialog(
@@ -517,6 +761,22 @@ namespace View
             {
                 return afterActionRequest;
             }
+            // the plugins (in the order they have to be executed) if a pipeline has to be executed
+            inline const std::vector<uint32>& GetPipeline() const
+            {
+                return pipeline;
+            }
+            inline bool RepeatPipeline() const
+            {
+                return cbRepeatPipeline->IsChecked();
+            }
+        };
+        class PluginPipelineDialog : public Window
+        {
+          public:
+            PluginPipelineDialog(const PluginPipeline& pipeline, Reference<SettingsData> settings);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
         };
         class GoToDialog : public Window
         {
@@ -541,7 +801,7 @@ namespace View
             void Validate();
 
           public:
-            FindAllDialog(const TokenObject& currentToken,const std::vector<TokenObject>& tokens, const char16* txt);
+            FindAllDialog(uint32 currentTokenIndex, const Instance& instance);
 
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline uint32 GetSelectedTokenIndex() const
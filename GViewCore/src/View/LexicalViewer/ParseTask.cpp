@@ -0,0 +1,201 @@
+#include "LexicalViewer.hpp"
+
+namespace GView::View::LexicalViewer
+{
+ParsedContent::ParsedContent()
+    : lastLineNumber(0), noItemsVisible(true), showMetaData(true), prettyFormat(true), layoutVersion(0), layoutAligned(false)
+{
+}
+ParsedContent::~ParsedContent()
+{
+    this->text.Destroy();
+}
+void ParsedContent::Swap(ParsedContent& content)
+{
+    std::swap(this->text, content.text);
+    std::swap(this->lastLineNumber, content.lastLineNumber);
+    std::swap(this->noItemsVisible, content.noItemsVisible);
+    std::swap(this->showMetaData, content.showMetaData);
+    std::swap(this->prettyFormat, content.prettyFormat);
+    std::swap(this->layoutVersion, content.layoutVersion);
+    std::swap(this->layoutAligned, content.layoutAligned);
+    this->tokens.swap(content.tokens);
+    this->blocks.swap(content.blocks);
+    this->tokenValues.swap(content.tokenValues);
+    this->tokenErrors.swap(content.tokenErrors);
+    this->deletedTokens.swap(content.deletedTokens);
+    this->tokenBlocks.swap(content.tokenBlocks);
+    this->blockParents.swap(content.blockParents);
+    this->blocksByStart.swap(content.blocksByStart);
+    this->hashTokens.swap(content.hashTokens);
+    this->blockLayouts.swap(content.blockLayouts);
+}
+void ParsedContent::Clear()
+{
+    this->tokens.clear();
+    this->blocks.clear();
+    this->tokenValues.clear();
+    this->tokenErrors.clear();
+    this->deletedTokens.clear();
+    this->tokenBlocks.clear();
+    this->blockParents.clear();
+    this->blocksByStart.clear();
+    this->hashTokens.clear();
+    this->blockLayouts.clear();
+    this->lastLineNumber = 0;
+    this->noItemsVisible = true;
+}
+void ParsedContent::ComputeLineNumbers()
+{
+    // the list of tokens and blocks has just been created so we know for sure that everything is expanded
+    auto lastY  = -1;
+    auto lineNo = 0;
+    for (auto& tok : this->tokens)
+    {
+        if (tok.pos.y != lastY)
+        {
+            lineNo++;
+            lastY = tok.pos.y;
+        }
+        tok.lineNo = lineNo;
+    }
+    // at the end --> lineNo is the highest line number
+    this->lastLineNumber = lineNo;
+}
+void ParsedContent::ComputeBlockIndex()
+{
+    // blocks are opened (and closed) in the order of their tokens --> the innermost block of a token is the
+    // last one (still open) that started before it
+    const auto blocksCount = static_cast<uint32>(this->blocks.size());
+    std::vector<uint32> openBlocks;
+    this->tokenBlocks.assign(this->tokens.size(), BlockObject::INVALID_ID);
+    this->blockParents.assign(blocksCount, BlockObject::INVALID_ID);
+    this->blocksByStart.clear();
+    for (auto idx = 0U; idx < static_cast<uint32>(this->tokens.size()); idx++)
+    {
+        while ((!openBlocks.empty()) && (this->blocks[openBlocks.back()].GetEndIndex() <= idx))
+            openBlocks.pop_back();
+        const auto& tok = this->tokens[idx];
+        if ((tok.IsBlockStarter()) && (tok.blockID < blocksCount))
+        {
+            this->blockParents[tok.blockID] = openBlocks.empty() ? BlockObject::INVALID_ID : openBlocks.back();
+            openBlocks.push_back(tok.blockID);
+            this->blocksByStart.push_back(tok.blockID);
+        }
+        if (!openBlocks.empty())
+            this->tokenBlocks[idx] = openBlocks.back();
+    }
+}
+void ParsedContent::AnalyzeText()
+{
+    TokensListBuilder tokensList(this);
+    BlocksListBuilder blockList(this);
+    TextParser textParser(this->text.text, this->text.size);
+    SyntaxManager syntax(textParser, tokensList, blockList);
+    this->settings->parser->AnalyzeText(syntax);
+}
+bool ParsedContent::AnalyzeFragment(Reference<SettingsData> _settings, u16string_view fragment)
+{
+    // parses only a part of a text that was already preprocessed (offsets are relative to the start of the fragment)
+    Clear();
+    this->text.Destroy();
+    this->settings = _settings;
+    if (fragment.empty())
+        return true;
+    const auto sz = static_cast<uint32>(fragment.size());
+    this->text    = UnicodeString(new char16[sz], sz, sz);
+    memcpy(this->text.text, fragment.data(), sz * sizeof(char16));
+
+    // if the preprocessor changes the fragment, its offsets can not be mapped back to the text
+    TextEditorBuilder ted(this->text);
+    this->settings->parser->PreprocessText(ted);
+    this->text = ted.Release();
+    if ((this->text.size != sz) || (memcmp(this->text.text, fragment.data(), sz * sizeof(char16)) != 0))
+        return false;
+
+    AnalyzeText();
+    return true;
+}
+
+ParseTask::ParseTask() : stage(ParseStage::Done), stop(false), finished(false)
+{
+}
+ParseTask::~ParseTask()
+{
+    Stop();
+}
+bool ParseTask::Start(UnicodeString& text, Reference<SettingsData> settings, bool prettyFormat)
+{
+    Stop();
+    CHECK(settings.IsValid() && settings->parser, false, "Expecting a valid parser !");
+
+    // the worker parses its own copy of the text (the original one is shown until the worker finishes)
+    this->content  = std::make_unique<ParsedContent>();
+    auto& c        = *this->content;
+    c.settings     = settings;
+    c.prettyFormat = prettyFormat;
+    c.showMetaData = true; // has to be true at this point to proper compute line numbers
+    c.text         = text.Clone();
+    CHECK((text.size == 0) || (c.text.text != nullptr), false, "Fail to copy the text (%u characters)", text.size);
+
+    this->stage    = ParseStage::Preprocess;
+    this->stop     = false;
+    this->finished = false;
+    this->worker   = std::thread(&ParseTask::Run, this);
+    return true;
+}
+void ParseTask::Run()
+{
+    // a plugin can not be interrupted --> the stop request is only checked between the steps
+    auto& c     = *this->content;
+    auto parser = c.settings->parser;
+
+    // step 1 (run the preprocessor)
+    TextEditorBuilder ted(c.text);
+    parser->PreprocessText(ted);
+    c.text = ted.Release();
+
+    // step 2 (run the analyzer)
+    if (!this->stop)
+    {
+        this->stage = ParseStage::Analyze;
+        c.AnalyzeText();
+    }
+
+    // step 3 (sizes, hashes, layout and line numbers)
+    if (!this->stop)
+    {
+        this->stage = ParseStage::Layout;
+        c.UpdateTokensInformation();
+        c.ComputeBlockIndex();
+        c.ComputeLayout();
+        c.ComputeLineNumbers();
+        // line numbers are computed with everything expanded --> the blocks that start folded are laid out again
+        if (c.FoldDeferredBlocks())
+            c.ComputeLayout();
+    }
+    this->stage = ParseStage::Done;
+    this->finished.store(true, std::memory_order_release);
+}
+void ParseTask::Stop()
+{
+    this->stop = true;
+    if (this->worker.joinable())
+        this->worker.join();
+    this->content.reset();
+}
+void ParseTask::Cancel()
+{
+    // the worker is not waited for (a plugin can not be interrupted) - it is joined (and its result discarded) by TakeResult
+    // once it finishes
+    this->stop = true;
+}
+std::unique_ptr<ParsedContent> ParseTask::TakeResult()
+{
+    if (this->worker.joinable())
+        this->worker.join();
+    if (this->stop)
+        this->content.reset();
+    return std::move(this->content);
+}
+} // namespace GView::View::LexicalViewer
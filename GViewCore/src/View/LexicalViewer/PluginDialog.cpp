@@ -7,6 +7,7 @@ using namespace AppCUI::Input;
 
 constexpr int32 BTN_ID_RUN      = 1;
 constexpr int32 BTN_ID_CANCEL   = 2;
+constexpr int32 BTN_ID_PIPELINE = 3;
 constexpr int32 APPLY_GROUP_ID  = 1234;
 constexpr uint64 INVALID_PLUGIN = 0xFFFFFFFFFFFFFFFFULL;
 
@@ -17,14 +18,17 @@ PluginDialog::PluginDialog(
       uint32 _selectionEnd,
       uint32 _blockStart,
       uint32 _blockEnd)
-    : Window("Plugins", "d:c,w:70,h:24", WindowFlags::ProcessReturn), pluginData(data), settings(_settings),
+    : Window("Plugins", "d:c,w:70,h:25", WindowFlags::ProcessReturn), pluginData(data), settings(_settings),
       afterActionRequest(PluginAfterActionRequest::None), selectionStart(_selectionStart), selectionEnd(_selectionEnd),
       blockStart(_blockStart), blockEnd(_blockEnd)
 {
-    this->lstPlugins          = Factory::ListView::Create(this, "l:1,t:1,r:1,b:9", { "w:25,a:l,n:Name","w:3,a:c,n:#", "w:200,a:l,n:Descrition" });
-    this->rbRunOnEntireFile   = Factory::RadioBox::Create(this, "Run the plugin for the entire &program", "l:1,b:7,w:60", APPLY_GROUP_ID);
-    this->rbRunOnCurrentBlock = Factory::RadioBox::Create(this, "Run the plugin for current &block", "l:1,b:6,w:60", APPLY_GROUP_ID);
-    this->rbRunOnSelection    = Factory::RadioBox::Create(this, "Run the plugin over the &selected tokens", "l:1,b:5,w:60", APPLY_GROUP_ID);
+    // the checked plugins form a pipeline (they are executed in the order from the list)
+    this->lstPlugins = Factory::ListView::Create(
+          this, "l:1,t:1,r:1,b:10", { "w:25,a:l,n:Name", "w:3,a:c,n:#", "w:200,a:l,n:Descrition" }, ListViewFlags::CheckBoxes);
+    this->rbRunOnEntireFile   = Factory::RadioBox::Create(this, "Run the plugin for the entire &program", "l:1,b:8,w:60", APPLY_GROUP_ID);
+    this->rbRunOnCurrentBlock = Factory::RadioBox::Create(this, "Run the plugin for current &block", "l:1,b:7,w:60", APPLY_GROUP_ID);
+    this->rbRunOnSelection    = Factory::RadioBox::Create(this, "Run the plugin over the &selected tokens", "l:1,b:6,w:60", APPLY_GROUP_ID);
+    this->cbRepeatPipeline    = Factory::CheckBox::Create(this, "Repeat the pipeline &until nothing changes", "l:1,b:4,w:60");
     this->cbOpenInNewWindow   = Factory::CheckBox::Create(this, "Open result in &new window", "l:1,b:3,w:60");
 
     this->cbOpenInNewWindow->SetEnabled(false); // for the moment
@@ -43,9 +47,10 @@ PluginDialog::PluginDialog(
     }
 
     // buttons
-    Factory::Button::Create(this, "&Run", "l:21,b:0,w:13", BTN_ID_RUN);
-    Factory::Button::Create(this, "&Cancel", "l:36,b:0,w:13", BTN_ID_CANCEL);
-    
+    Factory::Button::Create(this, "&Run", "l:11,b:0,w:13", BTN_ID_RUN);
+    Factory::Button::Create(this, "Run pipe&line", "l:26,b:0,w:17", BTN_ID_PIPELINE);
+    Factory::Button::Create(this, "&Cancel", "l:45,b:0,w:13", BTN_ID_CANCEL);
+
     // update plugin data
     UpdatePluginData();
 }
@@ -109,6 +114,22 @@ void PluginDialog::RunPlugin()
     this->afterActionRequest = this->settings->plugins[idx]->Execute(this->pluginData);
     Exit(Dialogs::Result::Ok);
 }
+void PluginDialog::RunPipeline()
+{
+    // the plugins are executed later (every one of them has to see the text modified by the previous ones)
+    this->pipeline.clear();
+    for (auto index = 0U; index < static_cast<uint32>(this->settings->plugins.size()); index++)
+    {
+        if (this->lstPlugins->GetItem(index).IsChecked())
+            this->pipeline.push_back(index);
+    }
+    if (this->pipeline.empty())
+    {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "Check the plugins that should be executed (in the order from the list) !");
+        return;
+    }
+    Exit(Dialogs::Result::Ok);
+}
 bool PluginDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
 {
     switch (eventType)
@@ -122,6 +143,9 @@ bool PluginDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
         case BTN_ID_RUN:
             RunPlugin();
             return true;
+        case BTN_ID_PIPELINE:
+            RunPipeline();
+            return true;
         }
         break;
     case Event::ListViewItemPressed:
@@ -0,0 +1,288 @@
+#include "LexicalViewer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace GView::View::LexicalViewer
+{
+
+using namespace AppCUI::Input;
+
+constexpr uint32 MAX_PIPELINE_ROUNDS = 16; // a pipeline that is repeated stops after this many rounds (even if the text still changes)
+constexpr int32 BTN_ID_OK            = 1;
+
+namespace
+{
+    uint64 ElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+    void ChangesToTextEdits(const std::vector<TextEditorBuilder::Change>& changes, std::vector<TextEdit>& edits)
+    {
+        // a change has the offset from the text at that moment (after all previous changes) --> the edits that it touches are
+        // merged with it and the ones after it are shifted
+        edits.clear();
+        for (const auto& change : changes)
+        {
+            const auto start = change.offset;
+            const auto end   = change.offset + change.removed;
+            auto first       = std::lower_bound(
+                  edits.begin(), edits.end(), start, [](const TextEdit& edit, uint32 offset) { return edit.newEnd < offset; });
+            auto last = first;
+            while ((last != edits.end()) && (last->newStart <= end))
+                last++;
+
+            // the offsets before the first edit (or after the last one) are shifted with the size difference of the edits before them
+            const auto shiftBefore = first == edits.begin() ? 0 : static_cast<int64>((first - 1)->newEnd) - (first - 1)->oldEnd;
+            TextEdit merged{ static_cast<uint32>(start - shiftBefore), static_cast<uint32>(end - shiftBefore), start, end };
+            if (first != last)
+            {
+                const auto& lastEdit = *(last - 1);
+                const auto shift     = static_cast<int64>(lastEdit.newEnd) - lastEdit.oldEnd;
+                if (first->newStart <= start)
+                {
+                    merged.oldStart = first->oldStart;
+                    merged.newStart = first->newStart;
+                }
+                if (lastEdit.newEnd >= end)
+                {
+                    merged.oldEnd = lastEdit.oldEnd;
+                    merged.newEnd = lastEdit.newEnd;
+                }
+                else
+                {
+                    merged.oldEnd = static_cast<uint32>(end - shift);
+                }
+            }
+            merged.newEnd = merged.newEnd - change.removed + change.inserted;
+            for (auto it = last; it != edits.end(); it++)
+            {
+                it->newStart = it->newStart - change.removed + change.inserted;
+                it->newEnd   = it->newEnd - change.removed + change.inserted;
+            }
+            first = edits.erase(first, last);
+            if ((merged.oldStart != merged.oldEnd) || (merged.newStart != merged.newEnd))
+                edits.insert(first, merged);
+        }
+    }
+    uint32 MapOffset(uint32 offset, const std::vector<TextEdit>& edits, bool rangeEnd)
+    {
+        // an offset from an edit (or from its margins) is moved to the margin of the new text --> the range contains the new text
+        auto shift = static_cast<int64>(0);
+        for (const auto& edit : edits)
+        {
+            if (offset < edit.oldStart)
+                break;
+            if (offset <= edit.oldEnd)
+                return rangeEnd ? edit.newEnd : edit.newStart;
+            shift = static_cast<int64>(edit.newEnd) - edit.oldEnd;
+        }
+        return static_cast<uint32>(offset + shift);
+    }
+    bool TokenStartsBefore(const TokenObject& tok, uint32 offset)
+    {
+        return tok.start < offset;
+    }
+} // namespace
+
+PluginPipeline::PluginPipeline(const ParsedContent& source, uint32 startIndex, uint32 endIndex) : changed(false), finished(false)
+{
+    // the plugins modify a copy of the tokens (the original ones are shown until the pipeline ends)
+    content.settings = source.settings;
+    content.text     = source.text.Clone();
+    content.tokens   = source.tokens;
+    content.blocks   = source.blocks;
+    for (const auto& [index, value] : source.tokenValues)
+        content.tokenValues[index].Set(value.ToStringView());
+    for (const auto& [index, error] : source.tokenErrors)
+        content.tokenErrors[index].Set(error.ToStringView());
+    content.deletedTokens = source.deletedTokens;
+    content.ComputeHashIndex();
+    content.ComputeBlockIndex();
+
+    // the range is kept as offsets (the indexes of the tokens change after every plugin)
+    const auto count = static_cast<uint32>(content.tokens.size());
+    if ((startIndex == 0) && (endIndex >= count))
+    {
+        rangeStart = 0;
+        rangeEnd   = content.text.size;
+    }
+    else
+    {
+        endIndex   = std::min<>(endIndex, count);
+        rangeStart = startIndex < endIndex ? content.tokens[startIndex].start : 0;
+        rangeEnd   = startIndex < endIndex ? content.tokens[endIndex - 1].end : 0;
+    }
+}
+void PluginPipeline::Run(const std::vector<uint32>& plugins, bool repeat)
+{
+    for (auto round = 1U; round <= MAX_PIPELINE_ROUNDS; round++)
+    {
+        auto roundChanges = false;
+        for (auto pluginIndex : plugins)
+            roundChanges |= RunStage(round, pluginIndex);
+        if ((!repeat) || (!roundChanges))
+        {
+            finished = true;
+            return;
+        }
+    }
+}
+bool PluginPipeline::RunStage(uint32 round, uint32 pluginIndex)
+{
+    CHECK(pluginIndex < content.settings->plugins.size(), false, "Invalid plugin index: %u", pluginIndex);
+    auto plugin = content.settings->plugins[pluginIndex];
+    auto& stage = stages.emplace_back(PluginPipelineStage{ round, pluginIndex, 0, false, false, 0, 0 });
+
+    auto textClone = content.text.Clone();
+    TextEditorBuilder ted(textClone);
+    TokensListBuilder tokensList(&content);
+    BlocksListBuilder blockList(&content);
+    PluginData pd(ted, tokensList, blockList);
+    const auto tokensCount = static_cast<uint32>(content.tokens.size());
+    const auto blocksCount = content.blocks.size();
+    pd.startIndex          = static_cast<uint32>(
+          std::lower_bound(content.tokens.begin(), content.tokens.end(), rangeStart, TokenStartsBefore) - content.tokens.begin());
+    pd.endIndex = static_cast<uint32>(
+          std::lower_bound(content.tokens.begin(), content.tokens.end(), rangeEnd, TokenStartsBefore) - content.tokens.begin());
+    pd.currentTokenIndex = pd.startIndex;
+    ted.RecordChanges();
+
+    if (!plugin->CanBeAppliedOn(pd))
+    {
+        ted.Release().Destroy();
+        return false;
+    }
+    stage.applied     = true;
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = plugin->Execute(pd);
+    stage.executeTime = ElapsedMicroseconds(start);
+
+    // the new values of the tokens are written in the text (the next plugins can only see the text)
+    std::vector<TextEdit> edits;
+    UnicodeString newText;
+    switch (result)
+    {
+    case PluginAfterActionRequest::Refresh:
+        ted.Release().Destroy();
+        if (!content.RebuildTextFromTokens(newText, edits))
+            return false;
+        break;
+    case PluginAfterActionRequest::Rescan:
+        newText = ted.Release();
+        if (ted.GetChanges())
+            ChangesToTextEdits(*ted.GetChanges(), edits);
+        else
+            edits = content.ComputeTextEdits(newText);
+        break;
+    default:
+        ted.Release().Destroy();
+        return false;
+    }
+
+    // a part of the text can be replaced with the same text
+    std::erase_if(
+          edits,
+          [this, &newText](const TextEdit& edit)
+          {
+              return u16string_view{ content.text.text + edit.oldStart, edit.oldEnd - edit.oldStart } ==
+                     u16string_view{ newText.text + edit.newStart, edit.newEnd - edit.newStart };
+          });
+    if (edits.empty())
+    {
+        newText.Destroy();
+        return false;
+    }
+    stage.edits      = static_cast<uint32>(edits.size());
+    const auto range = rangeStart < rangeEnd;
+    rangeStart       = MapOffset(rangeStart, edits, false);
+    rangeEnd         = range ? MapOffset(rangeEnd, edits, true) : rangeStart;
+
+    // tokens or blocks added by the plugin can not be mapped to the old ones
+    UpdateTokens(newText, edits, (content.tokens.size() == tokensCount) && (content.blocks.size() == blocksCount), stage);
+    changed = true;
+    return true;
+}
+void PluginPipeline::UpdateTokens(UnicodeString& newText, const std::vector<TextEdit>& edits, bool sameTokens, PluginPipelineStage& stage)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<TokensSplice> splices;
+    if ((sameTokens) && (!content.tokens.empty()) && (content.ComputeTokensSplices(newText, edits, splices)))
+    {
+        auto tokenIndex = 0U;
+        content.SpliceTokens(newText, edits, splices, tokenIndex);
+    }
+    else
+    {
+        content.Clear();
+        content.text.Destroy();
+        TextEditorBuilder ted(newText);
+        content.settings->parser->PreprocessText(ted);
+        content.text = ted.Release();
+        content.AnalyzeText();
+        content.UpdateTokensInformation();
+        content.ComputeBlockIndex();
+        rangeEnd       = std::min<>(rangeEnd, content.text.size);
+        stage.fullScan = true;
+    }
+    stage.tokenizeTime = ElapsedMicroseconds(start);
+}
+UnicodeString PluginPipeline::ReleaseText()
+{
+    auto result  = content.text;
+    content.text = UnicodeString();
+    content.Clear();
+    return result;
+}
+
+PluginPipelineDialog::PluginPipelineDialog(const PluginPipeline& pipeline, Reference<SettingsData> settings)
+    : Window("Plugin pipeline", "d:c,w:80,h:20", WindowFlags::ProcessReturn)
+{
+    LocalString<64> tmp;
+    LocalString<64> tmp2;
+    auto lst = Factory::ListView::Create(
+          this,
+          "l:1,t:0,r:1,b:3",
+          { "n:Round,a:r,w:6", "n:Plugin,a:l,w:25", "n:Result,a:l,w:20", "n:Plugin time,a:r,w:12", "n:Tokens time,a:r,w:12" },
+          ListViewFlags::HideSearchBar);
+
+    auto executeTime  = 0ULL;
+    auto tokenizeTime = 0ULL;
+    for (const auto& stage : pipeline.GetStages())
+    {
+        auto item = lst->AddItem(tmp.Format("%u", stage.round));
+        item.SetText(1, settings->plugins[stage.plugin]->GetName());
+        if (!stage.applied)
+            item.SetText(2, "Not applied");
+        else if (stage.edits == 0)
+            item.SetText(2, "No changes");
+        else
+            item.SetText(2, tmp.Format("%u edits (%s)", stage.edits, stage.fullScan ? "full" : "partial"));
+        item.SetText(3, tmp.Format("%llu.%03llu ms", stage.executeTime / 1000, stage.executeTime % 1000));
+        item.SetText(4, tmp2.Format("%llu.%03llu ms", stage.tokenizeTime / 1000, stage.tokenizeTime % 1000));
+        executeTime += stage.executeTime;
+        tokenizeTime += stage.tokenizeTime;
+    }
+    auto total = lst->AddItem("");
+    total.SetText(1, "Total");
+    total.SetText(2, pipeline.IsFinished() ? "" : "Stopped (too many rounds)");
+    total.SetText(3, tmp.Format("%llu.%03llu ms", executeTime / 1000, executeTime % 1000));
+    total.SetText(4, tmp2.Format("%llu.%03llu ms", tokenizeTime / 1000, tokenizeTime % 1000));
+    total.SetType(ListViewItem::Type::Emphasized_1);
+
+    Factory::Button::Create(this, "&OK", "l:33,b:0,w:13", BTN_ID_OK);
+}
+bool PluginPipelineDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+    case Event::WindowAccept:
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Ok);
+        return true;
+    }
+    return false;
+}
+} // namespace GView::View::LexicalViewer
@@ -0,0 +1,107 @@
+#include "LexicalViewer.hpp"
+
+namespace GView::View::LexicalViewer
+{
+void RowIndex::Clear()
+{
+    this->visibleTokens.clear();
+    this->firstOnRow.clear();
+    this->endOnRow.clear();
+}
+void RowIndex::Build(const std::vector<TokenObject>& tokens)
+{
+    // called after the tokens were laid out (positions and visibility will not change until the next layout)
+    Clear();
+    size_t rows = 0;
+    uint32 idx  = 0;
+    for (const auto& tok : tokens)
+    {
+        if (tok.IsVisible())
+        {
+            this->visibleTokens.push_back(idx);
+            rows = std::max<size_t>(rows, static_cast<size_t>(std::max<int32>(0, tok.pos.y)) + std::max<uint32>(1, tok.pos.height));
+        }
+        idx++;
+    }
+
+    const auto count = static_cast<uint32>(this->visibleTokens.size());
+    this->firstOnRow.assign(rows, count);
+    this->endOnRow.assign(rows, 0);
+    for (uint32 pos = 0; pos < count; pos++)
+    {
+        const auto& tok   = tokens[this->visibleTokens[pos]];
+        const auto top    = static_cast<size_t>(std::max<int32>(0, tok.pos.y));
+        const auto bottom = top + std::max<uint32>(1, tok.pos.height) - 1;
+        this->firstOnRow[bottom] = std::min<>(this->firstOnRow[bottom], pos);
+        this->endOnRow[top]      = std::max<>(this->endOnRow[top], pos + 1);
+    }
+    // tokens are usually laid out in order, but nothing requires that --> every row also covers the tokens that end after it
+    // (or start before it)
+    for (size_t row = rows; row > 1; row--)
+        this->firstOnRow[row - 2] = std::min<>(this->firstOnRow[row - 2], this->firstOnRow[row - 1]);
+    for (size_t row = 1; row < rows; row++)
+        this->endOnRow[row] = std::max<>(this->endOnRow[row], this->endOnRow[row - 1]);
+}
+void RowIndex::Update(const std::vector<TokenObject>& tokens, uint32 firstToken)
+{
+    // called after only the tokens starting with 'firstToken' (a visible one) were laid out again or moved - with the pretty
+    // format a visible token never starts on a row before the one of the token before it, so the rows before the one of
+    // 'firstToken' are kept and only the rows after it are computed again
+    auto top    = [&tokens](uint32 idx) { return static_cast<size_t>(std::max<int32>(0, tokens[idx].pos.y)); };
+    auto bottom = [&tokens, &top](uint32 idx) { return top(idx) + std::max<uint32>(1, tokens[idx].pos.height) - 1; };
+    if ((firstToken >= tokens.size()) || (!tokens[firstToken].IsVisible()) || (top(firstToken) >= this->firstOnRow.size()))
+    {
+        Build(tokens);
+        return;
+    }
+    const auto firstRow = top(firstToken);
+    const auto kept     = std::lower_bound(this->visibleTokens.begin(), this->visibleTokens.end(), firstToken);
+    const auto keptSize = static_cast<uint32>(kept - this->visibleTokens.begin());
+    // the rows reached by the (multi-line) tokens before 'firstToken' - 'firstOnRow' is sorted
+    const auto keptRows = static_cast<size_t>(
+          std::partition_point(
+                this->firstOnRow.begin() + firstRow, this->firstOnRow.end(), [keptSize](uint32 pos) { return pos < keptSize; }) -
+          this->firstOnRow.begin());
+    auto rows = std::max<size_t>(firstRow + 1, keptRows);
+    this->visibleTokens.erase(kept, this->visibleTokens.end());
+    for (auto idx = firstToken; idx < static_cast<uint32>(tokens.size()); idx++)
+    {
+        if (tokens[idx].IsVisible())
+        {
+            this->visibleTokens.push_back(idx);
+            rows = std::max<size_t>(rows, bottom(idx) + 1);
+        }
+    }
+
+    const auto count = static_cast<uint32>(this->visibleTokens.size());
+    this->firstOnRow.resize(rows);
+    this->endOnRow.resize(rows);
+    std::fill(this->firstOnRow.begin() + keptRows, this->firstOnRow.end(), count);
+    std::fill(this->endOnRow.begin() + firstRow, this->endOnRow.end(), keptSize); // the tokens before start on these rows or before
+    for (auto pos = keptSize; pos < count; pos++)
+    {
+        const auto tokenTop    = top(this->visibleTokens[pos]);
+        const auto tokenBottom = bottom(this->visibleTokens[pos]);
+        this->firstOnRow[tokenBottom] = std::min<>(this->firstOnRow[tokenBottom], pos);
+        this->endOnRow[tokenTop]      = std::max<>(this->endOnRow[tokenTop], pos + 1);
+    }
+    for (auto row = rows; row > firstRow + 1; row--)
+        this->firstOnRow[row - 2] = std::min<>(this->firstOnRow[row - 2], this->firstOnRow[row - 1]);
+    for (auto row = firstRow + 1; row < rows; row++)
+        this->endOnRow[row] = std::max<>(this->endOnRow[row], this->endOnRow[row - 1]);
+}
+std::span<const uint32> RowIndex::GetTokens(int32 firstRow, int32 lastRow) const
+{
+    // indexes (in ascending order) of the visible tokens that might intersect the rows from [firstRow, lastRow]
+    const auto rows = static_cast<int32>(this->firstOnRow.size());
+    firstRow        = std::max<>(firstRow, 0);
+    lastRow         = std::min<>(lastRow, rows - 1);
+    if (firstRow > lastRow)
+        return {};
+    const auto start = this->firstOnRow[firstRow];
+    const auto end   = this->endOnRow[lastRow];
+    if (start >= end)
+        return {};
+    return std::span<const uint32>(this->visibleTokens.data() + start, end - start);
+}
+} // namespace GView::View::LexicalViewer
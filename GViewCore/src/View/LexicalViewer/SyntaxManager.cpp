@@ -2,7 +2,7 @@
 
 namespace GView::View::LexicalViewer
 {
-#define INSTANCE reinterpret_cast<Instance*>(this->data)
+#define INSTANCE reinterpret_cast<ParsedContent*>(this->data)
 #define CREATE_TOKENREF(err)                                                                                                               \
     if (this->data == nullptr)                                                                                                             \
         return (err);                                                                                                                      \
@@ -161,18 +161,18 @@ bool Token::DisableSimilartyHighlight()
 bool Token::SetText(const ConstString& text)
 {
     CREATE_TOKENREF(false);
-    return tok.value.Set(text);
+    return INSTANCE->SetTokenValue(this->index, text);
 }
 bool Token::SetError(const ConstString& error)
 {
     CREATE_TOKENREF(false);
     tok.color = TokenColor::Error;
-    return tok.error.Set(error);
+    return INSTANCE->SetTokenError(this->index, error);
 }
 bool Token::Delete()
 {
     CREATE_TOKENREF(false);
-    tok.SetShouldDeleteFlag();
+    INSTANCE->MarkTokenForDeletion(this->index);
     return true;
 }
 std::optional<uint32> Token::GetTokenStartOffset() const
@@ -186,15 +186,10 @@ std::optional<uint32> Token::GetTokenEndOffset() const
     return tok.end;
 }
 // Token Object
-void TokenObject::UpdateSizes(const char16* text)
+void TokenObject::UpdateSizes(u16string_view content)
 {
-    const char16* p = text + start;
-    const char16* e = text + end;
-    if (this->value.Len() > 0)
-    {
-        p = this->value.GetString();
-        e = this->value.GetString() + this->value.Len();
-    }
+    const char16* p = content.data();
+    const char16* e = p + content.size();
     auto nrLines = 1U;
     auto w       = 0U;
     auto maxW    = 0U;
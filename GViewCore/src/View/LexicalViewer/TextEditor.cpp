@@ -34,14 +34,27 @@ const uint8 string_lowercase_table[256] = {
     {                                                                                                                                      \
         memcpy(this->text + offset, (source), (len) * sizeof(char16));                                                                     \
     }
+
+// edits that move more characters than this are kept as pieces (see TextEditor::Piece)
+#define USE_PIECES(tailOffset) ((HasPieces()) || ((this->size - (tailOffset)) > MAX_CHARACTERS_TO_MOVE))
+
 // max 1G char15 chars = 2G memory
 constexpr uint32 MAX_MEMORY_TO_ALLOCATE = 0x40000000;
+constexpr uint32 MAX_CHARACTERS_TO_MOVE = 0x1000; // 8K memory
 char16 indexOperatorTempChar            = 0;
 TextEditor::TextEditor()
 {
-    this->text      = nullptr;
-    this->size      = 0;
-    this->allocated = 0;
+    this->text           = nullptr;
+    this->size           = 0;
+    this->allocated      = 0;
+    this->cursorOffset   = 0;
+    this->recordChanges  = false;
+    this->unknownChanges = false;
+}
+void TextEditor::RecordChange(uint32 offset, uint32 removed, uint32 inserted)
+{
+    if ((this->recordChanges) && ((removed > 0) || (inserted > 0)))
+        this->changes.push_back(Change{ offset, removed, inserted });
 }
 bool TextEditor::Grow(size_t newSize)
 {
@@ -67,16 +80,176 @@ bool TextEditor::Grow(size_t newSize)
         return false;
     }
 }
+void TextEditor::SeekPiece(uint32 offset)
+{
+    // moves the cursor to the start of the piece that contains 'offset' (the first piece after the cursor)
+    while (this->cursorOffset > offset)
+    {
+        const auto piece = this->piecesBefore.back();
+        this->piecesBefore.pop_back();
+        this->piecesAfter.push_back(piece);
+        this->cursorOffset -= piece.size;
+    }
+    while ((!this->piecesAfter.empty()) && (this->cursorOffset + this->piecesAfter.back().size <= offset))
+    {
+        const auto piece = this->piecesAfter.back();
+        this->piecesAfter.pop_back();
+        this->piecesBefore.push_back(piece);
+        this->cursorOffset += piece.size;
+    }
+}
+void TextEditor::MoveCursor(uint32 offset)
+{
+    // moves the cursor exactly at 'offset' (the piece that contains it is split)
+    SeekPiece(offset);
+    if (this->cursorOffset < offset)
+    {
+        auto& piece     = this->piecesAfter.back();
+        const auto left = offset - this->cursorOffset;
+        this->piecesBefore.push_back(Piece{ piece.start, left, piece.added });
+        piece.start += left;
+        piece.size -= left;
+        this->cursorOffset = offset;
+    }
+}
+bool TextEditor::SplicePieces(uint32 offset, uint32 count, uint32 addedStart, uint32 addedSize)
+{
+    // 'count' characters from 'offset' are replaced with 'addedSize' characters from the added buffer
+    if ((!HasPieces()) && (this->size > 0))
+    {
+        this->piecesAfter.push_back(Piece{ 0, this->size, false });
+        this->cursorOffset = 0;
+    }
+    count = std::min<>(count, this->size - offset);
+    RecordChange(offset, count, addedSize);
+    MoveCursor(offset);
+    this->size -= count;
+    while (count > 0)
+    {
+        auto& piece = this->piecesAfter.back();
+        if (piece.size > count)
+        {
+            piece.start += count;
+            piece.size -= count;
+            break;
+        }
+        count -= piece.size;
+        this->piecesAfter.pop_back();
+    }
+    if (addedSize > 0)
+    {
+        // consecutive additions (one after another) are merged in the same piece
+        if ((!this->piecesBefore.empty()) && (this->piecesBefore.back().added) &&
+            (this->piecesBefore.back().start + this->piecesBefore.back().size == addedStart))
+            this->piecesBefore.back().size += addedSize;
+        else
+            this->piecesBefore.push_back(Piece{ addedStart, addedSize, true });
+        this->cursorOffset += addedSize;
+        this->size += addedSize;
+    }
+    if (this->size == 0)
+        ClearPieces();
+    return true;
+}
+bool TextEditor::Splice(uint32 offset, uint32 count, std::string_view newText)
+{
+    if ((size_t) this->size + newText.size() > MAX_MEMORY_TO_ALLOCATE)
+        return false;
+    const auto start = static_cast<uint32>(this->added.size());
+    try
+    {
+        this->added.insert(this->added.end(), newText.begin(), newText.end());
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return SplicePieces(offset, count, start, static_cast<uint32>(newText.size()));
+}
+bool TextEditor::Splice(uint32 offset, uint32 count, std::u16string_view newText)
+{
+    if ((size_t) this->size + newText.size() > MAX_MEMORY_TO_ALLOCATE)
+        return false;
+    const auto start = static_cast<uint32>(this->added.size());
+    try
+    {
+        this->added.insert(this->added.end(), newText.begin(), newText.end());
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return SplicePieces(offset, count, start, static_cast<uint32>(newText.size()));
+}
+bool TextEditor::Flatten()
+{
+    // applies all pending edits (one pass over the pieces)
+    if (!HasPieces())
+        return true;
+    const auto newSize = (static_cast<size_t>(this->size) | 0xFF) + 1;
+    char16* temp       = nullptr;
+    try
+    {
+        temp = new char16[newSize];
+    }
+    catch (...)
+    {
+        return false;
+    }
+    auto* p = temp;
+    for (const auto& piece : this->piecesBefore)
+    {
+        memcpy(p, (piece.added ? this->added.data() : this->text) + piece.start, piece.size * sizeof(char16));
+        p += piece.size;
+    }
+    for (auto it = this->piecesAfter.rbegin(); it != this->piecesAfter.rend(); it++)
+    {
+        memcpy(p, (it->added ? this->added.data() : this->text) + it->start, it->size * sizeof(char16));
+        p += it->size;
+    }
+    delete[] this->text;
+    this->text      = temp;
+    this->allocated = static_cast<uint32>(newSize);
+    ClearPieces();
+    return true;
+}
+void TextEditor::ClearPieces()
+{
+    this->piecesBefore.clear();
+    this->piecesAfter.clear();
+    this->added.clear();
+    this->cursorOffset = 0;
+}
 char16& TextEditor::operator[](uint32 index)
+{
+    // the character can be modified by the caller --> it is not known what changed
+    if ((this->recordChanges) && (index < size))
+        this->unknownChanges = true;
+    return CharAt(index);
+}
+char16& TextEditor::CharAt(uint32 index)
 {
     if (index < size)
-        return text[index];
+    {
+        if (!HasPieces())
+            return text[index];
+        SeekPiece(index);
+        const auto& piece = this->piecesAfter.back();
+        const auto pos    = piece.start + index - this->cursorOffset;
+        return piece.added ? this->added[pos] : this->text[pos];
+    }
     else
     {
         indexOperatorTempChar = 0;
         return indexOperatorTempChar;
     };
 }
+TextEditor::operator u16string_view()
+{
+    if (!Flatten())
+        return {};
+    return { text, (size_t) size };
+}
 
 std::optional<uint32> TextEditor::Find(uint32 startOffset, std::string_view textToSearch, bool ignoreCase)
 {
@@ -85,6 +258,28 @@ std::optional<uint32> TextEditor::Find(uint32 startOffset, std::string_view text
     if ((startOffset + textToSearch.size()) > this->size)
         return std::nullopt;
 
+    if (HasPieces())
+    {
+        // pending edits are not applied (the characters are read through the pieces)
+        const auto len = static_cast<uint32>(textToSearch.size());
+        for (auto pos = startOffset; pos + len <= this->size; pos++)
+        {
+            auto idx = 0U;
+            for (; idx < len; idx++)
+            {
+                const char16 ch = CharAt(pos + idx);
+                const char16 c  = static_cast<uint8>(textToSearch[idx]);
+                if (ch == c)
+                    continue;
+                if ((!ignoreCase) || (ch > 0xFF) || (string_lowercase_table[ch] != string_lowercase_table[c]))
+                    break;
+            }
+            if (idx == len)
+                return pos;
+        }
+        return std::nullopt;
+    }
+
     const auto* p      = this->text + startOffset;
     const auto* e      = this->text + size + 1 - textToSearch.size();
     const uint8* txt   = reinterpret_cast<const uint8*>(textToSearch.data());
@@ -140,9 +335,12 @@ bool TextEditor::Insert(uint32 offset, std::string_view newText)
         return false;
     if (offset == size)
         return Add(newText);
+    if (USE_PIECES(offset))
+        return Splice(offset, 0, newText);
     GROW_TO(size + newText.size());
     memmove(this->text + offset + newText.size(), this->text + offset, (this->size - offset) * sizeof(char16));
     COPY_ASCII(offset, newText.data(), newText.size());
+    RecordChange(offset, 0, static_cast<uint32>(newText.size()));
     size += static_cast<uint32>(newText.size());
     return true;
 }
@@ -154,22 +352,28 @@ bool TextEditor::Insert(uint32 offset, std::u16string_view newText)
         return false;
     if (offset == size)
         return Add(newText);
+    if (USE_PIECES(offset))
+        return Splice(offset, 0, newText);
     GROW_TO(size + newText.size());
     memmove(this->text + offset + newText.size(), this->text + offset, (this->size - offset) * sizeof(char16));
     COPY_UNICODE16(offset, newText.data(), newText.size());
+    RecordChange(offset, 0, static_cast<uint32>(newText.size()));
     size += static_cast<uint32>(newText.size());
     return true;
 }
 bool TextEditor::InsertChar(uint32 offset, char16 ch)
 {
-    GROW_TO(size + 1);
     if (offset > size)
         return false;
+    if (USE_PIECES(offset))
+        return Splice(offset, 0, std::u16string_view{ &ch, 1 });
+    GROW_TO(size + 1);
     if (offset < size)
     {
         memmove(this->text + offset + 1, this->text + offset, (size - offset) * sizeof(char16));
     }
     text[offset] = ch;
+    RecordChange(offset, 0, 1);
     size++;
     return true;
 }
@@ -179,9 +383,15 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::string_view newText)
         return false;
     if (offset + count >= size)
     {
+        if (HasPieces())
+            return Splice(offset, size - offset, newText);
+        RecordChange(offset, this->size - offset, 0);
         this->size = offset;
         return Add(newText);
     }
+    // a replacement with the same size does not move anything
+    if ((HasPieces()) || ((newText.size() != (size_t) count) && (USE_PIECES(offset + count))))
+        return Splice(offset, count, newText);
     if (newText.size() > (size_t) count)
     {
         GROW_TO((size_t) size + newText.size() - (size_t) count);
@@ -194,6 +404,7 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::string_view newText)
         this->size -= (uint32) ((size_t) count - newText.size());
     }
     COPY_ASCII(offset, newText.data(), newText.size());
+    RecordChange(offset, count, static_cast<uint32>(newText.size()));
     return true;
 }
 bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newText)
@@ -202,9 +413,15 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newTex
         return false;
     if (offset + count >= size)
     {
+        if (HasPieces())
+            return Splice(offset, size - offset, newText);
+        RecordChange(offset, this->size - offset, 0);
         this->size = offset;
         return Add(newText);
     }
+    // a replacement with the same size does not move anything
+    if ((HasPieces()) || ((newText.size() != (size_t) count) && (USE_PIECES(offset + count))))
+        return Splice(offset, count, newText);
     if (newText.size() > (size_t) count)
     {
         GROW_TO((size_t) size + newText.size() - (size_t) count);
@@ -217,35 +434,70 @@ bool TextEditor::Replace(uint32 offset, uint32 count, std::u16string_view newTex
         this->size -= (uint32) ((size_t) count - newText.size());
     }
     COPY_UNICODE16(offset, newText.data(), newText.size());
+    RecordChange(offset, count, static_cast<uint32>(newText.size()));
     return true;
 }
 bool TextEditor::ReplaceAll(std::string_view textToSearch, std::string_view textToReplaceWith, bool ignoreCase)
 {
     if ((textToSearch.empty()) || (this->size == 0))
         return false;
+    if (!Flatten())
+        return false;
 
-    auto pos = 0;
-    auto len = static_cast<uint32>(textToSearch.size());
+    // all matches are found first and the new text is built in one pass
+    std::vector<uint32> matches;
+    const auto len = static_cast<uint32>(textToSearch.size());
+    auto res       = Find(0, textToSearch, ignoreCase);
+    while (res.has_value())
+    {
+        matches.push_back(res.value());
+        res = Find(res.value() + len, textToSearch, ignoreCase);
+    }
+    if (matches.empty())
+        return true;
 
-    do
+    const auto newSize = (size_t) this->size + matches.size() * textToReplaceWith.size() - matches.size() * len;
+    if (newSize > MAX_MEMORY_TO_ALLOCATE)
+        return false;
+    const auto newAllocated = (newSize | 0xFF) + 1;
+    char16* temp            = nullptr;
+    try
     {
-        auto res = Find(pos, textToSearch, ignoreCase);
-        if (!res.has_value())
-            break;
-        if (Replace(res.value(), len, textToReplaceWith) == false)
-            return false;
-        pos += len;
-    } while (true);
+        temp = new char16[newAllocated];
+    }
+    catch (...)
+    {
+        return false;
+    }
+    auto* p  = temp;
+    auto pos = 0U;
+    for (auto m : matches)
+    {
+        memcpy(p, this->text + pos, (m - pos) * sizeof(char16));
+        p += m - pos;
+        RecordChange(static_cast<uint32>(p - temp), len, static_cast<uint32>(textToReplaceWith.size()));
+        for (auto ch : textToReplaceWith)
+            *(p++) = static_cast<uint8>(ch);
+        pos = m + len;
+    }
+    memcpy(p, this->text + pos, (this->size - pos) * sizeof(char16));
+    delete[] this->text;
+    this->text      = temp;
+    this->size      = static_cast<uint32>(newSize);
+    this->allocated = static_cast<uint32>(newAllocated);
     return true;
 }
 bool TextEditor::DeleteChar(uint32 offset)
 {
     if (offset >= size)
         return false;
+    if (USE_PIECES(offset + 1))
+        return Splice(offset, 1, std::u16string_view{});
     if (offset + 1 < size)
     {
         memmove(this->text + offset, this->text + offset + 1, (this->size - (offset + 1)) * sizeof(char16));
     }
+    RecordChange(offset, 1, 0);
     size--;
     return true;
 }
@@ -256,38 +508,54 @@ bool TextEditor::Delete(uint32 offset, uint32 charactersCount)
     if ((offset + charactersCount) >= size)
     {
         // last characters to delete
+        if (HasPieces())
+            return Splice(offset, size - offset, std::u16string_view{});
+        RecordChange(offset, size - offset, 0);
         size = offset;
         return true;
     }
+    if (USE_PIECES(offset + charactersCount))
+        return Splice(offset, charactersCount, std::u16string_view{});
     memmove(this->text + offset, this->text + offset + charactersCount, (this->size - (offset + charactersCount)) * sizeof(char16));
+    RecordChange(offset, charactersCount, 0);
     size -= charactersCount;
     return true;
 }
 bool TextEditor::Add(std::string_view newText)
 {
+    if (HasPieces())
+        return Splice(size, 0, newText);
     GROW_TO(newText.size() + size);
     COPY_ASCII(size, newText.data(), newText.size());
+    RecordChange(size, 0, static_cast<uint32>(newText.size()));
     size += static_cast<uint32>(newText.size());
     return true;
 }
 bool TextEditor::Add(std::u16string_view newText)
 {
+    if (HasPieces())
+        return Splice(size, 0, newText);
     GROW_TO(newText.size() + size);
     COPY_UNICODE16(size, newText.data(), newText.size());
+    RecordChange(size, 0, static_cast<uint32>(newText.size()));
     size += static_cast<uint32>(newText.size());
     return true;
 }
 bool TextEditor::Set(std::string_view newText)
 {
+    Clear();
     GROW_TO(newText.size());
     COPY_ASCII(0, newText.data(), newText.size());
+    RecordChange(0, 0, static_cast<uint32>(newText.size()));
     this->size = static_cast<uint32>(newText.size());
     return true;
 }
 bool TextEditor::Set(std::u16string_view newText)
 {
+    Clear();
     GROW_TO(newText.size());
     COPY_UNICODE16(0, newText.data(), newText.size());
+    RecordChange(0, 0, static_cast<uint32>(newText.size()));
     this->size = static_cast<uint32>(newText.size());
     return true;
 }
@@ -297,23 +565,33 @@ bool TextEditor::Resize(uint32 newSize, char16 fillChar)
         return true;
     if (newSize < size)
     {
+        if (HasPieces())
+            return Splice(newSize, size - newSize, std::u16string_view{});
+        RecordChange(newSize, size - newSize, 0);
         size = newSize;
         return true;
     }
+    if (!Flatten())
+        return false;
     GROW_TO(newSize);
     auto* p = this->text + size;
     auto* e = this->text + newSize;
     for (; p < e; p++)
         (*p) = fillChar;
+    RecordChange(size, 0, newSize - size);
     size = newSize;
     return true;
 }
 void TextEditor::Clear()
 {
+    RecordChange(0, this->size, 0);
+    ClearPieces();
     this->size = 0;
 }
 bool TextEditor::Reserve(uint32 newSize)
 {
+    if (!Flatten())
+        return false;
     GROW_TO(newSize);
     return true;
 }
@@ -321,11 +599,9 @@ bool TextEditor::Reserve(uint32 newSize)
 // ================= Builder specific
 bool TextEditorBuilder::Set(const CharacterBuffer& chars)
 {
+    Clear();
     if (chars.IsEmpty())
-    {
-        Clear();
         return true;
-    }
 
     GROW_TO(chars.Len());
     auto* p  = this->text;
@@ -337,8 +613,9 @@ bool TextEditorBuilder::Set(const CharacterBuffer& chars)
         p++;
         ch++;
     }
+    RecordChange(0, 0, chars.Len());
     this->size = chars.Len();
     return true;
 }
 
-} // namespace GView::View::LexicalViewer
\ No newline at end of file
+} // namespace GView::View::LexicalViewer
@@ -149,6 +149,18 @@ uint32 TextParser::Parse(uint32 index, bool (*validate)(char16 character)) const
     }
     return index;
 }
+uint32 TextParser::Parse(uint32 index, const CharacterClasses& classes, uint64 classesMask) const
+{
+    if (index >= size)
+        return size;
+    auto* p = text + index;
+    while ((index < size) && ((CharacterClasses::Mask(classes[*p]) & classesMask) != 0))
+    {
+        index++;
+        p++;
+    }
+    return index;
+}
 uint32 TextParser::ParseBackwards(uint32 index, bool (*validate)(char16 character)) const
 {
     if (index == 0)
@@ -165,6 +177,26 @@ uint32 TextParser::ParseBackwards(uint32 index, bool (*validate)(char16 characte
     }
     return index;
 }
+uint32 TextParser::ParseBackwards(uint32 index, const CharacterClasses& classes, uint64 classesMask) const
+{
+    if (index == 0)
+        return 0;
+    if (index >= size)
+        return size;
+    auto* p = text + index;
+    while ((index > 0) && ((CharacterClasses::Mask(classes[*p]) & classesMask) != 0))
+    {
+        index--;
+        p--;
+    }
+    return index;
+}
+uint32 TextParser::ParseDirective(uint32 index, const CharacterClasses& classes, uint8 nameClass, bool& validName) const
+{
+    const auto eol = ParseUntillEndOfLine(index);
+    validName      = classes[(*this)[ParseSpace(index + 1, SpaceType::SpaceAndTabs)]] == nameClass;
+    return eol;
+}
 uint32 TextParser::ParseSameGroupID(uint32 index, uint32 (*charToGroupID)(char16 character)) const
 {
     if (index >= size)
@@ -180,6 +212,19 @@ uint32 TextParser::ParseSameGroupID(uint32 index, uint32 (*charToGroupID)(char16
     }
     return index;
 }
+uint32 TextParser::ParseSameGroupID(uint32 index, const CharacterClasses& classes) const
+{
+    if (index >= size)
+        return size;
+    auto* p = text + index;
+    auto id = classes[*p];
+    while ((index < size) && (classes[*p] == id))
+    {
+        index++;
+        p++;
+    }
+    return index;
+}
 uint32 TextParser::ParseSpace(uint32 index, SpaceType type) const
 {
     if (index >= size)
@@ -6,6 +6,7 @@ using namespace AppCUI::Input;
 void Config::Update(IniSection sect)
 {
     sect.UpdateValue("Key.WrapMethod", Key::F2, true);
+    sect.UpdateValue("Key.FollowMode", Key::F6, true);
 }
 void Config::Initialize()
 {
@@ -14,10 +15,12 @@ void Config::Initialize()
     {
         auto sect           = ini->GetSection("View.Text");
         this->Keys.WordWrap = sect.GetValue("Key.WrapMethod").ToKey(Key::F2);
+        this->Keys.Follow   = sect.GetValue("Key.FollowMode").ToKey(Key::F6);
     }
     else
     {
         this->Keys.WordWrap = Key::F2;
+        this->Keys.Follow   = Key::F6;
     }
 
     this->Loaded = true;
@@ -0,0 +1,80 @@
+#include "TextViewer.hpp"
+
+#include <filesystem>
+
+#ifdef BUILD_FOR_UNIX
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+using namespace GView::View::TextViewer;
+
+FileWatcher::FileWatcher() : handle(-1), watch(-1), running(false), lastSize(0)
+{
+}
+FileWatcher::~FileWatcher()
+{
+    Stop();
+}
+bool FileWatcher::Start(u16string_view path)
+{
+    Stop();
+    CHECK(path.size() > 0, false, "Expecting a valid path to watch !");
+#ifdef BUILD_FOR_UNIX
+    const auto p = std::filesystem::path(path);
+    this->handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    CHECK(this->handle >= 0, false, "Fail to initialize inotify !");
+    this->watch = inotify_add_watch(this->handle, p.c_str(), IN_MODIFY);
+    if (this->watch < 0)
+    {
+        close(this->handle);
+        this->handle = -1;
+        RETURNERROR(false, "Fail to watch: %s", p.string().c_str());
+    }
+#else
+    std::error_code ec;
+    this->path          = std::filesystem::path(path);
+    this->lastSize      = std::filesystem::file_size(this->path, ec);
+    this->lastWriteTime = std::filesystem::last_write_time(this->path, ec);
+    CHECK(!ec, false, "Fail to watch: %s", this->path.string().c_str());
+#endif
+    this->running = true;
+    return true;
+}
+void FileWatcher::Stop()
+{
+#ifdef BUILD_FOR_UNIX
+    if (this->handle >= 0)
+    {
+        if (this->watch >= 0)
+            inotify_rm_watch(this->handle, this->watch);
+        close(this->handle);
+    }
+#endif
+    this->handle  = -1;
+    this->watch   = -1;
+    this->running = false;
+}
+bool FileWatcher::HasChanged()
+{
+    if (!this->running)
+        return false;
+#ifdef BUILD_FOR_UNIX
+    // the descriptor is non-blocking --> drain all pending events (we only care if there was at least one)
+    alignas(inotify_event) char events[4096];
+    auto changed = false;
+    while (read(this->handle, events, sizeof(events)) > 0)
+        changed = true;
+    return changed;
+#else
+    // no notifications --> the file is checked every time (a failed check reports no change)
+    std::error_code ec;
+    const auto size      = std::filesystem::file_size(this->path, ec);
+    const auto writeTime = std::filesystem::last_write_time(this->path, ec);
+    if ((ec) || ((size == this->lastSize) && (writeTime == this->lastWriteTime)))
+        return false;
+    this->lastSize      = size;
+    this->lastWriteTime = writeTime;
+    return true;
+#endif
+}
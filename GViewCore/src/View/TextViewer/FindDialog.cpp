@@ -0,0 +1,63 @@
+#include "TextViewer.hpp"
+
+using namespace GView::View::TextViewer;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+FindDialog::FindDialog() : Window("Find", "d:c,w:60,h:11", WindowFlags::ProcessReturn)
+{
+    Factory::Label::Create(this, "&Text", "x:1,y:1,w:8");
+    txText      = Factory::TextField::Create(this, "", "x:10,y:1,w:46");
+    cbRegex     = Factory::CheckBox::Create(this, "&Regular expression", "x:10,y:3,w:40");
+    cbMatchCase = Factory::CheckBox::Create(this, "Match &case", "x:10,y:4,w:40");
+
+    Factory::Button::Create(this, "&OK", "l:16,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:31,b:0,w:13", BTN_ID_CANCEL);
+
+    txText->SetFocus();
+}
+void FindDialog::Validate()
+{
+    LocalUnicodeStringBuilder<256> content;
+    if (content.Set(txText->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Fail to get the text to search for !");
+        txText->SetFocus();
+        return;
+    }
+    if (content.Len() == 0)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Please write the text to search for !");
+        txText->SetFocus();
+        return;
+    }
+    text = content.ToStringView();
+    Exit(Dialogs::Result::Ok);
+}
+bool FindDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    switch (eventType)
+    {
+    case Event::ButtonClicked:
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+        break;
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
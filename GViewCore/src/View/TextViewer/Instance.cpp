@@ -1,5 +1,6 @@
 #include "TextViewer.hpp"
 #include <algorithm>
+#include <cstring>
 
 using namespace GView::View::TextViewer;
 using namespace AppCUI::Input;
@@ -7,7 +8,9 @@ using namespace AppCUI::Input;
 Config Instance::config;
 
 constexpr int32 CMD_ID_WORD_WRAP     = 0xBF00;
+constexpr int32 CMD_ID_FOLLOW        = 0xBF01;
 constexpr uint32 INVALID_LINE_NUMBER = 0xFFFFFFFF;
+constexpr uint32 FOLLOW_TAIL_SIZE    = 64;
 
 enum class BulletParserState : uint8
 {
@@ -198,7 +201,7 @@ uint8 GetCharGroup(char16 ch)
 class DataCharacterStream
 {
     GView::Utils::DataCache& dataCache;
-    std::vector<LineInfo>& lines;
+    LineIndex& lines;
     Reference<SettingsData> settings;
     uint32 linesCount;
     uint32 charIndex;
@@ -206,18 +209,20 @@ class DataCharacterStream
 
     bool ConvertLine(uint32 lineNo)
     {
+        LineInfo li;
         CHECK(lineNo < linesCount, false, "");
-        auto buf = dataCache.Get(lines[lineNo].offset, lines[lineNo].size, false);
+        CHECK(lines.Get(lineNo, li), false, "");
+        auto buf = dataCache.Get(li.offset, li.size, false);
         CHECK(tempLine.Create(buf, settings), false, "");
         currentLine = lineNo;
         return true;
     }
 
   public:
-    DataCharacterStream(std::vector<LineInfo>& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
+    DataCharacterStream(LineIndex& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
         : settings(_settings), dataCache(cache), lines(li)
     {
-        linesCount  = static_cast<uint32>(li.size());
+        linesCount  = li.GetLinesCount();
         currentLine = 0;
         charIndex   = 0;
     }
@@ -268,6 +273,88 @@ class DataCharacterStream
     }
 };
 
+void GView::View::TextViewer::SplitLineInSubLines(
+      BufferView buf, uint32 w, Reference<SettingsData> settings, std::vector<SubLineInfo>& entries, uint32& leftAlignament)
+{
+    uint32 bufPos          = 0;
+    uint32 charIndex       = 0;
+    bool computeAlignament = true;
+    auto bp                = BulletParserState::FirstPadding;
+    uint32 bpBulletWidth   = 0;
+    CharacterStream cs(buf, 0, settings);
+
+    entries.clear();
+    leftAlignament = 0;
+    // parse first sub-line
+    while (cs.Next())
+    {
+        if (cs.GetNextXOffset() > w)
+        {
+            // move to next line
+            entries.emplace_back(bufPos, cs.GetCurrentBufferPos() - bufPos, charIndex, cs.GetNextCharIndex() - charIndex);
+            bufPos            = cs.GetCurrentBufferPos();
+            charIndex         = cs.GetNextCharIndex();
+            computeAlignament = false;
+            cs.ResetXOffset(leftAlignament);
+        }
+        if (computeAlignament)
+        {
+            switch (settings->wrapMethod)
+            {
+            case WrapMethod::LeftMargin:
+                computeAlignament = false;
+                leftAlignament    = 0;
+                break;
+            case WrapMethod::Padding:
+                if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
+                    leftAlignament = cs.GetNextXOffset();
+                else
+                    computeAlignament = false;
+                break;
+            case WrapMethod::Bullets:
+                // its important for the parser to check this states in this order (next padding, first padding and bullet)
+                if (bp == BulletParserState::NextPadding)
+                {
+                    if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
+                        leftAlignament = cs.GetNextXOffset();
+                    else
+                        computeAlignament = false;
+                }
+                if (bp == BulletParserState::FirstPadding)
+                {
+                    if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
+                        leftAlignament = cs.GetNextXOffset();
+                    else
+                    {
+                        bp            = BulletParserState::Bullet;
+                        bpBulletWidth = 0;
+                    }
+                }
+                if (bp == BulletParserState::Bullet)
+                {
+                    leftAlignament = cs.GetNextXOffset();
+                    bpBulletWidth++;
+                    if ((cs.GetCharacter() == '-') || (cs.GetCharacter() == '*') || (cs.GetCharacter() == '.') ||
+                        (cs.GetCharacter() == ')'))
+                        bp = BulletParserState::NextPadding;
+                    else if (bpBulletWidth > 4)
+                    {
+                        // no special bullet detected --> align normally to the left margin
+                        computeAlignament = false;
+                        leftAlignament    = 0;
+                    }
+                }
+                break;
+            default:
+                computeAlignament = false;
+                break;
+            }
+        }
+    }
+    if (cs.GetCurrentBufferPos() > bufPos)
+        entries.emplace_back(bufPos, cs.GetCurrentBufferPos() - bufPos, charIndex, cs.GetCharIndex() - charIndex);
+}
+
 Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj, Settings* _settings)
     : settings(nullptr), ViewControl(UserControlFlags::ShowVerticalScrollBar | UserControlFlags::ScrollBarOutsideControl)
 {
@@ -295,7 +382,9 @@ Instance::Instance(const std::string_view& _name, Reference<GView::Object> _obj,
     this->SubLines.lineNo  = INVALID_LINE_NUMBER;
     this->ViewPort.scrollX = 0;
     this->ViewPort.Reset();
-    this->mouseStatus = MouseStatus::None;
+    this->mouseStatus    = MouseStatus::None;
+    this->lastLineIsOpen = false;
+    this->follow         = false;
 
     this->settings->encoding = CharacterEncoding::AnalyzeBufferForEncoding(this->obj->GetData().Get(0, 4096, false), true, this->sizeOfBOM);
     this->MoveTo(0, 0, false);
@@ -330,97 +419,110 @@ void Instance::RecomputeLineIndexes()
         if ((ch == '\n') || (ch == '\r'))
             crlf_count++;
 
-    auto estimated_count = ((crlf_count * sz) / buf.GetLength()) + 16;
+    auto estimated_count = ((crlf_count * sz) / std::max<uint64>(1, buf.GetLength())) + 16;
 
-    this->lines.clear();
-    this->lines.reserve(estimated_count);
+    this->lines.Init(this->obj, this->settings->encoding, estimated_count);
 
-    uint64 offset    = this->sizeOfBOM;
-    uint64 start     = this->sizeOfBOM;
-    uint32 charCount = 0;
-    char16 lastChar  = 0;
-
-    CharacterEncoding::ExpandedCharacter ch;
-
-    while (offset < sz)
+    this->indexer.Init(&this->lines, this->sizeOfBOM, this->settings->encoding);
+    while (this->indexer.GetOffset() < sz)
     {
-        buf = this->obj->GetData().Get(offset, csz, false);
+        auto offset = this->indexer.GetOffset();
+        buf         = this->obj->GetData().Get(offset, csz, false);
         if (buf.Empty())
-            return;
-        // process the buffer
-        auto* p       = buf.begin();
-        auto* e       = buf.end();
-        auto* loopEnd = buf.end();
-        if (((offset + buf.GetLength()) < sz) && (buf.GetLength() > 16))
-        {
-            // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
-            // will be made
-            loopEnd -= 8;
-        }
-        while (p < loopEnd)
-        {
-            if (ch.FromEncoding(this->settings->encoding, p, e))
-            {
-                p += ch.Length();
-                auto chr = ch.GetChar();
-                if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
-                {
-                    // end of the current line
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = chr;
-                    continue;
-                }
+            break;
+        this->indexer.Process(buf, (offset + buf.GetLength()) >= sz);
+    }
+    this->lastLineIsOpen = this->indexer.Finish();
+    UpdateLineNumberWidth();
+}
+void Instance::IndexAppendedData()
+{
+    auto& data = this->obj->GetData();
+    if (data.RefreshSize() == false)
+        return;
 
-                // combined CRLF or LFCR
-                if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
-                {
-                    // just advanced one extra char (no new line found)
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = 0; // important as the CRLF or LFCR has ended
-                    continue;
-                }
+    const auto sz       = data.GetSize();
+    const auto atBottom = this->ViewPort.End.lineNo + 1 >= this->lines.GetLinesCount();
+    if ((sz < this->indexer.GetOffset()) || (IndexedTailChanged()))
+    {
+        // the file was truncated (or truncated and written again, e.g. a rotated log) --> the existing index is no longer valid
+        this->selection.Clear();
+        this->RecomputeLineIndexes();
+        this->wrapIndex.Stop();
+        this->UpdateWrapIndex();
+        this->SubLines.lineNo = INVALID_LINE_NUMBER;
+        this->ViewPort.Reset();
+        this->MoveTo(0, 0, false);
+        if (atBottom)
+            this->MoveToEndOfFile(false);
+        RememberIndexedTail();
+        return;
+    }
 
-                // other character
-                lastChar = 0; // don't care
-                charCount++;
-                offset += ch.Length();
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-            else
-            {
-                // need to treat conversion error
-                // consider one character (binary format)
-                charCount++;
-                offset++;
-                p++;
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-        }
-        if (charCount > 0)
-        {
-            // last line
-            lines.emplace_back(start, charCount, (uint32) (offset - start));
-        }
+    // only the appended bytes are indexed (the last line is parsed again as it might continue in the new data)
+    if (this->lastLineIsOpen)
+    {
+        this->lines.RemoveLastLine();
+        this->indexer.RewindToLineStart();
+    }
+    this->lines.SetDataEnd(sz);
+    auto csz = data.GetCacheSize() & 0xFFFFFFF0;
+    while (this->indexer.GetOffset() < sz)
+    {
+        auto offset = this->indexer.GetOffset();
+        auto buf    = data.Get(offset, csz, false);
+        if (buf.Empty())
+            break;
+        this->indexer.Process(buf, (offset + buf.GetLength()) >= sz);
     }
+    this->lastLineIsOpen = this->indexer.Finish();
+    UpdateLineNumberWidth();
+    RememberIndexedTail();
+    // the rows of the appended lines are counted in background (unless the width of the line numbers changed)
+    if ((!this->HasWordWrap()) || (!this->wrapIndex.IsBuiltFor(*this->settings, GetWrapWidth())) || (!this->wrapIndex.Resume(sz)))
+        this->UpdateWrapIndex();
 
-    auto linesCount = this->lines.size() + 1;
+    this->SubLines.lineNo = INVALID_LINE_NUMBER; // the last line might have changed
+    this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
+    if (atBottom)
+        this->MoveToEndOfFile(false);
+    else
+        this->UpdateViewPort();
+}
+void Instance::RememberIndexedTail()
+{
+    const auto end    = this->indexer.GetOffset();
+    const auto size   = static_cast<uint32>(std::min<uint64>(end, FOLLOW_TAIL_SIZE));
+    this->indexedTail = size > 0 ? this->obj->GetData().CopyToBuffer(end - size, size) : Buffer();
+}
+bool Instance::IndexedTailChanged()
+{
+    // only called after the size of the file has changed (the cached data was discarded --> the bytes are read again)
+    const auto size = static_cast<uint32>(this->indexedTail.GetLength());
+    if (size == 0)
+        return false;
+    const auto current = this->obj->GetData().CopyToBuffer(this->indexer.GetOffset() - size, size);
+    return (current.GetLength() != size) || (memcmp(current.GetData(), this->indexedTail.GetData(), size) != 0);
+}
+bool Instance::SetFollowMode(bool enabled)
+{
+    if (!enabled)
+    {
+        this->watcher.Stop();
+        this->follow = false;
+        return true;
+    }
+    CHECK(this->obj->GetObjectType() == GView::Object::Type::File, false, "Follow mode is only available for files !");
+    CHECK(this->watcher.Start(this->obj->GetPath()), false, "Fail to watch the file for changes !");
+    this->follow = true;
+    // data might have been appended since the file was indexed
+    RememberIndexedTail();
+    IndexAppendedData();
+    return true;
+}
+void Instance::UpdateLineNumberWidth()
+{
+    auto linesCount = this->lines.GetLinesCount() + 1;
     if (linesCount < 10)
         this->lineNumberWidth = 2;
     else if (linesCount < 100)
@@ -438,19 +540,16 @@ void Instance::RecomputeLineIndexes()
 }
 bool Instance::GetLineInfo(uint32 lineNo, LineInfo& li)
 {
-    if (lineNo >= this->lines.size())
-        return false;
-    li = this->lines[lineNo];
-    return true;
+    return this->lines.Get(lineNo, li);
 }
 LineInfo Instance::GetLineInfo(uint32 lineNo)
 {
-    const auto sz = this->lines.size();
-    if (lineNo < sz)
-        return this->lines[lineNo];
+    LineInfo li;
+    if (this->lines.Get(lineNo, li))
+        return li;
     // if its outside --> always return the last line
-    if (sz > 0)
-        return this->lines[sz - 1];
+    if (!this->lines.Empty())
+        return this->lines.GetLastLine();
     // otherwise return an empty line
     return LineInfo(0, 0, 0);
 }
@@ -459,14 +558,9 @@ void Instance::ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& sta
     if (lineNo == this->SubLines.lineNo)
         return; // we've already computed this --> no need to computed again
 
-    LineInfo li            = GetLineInfo(lineNo);
-    uint32 w               = this->GetWidth();
-    uint32 bufPos          = 0;
-    uint32 charIndex       = 0;
-    bool computeAlignament = true;
-    auto bp                = BulletParserState::FirstPadding;
-    uint32 bpBulletWidth   = 0;
-    startOffset            = li.offset;
+    LineInfo li = GetLineInfo(lineNo);
+    uint32 w    = GetWrapWidth();
+    startOffset = li.offset;
 
     //---------------------------------------------------
     //|  We will always have at least ONE sub-line      |
@@ -475,85 +569,11 @@ void Instance::ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& sta
     this->SubLines.lineNo         = lineNo;
     this->SubLines.leftAlignament = 0;
 
-    if ((this->lineNumberWidth + 2) >= w)
-        w = 1;
-    else
-        w -= (this->lineNumberWidth + 2);
     buf = this->obj->GetData().Get(li.offset, li.size, false);
-    CharacterStream cs(buf, 0, this->settings.ToReference());
-    // process
 
     if (this->settings->wrapMethod != WrapMethod::None)
     {
-        // parse first sub-line
-        while (cs.Next())
-        {
-            if (cs.GetNextXOffset() > w)
-            {
-                // move to next line
-                this->SubLines.entries.emplace_back(
-                      bufPos, cs.GetCurrentBufferPos() - bufPos, charIndex, cs.GetNextCharIndex() - charIndex);
-                bufPos            = cs.GetCurrentBufferPos();
-                charIndex         = cs.GetNextCharIndex();
-                computeAlignament = false;
-                cs.ResetXOffset(this->SubLines.leftAlignament);
-            }
-            if (computeAlignament)
-            {
-                switch (this->settings->wrapMethod)
-                {
-                case WrapMethod::LeftMargin:
-                    computeAlignament             = false;
-                    this->SubLines.leftAlignament = 0;
-                    break;
-                case WrapMethod::Padding:
-                    if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
-                        this->SubLines.leftAlignament = cs.GetNextXOffset();
-                    else
-                        computeAlignament = false;
-                    break;
-                case WrapMethod::Bullets:
-                    // its important for the parser to check this states in this order (next padding, first padding and bullet)
-                    if (bp == BulletParserState::NextPadding)
-                    {
-                        if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
-                            this->SubLines.leftAlignament = cs.GetNextXOffset();
-                        else
-                            computeAlignament = false;
-                    }
-                    if (bp == BulletParserState::FirstPadding)
-                    {
-                        if ((cs.GetCharacter() == ' ') || (cs.IsTabCharacter()))
-                            this->SubLines.leftAlignament = cs.GetNextXOffset();
-                        else
-                        {
-                            bp            = BulletParserState::Bullet;
-                            bpBulletWidth = 0;
-                        }
-                    }
-                    if (bp == BulletParserState::Bullet)
-                    {
-                        this->SubLines.leftAlignament = cs.GetNextXOffset();
-                        bpBulletWidth++;
-                        if ((cs.GetCharacter() == '-') || (cs.GetCharacter() == '*') || (cs.GetCharacter() == '.') ||
-                            (cs.GetCharacter() == ')'))
-                            bp = BulletParserState::NextPadding;
-                        else if (bpBulletWidth > 4)
-                        {
-                            // no special bullet detected --> align normally to the left margin
-                            computeAlignament             = false;
-                            this->SubLines.leftAlignament = 0;
-                        }
-                    }
-                    break;
-                default:
-                    computeAlignament = false;
-                    break;
-                }
-            }
-        }
-        if (cs.GetCurrentBufferPos() > bufPos)
-            this->SubLines.entries.emplace_back(bufPos, cs.GetCurrentBufferPos() - bufPos, charIndex, cs.GetCharIndex() - charIndex);
+        SplitLineInSubLines(buf, w, this->settings.ToReference(), this->SubLines.entries, this->SubLines.leftAlignament);
         // there should always be at least one sub-line
         if (this->SubLines.entries.empty())
         {
@@ -617,6 +637,43 @@ uint32 Instance::CharacterIndexToSubLineNo(uint32 charIndex)
         middle = (start + end) >> 1;
     }
 }
+uint32 Instance::GetWrapWidth()
+{
+    // the line number and the separator are not part of the text area
+    uint32 w = this->GetWidth();
+    return (this->lineNumberWidth + 2) >= w ? 1 : w - (this->lineNumberWidth + 2);
+}
+void Instance::UpdateWrapIndex()
+{
+    // the rows are counted in background --> the index has to be rebuilt whenever the way lines are wrapped changes
+    if (!this->HasWordWrap())
+    {
+        this->wrapIndex.Stop();
+        return;
+    }
+    const auto w = GetWrapWidth();
+    if (this->wrapIndex.IsBuiltFor(*this->settings, w))
+        return;
+    this->wrapIndex.Start(this->obj, this->sizeOfBOM, *this->settings, w);
+}
+uint32 Instance::CountSubLines(uint32 lineNo)
+{
+    ComputeSubLineIndexes(lineNo);
+    return static_cast<uint32>(this->SubLines.entries.size());
+}
+bool Instance::LineToRow(uint32 lineNo, uint32 subLineNo, uint64& row)
+{
+    // returns false if the rows are not indexed (yet)
+    if ((!this->HasWordWrap()) || (!this->wrapIndex.IsReady(this->lines.GetLinesCount())))
+        return false;
+    return this->wrapIndex.LineToRow(lineNo, subLineNo, *this, row);
+}
+bool Instance::RowToLine(uint64 row, uint32& lineNo, uint32& subLineNo)
+{
+    if ((!this->HasWordWrap()) || (!this->wrapIndex.IsReady(this->lines.GetLinesCount())))
+        return false;
+    return this->wrapIndex.RowToLine(row, *this, lineNo, subLineNo);
+}
 void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
 {
     auto h       = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW)) - 1U;
@@ -629,10 +686,10 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
     }
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.Empty())
         return;
 
-    uint32 lastLineNo = static_cast<uint32>(this->lines.size() - 1); // lines.size() will alway be bigger than 1
+    uint32 lastLineNo = this->lines.GetLinesCount() - 1; // lines.size() will alway be bigger than 1
 
     // sets the view port
     ViewPort.Start.lineNo    = start;
@@ -660,7 +717,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
     auto h = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW));
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.Empty())
         return;
     if (dir == Direction::TopToBottom)
     {
@@ -673,7 +730,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         auto* l                  = ViewPort.Lines;
         const auto* l_max        = l + h;
 
-        while ((l < l_max) && (start < this->lines.size()))
+        while ((l < l_max) && (start < this->lines.GetLinesCount()))
         {
             auto lineInfo = GetLineInfo(start);
             ComputeSubLineIndexes(start);
@@ -753,14 +810,14 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
     if (select)
         sidx = this->selection.BeginSelection(this->Cursor.pos);
     // sanity checks
-    if (this->lines.size() == 0)
+    if (this->lines.Empty())
     {
         lineNo = 0;
     }
     else
     {
-        if (lineNo >= static_cast<uint32>(this->lines.size()))
-            lineNo = static_cast<uint32>(this->lines.size() - 1);
+        if (lineNo >= this->lines.GetLinesCount())
+            lineNo = this->lines.GetLinesCount() - 1;
     }
     LineInfo li = GetLineInfo(lineNo);
     if (charIndex >= li.charsCount)
@@ -790,8 +847,8 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
 }
 void Instance::MoveToStartOfLine(uint32 lineNo, bool select)
 {
-    if (lineNo >= this->lines.size())
-        MoveToEndOfLine(static_cast<uint32>(this->lines.size() - 1), select); // last position
+    if (lineNo >= this->lines.GetLinesCount())
+        MoveToEndOfLine(this->lines.GetLinesCount() - 1, select); // last position
     else
         MoveTo(lineNo, 0, select);
 }
@@ -805,9 +862,9 @@ void Instance::MoveToEndOfLine(uint32 lineNo, bool select)
 }
 void Instance::MoveToEndOfFile(bool select)
 {
-    if (this->lines.empty())
+    if (this->lines.Empty())
         return;
-    MoveTo(static_cast<uint32>(this->lines.size() - 1), 0xFFFFFFFF, select);
+    MoveTo(this->lines.GetLinesCount() - 1, 0xFFFFFFFF, select);
 }
 void Instance::MoveLeft(bool select)
 {
@@ -845,9 +902,9 @@ void Instance::MoveToNextWord(bool select)
 }
 void Instance::MoveDown(uint32 noOfTimes, bool select)
 {
-    if (this->lines.size() == 0)
+    if (this->lines.Empty())
         return; // safety check
-    uint32 lastLine = static_cast<uint32>(this->lines.size() - 1);
+    uint32 lastLine = this->lines.GetLinesCount() - 1;
     if (HasWordWrap())
     {
         auto lineNo = this->Cursor.lineNo;
@@ -857,49 +914,65 @@ void Instance::MoveDown(uint32 noOfTimes, bool select)
         const auto charIndexDif   = this->Cursor.charIndex > this->SubLines.entries[slIndex].relativeCharIndex
                                           ? this->Cursor.charIndex - this->SubLines.entries[slIndex].relativeCharIndex
                                           : 0U;
-        while (true)
+        uint64 row;
+        if ((noOfTimes > 1) && (LineToRow(lineNo, slIndex, row)))
         {
-            ComputeSubLineIndexes(lineNo);
-            const auto slCount = static_cast<uint32>(this->SubLines.entries.size());
-            const auto dif     = std::min<>(noOfTimes, slCount - slIndex);
-            noOfTimes -= dif;
-            slIndex += dif;
-            if (noOfTimes > 0)
+            // rows are indexed --> jump directly to the target row
+            const auto lastRow = this->wrapIndex.GetRowsCount() - 1;
+            if (row >= lastRow)
             {
-                lineNo++;
-                slIndex = 0;
-                if (lineNo > lastLine)
-                {
-                    lineNo    = lastLine;
-                    noOfTimes = 0;
-                    slIndex   = slCount - 1; // last subline
-                }
+                MoveToEndOfLine(lastLine, select);
+                return;
             }
-            else
+            CHECKRET(RowToLine(std::min<uint64>(row + noOfTimes, lastRow), lineNo, slIndex), "");
+            ComputeSubLineIndexes(lineNo);
+        }
+        else
+        {
+            while (true)
             {
-                if (slIndex >= slCount)
+                ComputeSubLineIndexes(lineNo);
+                const auto slCount = static_cast<uint32>(this->SubLines.entries.size());
+                const auto dif     = std::min<>(noOfTimes, slCount - slIndex);
+                noOfTimes -= dif;
+                slIndex += dif;
+                if (noOfTimes > 0)
                 {
-                    if (lineNo < lastLine)
+                    lineNo++;
+                    slIndex = 0;
+                    if (lineNo > lastLine)
                     {
-                        // move to next line
-                        lineNo++;
-                        slIndex = 0;
+                        lineNo    = lastLine;
+                        noOfTimes = 0;
+                        slIndex   = slCount - 1; // last subline
                     }
-                    else
+                }
+                else
+                {
+                    if (slIndex >= slCount)
                     {
-                        // we are already at the last line
-                        if (initialSubLine + 1 == slCount)
+                        if (lineNo < lastLine)
                         {
-                            MoveToEndOfLine(lastLine, select);
-                            return;
+                            // move to next line
+                            lineNo++;
+                            slIndex = 0;
                         }
                         else
                         {
-                            slIndex = slCount - 1;
+                            // we are already at the last line
+                            if (initialSubLine + 1 == slCount)
+                            {
+                                MoveToEndOfLine(lastLine, select);
+                                return;
+                            }
+                            else
+                            {
+                                slIndex = slCount - 1;
+                            }
                         }
                     }
+                    break;
                 }
-                break;
             }
         }
         const auto& currentSL = this->SubLines.entries[slIndex];
@@ -991,37 +1064,52 @@ void Instance::MoveUp(uint32 noOfTimes, bool select)
         const auto charIndexDif   = this->Cursor.charIndex > this->SubLines.entries[slIndex].relativeCharIndex
                                           ? this->Cursor.charIndex - this->SubLines.entries[slIndex].relativeCharIndex
                                           : 0U;
-        while (true)
+        uint64 row;
+        if ((noOfTimes > 1) && (LineToRow(lineNo, slIndex, row)))
         {
+            // rows are indexed --> jump directly to the target row
+            if (row < noOfTimes)
+            {
+                MoveToStartOfLine(0, select);
+                return;
+            }
+            CHECKRET(RowToLine(row - noOfTimes, lineNo, slIndex), "");
             ComputeSubLineIndexes(lineNo);
-            const auto dif = std::min<>(noOfTimes, slIndex);
-            noOfTimes -= dif;
-            slIndex -= dif;
-            if (noOfTimes > 0)
+        }
+        else
+        {
+            while (true)
             {
-                // slIndex is definetelly 0 (as dif is the smallest from noOfTimes and slIndex)
-                // we've reached the first sub-line
-                if (lineNo > 0)
+                ComputeSubLineIndexes(lineNo);
+                const auto dif = std::min<>(noOfTimes, slIndex);
+                noOfTimes -= dif;
+                slIndex -= dif;
+                if (noOfTimes > 0)
                 {
-                    // move one line up
-                    lineNo--;
-                    ComputeSubLineIndexes(lineNo);
-                    slIndex = static_cast<uint32>(this->SubLines.entries.size()) - 1;
-                    noOfTimes--;
-                    if (noOfTimes == 0)
-                        break;
+                    // slIndex is definetelly 0 (as dif is the smallest from noOfTimes and slIndex)
+                    // we've reached the first sub-line
+                    if (lineNo > 0)
+                    {
+                        // move one line up
+                        lineNo--;
+                        ComputeSubLineIndexes(lineNo);
+                        slIndex = static_cast<uint32>(this->SubLines.entries.size()) - 1;
+                        noOfTimes--;
+                        if (noOfTimes == 0)
+                            break;
+                    }
+                    else
+                    {
+                        MoveToStartOfLine(0, select);
+                        return;
+                    }
                 }
                 else
                 {
-                    MoveToStartOfLine(0, select);
-                    return;
+                    // noOfTimes is 0
+                    break;
                 }
             }
-            else
-            {
-                // noOfTimes is 0
-                break;
-            }
         }
         const auto& currentSL = this->SubLines.entries[slIndex];
         if (currentSL.charsCount == 0)
@@ -1249,6 +1337,20 @@ void Instance::DrawLine(uint32 y, Graphics::Renderer& renderer, ControlState sta
             renderer.WriteCharacter(this->lineNumberWidth + 1, y, ' ', Cfg.Cursor.Normal);
     }
 }
+bool Instance::OnFrameUpdate()
+{
+    // called periodically from the UI thread --> data appended to the file and the results of a search that runs in
+    // background are shown without any user input
+    auto repaint = false;
+    if ((this->Search.session) && (this->Search.panel.IsValid()))
+        repaint = this->Search.panel->Update();
+    if ((this->follow) && (this->watcher.HasChanged()))
+    {
+        this->IndexAppendedData();
+        repaint = true;
+    }
+    return repaint;
+}
 void Instance::Paint(Graphics::Renderer& renderer)
 {
     auto idx         = 0U;
@@ -1287,6 +1389,8 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
         commandBar.SetCommand(config.Keys.WordWrap, "Wrap:Bullets", CMD_ID_WORD_WRAP);
         break;
     }
+    if (this->obj->GetObjectType() == GView::Object::Type::File)
+        commandBar.SetCommand(config.Keys.Follow, this->follow ? "Follow:ON" : "Follow:OFF", CMD_ID_FOLLOW);
     return false;
 }
 bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
@@ -1381,11 +1485,14 @@ bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
 void Instance::OnStart()
 {
     this->RecomputeLineIndexes();
+    this->UpdateWrapIndex();
     this->ViewPort.Reset();
     this->UpdateViewPort();
 }
 void Instance::OnAfterResize(int newWidth, int newHeight)
 {
+    this->SubLines.lineNo = INVALID_LINE_NUMBER; // the width of the sub-lines might have changed
+    this->UpdateWrapIndex();
     this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
     this->UpdateViewPort();
 }
@@ -1415,15 +1522,26 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
             break;
         }
         return true;
+    case CMD_ID_FOLLOW:
+        if (!SetFollowMode(!this->follow))
+            Dialogs::MessageBox::ShowError("Error", "Fail to watch the file for changes !");
+        return true;
     }
     return false;
 }
 void Instance::OnUpdateScrollBars()
 {
-    if (this->lines.size() > 0)
+    uint64 row;
+    if (LineToRow(this->Cursor.lineNo, this->Cursor.sublineNo, row))
     {
-        const auto& fistLine = this->lines[0];
-        const auto& lastLine = this->lines[this->lines.size() - 1];
+        // wrapped text with indexed rows --> exact position
+        this->UpdateVScrollBar(row, this->wrapIndex.GetRowsCount() - 1);
+        return;
+    }
+    if (!this->lines.Empty())
+    {
+        const auto fistLine  = GetLineInfo(0);
+        const auto& lastLine = this->lines.GetLastLine();
         const auto maxOfs    = lastLine.offset + lastLine.size;
         auto pos             = std::max<>(this->Cursor.pos, fistLine.offset);
         this->UpdateVScrollBar(std::min<>(pos, maxOfs), maxOfs);
@@ -1438,20 +1556,14 @@ void Instance::SetWrapMethod(WrapMethod method)
     this->settings->wrapMethod = method;
     this->ViewPort.scrollX     = 0;
     this->SubLines.lineNo      = INVALID_LINE_NUMBER;
+    this->UpdateWrapIndex();
     this->ViewPort.Reset();
     this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
     this->UpdateViewPort();
 }
 bool Instance::GoTo(uint64 offset)
 {
-    auto lineNo = 0U;
-    for (lineNo = 0U; lineNo < this->lines.size(); lineNo++)
-    {
-        if (offset < this->lines[lineNo].offset)
-            break;
-    }
-    if (lineNo > 0)
-        lineNo--;
+    auto lineNo = this->lines.FindLineByOffset(offset);
     auto li     = GetLineInfo(lineNo);
     auto cIndex = 0U;
     CharacterStream cs(this->obj->GetData().Get(li.offset, li.size, false), 0, this->settings.ToReference());
@@ -1466,11 +1578,15 @@ bool Instance::GoTo(uint64 offset)
 }
 bool Instance::Select(uint64 offset, uint64 size)
 {
-    return false; // no selection is possible in this mode
+    CHECK(size > 0, false, "");
+    CHECK(offset + size <= this->obj->GetData().GetSize(), false, "");
+    GoTo(offset);
+    this->selection.Clear();
+    return this->selection.SetSelection(0, offset, offset + size - 1);
 }
 bool Instance::ShowGoToDialog()
 {
-    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, static_cast<uint32>(this->lines.size()));
+    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, this->lines.GetLinesCount());
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         if (dlg.ShouldGoToLine())
@@ -1486,7 +1602,32 @@ bool Instance::ShowGoToDialog()
 }
 bool Instance::ShowFindDialog()
 {
-    NOT_IMPLEMENTED(false);
+    FindDialog dlg;
+    if (dlg.Show() != Dialogs::Result::Ok)
+        return true;
+
+    LocalString<256> error;
+    auto session = std::make_shared<SearchSession>();
+    if (!session->Start(this->obj, dlg.GetText(), dlg.UseRegex(), dlg.MatchCase(), this->settings->encoding, this->sizeOfBOM, error))
+    {
+        Dialogs::MessageBox::ShowError("Error", error);
+        return true;
+    }
+    if (this->Search.session)
+        this->Search.session->Stop();
+    this->Search.session = session;
+
+    // the results panel is created once (for the first search) and reused afterwards
+    if (!this->Search.panel.IsValid())
+    {
+        auto win = GView::App::GetCurrentWindow();
+        CHECK(win.IsValid(), false, "No window to add the search results into !");
+        auto panel         = new SearchResultsPanel(this);
+        this->Search.panel = panel;
+        win->AddPanel(Pointer<TabPage>(panel), false);
+    }
+    this->Search.panel->SetSession(session);
+    return true;
 }
 bool Instance::ShowCopyDialog()
 {
@@ -1659,7 +1800,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
             xPoz = PrintSelectionInfo(2, xPoz, 0, 16, r);
             xPoz = PrintSelectionInfo(3, xPoz, 0, 16, r);
         }
-        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, lines.GetLinesCount()));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 10, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -1669,7 +1810,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = PrintSelectionInfo(2, 0, 1, 16, r);
         PrintSelectionInfo(1, xPoz, 0, 16, r);
         xPoz = PrintSelectionInfo(3, xPoz, 1, 16, r);
-        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, lines.GetLinesCount()));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 20, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -1685,7 +1826,9 @@ enum class PropertyID : uint32
     HighlightCurrentLine,
     TabSize,
     ShowTabCharacter,
+    Follow,
     WrapMethodKey,
+    FollowKey,
 };
 #define BT(t) static_cast<uint32>(t)
 
@@ -1711,9 +1854,15 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PropertyID::ShowTabCharacter:
         value = this->settings->showTabCharacter;
         return true;
+    case PropertyID::Follow:
+        value = this->follow;
+        return true;
     case PropertyID::WrapMethodKey:
         value = this->config.Keys.WordWrap;
         return true;
+    case PropertyID::FollowKey:
+        value = this->config.Keys.Follow;
+        return true;
     }
     return false;
 }
@@ -1741,14 +1890,26 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
             return false;
         }
         this->settings->tabSize = uint32Temp;
+        this->SubLines.lineNo   = INVALID_LINE_NUMBER;
+        this->UpdateWrapIndex();
         this->UpdateViewPort();
         return true;
     case PropertyID::ShowTabCharacter:
         this->settings->showTabCharacter = std::get<bool>(value);
         return true;
+    case PropertyID::Follow:
+        if (!SetFollowMode(std::get<bool>(value)))
+        {
+            error.Set("Fail to watch the file for changes (follow mode is only available for files) !");
+            return false;
+        }
+        return true;
     case PropertyID::WrapMethodKey:
         config.Keys.WordWrap = std::get<AppCUI::Input::Key>(value);
         return true;
+    case PropertyID::FollowKey:
+        config.Keys.Follow = std::get<AppCUI::Input::Key>(value);
+        return true;
     }
     error.SetFormat("Unknown internat ID: %u", id);
     return false;
@@ -1772,12 +1933,14 @@ const vector<Property> Instance::GetPropertiesList()
     return {
         { BT(PropertyID::WordWrap), "General", "Wrap method", PropertyType::List, "None=0,LeftMargin=1,Padding=2,Bullets=3" },
         { BT(PropertyID::HighlightCurrentLine), "General", "Highlight Current line", PropertyType::Boolean },
+        { BT(PropertyID::Follow), "General", "Follow file changes", PropertyType::Boolean },
         { BT(PropertyID::TabSize), "Tabs", "Size", PropertyType::UInt32 },
         { BT(PropertyID::ShowTabCharacter), "Tabs", "Show tab character", PropertyType::Boolean },
         { BT(PropertyID::Encoding), "Encoding", "Format", PropertyType::List, "Binary=0,Ascii=1,UTF-8=2,UTF-16(LE)=3,UTF-16(BE)=4" },
         { BT(PropertyID::HasBOM), "Encoding", "HasBom", PropertyType::Boolean },
         // shortcuts
         { BT(PropertyID::WrapMethodKey), "Shortcuts", "Change wrap method", PropertyType::Key },
+        { BT(PropertyID::FollowKey), "Shortcuts", "Follow file changes", PropertyType::Key },
     };
 }
 #undef BT
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "TextViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define TEXTVIEWER_INDEXER_SSE2
+#endif
+
+using namespace GView::View::TextViewer;
+
+constexpr uint32 MAX_INDEXED_LINE_CHARS = 2000; // longer lines are split (a line will have at most 2001 characters)
+constexpr uint32 INVALID_BLOCK_INDEX    = 0xFFFFFFFF;
+constexpr uint32 BLOCK_READ_SIZE        = 0x4000;
+
+namespace
+{
+constexpr uint64 SWAR_ONES  = 0x0101010101010101ULL;
+constexpr uint64 SWAR_HIGHS = 0x8080808080808080ULL;
+
+inline uint64 SWAR_HasByte(uint64 v, uint8 value)
+{
+    const auto x = v ^ (SWAR_ONES * value);
+    return (x - SWAR_ONES) & (~x) & SWAR_HIGHS;
+}
+
+// returns the first byte from [p, end) that is a '\n' or a '\r' (or, if stopOnHighBytes is set, a byte >= 0x80)
+const uint8* FindSpecialByte(const uint8* p, const uint8* end, bool stopOnHighBytes)
+{
+#ifdef TEXTVIEWER_INDEXER_SSE2
+    const auto vLF = _mm_set1_epi8('\n');
+    const auto vCR = _mm_set1_epi8('\r');
+    for (; p + 16 <= end; p += 16)
+    {
+        auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto mask = static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, vLF), _mm_cmpeq_epi8(v, vCR))));
+        if (stopOnHighBytes)
+            mask |= static_cast<uint32>(_mm_movemask_epi8(v));
+        if (mask)
+            return p + std::countr_zero(mask);
+    }
+#else
+    for (; p + 8 <= end; p += 8)
+    {
+        uint64 v;
+        memcpy(&v, p, 8);
+        auto mask = SWAR_HasByte(v, '\n') | SWAR_HasByte(v, '\r');
+        if (stopOnHighBytes)
+            mask |= v & SWAR_HIGHS;
+        if (mask)
+            break; // the exact position is found below
+    }
+#endif
+    while ((p < end) && ((*p) != '\n') && ((*p) != '\r') && ((!stopOnHighBytes) || ((*p) < 0x80)))
+        p++;
+    return p;
+}
+
+class BlockLinesCollector : public LineIndexOutput
+{
+    std::vector<LineInfo>& lines;
+
+  public:
+    BlockLinesCollector(std::vector<LineInfo>& _lines) : lines(_lines)
+    {
+    }
+    void AddLine(const LineInfo& li, char16) override
+    {
+        lines.push_back(li);
+    }
+};
+} // namespace
+
+void LineIndexBuilder::Init(LineIndexOutput* _output, uint64 startOffset, CharacterEncoding::Encoding _encoding, char16 _lastChar)
+{
+    this->output        = _output;
+    this->start         = startOffset;
+    this->offset        = startOffset;
+    this->charCount     = 0;
+    this->lastChar      = _lastChar;
+    this->startLastChar = _lastChar;
+    this->encoding      = _encoding;
+}
+void LineIndexBuilder::AddCharacters(uint32 count)
+{
+    // 'count' characters of one byte each (no new line among them)
+    while (this->charCount + count > MAX_INDEXED_LINE_CHARS)
+    {
+        const auto step = MAX_INDEXED_LINE_CHARS + 1 - this->charCount;
+        this->offset += step;
+        count -= step;
+        this->output->AddLine(LineInfo(this->start, MAX_INDEXED_LINE_CHARS + 1, (uint32) (this->offset - this->start)), this->startLastChar);
+        this->start         = this->offset;
+        this->startLastChar = 0;
+        this->charCount     = 0;
+    }
+    this->charCount += count;
+    this->offset += count;
+    this->lastChar = 0;
+}
+void LineIndexBuilder::AddCharacter(uint32 size)
+{
+    this->charCount++;
+    this->offset += size;
+    if (this->charCount > MAX_INDEXED_LINE_CHARS)
+    {
+        // limit line to 2000 characters
+        this->output->AddLine(LineInfo(this->start, this->charCount, (uint32) (this->offset - this->start)), this->startLastChar);
+        this->start         = this->offset;
+        this->startLastChar = this->lastChar;
+        this->charCount     = 0;
+    }
+}
+void LineIndexBuilder::AddNewLine(char16 chr, uint32 size)
+{
+    if (((chr == '\n') && (this->lastChar != '\r')) || ((chr == '\r') && (this->lastChar != '\n')))
+    {
+        // end of the current line
+        this->output->AddLine(LineInfo(this->start, this->charCount, (uint32) (this->offset - this->start)), this->startLastChar);
+        this->lastChar = chr;
+    }
+    else
+    {
+        // combined CRLF or LFCR
+        this->lastChar = 0; // important as the CRLF or LFCR has ended
+    }
+    this->offset += size;
+    this->start         = this->offset;
+    this->startLastChar = this->lastChar;
+    this->charCount     = 0;
+}
+void LineIndexBuilder::ProcessBytes(const uint8* p, const uint8* loopEnd, const uint8* e)
+{
+    // Ascii, Binary and UTF-8: new lines are single bytes that can not be part of a multi-byte UTF-8 sequence, so we can jump
+    // from one special byte to the next one and count everything in between in bulk (one character per byte)
+    const auto isUTF8 = this->encoding == CharacterEncoding::Encoding::UTF8;
+    CharacterEncoding::ExpandedCharacter ch;
+
+    while (p < loopEnd)
+    {
+        auto next = FindSpecialByte(p, loopEnd, isUTF8);
+        if (next > p)
+        {
+            AddCharacters(static_cast<uint32>(next - p));
+            p = next;
+            if (p >= loopEnd)
+                break;
+        }
+        if (((*p) == '\n') || ((*p) == '\r'))
+        {
+            AddNewLine(*p, 1);
+            p++;
+            continue;
+        }
+        // UTF-8 multi-byte sequence - use the same rules as the decoder (an invalid sequence is a one byte character)
+        const auto size = ch.FromUTF8Buffer(p, e) ? ch.Length() : 1U;
+        this->lastChar  = 0;
+        AddCharacter(size);
+        p += size;
+    }
+}
+void LineIndexBuilder::ProcessWithDecoder(const uint8* p, const uint8* loopEnd, const uint8* e)
+{
+    CharacterEncoding::ExpandedCharacter ch;
+
+    while (p < loopEnd)
+    {
+        if (ch.FromEncoding(this->encoding, p, e))
+        {
+            p += ch.Length();
+            auto chr = ch.GetChar();
+            if ((chr == '\n') || (chr == '\r'))
+            {
+                AddNewLine(chr, ch.Length());
+                continue;
+            }
+            // other character
+            this->lastChar = 0; // don't care
+            AddCharacter(ch.Length());
+        }
+        else
+        {
+            // need to treat conversion error
+            // consider one character (binary format)
+            p++;
+            AddCharacter(1);
+        }
+    }
+}
+void LineIndexBuilder::Process(BufferView buf, bool isLastBuffer)
+{
+    // buf must start at the current offset
+    auto* p       = buf.begin();
+    auto* e       = buf.end();
+    auto* loopEnd = buf.end();
+    if ((!isLastBuffer) && (buf.GetLength() > 16))
+    {
+        // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
+        // will be made
+        loopEnd -= 8;
+    }
+    if ((this->encoding == CharacterEncoding::Encoding::Unicode16LE) || (this->encoding == CharacterEncoding::Encoding::Unicode16BE))
+        ProcessWithDecoder(p, loopEnd, e);
+    else
+        ProcessBytes(p, loopEnd, e);
+}
+bool LineIndexBuilder::Finish()
+{
+    // returns true if a partial line (not ended by a new line) was emitted. The state is not reset so that the indexing can
+    // be resumed if more data is appended (see RewindToLineStart)
+    if (this->charCount > 0)
+    {
+        // last line
+        this->output->AddLine(LineInfo(this->start, this->charCount, (uint32) (this->offset - this->start)), this->startLastChar);
+        return true;
+    }
+    return false;
+}
+void LineIndexBuilder::RewindToLineStart()
+{
+    // the last buffer might have ended in the middle of a character --> the current line is parsed again (the partial line
+    // emitted by Finish has to be removed from the output)
+    this->offset    = this->start;
+    this->charCount = 0;
+    this->lastChar  = this->startLastChar;
+}
+
+LineIndex::LineIndex() : encoding(CharacterEncoding::Encoding::Binary), lastLine(0, 0, 0)
+{
+    this->dataEnd    = 0;
+    this->useCounter = 0;
+    this->linesCount = 0;
+    for (auto& b : this->blocks)
+    {
+        b.blockIndex = INVALID_BLOCK_INDEX;
+        b.lastUsed   = 0;
+    }
+}
+void LineIndex::Init(Reference<GView::Object> _obj, CharacterEncoding::Encoding _encoding, uint64 estimatedLinesCount)
+{
+    this->obj        = _obj;
+    this->encoding   = _encoding;
+    this->dataEnd    = _obj->GetData().GetSize();
+    this->lastLine   = LineInfo(0, 0, 0);
+    this->useCounter = 0;
+    this->linesCount = 0;
+    this->checkpoints.clear();
+    this->checkpoints.reserve(estimatedLinesCount / LINES_PER_CHECKPOINT + 1);
+    for (auto& b : this->blocks)
+    {
+        b.lines.clear();
+        b.blockIndex = INVALID_BLOCK_INDEX;
+        b.lastUsed   = 0;
+    }
+}
+void LineIndex::AddLine(const LineInfo& li, char16 startLastChar)
+{
+    if ((this->linesCount % LINES_PER_CHECKPOINT) == 0)
+        this->checkpoints.push_back({ li.offset, startLastChar });
+    this->lastLine = li;
+    this->linesCount++;
+}
+void LineIndex::RemoveLastLine()
+{
+    CHECKRET(this->linesCount > 0, "");
+    this->linesCount--;
+    if ((this->linesCount % LINES_PER_CHECKPOINT) == 0)
+        this->checkpoints.pop_back();
+    for (auto& b : this->blocks)
+    {
+        if ((b.blockIndex != INVALID_BLOCK_INDEX) && (b.blockIndex >= this->linesCount / LINES_PER_CHECKPOINT))
+            b.blockIndex = INVALID_BLOCK_INDEX;
+    }
+    if (this->linesCount == 0)
+    {
+        this->lastLine = LineInfo(0, 0, 0);
+        return;
+    }
+    auto b = GetBlock((this->linesCount - 1) / LINES_PER_CHECKPOINT);
+    CHECKRET(b, "");
+    this->lastLine = b->lines[(this->linesCount - 1) % LINES_PER_CHECKPOINT];
+}
+void LineIndex::SetDataEnd(uint64 _dataEnd)
+{
+    // new data was appended (the last block will receive new lines --> it has to be expanded again)
+    this->dataEnd = _dataEnd;
+    for (auto& b : this->blocks)
+    {
+        if ((b.blockIndex != INVALID_BLOCK_INDEX) && (b.blockIndex + 1 >= this->checkpoints.size()))
+            b.blockIndex = INVALID_BLOCK_INDEX;
+    }
+}
+LineIndex::ExpandedBlock* LineIndex::GetBlock(uint32 blockIndex)
+{
+    auto* lru = this->blocks;
+    for (auto& b : this->blocks)
+    {
+        if (b.blockIndex == blockIndex)
+        {
+            b.lastUsed = ++this->useCounter;
+            return &b;
+        }
+        if (b.lastUsed < lru->lastUsed)
+            lru = &b;
+    }
+
+    // not expanded --> re-index the lines of this block starting from its checkpoint
+    CHECK(blockIndex < this->checkpoints.size(), nullptr, "Invalid block index: %u", blockIndex);
+    const auto& cp            = this->checkpoints[blockIndex];
+    const auto expectedLines  = std::min<uint32>(LINES_PER_CHECKPOINT, this->linesCount - blockIndex * LINES_PER_CHECKPOINT);
+    BlockLinesCollector collector(lru->lines);
+    LineIndexBuilder builder;
+
+    lru->blockIndex = INVALID_BLOCK_INDEX;
+    lru->lines.clear();
+    builder.Init(&collector, cp.offset, this->encoding, cp.lastChar);
+    while ((lru->lines.size() < expectedLines) && (builder.GetOffset() < this->dataEnd))
+    {
+        const auto offset = builder.GetOffset();
+        auto buf          = this->obj->GetData().Get(offset, BLOCK_READ_SIZE, false);
+        if (buf.Empty())
+            break;
+        builder.Process(buf, (offset + buf.GetLength()) >= this->dataEnd);
+    }
+    if (lru->lines.size() < expectedLines)
+        builder.Finish();
+    CHECK(lru->lines.size() >= expectedLines, nullptr, "Fail to re-index block %u", blockIndex);
+
+    lru->lines.resize(expectedLines);
+    lru->blockIndex = blockIndex;
+    lru->lastUsed   = ++this->useCounter;
+    return lru;
+}
+bool LineIndex::Get(uint32 lineNo, LineInfo& li)
+{
+    if (lineNo >= this->linesCount)
+        return false;
+    if (lineNo + 1 == this->linesCount)
+    {
+        li = this->lastLine;
+        return true;
+    }
+    auto b = GetBlock(lineNo / LINES_PER_CHECKPOINT);
+    CHECK(b, false, "");
+    li = b->lines[lineNo % LINES_PER_CHECKPOINT];
+    return true;
+}
+uint32 LineIndex::FindLineByOffset(uint64 offset)
+{
+    // returns the last line that starts at or before the offset
+    if (this->linesCount == 0)
+        return 0;
+    auto it = std::upper_bound(
+          this->checkpoints.begin(), this->checkpoints.end(), offset, [](uint64 ofs, const Checkpoint& cp) { return ofs < cp.offset; });
+    if (it == this->checkpoints.begin())
+        return 0;
+    const auto blockIndex = static_cast<uint32>((it - this->checkpoints.begin()) - 1);
+    auto b                = GetBlock(blockIndex);
+    CHECK(b, 0, "");
+    auto lIt = std::upper_bound(
+          b->lines.begin(), b->lines.end(), offset, [](uint64 ofs, const LineInfo& li) { return ofs < li.offset; });
+    return blockIndex * LINES_PER_CHECKPOINT + static_cast<uint32>((lIt - b->lines.begin()) - 1);
+}
@@ -0,0 +1,557 @@
+#include "TextViewer.hpp"
+
+#include <algorithm>
+#include <functional>
+
+using namespace GView::View::TextViewer;
+
+constexpr uint64 SEARCH_CHUNK_SIZE    = 0x800000;   // 8M bytes per chunk
+constexpr uint32 SEARCH_SNAP_SIZE     = 0x10000;    // a chunk starts after the first new line found in this range
+constexpr uint32 SEARCH_OVERLAP_SIZE  = 0x10000;    // bytes decoded after the end of a chunk (for matches that cross it)
+constexpr uint32 MAX_PATTERN_SIZE     = 1024;       // characters (so that a literal match always fits in the overlap)
+constexpr uint32 MAX_SEARCH_MATCHES   = 0x10000;
+constexpr uint32 MAX_REGEX_SPAN       = 1024;       // characters - longer lines are matched in pieces (see SearchRegex)
+constexpr uint64 MAX_MEMORY_OBJECT    = 0x10000000; // non-file objects are copied in memory (256M max)
+constexpr uint32 PREVIEW_CHARS_BEFORE = 32;
+constexpr uint32 PREVIEW_CHARS        = 120;
+constexpr uint32 PREVIEW_BYTES_BEFORE = PREVIEW_CHARS_BEFORE * 2;
+constexpr uint32 PREVIEW_BYTES        = PREVIEW_CHARS * 3;
+
+namespace
+{
+template <typename T>
+inline T FoldCase(T ch)
+{
+    return ((ch >= 'A') && (ch <= 'Z')) ? (ch | 0x20) : ch;
+}
+template <typename T>
+struct FoldedHash
+{
+    inline size_t operator()(T ch) const
+    {
+        return std::hash<T>()(FoldCase(ch));
+    }
+};
+template <typename T>
+struct FoldedEqual
+{
+    inline bool operator()(T a, T b) const
+    {
+        return FoldCase(a) == FoldCase(b);
+    }
+};
+inline bool IsUnicode16(CharacterEncoding::Encoding encoding)
+{
+    return (encoding == CharacterEncoding::Encoding::Unicode16LE) || (encoding == CharacterEncoding::Encoding::Unicode16BE);
+}
+void Decode(const uint8* p, const uint8* e, CharacterEncoding::Encoding encoding, std::wstring& text, std::vector<uint32>& offsets)
+{
+    // same rules as the viewer: a character that can not be decoded is a one byte character
+    const auto* start    = p;
+    const auto asciiFast = !IsUnicode16(encoding);
+    size_t count         = 0;
+    CharacterEncoding::ExpandedCharacter ch;
+
+    text.resize(e - p);
+    offsets.resize((e - p) + 1);
+    while (p < e)
+    {
+        offsets[count] = static_cast<uint32>(p - start);
+        if ((asciiFast) && ((*p) < 0x80))
+        {
+            text[count++] = static_cast<wchar_t>(*p);
+            p++;
+            continue;
+        }
+        if (ch.FromEncoding(encoding, p, e))
+        {
+            text[count++] = static_cast<wchar_t>(ch.GetChar());
+            p += ch.Length();
+        }
+        else
+        {
+            text[count++] = static_cast<wchar_t>(*p);
+            p++;
+        }
+    }
+    offsets[count] = static_cast<uint32>(p - start); // end of the decoded text
+    text.resize(count);
+    offsets.resize(count + 1);
+}
+// A literal pattern can be searched directly in the raw data if it has a unique representation in the encoding of the object
+// (new lines and other ASCII characters can not be part of a multi-byte UTF-8 character). Case folding is only done for the
+// ASCII letters, so it can not be used on UTF-16 bytes.
+bool EncodePattern(const std::wstring& pattern, CharacterEncoding::Encoding encoding, bool matchCase, std::vector<uint8>& output)
+{
+    output.clear();
+    for (auto ch : pattern)
+    {
+        if ((ch >= 0xD800) && (ch <= 0xDFFF))
+            return false; // surrogates are not decoded as pairs by the viewer
+        switch (encoding)
+        {
+        case CharacterEncoding::Encoding::Ascii:
+        case CharacterEncoding::Encoding::Binary:
+            if (ch > 0xFF)
+                return false;
+            output.push_back(static_cast<uint8>(ch));
+            break;
+        case CharacterEncoding::Encoding::UTF8:
+            if (ch < 0x80)
+                output.push_back(static_cast<uint8>(ch));
+            else if (ch < 0x800)
+            {
+                output.push_back(static_cast<uint8>(0xC0 | (ch >> 6)));
+                output.push_back(static_cast<uint8>(0x80 | (ch & 0x3F)));
+            }
+            else
+            {
+                output.push_back(static_cast<uint8>(0xE0 | (ch >> 12)));
+                output.push_back(static_cast<uint8>(0x80 | ((ch >> 6) & 0x3F)));
+                output.push_back(static_cast<uint8>(0x80 | (ch & 0x3F)));
+            }
+            break;
+        case CharacterEncoding::Encoding::Unicode16LE:
+            if (!matchCase)
+                return false;
+            output.push_back(static_cast<uint8>(ch & 0xFF));
+            output.push_back(static_cast<uint8>(ch >> 8));
+            break;
+        case CharacterEncoding::Encoding::Unicode16BE:
+            if (!matchCase)
+                return false;
+            output.push_back(static_cast<uint8>(ch >> 8));
+            output.push_back(static_cast<uint8>(ch & 0xFF));
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool SearchSource::Open(const std::filesystem::path& path, uint64 _size)
+{
+    // the data cache of the object is not thread safe --> every worker uses its own handle
+    this->size   = _size;
+    this->memory = nullptr;
+    file.Close(); // a source can be opened again (the size of the file might have changed)
+    return file.OpenRead(path);
+}
+void SearchSource::Open(const Buffer& buffer)
+{
+    this->size   = buffer.GetLength();
+    this->memory = &buffer;
+}
+bool SearchSource::Read(uint64 offset, uint8* buffer, uint32 bufferSize)
+{
+    CHECK(offset + bufferSize <= this->size, false, "Invalid read (%u bytes from %llu)", bufferSize, offset);
+    if (this->memory)
+    {
+        memcpy(buffer, this->memory->GetData() + offset, bufferSize);
+        return true;
+    }
+    CHECK(file.SetCurrentPos(offset), false, "Fail to move to offset %llu", offset);
+    return file.Read(buffer, bufferSize);
+}
+
+SearchSession::SearchSession()
+    : size(0), dataStart(0), completedMatches(0), chunksCount(0), published(0), completed(0),
+      encoding(CharacterEncoding::Encoding::Binary), useRegex(false), matchCase(false), useMemory(false), processed(0), nextChunk(0),
+      activeWorkers(0), stop(false), finished(true), failed(false), truncated(false), canceled(false)
+{
+}
+SearchSession::~SearchSession()
+{
+    Stop();
+}
+bool SearchSession::Start(
+      Reference<GView::Object> obj,
+      u16string_view text,
+      bool _useRegex,
+      bool _matchCase,
+      CharacterEncoding::Encoding _encoding,
+      uint64 _dataStart,
+      String& error)
+{
+    CHECK(obj.IsValid(), false, "Expecting a valid object !");
+    CHECK(this->workers.empty(), false, "Search already started !");
+    if (text.empty())
+    {
+        error.Set("Nothing to search for !");
+        return false;
+    }
+    if (text.size() > MAX_PATTERN_SIZE)
+    {
+        error.SetFormat("The text to search for is too long (max %u characters)", MAX_PATTERN_SIZE);
+        return false;
+    }
+
+    this->pattern.assign(text.begin(), text.end());
+    this->useRegex  = _useRegex;
+    this->matchCase = _matchCase;
+    this->encoding  = _encoding;
+    if ((this->useRegex) || (!EncodePattern(this->pattern, this->encoding, this->matchCase, this->bytePattern)))
+        this->bytePattern.clear();
+    if (this->useRegex)
+    {
+        auto flags = std::regex_constants::ECMAScript | std::regex_constants::optimize;
+        if (!this->matchCase)
+            flags |= std::regex_constants::icase;
+        try
+        {
+            this->regex.assign(this->pattern, flags);
+        }
+        catch (const std::regex_error& e)
+        {
+            error.SetFormat("Invalid regular expression: %s", e.what());
+            return false;
+        }
+    }
+
+    this->size      = obj->GetData().GetSize();
+    this->dataStart = std::min<>(_dataStart, this->size);
+    this->useMemory = obj->GetObjectType() != GView::Object::Type::File;
+    if (this->useMemory)
+    {
+        if (this->size > MAX_MEMORY_OBJECT)
+        {
+            error.SetFormat("Object is too large to be searched (%llu bytes)", this->size);
+            return false;
+        }
+        if (this->size > 0)
+        {
+            this->memory = obj->GetData().CopyToBuffer(0, static_cast<uint32>(this->size), true);
+            if (!this->memory.IsValid())
+            {
+                error.SetFormat("Fail to copy %llu bytes for searching", this->size);
+                return false;
+            }
+        }
+    }
+    else
+    {
+        this->path = std::filesystem::path(obj->GetPath());
+    }
+
+    this->chunksCount = static_cast<uint32>((this->size - this->dataStart + SEARCH_CHUNK_SIZE - 1) / SEARCH_CHUNK_SIZE);
+    this->published   = 0;
+    this->chunkResults.clear();
+    this->chunkResults.resize(this->chunksCount);
+    this->chunkMatches.assign(this->chunksCount, 0);
+    this->chunkDone.assign(this->chunksCount, false);
+    this->matches.clear();
+    this->completed        = 0;
+    this->completedMatches = 0;
+    this->processed        = 0;
+    this->nextChunk        = 0;
+    this->stop             = false;
+    this->failed           = false;
+    this->truncated        = false;
+    this->canceled         = false;
+    if (this->chunksCount == 0)
+    {
+        this->finished = true;
+        return true;
+    }
+
+    const auto threadsCount = std::min<uint32>(this->chunksCount, std::max<uint32>(1, std::thread::hardware_concurrency()));
+    this->finished          = false;
+    this->activeWorkers     = threadsCount;
+    for (uint32 idx = 0; idx < threadsCount; idx++)
+        this->workers.emplace_back(&SearchSession::Run, this);
+    return true;
+}
+void SearchSession::Stop()
+{
+    this->canceled = this->canceled || (!this->finished);
+    this->stop     = true;
+    for (auto& w : this->workers)
+        if (w.joinable())
+            w.join();
+    this->workers.clear();
+}
+bool SearchSession::Update()
+{
+    // moves the results of the chunks that are done to 'matches' (in file order) - returns true if new matches were added
+    // only the first MAX_SEARCH_MATCHES matches are kept, so the same matches are shown no matter how the chunks were scheduled
+    std::lock_guard<std::mutex> lock(this->resultsLock);
+    const auto count = this->matches.size();
+    while ((this->published < this->chunksCount) && (this->chunkDone[this->published]))
+    {
+        auto& r      = this->chunkResults[this->published];
+        const auto n = std::min<size_t>(r.size(), MAX_SEARCH_MATCHES - std::min<size_t>(MAX_SEARCH_MATCHES, this->matches.size()));
+        this->matches.insert(this->matches.end(), std::make_move_iterator(r.begin()), std::make_move_iterator(r.begin() + n));
+        r.clear();
+        r.shrink_to_fit();
+        this->published++;
+    }
+    return this->matches.size() != count;
+}
+void SearchSession::Run()
+{
+    SearchSource source;
+    Workspace ws;
+
+    if (this->useMemory)
+        source.Open(this->memory);
+    else if (!source.Open(this->path, this->size))
+    {
+        this->failed = true;
+        this->stop   = true;
+    }
+    while (!this->stop)
+    {
+        const auto idx = this->nextChunk.fetch_add(1);
+        if (idx >= this->chunksCount)
+            break;
+        std::vector<SearchMatch> result;
+        if (!SearchChunk(source, idx, ws, result))
+        {
+            this->failed = true;
+            this->stop   = true;
+            break;
+        }
+        std::lock_guard<std::mutex> lock(this->resultsLock);
+        this->chunkMatches[idx] = static_cast<uint32>(result.size());
+        this->chunkResults[idx] = std::move(result);
+        this->chunkDone[idx]    = true;
+
+        // once the chunks that are done (from the first one) have more matches than can be shown, the rest of the object
+        // can not change the results anymore (every chunk keeps at most MAX_SEARCH_MATCHES + 1 matches)
+        while ((this->completed < this->chunksCount) && (this->chunkDone[this->completed]))
+            this->completedMatches += this->chunkMatches[this->completed++];
+        if (this->completedMatches > MAX_SEARCH_MATCHES)
+        {
+            this->truncated = true;
+            this->stop      = true;
+        }
+    }
+    if (this->activeWorkers.fetch_sub(1) == 1)
+        this->finished.store(true, std::memory_order_release);
+}
+bool SearchSession::FindChunkStart(SearchSource& source, uint64 offset, Workspace& ws, uint64& result)
+{
+    // a chunk starts right after the first new line found at (or after) its nominal offset, so that the chunk before it
+    // (that uses the same rule to find its end) can decide alone about every match that starts before that point
+    if ((offset <= this->dataStart) || (offset >= this->size))
+    {
+        result = offset <= this->dataStart ? this->dataStart : this->size;
+        return true;
+    }
+    const auto unicode16 = IsUnicode16(this->encoding);
+    if (unicode16)
+        offset -= (offset - this->dataStart) & 1;
+    const auto sz = static_cast<uint32>(std::min<uint64>(SEARCH_SNAP_SIZE, this->size - offset));
+    ws.buffer.resize(sz);
+    CHECK(source.Read(offset, ws.buffer.data(), sz), false, "Fail to read %u bytes from %llu", sz, offset);
+
+    const auto* p = ws.buffer.data();
+    result        = offset;
+    if (unicode16)
+    {
+        const auto le = this->encoding == CharacterEncoding::Encoding::Unicode16LE;
+        for (uint32 idx = 0; idx + 1 < sz; idx += 2)
+        {
+            if ((p[idx + (le ? 0 : 1)] == '\n') && (p[idx + (le ? 1 : 0)] == 0))
+            {
+                result = offset + idx + 2;
+                break;
+            }
+        }
+        return true;
+    }
+    if (auto nl = static_cast<const uint8*>(memchr(p, '\n', sz)); nl)
+    {
+        result = offset + (nl - p) + 1;
+        return true;
+    }
+    if (this->encoding == CharacterEncoding::Encoding::UTF8)
+    {
+        // no new line --> at least don't start in the middle of an UTF-8 character
+        for (uint32 idx = 0; (idx < sz) && (idx < 4); idx++)
+        {
+            if ((p[idx] & 0xC0) != 0x80)
+            {
+                result = offset + idx;
+                break;
+            }
+        }
+    }
+    return true;
+}
+bool SearchSession::AddMatch(
+      const std::wstring& text, const std::vector<uint32>& offsets, uint64 start, size_t pos, size_t len, std::vector<SearchMatch>& output)
+{
+    // returns false once the chunk has one match more than can be shown (its next matches would not be shown anyway)
+    auto from = pos;
+    while ((from > 0) && (pos - from < PREVIEW_CHARS_BEFORE) && (text[from - 1] != '\n') && (text[from - 1] != '\r'))
+        from--;
+    auto to = pos;
+    while ((to < text.size()) && (to - from < PREVIEW_CHARS) && (text[to] != '\n') && (text[to] != '\r'))
+        to++;
+
+    auto& m             = output.emplace_back();
+    m.offset            = start + offsets[pos];
+    m.size              = offsets[pos + len] - offsets[pos];
+    m.previewMatchStart = static_cast<uint32>(pos - from);
+    m.previewMatchSize  = static_cast<uint32>(std::min<size_t>(len, to - pos));
+    m.preview.reserve(to - from);
+    for (auto idx = from; idx < to; idx++)
+        m.preview.push_back(text[idx] < 32 ? u' ' : static_cast<char16>(text[idx]));
+    return output.size() <= MAX_SEARCH_MATCHES;
+}
+bool SearchSession::AddByteMatch(Workspace& ws, uint64 start, uint32 pos, std::vector<SearchMatch>& output)
+{
+    // only the area around the match is decoded (for the preview)
+    auto from      = pos > PREVIEW_BYTES_BEFORE ? pos - PREVIEW_BYTES_BEFORE : 0U;
+    const auto to  = static_cast<uint32>(std::min<size_t>(ws.buffer.size(), static_cast<size_t>(pos) + this->bytePattern.size() + PREVIEW_BYTES));
+    const auto* p  = ws.buffer.data();
+    if (IsUnicode16(this->encoding))
+        from += (pos - from) & 1;
+    else if (this->encoding == CharacterEncoding::Encoding::UTF8)
+        while ((from < pos) && ((p[from] & 0xC0) == 0x80))
+            from++;
+    Decode(p + from, p + to, this->encoding, ws.text, ws.offsets);
+
+    const auto first = std::lower_bound(ws.offsets.begin(), ws.offsets.end(), pos - from) - ws.offsets.begin();
+    const auto last  = std::lower_bound(ws.offsets.begin(), ws.offsets.end(), pos - from + static_cast<uint32>(this->bytePattern.size())) -
+                      ws.offsets.begin();
+    return AddMatch(ws.text, ws.offsets, start + from, first, last - first, output);
+}
+void SearchSession::SearchBytes(Workspace& ws, uint64 start, uint32 limit, std::vector<SearchMatch>& output)
+{
+    // the raw data is searched (no decoding) - a match has to start before 'limit' and, for UTF-16, on a character boundary
+    const auto* b         = ws.buffer.data();
+    const auto* e         = b + ws.buffer.size();
+    const auto unicode16  = IsUnicode16(this->encoding);
+    auto findAll          = [&](const auto& searcher)
+    {
+        for (auto* p = b; !this->stop;)
+        {
+            const auto r = searcher(p, e);
+            if (r.first == e)
+                break;
+            const auto pos = static_cast<uint32>(r.first - b);
+            if (pos >= limit)
+                break;
+            if ((unicode16) && (((start + pos - this->dataStart) & 1) != 0))
+            {
+                p = r.first + 1;
+                continue;
+            }
+            if (!AddByteMatch(ws, start, pos, output))
+                break;
+            p = r.second;
+        }
+    };
+    if (this->matchCase)
+        findAll(std::boyer_moore_horspool_searcher(this->bytePattern.begin(), this->bytePattern.end()));
+    else
+        findAll(std::boyer_moore_horspool_searcher(
+              this->bytePattern.begin(), this->bytePattern.end(), FoldedHash<uint8>(), FoldedEqual<uint8>()));
+}
+void SearchSession::SearchRegex(Workspace& ws, uint64 start, size_t limitIndex, std::vector<SearchMatch>& output)
+{
+    // the regex is applied on every line (without its new line) so that '^' and '$' match at the start and the end of the
+    // lines; the lines longer than MAX_REGEX_SPAN characters are split in pieces, because std::wregex backtracks recursively
+    // in some implementations (a pattern like "(a|b)*" over a few MB of text overflows the stack). As a result a match can
+    // not cross a new line, nor be longer than MAX_REGEX_SPAN characters.
+    const auto* b     = ws.text.data();
+    const auto* e     = b + ws.text.size();
+    const auto* limit = b + limitIndex;
+    for (auto* line = b; (line < limit) && (!this->stop);)
+    {
+        auto* lineEnd    = std::find(line, e, L'\n');
+        const auto* next = lineEnd == e ? e : lineEnd + 1;
+        if ((lineEnd > line) && (lineEnd[-1] == L'\r'))
+            lineEnd--;
+        for (auto* p = line; (p < limit) && (!this->stop);)
+        {
+            const auto* pe = static_cast<size_t>(lineEnd - p) > MAX_REGEX_SPAN ? p + MAX_REGEX_SPAN : lineEnd;
+            auto flags     = std::regex_constants::match_default;
+            if (p != line)
+                flags |= std::regex_constants::match_not_bol;
+            if (pe != lineEnd)
+                flags |= std::regex_constants::match_not_eol;
+            for (std::wcregex_iterator it(p, pe, this->regex, flags), last; (it != last) && (!this->stop); it++)
+            {
+                const auto pos = static_cast<size_t>(p - b) + static_cast<size_t>(it->position(0));
+                const auto len = static_cast<size_t>(it->length(0));
+                if (pos >= limitIndex)
+                    return;
+                if ((len > 0) && (!AddMatch(ws.text, ws.offsets, start, pos, len, output)))
+                    return;
+            }
+            if (pe == lineEnd)
+                break;
+            p = pe;
+        }
+        line = next;
+    }
+}
+bool SearchSession::SearchChunk(SearchSource& source, uint32 chunkIndex, Workspace& ws, std::vector<SearchMatch>& output)
+{
+    const auto nominal = this->dataStart + static_cast<uint64>(chunkIndex) * SEARCH_CHUNK_SIZE;
+    uint64 start, end;
+    CHECK(FindChunkStart(source, nominal, ws, start), false, "");
+    CHECK(FindChunkStart(source, std::min<uint64>(this->size, nominal + SEARCH_CHUNK_SIZE), ws, end), false, "");
+    if (start >= end)
+        return true;
+
+    // read the chunk and the overlap after it
+    const auto readSize = static_cast<uint32>(std::min<uint64>(this->size, end + SEARCH_OVERLAP_SIZE) - start);
+    ws.buffer.resize(readSize);
+    CHECK(source.Read(start, ws.buffer.data(), readSize), false, "Fail to read %u bytes from %llu", readSize, start);
+    if (!this->bytePattern.empty())
+    {
+        SearchBytes(ws, start, static_cast<uint32>(end - start), output);
+        this->processed += end - start;
+        return true;
+    }
+    Decode(ws.buffer.data(), ws.buffer.data() + readSize, this->encoding, ws.text, ws.offsets);
+
+    // only the matches that start before the end of the chunk belong to it
+    const auto limit = static_cast<uint32>(end - start);
+    const auto limitIndex =
+          static_cast<size_t>(std::lower_bound(ws.offsets.begin(), ws.offsets.end() - 1, limit) - ws.offsets.begin());
+    const auto* b = ws.text.data();
+    const auto* e = b + ws.text.size();
+
+    if (this->useRegex)
+    {
+        try
+        {
+            SearchRegex(ws, start, limitIndex, output);
+        }
+        catch (const std::regex_error& err)
+        {
+            // some implementations give up on patterns that are too complex (error_complexity / error_stack)
+            RETURNERROR(false, "Regular expression failed (%s)", err.what());
+        }
+    }
+    else
+    {
+        auto findAll = [&](const auto& searcher)
+        {
+            for (auto* p = b; !this->stop;)
+            {
+                const auto r = searcher(p, e);
+                if (r.first == e)
+                    break;
+                const auto pos = static_cast<size_t>(r.first - b);
+                if ((pos >= limitIndex) || (!AddMatch(ws.text, ws.offsets, start, pos, this->pattern.size(), output)))
+                    break;
+                p = r.second;
+            }
+        };
+        if (this->matchCase)
+            findAll(std::boyer_moore_horspool_searcher(this->pattern.begin(), this->pattern.end()));
+        else
+            findAll(std::boyer_moore_horspool_searcher(
+                  this->pattern.begin(), this->pattern.end(), FoldedHash<wchar_t>(), FoldedEqual<wchar_t>()));
+    }
+    this->processed += end - start;
+    return true;
+}
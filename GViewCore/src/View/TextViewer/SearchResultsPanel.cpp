@@ -0,0 +1,102 @@
+#include "TextViewer.hpp"
+
+using namespace GView::View::TextViewer;
+using namespace AppCUI::Input;
+
+enum class SearchResultAction : int32
+{
+    GoTo = 1,
+    Stop = 2
+};
+
+SearchResultsPanel::SearchResultsPanel(Reference<Instance> _view) : TabPage("&Find"), view(_view), shownMatches(0), finishedShown(false)
+{
+    status = Factory::Label::Create(this, "", "l:0,t:0,r:0,h:1");
+    list   = Factory::ListView::Create(
+          this, "l:0,t:1,r:0,b:0", { "n:Line,a:r,w:10", "n:Offset,a:r,w:14", "n:Text,a:l,w:200" }, ListViewFlags::None);
+}
+void SearchResultsPanel::SetSession(std::shared_ptr<SearchSession> _session)
+{
+    session       = _session;
+    shownMatches  = 0;
+    finishedShown = false;
+    list->DeleteAllItems();
+    Update();
+}
+bool SearchResultsPanel::Update()
+{
+    // called periodically (from the UI thread) - adds the matches that were found since the last call and returns false
+    // once the final state of the search is shown
+    CHECK(session, false, "");
+    if (finishedShown)
+        return false;
+    const auto finished = session->IsFinished(); // read first --> every match of a finished search is published below
+    session->Update();
+    finishedShown = finished;
+
+    LocalString<128> tmp;
+    const auto& matches = session->matches;
+    for (; shownMatches < matches.size(); shownMatches++)
+    {
+        const auto& m = matches[shownMatches];
+        auto item     = list->AddItem(tmp.Format("%u", view->OffsetToLineNumber(m.offset) + 1));
+        item.SetText(1, tmp.Format("%llu", m.offset));
+        item.SetText(2, m.preview);
+        item.HighlightText(2, m.previewMatchStart, m.previewMatchSize);
+        item.SetData(shownMatches);
+    }
+
+    if (!session->IsFinished())
+        status->SetText(tmp.Format("Searching ... %u%% (%u matches)", session->GetProgress(), (uint32) matches.size()));
+    else if (session->IsCanceled())
+        status->SetText(tmp.Format("Search stopped (%u matches)", (uint32) matches.size()));
+    else if (session->HasFailed())
+        status->SetText(tmp.Format("Search failed (%u matches)", (uint32) matches.size()));
+    else if (session->IsTruncated())
+        status->SetText(tmp.Format("Too many matches - only the first %u are shown", (uint32) matches.size()));
+    else
+        status->SetText(tmp.Format("%u matches", (uint32) matches.size()));
+    return true;
+}
+void SearchResultsPanel::GoToSelectedMatch()
+{
+    CHECKRET(session, "");
+    auto index = list->GetCurrentItem().GetData(session->matches.size());
+    CHECKRET(index < session->matches.size(), "");
+
+    const auto& m = session->matches[index];
+    view->Select(m.offset, m.size);
+}
+bool SearchResultsPanel::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    commandBar.SetCommand(Key::Enter, "GoTo", static_cast<int32_t>(SearchResultAction::GoTo));
+    if ((session) && (!session->IsFinished()))
+        commandBar.SetCommand(Key::F8, "Stop", static_cast<int32_t>(SearchResultAction::Stop));
+    return true;
+}
+bool SearchResultsPanel::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
+
+    if (evnt == Event::ListViewItemPressed)
+    {
+        GoToSelectedMatch();
+        return true;
+    }
+    if (evnt == Event::Command)
+    {
+        switch (static_cast<SearchResultAction>(controlID))
+        {
+        case SearchResultAction::GoTo:
+            GoToSelectedMatch();
+            return true;
+        case SearchResultAction::Stop:
+            if (session)
+                session->Stop();
+            finishedShown = false;
+            Update();
+            return true;
+        }
+    }
+    return false;
+}
@@ -2,6 +2,12 @@
 
 #include "Internal.hpp"
 
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <regex>
+#include <thread>
+
 namespace GView
 {
 namespace View
@@ -29,6 +35,7 @@ namespace View
             struct
             {
                 AppCUI::Input::Key WordWrap;
+                AppCUI::Input::Key Follow;
             } Keys;
             bool Loaded;
 
@@ -47,6 +54,237 @@ namespace View
             {
             }
         };
+        class LineIndexOutput
+        {
+          public:
+            // startLastChar is the parser state ('\n', '\r' or 0) at li.offset - needed to resume indexing from the start of the line
+            virtual void AddLine(const LineInfo& li, char16 startLastChar) = 0;
+        };
+        class LineIndexBuilder
+        {
+            uint64 start;
+            uint64 offset;
+            uint32 charCount;
+            char16 lastChar;
+            char16 startLastChar;
+            CharacterEncoding::Encoding encoding;
+            LineIndexOutput* output;
+
+            void AddCharacters(uint32 count);
+            void AddCharacter(uint32 size);
+            void AddNewLine(char16 chr, uint32 size);
+            void ProcessBytes(const uint8* p, const uint8* loopEnd, const uint8* e);
+            void ProcessWithDecoder(const uint8* p, const uint8* loopEnd, const uint8* e);
+
+          public:
+            void Init(LineIndexOutput* output, uint64 startOffset, CharacterEncoding::Encoding encoding, char16 lastChar = 0);
+            void Process(BufferView buf, bool isLastBuffer);
+            bool Finish();
+            void RewindToLineStart();
+            inline uint64 GetOffset() const
+            {
+                return offset;
+            }
+        };
+        // Sparse line index: only one checkpoint (line start + parser state) is kept for every LINES_PER_CHECKPOINT lines.
+        // The lines of a block are recomputed on demand (starting from its checkpoint) and kept in a small LRU cache.
+        class LineIndex : public LineIndexOutput
+        {
+            static constexpr uint32 LINES_PER_CHECKPOINT = 256;
+            static constexpr uint32 MAX_EXPANDED_BLOCKS  = 8;
+
+            struct Checkpoint
+            {
+                uint64 offset;
+                char16 lastChar;
+            };
+            struct ExpandedBlock
+            {
+                std::vector<LineInfo> lines;
+                uint32 blockIndex;
+                uint64 lastUsed;
+            };
+            std::vector<Checkpoint> checkpoints;
+            ExpandedBlock blocks[MAX_EXPANDED_BLOCKS];
+            Reference<GView::Object> obj;
+            CharacterEncoding::Encoding encoding;
+            LineInfo lastLine;
+            uint64 dataEnd;
+            uint64 useCounter;
+            uint32 linesCount;
+
+            ExpandedBlock* GetBlock(uint32 blockIndex);
+
+          public:
+            LineIndex();
+            void Init(Reference<GView::Object> obj, CharacterEncoding::Encoding encoding, uint64 estimatedLinesCount);
+            void AddLine(const LineInfo& li, char16 startLastChar) override;
+            void RemoveLastLine();
+            void SetDataEnd(uint64 dataEnd);
+
+            bool Get(uint32 lineNo, LineInfo& li);
+            uint32 FindLineByOffset(uint64 offset);
+            inline uint32 GetLinesCount() const
+            {
+                return linesCount;
+            }
+            inline bool Empty() const
+            {
+                return linesCount == 0;
+            }
+            inline const LineInfo& GetLastLine() const
+            {
+                return lastLine;
+            }
+        };
+        // Reports changes of a file on disk. On Linux this is done through inotify; on other platforms the size and the time of
+        // the last write of the file are compared with the ones from the previous call.
+        class FileWatcher
+        {
+            int32 handle;
+            int32 watch;
+            bool running;
+            std::filesystem::path path;
+            uint64 lastSize;
+            std::filesystem::file_time_type lastWriteTime;
+
+          public:
+            FileWatcher();
+            ~FileWatcher();
+
+            bool Start(u16string_view path);
+            void Stop();
+            bool HasChanged();
+            inline bool IsRunning() const
+            {
+                return running;
+            }
+        };
+        struct SearchMatch
+        {
+            uint64 offset;
+            uint32 size;
+            uint32 previewMatchStart; // character index of the match within the preview
+            uint32 previewMatchSize;
+            std::u16string preview;   // the text of the line around the match
+        };
+        class SearchSource
+        {
+            AppCUI::OS::File file;
+            const Buffer* memory;
+            uint64 size;
+
+          public:
+            SearchSource() : memory(nullptr), size(0)
+            {
+            }
+            bool Open(const std::filesystem::path& path, uint64 size);
+            void Open(const Buffer& buffer);
+            bool Read(uint64 offset, uint8* buffer, uint32 bufferSize);
+        };
+        // Searches the decoded text of an object on background threads. The object is split in chunks that start right after
+        // a new line; each worker decodes a chunk (plus an overlap after it) and keeps only the matches that start in the chunk.
+        class SearchSession
+        {
+            struct Workspace
+            {
+                std::vector<uint8> buffer;
+                std::wstring text;
+                std::vector<uint32> offsets; // offset of every decoded character (relative to the start of the chunk)
+            };
+
+            std::wstring pattern;
+            std::vector<uint8> bytePattern; // the pattern in the encoding of the object (if it can be searched without decoding)
+            std::wregex regex;
+            std::filesystem::path path;
+            Buffer memory;
+            std::vector<std::thread> workers;
+            std::mutex resultsLock;
+            std::vector<std::vector<SearchMatch>> chunkResults;
+            std::vector<uint32> chunkMatches; // matches found in every chunk (they are kept after the results are published)
+            std::vector<bool> chunkDone;
+            uint64 size, dataStart, completedMatches;
+            uint32 chunksCount, published, completed;
+            CharacterEncoding::Encoding encoding;
+            bool useRegex, matchCase, useMemory;
+            std::atomic<uint64> processed;
+            std::atomic<uint32> nextChunk, activeWorkers;
+            std::atomic<bool> stop, finished, failed, truncated;
+            bool canceled;
+
+            void Run();
+            bool FindChunkStart(SearchSource& source, uint64 offset, Workspace& ws, uint64& result);
+            bool SearchChunk(SearchSource& source, uint32 chunkIndex, Workspace& ws, std::vector<SearchMatch>& output);
+            bool AddMatch(
+                  const std::wstring& text,
+                  const std::vector<uint32>& offsets,
+                  uint64 start,
+                  size_t pos,
+                  size_t len,
+                  std::vector<SearchMatch>& output);
+            bool AddByteMatch(Workspace& ws, uint64 start, uint32 pos, std::vector<SearchMatch>& output);
+            void SearchBytes(Workspace& ws, uint64 start, uint32 limit, std::vector<SearchMatch>& output);
+            void SearchRegex(Workspace& ws, uint64 start, size_t limitIndex, std::vector<SearchMatch>& output);
+
+          public:
+            std::vector<SearchMatch> matches; // only accessed from the UI thread (in file order)
+
+            SearchSession();
+            ~SearchSession();
+
+            bool Start(
+                  Reference<GView::Object> obj,
+                  u16string_view text,
+                  bool useRegex,
+                  bool matchCase,
+                  CharacterEncoding::Encoding encoding,
+                  uint64 dataStart,
+                  String& error);
+            void Stop();
+            bool Update();
+
+            inline uint32 GetProgress() const
+            {
+                const auto total = size > dataStart ? size - dataStart : 0;
+                return total == 0 ? 100 : static_cast<uint32>(processed.load(std::memory_order_relaxed) * 100 / total);
+            }
+            inline bool IsFinished() const
+            {
+                return finished.load(std::memory_order_acquire);
+            }
+            inline bool IsTruncated() const
+            {
+                return truncated.load();
+            }
+            inline bool HasFailed() const
+            {
+                return failed.load();
+            }
+            inline bool IsCanceled() const
+            {
+                return canceled;
+            }
+        };
+        class Instance;
+        class SearchResultsPanel : public AppCUI::Controls::TabPage
+        {
+            Reference<Instance> view;
+            Reference<AppCUI::Controls::Label> status;
+            Reference<AppCUI::Controls::ListView> list;
+            std::shared_ptr<SearchSession> session;
+            size_t shownMatches;
+            bool finishedShown;
+
+            void GoToSelectedMatch();
+
+          public:
+            SearchResultsPanel(Reference<Instance> view);
+
+            void SetSession(std::shared_ptr<SearchSession> session);
+            bool Update();
+            bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+            bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+        };
         struct SubLineInfo
         {
             uint32 relativeOffset;
@@ -58,7 +296,85 @@ namespace View
             {
             }
         };
-        class Instance : public View::ViewControl
+        // splits the text of a line in sub-lines of at most 'width' columns (used by the view and by the WrapIndex worker)
+        void SplitLineInSubLines(
+              BufferView buf, uint32 width, Reference<SettingsData> settings, std::vector<SubLineInfo>& entries, uint32& leftAlignament);
+
+        class SubLinesCounter
+        {
+          public:
+            virtual uint32 CountSubLines(uint32 lineNo) = 0;
+        };
+        // Rows (sub-lines) of a wrapped text. The rows of every block of LINES_PER_BLOCK lines are counted on a background thread
+        // and kept in a Fenwick tree, so that a row can be converted to a line (and back) in O(log n). The rows of each line of
+        // a block are only counted (through a SubLinesCounter) when the block is used, and kept in a small LRU cache.
+        class WrapIndex : public LineIndexOutput
+        {
+            static constexpr uint32 LINES_PER_BLOCK     = 256;
+            static constexpr uint32 MAX_EXPANDED_BLOCKS = 4;
+
+            struct Checkpoint
+            {
+                uint64 offset;
+                char16 lastChar;
+            };
+            struct ExpandedBlock
+            {
+                std::vector<uint64> rows; // rows[i] = first row of the i-th line (relative to the block), rows[count] = total
+                uint32 blockIndex;
+                uint64 lastUsed;
+            };
+            // only used by the worker thread while it runs
+            std::vector<Checkpoint> checkpoints;
+            std::vector<uint64> blockRows;
+            std::vector<uint64> tree; // Fenwick tree over blockRows (1-based, tree[0] is not used)
+            std::vector<SubLineInfo> subLines;
+            std::vector<uint8> window;
+            std::vector<uint8> lineBuffer;
+            SearchSource source;
+            uint64 windowStart;
+            uint64 rowsCount;
+            uint32 linesCount;
+
+            ExpandedBlock blocks[MAX_EXPANDED_BLOCKS];
+            std::thread worker;
+            std::filesystem::path path;
+            Buffer memory;
+            SettingsData settings;
+            uint64 dataStart, dataEnd;
+            uint64 resumeOffset;
+            uint64 useCounter;
+            uint32 width;
+            char16 resumeLastChar;
+            bool useMemory, valid;
+            std::atomic<bool> stop, finished, failed;
+
+            void Run();
+            void Launch();
+            void Join();
+            void AppendToTree(uint64 rows);
+            uint64 GetRowsBeforeBlock(uint32 blockIndex) const;
+            ExpandedBlock* GetBlock(uint32 blockIndex, SubLinesCounter& counter);
+
+          public:
+            WrapIndex();
+            ~WrapIndex();
+
+            bool Start(Reference<GView::Object> obj, uint64 dataStart, const SettingsData& settings, uint32 width);
+            bool Resume(uint64 dataEnd);
+            void Stop();
+            void AddLine(const LineInfo& li, char16 startLastChar) override;
+
+            bool IsBuiltFor(const SettingsData& settings, uint32 width) const;
+            bool IsReady(uint32 linesCount) const;
+            inline uint64 GetRowsCount() const
+            {
+                return rowsCount;
+            }
+            bool LineToRow(uint32 lineNo, uint32 subLineNo, SubLinesCounter& counter, uint64& row);
+            bool RowToLine(uint64 row, SubLinesCounter& counter, uint32& lineNo, uint32& subLineNo);
+        };
+        class Instance : public View::ViewControl, public SubLinesCounter
         {
             enum class Direction
             {
@@ -71,7 +387,11 @@ namespace View
                 Text,
                 Border
             };
-            std::vector<LineInfo> lines;      
+            LineIndex lines;
+            LineIndexBuilder indexer; // kept after the initial indexing so that appended data can be indexed incrementally
+            FileWatcher watcher;
+            Buffer indexedTail; // the last indexed bytes (if they change, the file was truncated and written again)
+            WrapIndex wrapIndex;
             Utils::Selection selection;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
@@ -80,8 +400,15 @@ namespace View
             uint32 lineNumberWidth;
             uint32 sizeOfBOM;
             MouseStatus mouseStatus;
+            bool lastLineIsOpen; // the last line has no new line after it (it might continue if data is appended)
+            bool follow;
 
 
+            struct
+            {
+                std::shared_ptr<SearchSession> session;
+                Reference<SearchResultsPanel> panel;
+            } Search;
             struct
             {
                 std::vector<SubLineInfo> entries;
@@ -125,6 +452,11 @@ namespace View
             void OpenCurrentSelection();
 
             void RecomputeLineIndexes();
+            void UpdateLineNumberWidth();
+            void IndexAppendedData();
+            void RememberIndexedTail();
+            bool IndexedTailChanged();
+            bool SetFollowMode(bool enabled);
             void CommputeViewPort_NoWrap(uint32 lineNo, Direction dir);
             void CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction dir);
             void ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir);
@@ -134,7 +466,11 @@ namespace View
             void ComputeSubLineIndexes(uint32 lineNo, BufferView& buf, uint64& startOffset);
             void ComputeSubLineIndexes(uint32 lineNo);
             uint32 CharacterIndexToSubLineNo(uint32 charIndex);
-            
+            uint32 GetWrapWidth();
+            void UpdateWrapIndex();
+            bool LineToRow(uint32 lineNo, uint32 subLineNo, uint64& row);
+            bool RowToLine(uint64 row, uint32& lineNo, uint32& subLineNo);
+
             void DrawLine(uint32 viewDataIndex, Graphics::Renderer& renderer, ControlState state, bool showLineNumber);
 
             void MoveTo(uint32 lineNo, uint32 charIndex, bool select);
@@ -167,7 +503,14 @@ namespace View
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
 
+            inline uint32 OffsetToLineNumber(uint64 offset)
+            {
+                return this->lines.FindLineByOffset(offset);
+            }
+            uint32 CountSubLines(uint32 lineNo) override;
+
             virtual void Paint(Graphics::Renderer& renderer) override;
+            virtual bool OnFrameUpdate() override;
             virtual bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
             virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
@@ -197,6 +540,32 @@ namespace View
             bool IsPropertyValueReadOnly(uint32 propertyID) override;
             const vector<Property> GetPropertiesList() override;
         };
+        class FindDialog : public Window
+        {
+            Reference<TextField> txText;
+            Reference<CheckBox> cbRegex;
+            Reference<CheckBox> cbMatchCase;
+            std::u16string text;
+
+            void Validate();
+
+          public:
+            FindDialog();
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline u16string_view GetText() const
+            {
+                return text;
+            }
+            inline bool UseRegex() const
+            {
+                return cbRegex->IsChecked();
+            }
+            inline bool MatchCase() const
+            {
+                return cbMatchCase->IsChecked();
+            }
+        };
         class GoToDialog : public Window
         {
             Reference<RadioBox> rbLineNumber;
@@ -0,0 +1,265 @@
+#include "TextViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using namespace GView::View::TextViewer;
+
+constexpr uint32 WRAP_READ_SIZE      = 0x100000;   // bytes read at once by the worker
+constexpr uint64 MAX_MEMORY_OBJECT   = 0x10000000; // non-file objects are copied in memory (256M max)
+constexpr uint32 INVALID_BLOCK_INDEX = 0xFFFFFFFF;
+
+WrapIndex::WrapIndex()
+    : windowStart(0), rowsCount(0), linesCount(0), dataStart(0), dataEnd(0), resumeOffset(0), useCounter(0), width(0), resumeLastChar(0),
+      useMemory(false), valid(false), stop(false), finished(true), failed(false)
+{
+    for (auto& b : this->blocks)
+    {
+        b.blockIndex = INVALID_BLOCK_INDEX;
+        b.lastUsed   = 0;
+    }
+}
+WrapIndex::~WrapIndex()
+{
+    Join();
+}
+bool WrapIndex::Start(Reference<GView::Object> obj, uint64 _dataStart, const SettingsData& _settings, uint32 _width)
+{
+    CHECK(obj.IsValid(), false, "Expecting a valid object !");
+    Stop();
+
+    this->dataEnd   = obj->GetData().GetSize();
+    this->dataStart = std::min<>(_dataStart, this->dataEnd);
+    this->useMemory = obj->GetObjectType() != GView::Object::Type::File;
+    if (this->useMemory)
+    {
+        // the content of a memory object does not change --> it is only copied once
+        CHECK(this->dataEnd <= MAX_MEMORY_OBJECT, false, "Object is too large to be indexed (%llu bytes)", this->dataEnd);
+        if ((this->dataEnd > 0) && (this->memory.GetLength() != this->dataEnd))
+        {
+            this->memory = obj->GetData().CopyToBuffer(0, static_cast<uint32>(this->dataEnd), true);
+            CHECK(this->memory.IsValid(), false, "Fail to copy %llu bytes", this->dataEnd);
+        }
+    }
+    else
+    {
+        this->path = std::filesystem::path(obj->GetPath());
+    }
+
+    this->settings   = _settings;
+    this->width      = _width;
+    this->rowsCount  = 0;
+    this->linesCount = 0;
+    this->checkpoints.clear();
+    this->blockRows.clear();
+    this->tree.assign(1, 0);
+    this->resumeOffset   = this->dataStart;
+    this->resumeLastChar = 0;
+    this->valid          = true;
+    Launch();
+    return true;
+}
+bool WrapIndex::Resume(uint64 _dataEnd)
+{
+    // data was appended --> the last block is counted again (its last line might continue) together with the new data
+    CHECK(this->valid, false, "The index was not started !");
+    Join();
+    CHECK(!this->failed, false, "The index has failed !");
+    CHECK(_dataEnd >= this->dataEnd, false, "Data can only be appended !");
+
+    if (!this->blockRows.empty())
+    {
+        const auto lastBlock = static_cast<uint32>(this->blockRows.size() - 1);
+        this->linesCount     = lastBlock * LINES_PER_BLOCK;
+        this->rowsCount -= this->blockRows.back();
+        this->resumeOffset   = this->checkpoints.back().offset;
+        this->resumeLastChar = this->checkpoints.back().lastChar;
+        this->blockRows.pop_back();
+        this->checkpoints.pop_back();
+        // the values of a Fenwick tree only depend on the elements before them --> the tree can simply be truncated
+        this->tree.resize(std::min<size_t>(this->tree.size(), this->blockRows.size() + 1));
+    }
+    else
+    {
+        this->resumeOffset   = this->dataStart;
+        this->resumeLastChar = 0;
+    }
+    this->dataEnd = _dataEnd;
+    Launch();
+    return true;
+}
+void WrapIndex::Launch()
+{
+    for (auto& b : this->blocks)
+        b.blockIndex = INVALID_BLOCK_INDEX;
+    this->stop     = false;
+    this->failed   = false;
+    this->finished = false;
+    this->worker   = std::thread(&WrapIndex::Run, this);
+}
+void WrapIndex::Join()
+{
+    this->stop = true;
+    if (this->worker.joinable())
+        this->worker.join();
+}
+void WrapIndex::Stop()
+{
+    Join();
+    this->valid = false;
+}
+void WrapIndex::Run()
+{
+    if (this->useMemory)
+        this->source.Open(this->memory);
+    else if (!this->source.Open(this->path, this->dataEnd))
+        this->failed = true;
+
+    LineIndexBuilder builder;
+    builder.Init(this, this->resumeOffset, this->settings.encoding, this->resumeLastChar);
+    while ((!this->stop) && (!this->failed) && (builder.GetOffset() < this->dataEnd))
+    {
+        const auto offset = builder.GetOffset();
+        const auto sz     = static_cast<uint32>(std::min<uint64>(WRAP_READ_SIZE, this->dataEnd - offset));
+        this->window.resize(sz);
+        this->windowStart = offset;
+        if (!this->source.Read(offset, this->window.data(), sz))
+        {
+            this->failed = true;
+            break;
+        }
+        builder.Process(BufferView(this->window.data(), sz), (offset + sz) >= this->dataEnd);
+    }
+    if ((!this->stop) && (!this->failed))
+        builder.Finish();
+
+    // blocks are added to the tree only when they are complete (or at the end) - a stopped worker can be resumed from here
+    while (this->tree.size() <= this->blockRows.size())
+        AppendToTree(this->blockRows[this->tree.size() - 1]);
+    this->finished.store(true, std::memory_order_release);
+}
+void WrapIndex::AddLine(const LineInfo& li, char16 startLastChar)
+{
+    // called from the worker thread
+    if ((this->linesCount % LINES_PER_BLOCK) == 0)
+    {
+        while (this->tree.size() <= this->blockRows.size())
+            AppendToTree(this->blockRows[this->tree.size() - 1]); // the previous block is complete
+        this->checkpoints.push_back({ li.offset, startLastChar });
+        this->blockRows.push_back(0);
+    }
+    BufferView buf;
+    if ((li.offset >= this->windowStart) && (li.offset + li.size <= this->windowStart + this->window.size()))
+    {
+        buf = BufferView(this->window.data() + (li.offset - this->windowStart), li.size);
+    }
+    else if (li.size > 0)
+    {
+        // the line started in a previous window
+        this->lineBuffer.resize(li.size);
+        if (this->source.Read(li.offset, this->lineBuffer.data(), li.size))
+            buf = BufferView(this->lineBuffer.data(), li.size);
+        else
+            this->failed = true;
+    }
+
+    // same rules as Instance::ComputeSubLineIndexes (there is always at least one sub-line)
+    uint32 rows = 1;
+    if (!buf.Empty())
+    {
+        uint32 leftAlignament;
+        SplitLineInSubLines(buf, this->width, &this->settings, this->subLines, leftAlignament);
+        rows = std::max<uint32>(1, static_cast<uint32>(this->subLines.size()));
+    }
+    this->blockRows.back() += rows;
+    this->rowsCount += rows;
+    this->linesCount++;
+}
+void WrapIndex::AppendToTree(uint64 rows)
+{
+    // tree[n] holds the sum of the elements from (n - lowbit(n), n] --> add the nodes that cover that range
+    const auto n   = this->tree.size();
+    const auto low = n - (n & (~n + 1));
+    for (auto idx = n - 1; idx > low; idx -= idx & (~idx + 1))
+        rows += this->tree[idx];
+    this->tree.push_back(rows);
+}
+uint64 WrapIndex::GetRowsBeforeBlock(uint32 blockIndex) const
+{
+    uint64 sum = 0;
+    for (size_t idx = blockIndex; idx > 0; idx &= idx - 1)
+        sum += this->tree[idx];
+    return sum;
+}
+WrapIndex::ExpandedBlock* WrapIndex::GetBlock(uint32 blockIndex, SubLinesCounter& counter)
+{
+    auto* lru = this->blocks;
+    for (auto& b : this->blocks)
+    {
+        if (b.blockIndex == blockIndex)
+        {
+            b.lastUsed = ++this->useCounter;
+            return &b;
+        }
+        if (b.lastUsed < lru->lastUsed)
+            lru = &b;
+    }
+
+    CHECK(blockIndex < this->blockRows.size(), nullptr, "Invalid block index: %u", blockIndex);
+    const auto first = blockIndex * LINES_PER_BLOCK;
+    const auto count = std::min<uint32>(LINES_PER_BLOCK, this->linesCount - first);
+    lru->blockIndex  = INVALID_BLOCK_INDEX;
+    lru->rows.resize(count + 1);
+    lru->rows[0] = 0;
+    for (uint32 idx = 0; idx < count; idx++)
+        lru->rows[idx + 1] = lru->rows[idx] + counter.CountSubLines(first + idx);
+    CHECK(lru->rows[count] == this->blockRows[blockIndex], nullptr, "Rows of block %u differ from the index", blockIndex);
+
+    lru->blockIndex = blockIndex;
+    lru->lastUsed   = ++this->useCounter;
+    return lru;
+}
+bool WrapIndex::IsBuiltFor(const SettingsData& _settings, uint32 _width) const
+{
+    return (this->valid) && (!this->failed) && (this->width == _width) && (this->settings.wrapMethod == _settings.wrapMethod) &&
+           (this->settings.tabSize == _settings.tabSize) && (this->settings.encoding == _settings.encoding);
+}
+bool WrapIndex::IsReady(uint32 _linesCount) const
+{
+    return (this->valid) && (this->finished.load(std::memory_order_acquire)) && (!this->failed) && (this->linesCount == _linesCount);
+}
+bool WrapIndex::LineToRow(uint32 lineNo, uint32 subLineNo, SubLinesCounter& counter, uint64& row)
+{
+    CHECK(lineNo < this->linesCount, false, "Invalid line number: %u", lineNo);
+    const auto blockIndex = lineNo / LINES_PER_BLOCK;
+    const auto idx        = lineNo % LINES_PER_BLOCK;
+    auto b                = GetBlock(blockIndex, counter);
+    CHECK(b, false, "");
+    const auto lineRows = b->rows[idx + 1] - b->rows[idx];
+    row                 = GetRowsBeforeBlock(blockIndex) + b->rows[idx] + std::min<uint64>(subLineNo, lineRows - 1);
+    return true;
+}
+bool WrapIndex::RowToLine(uint64 row, SubLinesCounter& counter, uint32& lineNo, uint32& subLineNo)
+{
+    CHECK(row < this->rowsCount, false, "Invalid row: %llu", row);
+
+    // Fenwick descent: the largest number of blocks with less rows (in total) than 'row'
+    const auto n = this->tree.size() - 1;
+    size_t pos   = 0;
+    for (auto step = std::bit_floor(n); step > 0; step >>= 1)
+    {
+        if ((pos + step <= n) && (this->tree[pos + step] <= row))
+        {
+            pos += step;
+            row -= this->tree[pos];
+        }
+    }
+    CHECK(pos < this->blockRows.size(), false, "");
+    const auto blockIndex = static_cast<uint32>(pos);
+    auto b                = GetBlock(blockIndex, counter);
+    CHECK(b, false, "");
+    const auto it = std::upper_bound(b->rows.begin(), b->rows.end(), row) - 1;
+    lineNo        = blockIndex * LINES_PER_BLOCK + static_cast<uint32>(it - b->rows.begin());
+    subLineNo     = static_cast<uint32>(row - (*it));
+    return true;
+}
@@ -271,6 +271,8 @@ namespace Utils
         };
         Encoding AnalyzeBufferForEncoding(BufferView buf, bool checkForBOM, uint32& BOMLength);
         UnicodeString ConvertToUnicode16(BufferView buf);
+        UnicodeString ConvertToUnicode16(BufferView buf, Encoding encoding, uint32 BOMLength);
+        UnicodeString ConvertToUnicode16(DataCache& cache);
         BufferView GetBOMForEncoding(Encoding encoding);
     }; // namespace CharacterEncoding
 } // namespace Utils
@@ -584,6 +586,7 @@ namespace App
         uint32 GetObjectsCount();
         Reference<GView::Object> GetObject(uint32 index);
         Reference<GView::Object> GetCurrentObject();
+        Reference<GView::View::WindowInterface> GetCurrentWindow();
         uint32 GetTypePluginsCount();
         std::string_view GetTypePluginName(uint32 index);
         std::string_view GetTypePluginDescription(uint32 index);
@@ -670,6 +673,9 @@ namespace App
         bool CreateViewer(const std::string_view& name, View::LexicalViewer::Settings& settings) override;
 
         Reference<View::ViewControl> GetCurrentView() override;
+        uint32 GetViewsCount();
+        Reference<View::ViewControl> GetViewByIndex(uint32 index);
+        bool SetCurrentViewByIndex(uint32 index);
 
         bool OnKeyEvent(AppCUI::Input::Key keyCode, char16_t unicode) override;
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "GView.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <vector>
+
+namespace GView::GenericPlugins::SignatureScanner
+{
+using namespace AppCUI;
+using namespace AppCUI::Utils;
+using namespace AppCUI::Application;
+using namespace AppCUI::Controls;
+using namespace GView::Utils;
+using namespace GView::View;
+
+constexpr uint32 MAX_RULE_SIZE     = 4096;
+constexpr uint32 MAX_ANCHOR_SIZE   = 16;
+constexpr uint32 MAX_MATCHES       = 0x10000;
+constexpr uint64 MAX_MEMORY_OBJECT = 0x10000000ULL;
+
+struct Rule
+{
+    std::string name;
+    std::vector<uint8> bytes;
+    std::vector<uint8> mask; // 0xFF for a fixed byte, 0x00 for a wildcard (??)
+    uint32 anchorOffset;     // the longest wildcard-free run - this is what the automaton looks for
+    uint32 anchorSize;
+
+    bool Match(const uint8* data) const;
+};
+
+struct SignatureMatch
+{
+    uint64 offset;
+    uint32 rule;
+};
+
+bool LoadRules(const std::filesystem::path& path, std::vector<Rule>& rules, std::string& error);
+
+// Aho-Corasick automaton over the anchors of all rules, expanded into a full DFA (256 transitions per state)
+// so that a scan costs one table lookup per byte no matter how many rules are loaded
+class Automaton
+{
+    std::vector<uint32> transitions;
+    std::vector<uint32> outputStart; // outputs[outputStart[s] .. outputStart[s+1]) = rules whose anchor ends in state s
+    std::vector<uint32> outputs;
+
+  public:
+    bool Build(const std::vector<Rule>& rules);
+
+    inline uint32 Next(uint32 state, uint8 value) const
+    {
+        return transitions[(static_cast<size_t>(state) << 8) | value];
+    }
+    inline bool HasOutputs(uint32 state) const
+    {
+        return outputStart[state] != outputStart[state + 1];
+    }
+    inline const uint32* OutputsBegin(uint32 state) const
+    {
+        return outputs.data() + outputStart[state];
+    }
+    inline const uint32* OutputsEnd(uint32 state) const
+    {
+        return outputs.data() + outputStart[state + 1];
+    }
+    inline uint32 GetStatesCount() const
+    {
+        return static_cast<uint32>(outputStart.size() - 1);
+    }
+};
+
+class DataSource
+{
+    AppCUI::OS::File file;
+    const Buffer* memory;
+    uint64 size;
+
+  public:
+    DataSource() : memory(nullptr), size(0)
+    {
+    }
+    bool Open(const std::filesystem::path& path, uint64 size);
+    void Open(const Buffer& buffer);
+    bool Read(uint64 offset, uint8* buffer, uint32 bufferSize);
+};
+
+class Scanner
+{
+    const std::vector<Rule>& rules;
+    Automaton automaton;
+    uint32 maxRuleSize;
+    std::atomic<uint64> processed;
+    std::atomic<bool> stop, truncated, failed;
+
+    void ScanChunk(DataSource& source, uint64 objectSize, uint64 start, uint64 end, std::vector<SignatureMatch>& output);
+
+  public:
+    Scanner(const std::vector<Rule>& rules);
+
+    bool Scan(Reference<GView::Object> object, std::vector<SignatureMatch>& matches);
+    inline bool IsTruncated() const
+    {
+        return truncated.load();
+    }
+};
+
+namespace Panels
+{
+    class Results : public AppCUI::Controls::TabPage, public GView::View::BufferViewer::ZoneProviderInterface
+    {
+        static std::vector<Results*> panels; // one for every window that was scanned (removed when its window is closed)
+
+        std::vector<Rule> rules;
+        std::vector<SignatureMatch> matches;
+        Reference<GView::View::WindowInterface> win;
+        Reference<GView::Object> object;
+        Reference<AppCUI::Controls::ListView> list;
+        uint64 maxMatchSize;
+        uint32 zonesVersion;
+        int32 Base;
+
+        std::string_view GetValue(NumericFormatter& n, uint64 value);
+        void GoToSelectedMatch();
+        void SelectCurrentMatch();
+
+      public:
+        Results(Reference<GView::View::WindowInterface> win);
+        ~Results();
+
+        static Reference<Results> Find(Reference<GView::View::WindowInterface> win);
+        // the matches of a new scan replace the ones that are listed (and shown as zones)
+        void SetMatches(std::vector<Rule> rules, std::vector<SignatureMatch> matches);
+        void Update();
+        bool GetZones(uint64 start, uint64 end, std::vector<GView::View::BufferViewer::BufferZone>& zones) override;
+        uint32 GetZonesVersion() override;
+        bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+        bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+    };
+} // namespace Panels
+} // namespace GView::GenericPlugins::SignatureScanner
@@ -0,0 +1,82 @@
+#include "SignatureScanner.hpp"
+
+#include <deque>
+
+namespace GView::GenericPlugins::SignatureScanner
+{
+constexpr uint32 NO_STATE = 0xFFFFFFFF;
+
+bool Automaton::Build(const std::vector<Rule>& rules)
+{
+    // 1. build the trie (state 0 is the root)
+    std::vector<uint32> trie(256, NO_STATE);
+    std::vector<std::vector<uint32>> stateOutputs(1);
+    for (uint32 ruleIndex = 0; ruleIndex < static_cast<uint32>(rules.size()); ruleIndex++)
+    {
+        const auto& r = rules[ruleIndex];
+        CHECK(r.anchorSize > 0, false, "Rule '%s' has no anchor !", r.name.c_str());
+        uint32 state = 0;
+        for (uint32 idx = 0; idx < r.anchorSize; idx++)
+        {
+            const auto value = r.bytes[r.anchorOffset + idx];
+            auto& next       = trie[(static_cast<size_t>(state) << 8) | value];
+            if (next == NO_STATE)
+            {
+                next = static_cast<uint32>(stateOutputs.size());
+                stateOutputs.emplace_back();
+                trie.resize(trie.size() + 256, NO_STATE);
+            }
+            state = trie[(static_cast<size_t>(state) << 8) | value];
+        }
+        stateOutputs[state].push_back(ruleIndex);
+    }
+
+    // 2. BFS over the trie - compute the fail links and turn missing edges into DFA transitions
+    const auto statesCount = static_cast<uint32>(stateOutputs.size());
+    std::vector<uint32> fail(statesCount, 0);
+    std::deque<uint32> queue;
+    for (uint32 value = 0; value < 256; value++)
+    {
+        auto& next = trie[value];
+        if (next == NO_STATE)
+            next = 0;
+        else
+            queue.push_back(next);
+    }
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+        // a state also reports everything its fail state reports (the fail state is closer to the root, so it is already complete)
+        const auto& inherited = stateOutputs[fail[state]];
+        stateOutputs[state].insert(stateOutputs[state].end(), inherited.begin(), inherited.end());
+
+        for (uint32 value = 0; value < 256; value++)
+        {
+            auto& next           = trie[(static_cast<size_t>(state) << 8) | value];
+            const auto failState = trie[(static_cast<size_t>(fail[state]) << 8) | value];
+            if (next == NO_STATE)
+            {
+                next = failState;
+            }
+            else
+            {
+                fail[next] = failState;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    // 3. flatten the outputs
+    transitions = std::move(trie);
+    outputStart.resize(static_cast<size_t>(statesCount) + 1);
+    outputs.clear();
+    for (uint32 state = 0; state < statesCount; state++)
+    {
+        outputStart[state] = static_cast<uint32>(outputs.size());
+        outputs.insert(outputs.end(), stateOutputs[state].begin(), stateOutputs[state].end());
+    }
+    outputStart[statesCount] = static_cast<uint32>(outputs.size());
+    return true;
+}
+} // namespace GView::GenericPlugins::SignatureScanner
@@ -0,0 +1,187 @@
+#include "SignatureScanner.hpp"
+
+#include <algorithm>
+
+namespace GView::GenericPlugins::SignatureScanner::Panels
+{
+using namespace AppCUI::Controls;
+using namespace AppCUI::Input;
+
+constexpr uint32 PREVIEW_SIZE = 16;
+
+enum class ResultAction : int32
+{
+    GoTo       = 1,
+    Select     = 2,
+    ChangeBase = 4
+};
+
+static const ColorPair zoneColors[] = {
+    ColorPair{ Color::Black, Color::Olive },    ColorPair{ Color::Black, Color::Teal },      ColorPair{ Color::Black, Color::Silver },
+    ColorPair{ Color::White, Color::Magenta },  ColorPair{ Color::White, Color::DarkBlue },  ColorPair{ Color::White, Color::DarkGreen },
+    ColorPair{ Color::White, Color::DarkRed },  ColorPair{ Color::Black, Color::Pink },
+};
+
+std::vector<Results*> Results::panels;
+
+Results::Results(Reference<GView::View::WindowInterface> _win) : TabPage("&Signatures")
+{
+    win          = _win;
+    object       = win->GetObject();
+    maxMatchSize = 0;
+    zonesVersion = 0;
+    Base         = 16;
+
+    list = Factory::ListView::Create(
+          this, "d:c", { "n:Offset,a:r,w:20", "n:Size,a:r,w:10", "n:Rule,a:l,w:30", "n:Preview,a:l,w:50" }, ListViewFlags::None);
+
+    panels.push_back(this);
+}
+
+Results::~Results()
+{
+    auto it = std::find(panels.begin(), panels.end(), this);
+    if (it != panels.end())
+        panels.erase(it);
+}
+
+Reference<Results> Results::Find(Reference<GView::View::WindowInterface> win)
+{
+    for (auto p : panels)
+        if (p->win == win)
+            return p;
+    return nullptr;
+}
+
+void Results::SetMatches(std::vector<Rule> _rules, std::vector<SignatureMatch> _matches)
+{
+    rules   = std::move(_rules);
+    matches = std::move(_matches);
+
+    maxMatchSize = 0;
+    for (const auto& r : rules)
+        maxMatchSize = std::max<uint64>(maxMatchSize, r.bytes.size());
+    zonesVersion++;
+
+    Update();
+}
+
+bool Results::GetZones(uint64 start, uint64 end, std::vector<GView::View::BufferViewer::BufferZone>& zones)
+{
+    // the matches are sorted by offset --> the first one that could still cover start begins at most maxMatchSize bytes before it
+    const auto from = start - std::min<uint64>(start, maxMatchSize);
+    auto it         = std::lower_bound(
+          matches.begin(), matches.end(), from, [](const SignatureMatch& m, uint64 value) { return m.offset < value; });
+    for (; (it != matches.end()) && (it->offset < end); it++)
+    {
+        const auto& r = rules[it->rule];
+        if (it->offset + r.bytes.size() <= start)
+            continue;
+        auto& z = zones.emplace_back();
+        z.start = it->offset;
+        z.size  = r.bytes.size();
+        z.color = zoneColors[it->rule % ARRAY_LEN(zoneColors)];
+        z.name  = r.name;
+    }
+    return true;
+}
+
+uint32 Results::GetZonesVersion()
+{
+    return zonesVersion;
+}
+
+std::string_view Results::GetValue(NumericFormatter& n, uint64 value)
+{
+    if (Base == 10)
+    {
+        return n.ToString(value, { NumericFormatFlags::None, 10, 3, ',' });
+    }
+
+    return n.ToString(value, { NumericFormatFlags::HexPrefix, 16 });
+}
+
+void Results::GoToSelectedMatch()
+{
+    auto index = list->GetCurrentItem().GetData(matches.size());
+    CHECKRET(index < matches.size(), "");
+
+    win->GetCurrentView()->GoTo(matches[index].offset);
+}
+
+void Results::SelectCurrentMatch()
+{
+    auto index = list->GetCurrentItem().GetData(matches.size());
+    CHECKRET(index < matches.size(), "");
+
+    const auto& m = matches[index];
+    win->GetCurrentView()->Select(m.offset, rules[m.rule].bytes.size());
+}
+
+void Results::Update()
+{
+    list->DeleteAllItems();
+
+    LocalString<128> tmp;
+    LocalString<128> preview;
+    NumericFormatter n;
+
+    for (auto i = 0ULL; i < matches.size(); i++)
+    {
+        const auto& m    = matches[i];
+        const auto& r    = rules[m.rule];
+        const auto bytes = object->GetData().Get(m.offset, static_cast<uint32>(std::min<size_t>(r.bytes.size(), PREVIEW_SIZE)), false);
+
+        preview.Clear();
+        for (auto b : bytes)
+            preview.AddFormat("%02X ", b);
+        if (r.bytes.size() > PREVIEW_SIZE)
+            preview.Add("...");
+
+        auto item = list->AddItem({ tmp.Format("%s", GetValue(n, m.offset).data()) });
+        item.SetText(1, tmp.Format("%s", GetValue(n, r.bytes.size()).data()));
+        item.SetText(2, r.name);
+        item.SetText(3, preview);
+        item.SetData(i);
+    }
+}
+
+bool Results::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    commandBar.SetCommand(Key::Enter, "GoTo", static_cast<int32_t>(ResultAction::GoTo));
+    commandBar.SetCommand(Key::F9, "Select", static_cast<int32_t>(ResultAction::Select));
+    commandBar.SetCommand(Key::F2, Base == 10 ? "Dec" : "Hex", static_cast<int32_t>(ResultAction::ChangeBase));
+
+    return true;
+}
+
+bool Results::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
+
+    if (evnt == Event::ListViewItemPressed)
+    {
+        GoToSelectedMatch();
+        return true;
+    }
+
+    if (evnt == Event::Command)
+    {
+        switch (static_cast<ResultAction>(controlID))
+        {
+        case ResultAction::GoTo:
+            GoToSelectedMatch();
+            return true;
+        case ResultAction::ChangeBase:
+            Base = 26 - Base;
+            Update();
+            return true;
+        case ResultAction::Select:
+            SelectCurrentMatch();
+            return true;
+        }
+    }
+
+    return false;
+}
+} // namespace GView::GenericPlugins::SignatureScanner::Panels
@@ -0,0 +1,215 @@
+#include "SignatureScanner.hpp"
+
+#include <fstream>
+
+namespace GView::GenericPlugins::SignatureScanner
+{
+// Rule file format (one rule per line):
+//     Name = 4D 5A ?? ?? 50 45        -> hex bytes, ?? matches any byte
+//     Name = "text\x00\r\n"           -> string (escapes: \\ \" \xNN \n \r \t \0)
+// Empty lines and lines starting with '#' or ';' are ignored.
+
+namespace
+{
+    inline std::string_view Trim(std::string_view text)
+    {
+        while ((!text.empty()) && ((text.front() == ' ') || (text.front() == '\t') || (text.front() == '\r')))
+            text.remove_prefix(1);
+        while ((!text.empty()) && ((text.back() == ' ') || (text.back() == '\t') || (text.back() == '\r')))
+            text.remove_suffix(1);
+        return text;
+    }
+    inline int32 HexValue(char ch)
+    {
+        if ((ch >= '0') && (ch <= '9'))
+            return ch - '0';
+        if ((ch >= 'a') && (ch <= 'f'))
+            return ch - 'a' + 10;
+        if ((ch >= 'A') && (ch <= 'F'))
+            return ch - 'A' + 10;
+        return -1;
+    }
+    bool ParseHexPattern(std::string_view text, Rule& rule)
+    {
+        size_t idx = 0;
+        while (idx < text.size())
+        {
+            if ((text[idx] == ' ') || (text[idx] == '\t'))
+            {
+                idx++;
+                continue;
+            }
+            if (idx + 1 >= text.size())
+                return false;
+            if ((text[idx] == '?') && (text[idx + 1] == '?'))
+            {
+                rule.bytes.push_back(0);
+                rule.mask.push_back(0);
+            }
+            else
+            {
+                auto hi = HexValue(text[idx]);
+                auto lo = HexValue(text[idx + 1]);
+                if ((hi < 0) || (lo < 0))
+                    return false;
+                rule.bytes.push_back(static_cast<uint8>((hi << 4) | lo));
+                rule.mask.push_back(0xFF);
+            }
+            idx += 2;
+        }
+        return true;
+    }
+    bool ParseStringPattern(std::string_view text, Rule& rule)
+    {
+        // text includes the starting and ending quotes
+        if ((text.size() < 2) || (text.back() != '"'))
+            return false;
+        text = text.substr(1, text.size() - 2);
+        for (size_t idx = 0; idx < text.size(); idx++)
+        {
+            auto ch = static_cast<uint8>(text[idx]);
+            if (ch == '\\')
+            {
+                if (idx + 1 >= text.size())
+                    return false;
+                idx++;
+                switch (text[idx])
+                {
+                case '\\':
+                    ch = '\\';
+                    break;
+                case '"':
+                    ch = '"';
+                    break;
+                case 'n':
+                    ch = '\n';
+                    break;
+                case 'r':
+                    ch = '\r';
+                    break;
+                case 't':
+                    ch = '\t';
+                    break;
+                case '0':
+                    ch = 0;
+                    break;
+                case 'x':
+                {
+                    if (idx + 2 >= text.size())
+                        return false;
+                    auto hi = HexValue(text[idx + 1]);
+                    auto lo = HexValue(text[idx + 2]);
+                    if ((hi < 0) || (lo < 0))
+                        return false;
+                    ch = static_cast<uint8>((hi << 4) | lo);
+                    idx += 2;
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            rule.bytes.push_back(ch);
+            rule.mask.push_back(0xFF);
+        }
+        return true;
+    }
+    void ComputeAnchor(Rule& rule)
+    {
+        // the anchor is the longest run of fixed bytes (capped to MAX_ANCHOR_SIZE)
+        uint32 bestStart = 0, bestSize = 0;
+        uint32 runStart = 0, runSize = 0;
+        for (uint32 idx = 0; idx < static_cast<uint32>(rule.mask.size()); idx++)
+        {
+            if (rule.mask[idx] == 0)
+            {
+                runSize = 0;
+                continue;
+            }
+            if (runSize == 0)
+                runStart = idx;
+            runSize++;
+            if (runSize > bestSize)
+            {
+                bestStart = runStart;
+                bestSize  = runSize;
+            }
+        }
+        rule.anchorOffset = bestStart;
+        rule.anchorSize   = std::min<uint32>(bestSize, MAX_ANCHOR_SIZE);
+    }
+} // namespace
+
+bool Rule::Match(const uint8* data) const
+{
+    const auto sz = bytes.size();
+    for (size_t idx = 0; idx < sz; idx++)
+    {
+        if ((data[idx] & mask[idx]) != bytes[idx])
+            return false;
+    }
+    return true;
+}
+
+bool LoadRules(const std::filesystem::path& path, std::vector<Rule>& rules, std::string& error)
+{
+    LocalString<256> tmp;
+    rules.clear();
+
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+    {
+        error = tmp.Format("Fail to open rules file: %s", path.string().c_str());
+        return false;
+    }
+
+    std::string line;
+    uint32 lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        auto text = Trim(line);
+        if ((text.empty()) || (text.front() == '#') || (text.front() == ';'))
+            continue;
+
+        auto eq = text.find('=');
+        if (eq == std::string_view::npos)
+        {
+            error = tmp.Format("Line %u: expecting 'Name = pattern'", lineNumber);
+            return false;
+        }
+        Rule rule;
+        rule.name    = Trim(text.substr(0, eq));
+        auto pattern = Trim(text.substr(eq + 1));
+        if (rule.name.empty())
+        {
+            error = tmp.Format("Line %u: missing rule name", lineNumber);
+            return false;
+        }
+        auto ok = (!pattern.empty()) && (pattern.front() == '"') ? ParseStringPattern(pattern, rule) : ParseHexPattern(pattern, rule);
+        if (!ok)
+        {
+            error = tmp.Format("Line %u: invalid pattern for rule '%s'", lineNumber, rule.name.c_str());
+            return false;
+        }
+        if (rule.bytes.empty() || (rule.bytes.size() > MAX_RULE_SIZE))
+        {
+            error = tmp.Format("Line %u: rule '%s' must have between 1 and %u bytes", lineNumber, rule.name.c_str(), MAX_RULE_SIZE);
+            return false;
+        }
+        ComputeAnchor(rule);
+        if (rule.anchorSize == 0)
+        {
+            error = tmp.Format("Line %u: rule '%s' has no fixed bytes (only wildcards)", lineNumber, rule.name.c_str());
+            return false;
+        }
+        rules.push_back(std::move(rule));
+    }
+    if (rules.empty())
+    {
+        error = "No rules found in the rules file";
+        return false;
+    }
+    return true;
+}
+} // namespace GView::GenericPlugins::SignatureScanner
@@ -0,0 +1,197 @@
+#include "SignatureScanner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace GView::GenericPlugins::SignatureScanner
+{
+constexpr uint32 BLOCK_SIZE     = 0x100000;
+constexpr uint64 MIN_CHUNK_SIZE = 0x100000;
+
+namespace
+{
+    void SortMatches(std::vector<SignatureMatch>& matches)
+    {
+        std::sort(
+              matches.begin(),
+              matches.end(),
+              [](const SignatureMatch& a, const SignatureMatch& b)
+              { return a.offset != b.offset ? a.offset < b.offset : a.rule < b.rule; });
+    }
+    // only the first MAX_MATCHES matches (in offset order) are kept
+    bool TrimMatches(std::vector<SignatureMatch>& matches)
+    {
+        if (matches.size() <= MAX_MATCHES)
+            return false;
+        SortMatches(matches);
+        matches.resize(MAX_MATCHES);
+        return true;
+    }
+} // namespace
+
+bool DataSource::Open(const std::filesystem::path& path, uint64 _size)
+{
+    // the data cache of the object is not thread safe --> every worker uses its own handle
+    this->size   = _size;
+    this->memory = nullptr;
+    return file.OpenRead(path);
+}
+void DataSource::Open(const Buffer& buffer)
+{
+    this->size   = buffer.GetLength();
+    this->memory = &buffer;
+}
+bool DataSource::Read(uint64 offset, uint8* buffer, uint32 bufferSize)
+{
+    CHECK(offset + bufferSize <= this->size, false, "Invalid read (%u bytes from %llu)", bufferSize, offset);
+    if (this->memory)
+    {
+        memcpy(buffer, this->memory->GetData() + offset, bufferSize);
+        return true;
+    }
+    CHECK(file.SetCurrentPos(offset), false, "Fail to move to offset %llu", offset);
+    return file.Read(buffer, bufferSize);
+}
+
+Scanner::Scanner(const std::vector<Rule>& _rules)
+    : rules(_rules), maxRuleSize(0), processed(0), stop(false), truncated(false), failed(false)
+{
+    for (const auto& r : rules)
+        maxRuleSize = std::max<uint32>(maxRuleSize, static_cast<uint32>(r.bytes.size()));
+}
+
+void Scanner::ScanChunk(DataSource& source, uint64 objectSize, uint64 start, uint64 end, std::vector<SignatureMatch>& output)
+{
+    // Only matches that start within [start, end) belong to this chunk. A rule starts no later than its anchor, so feeding
+    // the automaton from 'start' is enough; the feed continues up to maxRuleSize-1 bytes after 'end' so that matches that
+    // start inside the chunk but cross its end are still found. Each block is loaded with maxRuleSize bytes of margin on
+    // both sides so that the whole rule (wildcards included) can be verified around the anchor.
+    // A chunk keeps at most its first MAX_MATCHES matches (by offset) - the first MAX_MATCHES matches of the object are among
+    // them no matter how the threads are scheduled. A match found at 'pos' starts after pos - maxRuleSize, so once the chunk
+    // is full the scan stops when no later match could come before the ones it kept.
+    std::vector<uint8> buffer(static_cast<size_t>(BLOCK_SIZE) + 2ULL * maxRuleSize);
+    const auto feedEnd = std::min<uint64>(objectSize, end + maxRuleSize - 1);
+    uint32 state       = 0;
+    auto cutoff        = INVALID_OFFSET; // the last match kept by the chunk (after it was trimmed)
+
+    for (auto blockStart = start; (blockStart < feedEnd) && (!stop); blockStart += BLOCK_SIZE)
+    {
+        if ((cutoff != INVALID_OFFSET) && (blockStart > cutoff + maxRuleSize))
+            break;
+        const auto blockEnd    = std::min<uint64>(feedEnd, blockStart + BLOCK_SIZE);
+        const auto bufferStart = blockStart >= maxRuleSize ? blockStart - maxRuleSize : 0;
+        const auto bufferEnd   = std::min<uint64>(objectSize, blockEnd + maxRuleSize);
+        if (!source.Read(bufferStart, buffer.data(), static_cast<uint32>(bufferEnd - bufferStart)))
+        {
+            failed = true;
+            stop   = true;
+            return;
+        }
+
+        for (auto pos = blockStart; pos < blockEnd; pos++)
+        {
+            state = automaton.Next(state, buffer[pos - bufferStart]);
+            if (!automaton.HasOutputs(state))
+                continue;
+            for (auto it = automaton.OutputsBegin(state); it != automaton.OutputsEnd(state); it++)
+            {
+                const auto& r           = rules[*it];
+                const uint64 prefixSize = r.anchorOffset + r.anchorSize;
+                if (pos + 1 < start + prefixSize)
+                    continue; // the rule would start before this chunk
+                const auto matchStart = pos + 1 - prefixSize;
+                if ((matchStart >= end) || (matchStart + r.bytes.size() > objectSize))
+                    continue;
+                if (!r.Match(buffer.data() + (matchStart - bufferStart)))
+                    continue;
+                output.push_back({ matchStart, *it });
+                if (output.size() >= 2ULL * MAX_MATCHES)
+                {
+                    TrimMatches(output);
+                    cutoff    = output.back().offset;
+                    truncated = true;
+                }
+            }
+        }
+        if (blockStart < end)
+            processed += std::min<uint64>(blockEnd, end) - blockStart;
+    }
+    if (TrimMatches(output))
+        truncated = true;
+}
+
+bool Scanner::Scan(Reference<GView::Object> object, std::vector<SignatureMatch>& matches)
+{
+    CHECK(object.IsValid(), false, "Expecting a valid object !");
+    CHECK(automaton.Build(rules), false, "Fail to build the signatures automaton !");
+    matches.clear();
+
+    const auto objectSize = object->GetData().GetSize();
+    if (objectSize == 0)
+        return true;
+
+    // files are read through separate handles (one per thread); any other kind of object is copied in memory once
+    Buffer memory;
+    const auto useMemory = object->GetObjectType() != GView::Object::Type::File;
+    if (useMemory)
+    {
+        CHECK(objectSize <= MAX_MEMORY_OBJECT, false, "Object is too large to be scanned (%llu bytes)", objectSize);
+        memory = object->GetData().CopyToBuffer(0, static_cast<uint32>(objectSize), true);
+        CHECK(memory.IsValid(), false, "Fail to copy %llu bytes for scanning", objectSize);
+    }
+
+    const auto threadsCount = std::max<uint64>(1, std::thread::hardware_concurrency());
+    const auto chunkSize    = std::max<uint64>(MIN_CHUNK_SIZE, (objectSize + threadsCount - 1) / threadsCount);
+    const auto chunksCount  = static_cast<uint32>((objectSize + chunkSize - 1) / chunkSize);
+
+    std::vector<std::vector<SignatureMatch>> results(chunksCount);
+    std::vector<std::thread> workers;
+    std::atomic<uint32> finished(0);
+    const auto path = std::filesystem::path(object->GetPath());
+    for (uint32 idx = 0; idx < chunksCount; idx++)
+    {
+        const auto start = chunkSize * idx;
+        const auto end   = std::min<uint64>(objectSize, start + chunkSize);
+        workers.emplace_back(
+              [this, &results, &memory, &path, &finished, useMemory, objectSize, start, end, idx]()
+              {
+                  DataSource source;
+                  if (useMemory)
+                      source.Open(memory);
+                  else if (!source.Open(path, objectSize))
+                  {
+                      failed = true;
+                      stop   = true;
+                  }
+                  if (!stop)
+                      ScanChunk(source, objectSize, start, end, results[idx]);
+                  finished++;
+              });
+    }
+
+    LocalString<128> ls;
+    ProgressStatus::Init("Scanning...", objectSize);
+    while (finished < chunksCount)
+    {
+        if (ProgressStatus::Update(processed.load(), ls.Format("Scanning [%llu/%llu] bytes...", processed.load(), objectSize)))
+            stop = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    for (auto& w : workers)
+        w.join();
+
+    CHECK(failed == false, false, "Fail to read the object !");
+    CHECK(stop == false, false, "Scan canceled !");
+
+    for (auto& r : results)
+        matches.insert(matches.end(), r.begin(), r.end());
+    SortMatches(matches);
+    if (matches.size() > MAX_MATCHES)
+    {
+        matches.resize(MAX_MATCHES);
+        truncated = true;
+    }
+    return true;
+}
+} // namespace GView::GenericPlugins::SignatureScanner
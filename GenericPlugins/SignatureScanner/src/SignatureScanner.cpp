@@ -0,0 +1,113 @@
+#include "SignatureScanner.hpp"
+
+namespace GView::GenericPlugins::SignatureScanner
+{
+constexpr std::string_view CMD_SHORT_NAME_SCAN         = "ScanSignatures";
+constexpr std::string_view CMD_SHORT_NAME_SELECT_RULES = "SelectSignatureRules";
+
+constexpr std::string_view CMD_FULL_NAME_SCAN         = "Command.ScanSignatures";
+constexpr std::string_view CMD_FULL_NAME_SELECT_RULES = "Command.SelectSignatureRules";
+
+constexpr std::string_view SETTINGS_SECTION   = "Generic.SignatureScanner";
+constexpr std::string_view SETTINGS_RULESFILE = "RulesFile";
+
+static std::optional<std::filesystem::path> SelectRulesFile()
+{
+    auto res = Dialogs::FileDialog::ShowOpenFileWindow("", "", ".");
+    CHECK(res.has_value(), std::nullopt, "");
+
+    auto allSettings                                              = Application::GetAppSettings();
+    allSettings->GetSection(SETTINGS_SECTION)[SETTINGS_RULESFILE] = res->string();
+    allSettings->Save(Application::GetAppSettingsFile());
+    return res;
+}
+
+static std::optional<std::filesystem::path> GetRulesFile()
+{
+    auto allSettings = Application::GetAppSettings();
+    if (allSettings->HasSection(SETTINGS_SECTION))
+    {
+        auto path = allSettings->GetSection(SETTINGS_SECTION).GetValue(SETTINGS_RULESFILE).ToStringView();
+        if (!path.empty())
+            return std::filesystem::path(path);
+    }
+    return SelectRulesFile();
+}
+
+static bool ScanSignatures(Reference<GView::Object> object, const std::filesystem::path& rulesFile)
+{
+    std::vector<Rule> rules;
+    std::string error;
+    if (!LoadRules(rulesFile, rules, error))
+    {
+        Dialogs::MessageBox::ShowError("Error!", error);
+        RETURNERROR(false, "Fail to load signature rules: %s", error.c_str());
+    }
+
+    auto win = GView::App::GetCurrentWindow();
+    CHECK(win.IsValid(), false, "No window to publish the results into !");
+
+    Scanner scanner(rules);
+    std::vector<SignatureMatch> matches;
+    if (!scanner.Scan(object, matches))
+    {
+        Dialogs::MessageBox::ShowError("Error!", "Signature scan failed or was canceled!");
+        RETURNERROR(false, "Signature scan failed or was canceled!");
+    }
+    if (matches.empty())
+    {
+        LocalString<128> tmp;
+        Dialogs::MessageBox::ShowNotification("Signatures", tmp.Format("No matches for %u rule(s).", (uint32) rules.size()));
+    }
+    else if (scanner.IsTruncated())
+    {
+        LocalString<128> tmp;
+        Dialogs::MessageBox::ShowNotification("Signatures", tmp.Format("Too many matches - only the first %u are shown.", MAX_MATCHES));
+    }
+
+    // a window that was already scanned keeps its view and panel - only their matches are replaced
+    auto panel = Panels::Results::Find(win);
+    if (panel.IsValid())
+    {
+        panel->SetMatches(std::move(rules), std::move(matches));
+        return true;
+    }
+    if (matches.empty())
+        return true;
+
+    auto results = new Panels::Results(win);
+    results->SetMatches(std::move(rules), std::move(matches));
+    BufferViewer::Settings settings;
+    settings.SetZoneProvider(results);
+    win->CreateViewer("Signatures", settings);
+    win->AddPanel(Pointer<TabPage>(results), false);
+    return true;
+}
+} // namespace GView::GenericPlugins::SignatureScanner
+
+extern "C"
+{
+    PLUGIN_EXPORT bool Run(const string_view command, Reference<GView::Object> object)
+    {
+        if (command == GView::GenericPlugins::SignatureScanner::CMD_SHORT_NAME_SCAN)
+        {
+            auto rulesFile = GView::GenericPlugins::SignatureScanner::GetRulesFile();
+            CHECK(rulesFile.has_value(), false, "No rules file selected !");
+            return GView::GenericPlugins::SignatureScanner::ScanSignatures(object, *rulesFile);
+        }
+        else if (command == GView::GenericPlugins::SignatureScanner::CMD_SHORT_NAME_SELECT_RULES)
+        {
+            auto rulesFile = GView::GenericPlugins::SignatureScanner::SelectRulesFile();
+            CHECK(rulesFile.has_value(), false, "No rules file selected !");
+            return GView::GenericPlugins::SignatureScanner::ScanSignatures(object, *rulesFile);
+        }
+
+        return false;
+    }
+
+    PLUGIN_EXPORT void UpdateSettings(IniSection sect)
+    {
+        sect[GView::GenericPlugins::SignatureScanner::CMD_FULL_NAME_SCAN]         = Input::Key::Shift | Input::Key::F7;
+        sect[GView::GenericPlugins::SignatureScanner::CMD_FULL_NAME_SELECT_RULES] = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F7;
+    }
+}
@@ -48,218 +48,48 @@ namespace OperatorType
 } // namespace OperatorType
 namespace Operators
 {
-    uint8 chars_ids[128] = { 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0,  0, 0,  0,
-                             0, 4, 0, 0, 0, 9, 11, 0, 0, 0, 7, 5, 0, 6, 10, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 2,  3, 1,  15,
-                             0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0,  0, 13, 0,
-                             0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 12, 0, 14, 0 };
-
-    constexpr uint32 HASH_DEVIDER            = 133;
-    uint32 operator_hash_table[HASH_DEVIDER] = {
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Bigger << 8) | (uint32) (1 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Smaller << 8) | (uint32) (2 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Assign << 8) | (uint32) (3 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::LogicNOT << 8) | (uint32) (4 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Plus << 8) | (uint32) (5 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Minus << 8) | (uint32) (6 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Multiply << 8) | (uint32) (7 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Division << 8) | (uint32) (8 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Modulo << 8) | (uint32) (9 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::MemberAccess << 8) | (uint32) (10 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::AND << 8) | (uint32) (11 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::OR << 8) | (uint32) (12 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::XOR << 8) | (uint32) (13 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::NOT << 8) | (uint32) (14 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Condition << 8) | (uint32) (15 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::TWO_POINTS << 8) | (uint32) (16 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Spaceship << 8) | (uint32) (2145 << 16),
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::XorEQ << 8) | (uint32) (419 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::ModuloEQ << 8) | (uint32) (291 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::PlusEQ << 8) | (uint32) (163 << 16),
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Increment << 8) | (uint32) (165 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::RightShift << 8) | (uint32) (33 << 16),
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::BiggerOrEq << 8) | (uint32) (35 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Pointer << 8) | (uint32) (193 << 16),
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::MinusEQ << 8) | (uint32) (195 << 16),
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Decrement << 8) | (uint32) (198 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::LeftShift << 8) | (uint32) (66 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::SmallerOrEQ << 8) | (uint32) (67 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::AndEQ << 8) | (uint32) (355 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::MupliplyEQ << 8) | (uint32) (227 << 16),
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::LogicAND << 8) | (uint32) (363 << 16),
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Equal << 8) | (uint32) (99 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::LeftShiftEQ << 8) | (uint32) (2115 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::OrEQ << 8) | (uint32) (387 << 16),
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::DivisionEQ << 8) | (uint32) (259 << 16),
-        TokenType::None,
-        (uint32) TokenType::Operator | (uint32) (OperatorType::RightShiftEQ << 8) | (uint32) (1059 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Namespace << 8) | (uint32) (528 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::LogicOR << 8) | (uint32) (396 << 16),
-        (uint32) TokenType::Operator | (uint32) (OperatorType::Different << 8) | (uint32) (131 << 16),
-        TokenType::None
-    };
-
-    bool TextToOperatorID(const char16* txt, uint32 size, uint32& opID, uint32& opSize)
-    {
-        // compute the hashes over the entire 3 cases
-        uint32 hash1 = 0, hash2 = 0, hash3 = 0;
-        if (((*txt) < 128) && (chars_ids[*txt] != 0))
-        {
-            hash1 = chars_ids[*txt];
-            txt++;
-            if ((size > 1) && ((*txt) < 128) && (chars_ids[*txt] != 0))
-            {
-                hash2 = (hash1 << 5) + chars_ids[*txt];
-                txt++;
-                if ((size > 2) && ((*txt) < 128) && (chars_ids[*txt] != 0))
-                    hash3 = (hash2 << 5) + chars_ids[*txt];
-            }
-        }
-        auto op = operator_hash_table[hash3 % HASH_DEVIDER];
-        if ((op != TokenType::None) && ((op >> 16) == hash3))
-        {
-            opID   = (op & 0xFF) | ((op & 0xFF00) << 8);
-            opSize = 3;
-            return true;
-        }
-        op = operator_hash_table[hash2 % HASH_DEVIDER];
-        if ((op != TokenType::None) && ((op >> 16) == hash2))
-        {
-            opID   = (op & 0xFF) | ((op & 0xFF00) << 8);
-            opSize = 2;
-            return true;
-        }
-        op = operator_hash_table[hash1 % HASH_DEVIDER];
-        if ((op != TokenType::None) && ((op >> 16) == hash1))
-        {
-            opID   = (op & 0xFF) | ((op & 0xFF00) << 8);
-            opSize = 1;
-            return true;
-        }
-        return false; // invalid operator
-    }
-}; // namespace Operators
-struct HashText
-{
-    uint32 hash;
-    uint32 id;
-};
-HashText* BinarySearch(uint32 hash, HashText* list, int32 elementsCount)
-{
-    if (elementsCount <= 0)
-        return nullptr;
-    auto start = 0;
-    auto end   = elementsCount - 1;
-    while (start <= end)
-    {
-        auto mij   = (start + end) >> 1;
-        auto h_mij = list[mij].hash;
-        if (hash < h_mij)
-        {
-            end = mij - 1;
-            continue;
-        }
-        if (hash > h_mij)
-        {
-            start = mij + 1;
-            continue;
-        }
-        return list + mij;
-    }
-    return nullptr;
-}
-
+    constexpr LexicalTable list({
+          { ">", TokenType::Operator | (OperatorType::Bigger << 16) },
+          { "<", TokenType::Operator | (OperatorType::Smaller << 16) },
+          { "=", TokenType::Operator | (OperatorType::Assign << 16) },
+          { ">=", TokenType::Operator | (OperatorType::BiggerOrEq << 16) },
+          { "<=", TokenType::Operator | (OperatorType::SmallerOrEQ << 16) },
+          { "==", TokenType::Operator | (OperatorType::Equal << 16) },
+          { "!=", TokenType::Operator | (OperatorType::Different << 16) },
+          { "+", TokenType::Operator | (OperatorType::Plus << 16) },
+          { "-", TokenType::Operator | (OperatorType::Minus << 16) },
+          { "*", TokenType::Operator | (OperatorType::Multiply << 16) },
+          { "/", TokenType::Operator | (OperatorType::Division << 16) },
+          { "%", TokenType::Operator | (OperatorType::Modulo << 16) },
+          { ".", TokenType::Operator | (OperatorType::MemberAccess << 16) },
+          { "->", TokenType::Operator | (OperatorType::Pointer << 16) },
+          { "++", TokenType::Operator | (OperatorType::Increment << 16) },
+          { "--", TokenType::Operator | (OperatorType::Decrement << 16) },
+          { "&&", TokenType::Operator | (OperatorType::LogicAND << 16) },
+          { "||", TokenType::Operator | (OperatorType::LogicOR << 16) },
+          { "&", TokenType::Operator | (OperatorType::AND << 16) },
+          { "|", TokenType::Operator | (OperatorType::OR << 16) },
+          { "^", TokenType::Operator | (OperatorType::XOR << 16) },
+          { "!", TokenType::Operator | (OperatorType::LogicNOT << 16) },
+          { "~", TokenType::Operator | (OperatorType::NOT << 16) },
+          { "?", TokenType::Operator | (OperatorType::Condition << 16) },
+          { ":", TokenType::Operator | (OperatorType::TWO_POINTS << 16) },
+          { "::", TokenType::Operator | (OperatorType::Namespace << 16) },
+          { "+=", TokenType::Operator | (OperatorType::PlusEQ << 16) },
+          { "-=", TokenType::Operator | (OperatorType::MinusEQ << 16) },
+          { "*=", TokenType::Operator | (OperatorType::MupliplyEQ << 16) },
+          { "/=", TokenType::Operator | (OperatorType::DivisionEQ << 16) },
+          { "%=", TokenType::Operator | (OperatorType::ModuloEQ << 16) },
+          { "&=", TokenType::Operator | (OperatorType::AndEQ << 16) },
+          { "|=", TokenType::Operator | (OperatorType::OrEQ << 16) },
+          { "^=", TokenType::Operator | (OperatorType::XorEQ << 16) },
+          { "<<", TokenType::Operator | (OperatorType::LeftShift << 16) },
+          { ">>", TokenType::Operator | (OperatorType::RightShift << 16) },
+          { ">>=", TokenType::Operator | (OperatorType::RightShiftEQ << 16) },
+          { "<<=", TokenType::Operator | (OperatorType::LeftShiftEQ << 16) },
+          { "<=>", TokenType::Operator | (OperatorType::Spaceship << 16) },
+    });
+} // namespace Operators
 namespace KeywordsType
 {
     constexpr uint32 Atomic_commit            = 0;
@@ -339,56 +169,6 @@ namespace KeywordsType
     constexpr uint32 Static_assert            = 74;
     constexpr uint32 Operator                 = 75;
 } // namespace KeywordsType
-namespace Keyword
-{
-    HashText list[] = {
-        { 0x049E68E4, KeywordsType::Atomic_commit }, { 0x0DC628CE, KeywordsType::While },
-        { 0x112A90D4, KeywordsType::Import },        { 0x13251E95, KeywordsType::Reinterpret_cast },
-        { 0x1472C0A0, KeywordsType::Asm },           { 0x159AC2B7, KeywordsType::Final },
-        { 0x19A9984E, KeywordsType::Typename },      { 0x1E54727D, KeywordsType::Protected },
-        { 0x221EDE24, KeywordsType::Typedef },       { 0x28999611, KeywordsType::New },
-        { 0x2D6871C0, KeywordsType::Register },      { 0x39386E06, KeywordsType::If },
-        { 0x3B0333A9, KeywordsType::Mutable },       { 0x4288E94C, KeywordsType::Catch },
-        { 0x44E4E5F2, KeywordsType::Const_cast },    { 0x4ED2A4FD, KeywordsType::Reflexpr },
-        { 0x5AA35603, KeywordsType::Constexpr },     { 0x5D967EBC, KeywordsType::Virtual },
-        { 0x61338257, KeywordsType::Noexcept },      { 0x621CD814, KeywordsType::Do },
-        { 0x62CB0D0C, KeywordsType::Private },       { 0x664FD1D4, KeywordsType::Const },
-        { 0x676A80DC, KeywordsType::Dynamic_cast },  { 0x67C2444A, KeywordsType::Delete },
-        { 0x68E79149, KeywordsType::Explicit },      { 0x694AAA0B, KeywordsType::Template },
-        { 0x69CE1407, KeywordsType::Using },         { 0x6EE13AFD, KeywordsType::Sizeof },
-        { 0x7A78762F, KeywordsType::Throw },         { 0x816CB000, KeywordsType::Enum },
-        { 0x85EE37BF, KeywordsType::Return },        { 0x9087DDB7, KeywordsType::Extern },
-        { 0x923FA396, KeywordsType::Auto },          { 0x92C2BE20, KeywordsType::Struct },
-        { 0x933B5BDE, KeywordsType::Default },       { 0x93E05F71, KeywordsType::Switch },
-        { 0x94E1036D, KeywordsType::Volatile },      { 0x9B2538B1, KeywordsType::Case },
-        { 0x9B8CAA55, KeywordsType::Requires },      { 0xA01A5581, KeywordsType::Transaction_safe },
-        { 0xA3383D13, KeywordsType::Concept },       { 0xA4F6AD07, KeywordsType::Transaction_safe_dynamic },
-        { 0xA7226423, KeywordsType::Static_cast },   { 0xA8953BD8, KeywordsType::Typeid },
-        { 0xAB3E0BFF, KeywordsType::Class },         { 0xAC1DB00E, KeywordsType::Try },
-        { 0xACF38390, KeywordsType::For },           { 0xB1727E44, KeywordsType::Continue },
-        { 0xBDBF5BF0, KeywordsType::Else },          { 0xBEEDB7F2, KeywordsType::Compl },
-        { 0xBEF43EA5, KeywordsType::Decltype },      { 0xC2CB5034, KeywordsType::Inline },
-        { 0xC4B95C3D, KeywordsType::Override },      { 0xC9101B72, KeywordsType::Consteval },
-        { 0xC919731F, KeywordsType::Alignof },       { 0xC9648178, KeywordsType::Break },
-        { 0xCACE7AA0, KeywordsType::Namespace },     { 0xCBA09F8D, KeywordsType::Friend },
-        { 0xCC909380, KeywordsType::Public },        { 0xCD3C1AA1, KeywordsType::Thread_local },
-        { 0xD27D73DE, KeywordsType::Co_return },     { 0xD290C23B, KeywordsType::Static },
-        { 0xD34FD592, KeywordsType::Co_await },      { 0xD79F909D, KeywordsType::Module },
-        { 0xD994FC43, KeywordsType::Atomic_cancel }, { 0xDA2BD281, KeywordsType::This },
-        { 0xDBDED6F4, KeywordsType::Union },         { 0xEC3C3C7A, KeywordsType::Alignas },
-        { 0xF112B61B, KeywordsType::Synchronized },  { 0xF5A30FE6, KeywordsType::Goto },
-        { 0xF6522276, KeywordsType::Constinit },     { 0xF874CA49, KeywordsType::Co_yield },
-        { 0xFB080CB3, KeywordsType::Export },        { 0xFB60E40F, KeywordsType::Atomic_noexcept },
-        { 0xFB9673DE, KeywordsType::Static_assert }, { 0xFBD4EEFD, KeywordsType::Operator },
-    };
-    uint32 TextToKeywordID(const GView::View::LexicalViewer::TextParser& text, uint32 start, uint32 end)
-    {
-        auto* res = BinarySearch(text.ComputeHash32(start, end, false), list, 76);
-        if (res == nullptr)
-            return TokenType::None;
-        return TokenType::Keyword | (res->id << 16);
-    };
-} // namespace Keyword
 namespace ConstantsType
 {
     constexpr uint32 False   = 0;
@@ -396,22 +176,6 @@ namespace ConstantsType
     constexpr uint32 True    = 2;
     constexpr uint32 Null    = 3;
 } // namespace ConstantsType
-namespace Constant
-{
-    HashText list[] = {
-        { 0x0B069958, ConstantsType::False },
-        { 0x0BBDE79E, ConstantsType::Nullptr },
-        { 0x4DB211E5, ConstantsType::True },
-        { 0x77074BA4, ConstantsType::Null },
-    };
-    uint32 TextToConstantID(const GView::View::LexicalViewer::TextParser& text, uint32 start, uint32 end)
-    {
-        auto* res = BinarySearch(text.ComputeHash32(start, end, false), list, 4);
-        if (res == nullptr)
-            return TokenType::None;
-        return TokenType::Constant | (res->id << 16);
-    };
-} // namespace Constant
 namespace DatatypesType
 {
     constexpr uint32 Unsigned       = 0;
@@ -448,35 +212,141 @@ namespace DatatypesType
     constexpr uint32 Uint32_t       = 31;
     constexpr uint32 U8string_view  = 32;
 } // namespace DatatypesType
-namespace Datatype
+namespace Words
 {
-    HashText list[] = {
-        { 0x0C547726, DatatypesType::Unsigned },       { 0x0DFE5EDA, DatatypesType::Int16_t },
-        { 0x17C16538, DatatypesType::String },         { 0x210B6458, DatatypesType::String_view },
-        { 0x306340A8, DatatypesType::Uint8_t },        { 0x40FFA2F9, DatatypesType::Int8_t },
-        { 0x48B5725F, DatatypesType::Void },           { 0x504690E9, DatatypesType::Wstring_view },
-        { 0x50736EE7, DatatypesType::Wstring },        { 0x5807E43C, DatatypesType::Char8_t },
-        { 0x5C5F1A4A, DatatypesType::U16string },      { 0x682FE470, DatatypesType::Uint64_t },
-        { 0x7167ED94, DatatypesType::U32string_view }, { 0x7270198F, DatatypesType::Int64_t },
-        { 0x7C6A8FB7, DatatypesType::Size_t },         { 0x801A266D, DatatypesType::Char16_t },
-        { 0x86A803CC, DatatypesType::U32string },      { 0x95E97E5E, DatatypesType::Int },
-        { 0x96C45519, DatatypesType::Uint16_t },       { 0xA0EB0F08, DatatypesType::Double },
-        { 0xA6BB769A, DatatypesType::U16string_view }, { 0xA6C45D85, DatatypesType::Float },
-        { 0xA846FC93, DatatypesType::Char32_t },       { 0xA84C031D, DatatypesType::Char },
-        { 0xB5712015, DatatypesType::Signed },         { 0xB71DD581, DatatypesType::U8string },
-        { 0xBA226BD5, DatatypesType::Short },          { 0xC04A1FBC, DatatypesType::Int32_t },
-        { 0xC2ECDF53, DatatypesType::Long },           { 0xC523B9F1, DatatypesType::Wchar_t },
-        { 0xC894953D, DatatypesType::Bool },           { 0xE9B20787, DatatypesType::Uint32_t },
-        { 0xF277D373, DatatypesType::U8string_view },
-    };
-    uint32 TextToDatatypeID(const GView::View::LexicalViewer::TextParser& text, uint32 start, uint32 end)
-    {
-        auto* res = BinarySearch(text.ComputeHash32(start, end, false), list, 33);
-        if (res == nullptr)
-            return TokenType::None;
-        return TokenType::Datatype | (res->id << 16);
-    };
-} // namespace Datatype
+    // keywords, constants and data types
+    constexpr LexicalTable list({
+          { "alignas", TokenType::Keyword | (KeywordsType::Alignas << 16) },
+          { "alignof", TokenType::Keyword | (KeywordsType::Alignof << 16) },
+          { "asm", TokenType::Keyword | (KeywordsType::Asm << 16) },
+          { "atomic_cancel", TokenType::Keyword | (KeywordsType::Atomic_cancel << 16) },
+          { "atomic_commit", TokenType::Keyword | (KeywordsType::Atomic_commit << 16) },
+          { "atomic_noexcept", TokenType::Keyword | (KeywordsType::Atomic_noexcept << 16) },
+          { "auto", TokenType::Keyword | (KeywordsType::Auto << 16) },
+          { "break", TokenType::Keyword | (KeywordsType::Break << 16) },
+          { "case", TokenType::Keyword | (KeywordsType::Case << 16) },
+          { "catch", TokenType::Keyword | (KeywordsType::Catch << 16) },
+          { "class", TokenType::Keyword | (KeywordsType::Class << 16) },
+          { "compl", TokenType::Keyword | (KeywordsType::Compl << 16) },
+          { "concept", TokenType::Keyword | (KeywordsType::Concept << 16) },
+          { "const", TokenType::Keyword | (KeywordsType::Const << 16) },
+          { "consteval", TokenType::Keyword | (KeywordsType::Consteval << 16) },
+          { "constexpr", TokenType::Keyword | (KeywordsType::Constexpr << 16) },
+          { "constinit", TokenType::Keyword | (KeywordsType::Constinit << 16) },
+          { "const_cast", TokenType::Keyword | (KeywordsType::Const_cast << 16) },
+          { "continue", TokenType::Keyword | (KeywordsType::Continue << 16) },
+          { "co_await", TokenType::Keyword | (KeywordsType::Co_await << 16) },
+          { "co_return", TokenType::Keyword | (KeywordsType::Co_return << 16) },
+          { "co_yield", TokenType::Keyword | (KeywordsType::Co_yield << 16) },
+          { "decltype", TokenType::Keyword | (KeywordsType::Decltype << 16) },
+          { "default", TokenType::Keyword | (KeywordsType::Default << 16) },
+          { "delete", TokenType::Keyword | (KeywordsType::Delete << 16) },
+          { "do", TokenType::Keyword | (KeywordsType::Do << 16) },
+          { "dynamic_cast", TokenType::Keyword | (KeywordsType::Dynamic_cast << 16) },
+          { "else", TokenType::Keyword | (KeywordsType::Else << 16) },
+          { "enum", TokenType::Keyword | (KeywordsType::Enum << 16) },
+          { "explicit", TokenType::Keyword | (KeywordsType::Explicit << 16) },
+          { "export", TokenType::Keyword | (KeywordsType::Export << 16) },
+          { "extern", TokenType::Keyword | (KeywordsType::Extern << 16) },
+          { "for", TokenType::Keyword | (KeywordsType::For << 16) },
+          { "friend", TokenType::Keyword | (KeywordsType::Friend << 16) },
+          { "goto", TokenType::Keyword | (KeywordsType::Goto << 16) },
+          { "if", TokenType::Keyword | (KeywordsType::If << 16) },
+          { "inline", TokenType::Keyword | (KeywordsType::Inline << 16) },
+          { "mutable", TokenType::Keyword | (KeywordsType::Mutable << 16) },
+          { "namespace", TokenType::Keyword | (KeywordsType::Namespace << 16) },
+          { "new", TokenType::Keyword | (KeywordsType::New << 16) },
+          { "noexcept", TokenType::Keyword | (KeywordsType::Noexcept << 16) },
+          { "operator", TokenType::Keyword | (KeywordsType::Operator << 16) },
+          { "private", TokenType::Keyword | (KeywordsType::Private << 16) },
+          { "protected", TokenType::Keyword | (KeywordsType::Protected << 16) },
+          { "public", TokenType::Keyword | (KeywordsType::Public << 16) },
+          { "reflexpr", TokenType::Keyword | (KeywordsType::Reflexpr << 16) },
+          { "register", TokenType::Keyword | (KeywordsType::Register << 16) },
+          { "reinterpret_cast", TokenType::Keyword | (KeywordsType::Reinterpret_cast << 16) },
+          { "requires", TokenType::Keyword | (KeywordsType::Requires << 16) },
+          { "return", TokenType::Keyword | (KeywordsType::Return << 16) },
+          { "sizeof", TokenType::Keyword | (KeywordsType::Sizeof << 16) },
+          { "static", TokenType::Keyword | (KeywordsType::Static << 16) },
+          { "static_assert", TokenType::Keyword | (KeywordsType::Static_assert << 16) },
+          { "static_cast", TokenType::Keyword | (KeywordsType::Static_cast << 16) },
+          { "struct", TokenType::Keyword | (KeywordsType::Struct << 16) },
+          { "switch", TokenType::Keyword | (KeywordsType::Switch << 16) },
+          { "synchronized", TokenType::Keyword | (KeywordsType::Synchronized << 16) },
+          { "template", TokenType::Keyword | (KeywordsType::Template << 16) },
+          { "this", TokenType::Keyword | (KeywordsType::This << 16) },
+          { "thread_local", TokenType::Keyword | (KeywordsType::Thread_local << 16) },
+          { "throw", TokenType::Keyword | (KeywordsType::Throw << 16) },
+          { "try", TokenType::Keyword | (KeywordsType::Try << 16) },
+          { "typedef", TokenType::Keyword | (KeywordsType::Typedef << 16) },
+          { "typeid", TokenType::Keyword | (KeywordsType::Typeid << 16) },
+          { "typename", TokenType::Keyword | (KeywordsType::Typename << 16) },
+          { "union", TokenType::Keyword | (KeywordsType::Union << 16) },
+          { "using", TokenType::Keyword | (KeywordsType::Using << 16) },
+          { "virtual", TokenType::Keyword | (KeywordsType::Virtual << 16) },
+          { "volatile", TokenType::Keyword | (KeywordsType::Volatile << 16) },
+          { "while", TokenType::Keyword | (KeywordsType::While << 16) },
+          { "final", TokenType::Keyword | (KeywordsType::Final << 16) },
+          { "override", TokenType::Keyword | (KeywordsType::Override << 16) },
+          { "transaction_safe", TokenType::Keyword | (KeywordsType::Transaction_safe << 16) },
+          { "transaction_safe_dynamic", TokenType::Keyword | (KeywordsType::Transaction_safe_dynamic << 16) },
+          { "import", TokenType::Keyword | (KeywordsType::Import << 16) },
+          { "module", TokenType::Keyword | (KeywordsType::Module << 16) },
+          { "true", TokenType::Constant | (ConstantsType::True << 16) },
+          { "false", TokenType::Constant | (ConstantsType::False << 16) },
+          { "NULL", TokenType::Constant | (ConstantsType::Null << 16) },
+          { "nullptr", TokenType::Constant | (ConstantsType::Nullptr << 16) },
+          { "bool", TokenType::Datatype | (DatatypesType::Bool << 16) },
+          { "char", TokenType::Datatype | (DatatypesType::Char << 16) },
+          { "char8_t", TokenType::Datatype | (DatatypesType::Char8_t << 16) },
+          { "char16_t", TokenType::Datatype | (DatatypesType::Char16_t << 16) },
+          { "char32_t", TokenType::Datatype | (DatatypesType::Char32_t << 16) },
+          { "double", TokenType::Datatype | (DatatypesType::Double << 16) },
+          { "float", TokenType::Datatype | (DatatypesType::Float << 16) },
+          { "int", TokenType::Datatype | (DatatypesType::Int << 16) },
+          { "long", TokenType::Datatype | (DatatypesType::Long << 16) },
+          { "short", TokenType::Datatype | (DatatypesType::Short << 16) },
+          { "signed", TokenType::Datatype | (DatatypesType::Signed << 16) },
+          { "unsigned", TokenType::Datatype | (DatatypesType::Unsigned << 16) },
+          { "void", TokenType::Datatype | (DatatypesType::Void << 16) },
+          { "size_t", TokenType::Datatype | (DatatypesType::Size_t << 16) },
+          { "wchar_t", TokenType::Datatype | (DatatypesType::Wchar_t << 16) },
+          { "int8_t", TokenType::Datatype | (DatatypesType::Int8_t << 16) },
+          { "int16_t", TokenType::Datatype | (DatatypesType::Int16_t << 16) },
+          { "int32_t", TokenType::Datatype | (DatatypesType::Int32_t << 16) },
+          { "int64_t", TokenType::Datatype | (DatatypesType::Int64_t << 16) },
+          { "uint8_t", TokenType::Datatype | (DatatypesType::Uint8_t << 16) },
+          { "uint16_t", TokenType::Datatype | (DatatypesType::Uint16_t << 16) },
+          { "uint32_t", TokenType::Datatype | (DatatypesType::Uint32_t << 16) },
+          { "uint64_t", TokenType::Datatype | (DatatypesType::Uint64_t << 16) },
+          { "string", TokenType::Datatype | (DatatypesType::String << 16) },
+          { "wstring", TokenType::Datatype | (DatatypesType::Wstring << 16) },
+          { "u8string", TokenType::Datatype | (DatatypesType::U8string << 16) },
+          { "u16string", TokenType::Datatype | (DatatypesType::U16string << 16) },
+          { "u32string", TokenType::Datatype | (DatatypesType::U32string << 16) },
+          { "string_view", TokenType::Datatype | (DatatypesType::String_view << 16) },
+          { "wstring_view", TokenType::Datatype | (DatatypesType::Wstring_view << 16) },
+          { "u8string_view", TokenType::Datatype | (DatatypesType::U8string_view << 16) },
+          { "u16string_view", TokenType::Datatype | (DatatypesType::U16string_view << 16) },
+          { "u32string_view", TokenType::Datatype | (DatatypesType::U32string_view << 16) },
+    });
+} // namespace Words
+
+// the tables are built at compile time --> so they can be checked at compile time as well
+static_assert(
+      []
+      {
+          uint32 id = 0;
+          return Words::list.Find(u"constexpr", id) && (id == (TokenType::Keyword | (KeywordsType::Constexpr << 16))) &&
+                 !Words::list.Find(u"constexp", id);
+      }());
+static_assert(
+      []
+      {
+          uint32 id = 0, sz = 0;
+          return Operators::list.FindLongestPrefix(u"<=>0", id, sz) && (id == (TokenType::Operator | (OperatorType::Spaceship << 16))) &&
+                 (sz == 3);
+      }());
 
 namespace CharType
 {
@@ -495,34 +365,31 @@ namespace CharType
     constexpr uint8 ExpressionClose   = 12;
     constexpr uint8 Space             = 13;
     constexpr uint8 Invalid           = 14;
-    constexpr uint8 SingleLineComment = 15; // virtual (not in Cpp_Groups_IDs)
-    constexpr uint8 Comment           = 16; // virtual (not in Cpp_Groups_IDs)
+    constexpr uint8 SingleLineComment = 15; // virtual (not in classes)
+    constexpr uint8 Comment           = 16; // virtual (not in classes)
 
-    uint8 Cpp_Groups_IDs[] = { Invalid,    Invalid,  Invalid,    Invalid,    Invalid,   Invalid,        Invalid,
-                               Invalid,    Invalid,  Space,      Space,      Invalid,   Invalid,        Space,
-                               Invalid,    Invalid,  Invalid,    Invalid,    Invalid,   Invalid,        Invalid,
-                               Invalid,    Invalid,  Invalid,    Invalid,    Invalid,   Invalid,        Invalid,
-                               Invalid,    Invalid,  Invalid,    Invalid,    Space,     Operator,       String,
-                               Preprocess, Invalid,  Operator,   Operator,   String,    ExpressionOpen, ExpressionClose,
-                               Operator,   Operator, Comma,      Operator,   Operator,  Operator,       Number,
-                               Number,     Number,   Number,     Number,     Number,    Number,         Number,
-                               Number,     Number,   Operator,   Semicolumn, Operator,  Operator,       Operator,
-                               Operator,   Invalid,  Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               ArrayOpen,  Operator, ArrayClose, Operator,   Word,      Invalid,        Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       BlockOpen, Operator,       BlockClose,
-                               Operator,   Invalid };
+    constexpr CharacterClasses classes = CharacterClasses(Invalid, Invalid)
+                                               .Set('a', 'z', Word)
+                                               .Set('A', 'Z', Word)
+                                               .Set("_", Word)
+                                               .Set('0', '9', Number)
+                                               .Set("!%+-=^&|*:?~\\/><.", Operator)
+                                               .Set(",", Comma)
+                                               .Set(";", Semicolumn)
+                                               .Set("#", Preprocess)
+                                               .Set("\"'", String)
+                                               .Set("{", BlockOpen)
+                                               .Set("}", BlockClose)
+                                               .Set("[", ArrayOpen)
+                                               .Set("]", ArrayClose)
+                                               .Set("(", ExpressionOpen)
+                                               .Set(")", ExpressionClose)
+                                               .Set(" \t\n\r", Space);
+    constexpr uint64 WordCharacters = CharacterClasses::Mask(Word) | CharacterClasses::Mask(Number);
 
     inline uint32 GetCharType(char16 c)
     {
-        if (c < ARRAY_LEN(Cpp_Groups_IDs))
-            return Cpp_Groups_IDs[c];
-        return Invalid;
+        return classes[c];
     }
 } // namespace CharType
 
@@ -536,39 +403,23 @@ bool CPPFile::Update()
 }
 uint32 CPPFile::TokenizeWord(const GView::View::LexicalViewer::TextParser& text, TokensList& tokenList, uint32 pos)
 {
-    auto next = text.Parse(
-          pos,
-          [](char16 ch)
-          {
-              auto type = CharType::GetCharType(ch);
-              return (type == CharType::Word) || (type == CharType::Number);
-          });
     auto tokColor   = TokenColor::Word;
-    auto tokType    = Keyword::TextToKeywordID(text, pos, next);
+    auto tokType    = TokenType::Word;
     auto align      = TokenAlignament::None;
     auto opID       = 0U;
     auto tokenFlags = TokenFlags::None;
-
-    if (tokType == TokenType::None)
+    auto next       = Words::list.ScanWord(text, pos, CharType::classes, CharType::WordCharacters, tokType);
+    if ((tokType & 0xFFFF) != TokenType::Keyword)
     {
-        tokType = Constant::TextToConstantID(text, pos, next);
-        if (tokType == TokenType::None)
-        {
-            tokType = Datatype::TextToDatatypeID(text, pos, next);
-            if (tokType == TokenType::None)
-            {
-                tokType = TokenType::Word;
-            }
-            else
-            {
-                tokColor = TokenColor::Datatype;
-            }
-        }
-        else
+        if ((tokType & 0xFFFF) == TokenType::Constant)
         {
             tokColor   = TokenColor::Constant;
             tokenFlags = TokenFlags::DisableSimilaritySearch;
         }
+        else if ((tokType & 0xFFFF) == TokenType::Datatype)
+        {
+            tokColor = TokenColor::Datatype;
+        }
         auto lastTokenID = tokenList.GetLastTokenID();
         switch (lastTokenID & 0xFFFF)
         {
@@ -606,10 +457,8 @@ uint32 CPPFile::TokenizeWord(const GView::View::LexicalViewer::TextParser& text,
 }
 uint32 CPPFile::TokenizeOperator(const GView::View::LexicalViewer::TextParser& text, TokensList& tokenList, uint32 pos)
 {
-    auto next = text.ParseSameGroupID(pos, CharType::GetCharType);
-    auto txt  = text.GetSubString(pos, next);
-    uint32 tokenType, sz;
-    if (Operators::TextToOperatorID(txt.data(), (uint32) txt.size(), tokenType, sz))
+    uint32 tokenType, next;
+    if (Operators::list.ScanOperator(text, pos, CharType::classes, tokenType, next))
     {
         TokenAlignament align = TokenAlignament::AddSpaceBefore | TokenAlignament::AddSpaceAfter;
         auto opType           = tokenType >> 16;
@@ -640,8 +489,8 @@ uint32 CPPFile::TokenizeOperator(const GView::View::LexicalViewer::TextParser& t
             break;
         }
 
-        tokenList.Add(tokenType, pos, pos + sz, TokenColor::Operator, TokenDataType::None, align, TokenFlags::DisableSimilaritySearch);
-        return pos + sz;
+        tokenList.Add(tokenType, pos, next, TokenColor::Operator, TokenDataType::None, align, TokenFlags::DisableSimilaritySearch);
+        return next;
     }
     else
     {
@@ -652,14 +501,13 @@ uint32 CPPFile::TokenizeOperator(const GView::View::LexicalViewer::TextParser& t
 }
 uint32 CPPFile::TokenizePreprocessDirective(const TextParser& text, TokensList& list, BlocksList& blocks, uint32 pos)
 {
-    auto eol   = text.ParseUntillEndOfLine(pos);
-    auto start = pos;
-    pos        = text.ParseSpace(pos + 1, SpaceType::SpaceAndTabs);
-    if ((CharType::GetCharType(text[pos])) != CharType::Word)
+    bool validName;
+    auto eol = text.ParseDirective(pos, CharType::classes, CharType::Word, validName);
+    if (!validName)
     {
         // we have an error
         list.Add(TokenType::Preprocess,
-                 start,
+                 pos,
                  eol,
                  TokenColor::Preprocesor,
                  TokenAlignament::StartsOnNewLine | TokenAlignament::NewLineAfter)
@@ -667,25 +515,12 @@ uint32 CPPFile::TokenizePreprocessDirective(const TextParser& text, TokensList&
         return eol;
     }
     // we have a good preprocess directive ==> lets formalize it
-    auto next = text.ParseSameGroupID(pos, CharType::GetCharType);
     list.Add(
           TokenType::Preprocess,
-          start,
-          eol /*next*/,
+          pos,
+          eol,
           TokenColor::Preprocesor,
           TokenAlignament::StartsOnNewLine | TokenAlignament::AddSpaceAfter | TokenAlignament::NewLineAfter);
-
-    // auto tknIndex = list.Len();
-    // Tokenize(next, eol, text, list, blocks);
-    // auto tknCount = list.Len();
-    //// change the color of every added token
-    // for (auto index = tknIndex; index < tknCount; index++)
-    //     list[index].SetTokenColor(TokenColor::Preprocesor);
-    //// make sure that last token has a new line after it
-    // list.GetLastToken().UpdateAlignament(TokenAlignament::NewLineAfter);
-    //// crete a block
-    // blocks.Add(tknIndex - 1, tknCount-1, BlockAlignament::AsBlockStartToken);
-
     return eol;
 }
 void CPPFile::BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax)
@@ -873,7 +708,7 @@ void CPPFile::Tokenize(uint32 start, uint32 end, const TextParser& text, TokensL
             idx = TokenizeOperator(text, tokenList, idx);
             break;
         default:
-            next = text.ParseSameGroupID(idx, CharType::GetCharType);
+            next = text.ParseSameGroupID(idx, CharType::classes);
             tokenList.Add(TokenType::Word, idx, next, TokenColor::Word).SetError("Invalid character sequance");
             idx = next;
             break;
@@ -16,9 +16,15 @@ namespace Type
             };
         };
 
-        class CSVFile : public TypeInterface
+        class CSVFile : public TypeInterface, public GView::View::BufferViewer::ZoneProviderInterface
         {
           private:
+            struct LineCheckpoint
+            {
+                uint64_t line;      // the line that is not closed yet
+                uint64_t lineStart; // where that line starts
+                char lastNewLine;   // the new line that ended it ('\r' or '\n'), if the line after it could still start with its pair
+            };
             bool hasHeader{ false };
             unsigned int columnsNo{ 0 };
             unsigned int rowsNo{ 0 };
@@ -26,6 +32,17 @@ namespace Type
 
             uint64_t panelsMask{ 0 };
 
+            // the lines are counted only up to the last offset that was shown in the buffer view (one checkpoint for every block)
+            std::vector<LineCheckpoint> lineCheckpoints;
+
+            bool ScanLines(
+                  uint64_t start,
+                  uint64_t end,
+                  LineCheckpoint& state,
+                  std::vector<GView::View::BufferViewer::BufferZone>* zones,
+                  uint64_t zonesStart,
+                  uint64_t zonesEnd);
+
           public:
             Reference<GView::Object> obj; // should not be here
 
@@ -41,6 +58,7 @@ namespace Type
             bool Update(Reference<GView::Object> obj);
             bool HasPanel(Panels::IDs id);
             void UpdateBufferViewZones(GView::View::BufferViewer::Settings& settings);
+            bool GetZones(uint64 start, uint64 end, std::vector<GView::View::BufferViewer::BufferZone>& zones) override;
             void UpdateGrid(GView::View::GridViewer::Settings& settings);
         };
 
@@ -2,6 +2,8 @@
 
 using namespace GView::Type::CSV;
 
+constexpr uint64_t LINE_BLOCK_SIZE = 0x100000; // the line at the start of every 1M bytes is kept
+
 CSVFile::CSVFile() : panelsMask(0)
 {
     this->panelsMask |= (1ULL << (unsigned char) Panels::IDs::Information);
@@ -38,58 +40,93 @@ bool GView::Type::CSV::CSVFile::HasPanel(Panels::IDs id)
 
 void GView::Type::CSV::CSVFile::UpdateBufferViewZones(GView::View::BufferViewer::Settings& settings)
 {
-    const auto color = ColorPair{ Color::Gray, Color::Transparent };
+    // every line is a zone, but the lines are found only when the buffer view needs them
+    this->lineCheckpoints.clear();
+    settings.SetZoneProvider(this);
+}
 
+bool GView::Type::CSV::CSVFile::ScanLines(
+      uint64_t start,
+      uint64_t end,
+      LineCheckpoint& state,
+      std::vector<GView::View::BufferViewer::BufferZone>* zones,
+      uint64_t zonesStart,
+      uint64_t zonesEnd)
+{
+    // a line ends with '\n', '\r', "\r\n" or "\n\r" - it is closed (and added to zones if it ends after zonesStart) when the
+    // next byte is not the pair of its new line
+    const auto color = ColorPair{ Color::Gray, Color::Transparent };
     const auto oSize = obj->GetData().GetSize();
     const auto cSize = obj->GetData().GetCacheSize();
-
-    auto oSizeProcessed = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do
+    auto closeLine   = [&](uint64_t lineEnd)
     {
-        const auto buf = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(cSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        const auto nPos = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
-
-        const auto oldOSizeProcessed = oSizeProcessed;
-
-        if (nPos < rPos)
+        if ((zones) && (lineEnd > zonesStart) && (lineEnd > state.lineStart))
         {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r')
-            {
-                oSizeProcessed += nPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += nPos + 1;
-            }
+            auto& zone = zones->emplace_back();
+            zone.start = state.lineStart;
+            zone.size  = lineEnd - state.lineStart;
+            zone.color = color;
+            zone.name  = std::to_string(state.line);
         }
-        else if (nPos > rPos)
+        state.line++;
+        state.lineStart   = lineEnd;
+        state.lastNewLine = 0;
+    };
+
+    for (auto offset = start; offset < end;)
+    {
+        const auto buf = obj->GetData().Get(offset, static_cast<uint32>(std::min<uint64_t>(cSize, end - offset)), false);
+        CHECK(buf.GetLength() > 0, false, "Fail to read from offset %llu", offset);
+        const auto* p = reinterpret_cast<const char*>(buf.GetData());
+        for (auto idx = 0U; idx < buf.GetLength(); idx++)
         {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n')
-            {
-                oSizeProcessed += rPos + 2;
-            }
-            else
+            const auto ch  = p[idx];
+            const auto pos = offset + idx;
+            if (state.lastNewLine != 0)
             {
-                oSizeProcessed += rPos + 1;
+                const auto isPair = ((ch == '\n') || (ch == '\r')) && (ch != state.lastNewLine);
+                closeLine(isPair ? pos + 1 : pos);
+                if ((zones) && (state.lineStart >= zonesEnd))
+                    return true;
+                if (isPair)
+                    continue;
             }
+            if ((ch == '\n') || (ch == '\r'))
+                state.lastNewLine = ch;
         }
-        else // last line EOF
-        {
-            settings.AddZone(oldOSizeProcessed, oSize - oldOSizeProcessed, color, std::to_string(currentLine));
-            currentLine++;
-            break;
-        }
+        offset += buf.GetLength();
+    }
 
-        settings.AddZone(oldOSizeProcessed, oSizeProcessed - oldOSizeProcessed, color, std::to_string(currentLine));
+    // the last line ends with the object
+    if ((zones) && (end == oSize) && (state.lineStart < oSize))
+        closeLine(oSize);
+    return true;
+}
 
-        currentLine++;
+bool GView::Type::CSV::CSVFile::GetZones(uint64 start, uint64 end, std::vector<GView::View::BufferViewer::BufferZone>& zones)
+{
+    /*
+    The line of an offset is only known after all the lines before it are counted. The lines are counted one block at a time and
+    the state at the start of every block is kept: the lines before an offset are counted only once and a range of offsets only
+    needs the lines from the start of its block.
+    */
+    const auto oSize = obj->GetData().GetSize();
+    end              = std::min<uint64>(end, oSize);
+    if (start >= end)
+        return true;
+    if (this->lineCheckpoints.empty())
+        this->lineCheckpoints.push_back(LineCheckpoint{ 0, 0, 0 });
+    while (this->lineCheckpoints.size() <= start / LINE_BLOCK_SIZE)
+    {
+        const auto blockStart = (this->lineCheckpoints.size() - 1) * LINE_BLOCK_SIZE;
+        auto state            = this->lineCheckpoints.back();
+        CHECK(ScanLines(blockStart, blockStart + LINE_BLOCK_SIZE, state, nullptr, 0, 0), false, "");
+        this->lineCheckpoints.push_back(state);
+    }
 
-    } while (oSizeProcessed < oSize);
+    // the lines from the start of the block are counted again (the ones that end in [start, end) are added)
+    auto state = this->lineCheckpoints[start / LINE_BLOCK_SIZE];
+    return ScanLines((start / LINE_BLOCK_SIZE) * LINE_BLOCK_SIZE, oSize, state, &zones, start, end);
 }
 
 void GView::Type::CSV::CSVFile::UpdateGrid(GView::View::GridViewer::Settings& settings)
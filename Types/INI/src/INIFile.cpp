@@ -15,7 +15,7 @@ enum class ParserState
 namespace CharType
 {
     constexpr uint8 Word                = 0;
-    constexpr uint8 SpaceOrNewLine      = 1;
+    constexpr uint8 Space               = 1;
     constexpr uint8 Comma               = 2;
     constexpr uint8 Equal               = 3;
     constexpr uint8 String              = 4;
@@ -23,77 +23,28 @@ namespace CharType
     constexpr uint8 SectionOrArrayStart = 6;
     constexpr uint8 SectionOrArrayEnd   = 7;
     constexpr uint8 Invalid             = 8;
+    constexpr uint8 NewLine             = 9;
 
-    uint8 Ini_Groups_IDs[] = { Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        SpaceOrNewLine,
-                               SpaceOrNewLine, Invalid,
-                               Invalid,        SpaceOrNewLine,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               Invalid,        Invalid,
-                               SpaceOrNewLine, Word,
-                               String,         Comment,
-                               Word,           Word,
-                               Word,           String,
-                               Word,           Word,
-                               Word,           Word,
-                               Comma,          Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Equal,          Comment,
-                               Word,           Equal,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           SectionOrArrayStart,
-                               Word,           SectionOrArrayEnd,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word,
-                               Word,           Word };
+    constexpr CharacterClasses classes = CharacterClasses(Invalid, Word)
+                                               .Set('!', '\x7F', Word)
+                                               .Set(" \t", Space)
+                                               .Set("\r\n", NewLine)
+                                               .Set(",", Comma)
+                                               .Set("=:", Equal)
+                                               .Set("\"'", String)
+                                               .Set(";#", Comment)
+                                               .Set("[", SectionOrArrayStart)
+                                               .Set("]", SectionOrArrayEnd);
+    constexpr uint64 Spaces      = CharacterClasses::Mask(Space);
+    constexpr uint64 LineEnd     = CharacterClasses::Mask(Comment) | CharacterClasses::Mask(NewLine); // a comment ends a line as well
+    constexpr uint64 SectionName = ~(LineEnd | CharacterClasses::Mask(SectionOrArrayEnd));
+    constexpr uint64 KeyName     = ~(LineEnd | CharacterClasses::Mask(Equal) | Spaces);
+    constexpr uint64 Value       = ~LineEnd;
+    constexpr uint64 ArrayValue  = ~(LineEnd | CharacterClasses::Mask(Comma) | CharacterClasses::Mask(SectionOrArrayEnd));
 
     inline uint32 GetCharType(char16 c)
     {
-        if (c < ARRAY_LEN(Ini_Groups_IDs))
-            return Ini_Groups_IDs[c];
-        return Word;
+        return classes[c];
     }
 } // namespace CharType
 namespace ConstantsHashes
@@ -155,7 +106,7 @@ struct ParserData
             pos = next;
             break;
         case CharType::SectionOrArrayStart:
-            next = text.Parse(pos, [](char16 ch) { return (ch != ']') && (ch != ';') && (ch != '#') && (ch != 13) && (ch != 10); });
+            next = text.Parse(pos, CharType::classes, CharType::SectionName);
             if (text[next] == ']')
                 next++;
             tokenList.Add(
@@ -169,12 +120,7 @@ struct ParserData
             pos = next;
             break;
         case CharType::Word:
-            next = text.Parse(
-                  pos,
-                  [](char16 ch) {
-                      return (ch != ';') && (ch != '#') && (ch != 13) && (ch != 10) && (ch != '=') && (ch != ':') && (ch != ' ') &&
-                             (ch != '\t');
-                  });
+            next = text.Parse(pos, CharType::classes, CharType::KeyName);
             tokenList.Add(
                   TokenType::Key,
                   pos,
@@ -241,8 +187,8 @@ struct ParserData
             break;
         default:
             // its an word
-            next = text.Parse(pos, [](char16 ch) { return (ch != ';') && (ch != '#') && (ch != 13) && (ch != 10); });
-            next = text.ParseBackwards(next - 1, [](char16 ch) { return (ch == ' ') || (ch == '\t'); });
+            next = text.Parse(pos, CharType::classes, CharType::Value);
+            next = text.ParseBackwards(next - 1, CharType::classes, CharType::Spaces);
             next++;
             // we should check if next is a number or another special value
             AddValue(pos, next);
@@ -331,9 +277,8 @@ struct ParserData
             pos++;
             break;
         default:
-            next = text.Parse(
-                  pos, [](char16 ch) { return (ch != ';') && (ch != '#') && (ch != 13) && (ch != 10) && (ch != ',') && (ch != ']'); });
-            next = text.ParseBackwards(next - 1, [](char16 ch) { return (ch == ' ') || (ch == '\t'); });
+            next = text.Parse(pos, CharType::classes, CharType::ArrayValue);
+            next = text.ParseBackwards(next - 1, CharType::classes, CharType::Spaces);
             next++;
             tokenList.Add(TokenType::Invalid, pos, next, TokenColor::Word)
                   .SetError("Invalid character (expecting either a comma (,) or the end of an array (])");
@@ -401,9 +346,8 @@ struct ParserData
             break;
         default:
             // its an word
-            next = text.Parse(
-                  pos, [](char16 ch) { return (ch != ';') && (ch != '#') && (ch != 13) && (ch != 10) && (ch != ',') && (ch != ']'); });
-            next = text.ParseBackwards(next - 1, [](char16 ch) { return (ch == ' ') || (ch == '\t'); });
+            next = text.Parse(pos, CharType::classes, CharType::ArrayValue);
+            next = text.ParseBackwards(next - 1, CharType::classes, CharType::Spaces);
             next++;
             // we should check if next is a number or another special value
             AddValue(pos, next);
@@ -417,7 +361,7 @@ struct ParserData
         while (this->pos < this->len)
         {
             auto chType = CharType::GetCharType(text[this->pos]);
-            if (chType == CharType::SpaceOrNewLine)
+            if ((chType == CharType::Space) || (chType == CharType::NewLine))
             {
                 this->pos = text.ParseSpace(this->pos, SpaceType::All);
             }
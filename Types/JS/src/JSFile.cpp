@@ -4,419 +4,213 @@ namespace GView::Type::JS
 {
 using namespace GView::View::LexicalViewer;
 
-int32 BinarySearch(uint32 hash, uint32* list, int32 elementsCount)
+namespace Words
 {
-    if (elementsCount <= 0)
-        return -1;
-    auto start = 0;
-    auto end   = elementsCount - 1;
-    while (start <= end)
-    {
-        auto mij   = (start + end) >> 1;
-        auto h_mij = list[mij];
-        if (hash < h_mij)
-        {
-            end = mij - 1;
-            continue;
-        }
-        if (hash > h_mij)
-        {
-            start = mij + 1;
-            continue;
-        }
-        return mij;
-    }
-    return -1;
-}
-
-namespace Keyword
-{
-    uint32 list[] = {
-        0x06ECB7E7, 0x081FB565, 0x08D22E0F, 0x0903C7AE, 0x0BF5A9A6, 0x0BF7CB59, 0x0C4AFE69, 0x0DC628CE, 0x112A90D4, 0x128BDC5B, 0x14204413,
-        0x159AC2B7, 0x16378A88, 0x1A2BBEF3, 0x1E54727D, 0x2446530A, 0x26129D76, 0x27A252D4, 0x27CB3B23, 0x28258718, 0x28999611, 0x2951C89F,
-        0x2E329B2A, 0x2FEBCEF5, 0x32E76161, 0x39386E06, 0x3F617060, 0x41387A9E, 0x419C3BA5, 0x4288E94C, 0x43AD5579, 0x49346080, 0x4A7181DF,
-        0x4F82B9C9, 0x55F0DD53, 0x5E70F23D, 0x601B3C5E, 0x621CD814, 0x62CB0D0C, 0x645BA277, 0x664FD1D4, 0x67C2444A, 0x6AF0FE62, 0x6BFBD198,
-        0x6C5395C0, 0x70DAEE4F, 0x74F440F8, 0x78B04FBE, 0x7A78762F, 0x7B71324F, 0x816CB000, 0x83D03615, 0x84EA5130, 0x85EE37BF, 0x8684C5F8,
-        0x8912C4E5, 0x8A58AD26, 0x8A9E6B73, 0x8D39BDE6, 0x913B2BFB, 0x933B5BDE, 0x93E05F71, 0x96234BD4, 0x97EB7E50, 0x9A90A8A0, 0x9B2538B1,
-        0x9C0C3BA8, 0x9D0F221F, 0x9D85D64E, 0x9E212406, 0x9ED1A63B, 0x9ED64249, 0xA0EB0F08, 0xA179DD8A, 0xA710DC3C, 0xA90B999B, 0xAB3E0BFF,
-        0xAC1DB00E, 0xACF38390, 0xAE7183F0, 0xB1727E44, 0xB1B3C06A, 0xB7C358F9, 0xB8440699, 0xBA4B77EF, 0xBDBF5BF0, 0xBDF0855A, 0xBE28AC52,
-        0xC18234D0, 0xC9648178, 0xCB532AE5, 0xCC909380, 0xCD80829D, 0xD290C23B, 0xD2C8C28E, 0xD35EC4C9, 0xD472DC59, 0xD5F0C82E, 0xD72BCD52,
-        0xDA2BD281, 0xDB3FB489, 0xDD4EC22C, 0xDEF08C82, 0xDFE6493B, 0xE0DE22ED, 0xE259526E, 0xE9359601, 0xEA1B7675, 0xEACDFCFD, 0xEBEE50C5,
-        0xED7F94C7, 0xEE88998F, 0xF112B61B, 0xF25D9F4F, 0xF5A30FE6, 0xF77E01D4, 0xF7863C98, 0xF9B5A4FF, 0xFB080CB3, 0xFD12C898, 0xFEE4436A
-    };
-    uint32 TextToKeywordID(const GView::View::LexicalViewer::TextParser& text, uint32 start, uint32 end)
-    {
-        auto res = BinarySearch(text.ComputeHash32(start, end, false), list, 121);
-        if (res == -1)
-            return TokenType::None;
-        return 1000 + res;
-    };
-} // namespace Keyword
-
-namespace Constant
-{
-    uint32 list[] = { 0x0B069958, 0x2F8F13BA, 0x4DB211E5, 0x77074BA4 };
-    uint32 TextToConstantID(const GView::View::LexicalViewer::TextParser& text, uint32 start, uint32 end)
-    {
-        auto res = BinarySearch(text.ComputeHash32(start, end, false), list, 4);
-        if (res == -1)
-            return TokenType::None;
-        return 8000 + res;
-    };
-} // namespace Constant
-
-namespace Datatype
-{
-    uint32 list[] = {
-        0x17C16538, 0x1BD670A0, 0x48B5725F, 0x506B03FA, 0x645A021F, 0x65F46EBF, 0x8A25E7BE,
-        0x95E97E5E, 0xA6C45D85, 0xA84C031D, 0xB8C60CBA, 0xBA226BD5, 0xC2ECDF53,
-    };
-    uint32 TextToDatatypeID(const GView::View::LexicalViewer::TextParser& text, uint32 start, uint32 end)
-    {
-        auto res = BinarySearch(text.ComputeHash32(start, end, false), list, 13);
-        if (res == -1)
-            return TokenType::None;
-        return 6000 + res;
-    };
-} // namespace Datatype
+    // keywords, constants and data types
+    constexpr LexicalTable list({
+          { "abstract", TokenType::Keyword_Abstract },
+          { "break", TokenType::Keyword_Break },
+          { "case", TokenType::Keyword_Case },
+          { "catch", TokenType::Keyword_Catch },
+          { "class", TokenType::Keyword_Class },
+          { "continue", TokenType::Keyword_Continue },
+          { "const", TokenType::Keyword_Const },
+          { "console", TokenType::Keyword_Console },
+          { "debugger", TokenType::Keyword_Debugger },
+          { "default", TokenType::Keyword_Default },
+          { "delete", TokenType::Keyword_Delete },
+          { "do", TokenType::Keyword_Do },
+          { "double", TokenType::Keyword_Double },
+          { "else", TokenType::Keyword_Else },
+          { "enum", TokenType::Keyword_Enum },
+          { "export", TokenType::Keyword_Export },
+          { "extends", TokenType::Keyword_Extends },
+          { "final", TokenType::Keyword_Final },
+          { "finally", TokenType::Keyword_Finally },
+          { "for", TokenType::Keyword_For },
+          { "function", TokenType::Keyword_Function },
+          { "goto", TokenType::Keyword_Goto },
+          { "if", TokenType::Keyword_If },
+          { "implements", TokenType::Keyword_Implements },
+          { "import", TokenType::Keyword_Import },
+          { "in", TokenType::Keyword_In },
+          { "instanceof", TokenType::Keyword_Instanceof },
+          { "interface", TokenType::Keyword_Interface },
+          { "native", TokenType::Keyword_Native },
+          { "new", TokenType::Keyword_New },
+          { "package", TokenType::Keyword_Package },
+          { "private", TokenType::Keyword_Private },
+          { "protected", TokenType::Keyword_Protected },
+          { "public", TokenType::Keyword_Public },
+          { "return", TokenType::Keyword_Return },
+          { "static", TokenType::Keyword_Static },
+          { "super", TokenType::Keyword_Super },
+          { "switch", TokenType::Keyword_Switch },
+          { "synchronized", TokenType::Keyword_Synchronized },
+          { "this", TokenType::Keyword_This },
+          { "throw", TokenType::Keyword_Throw },
+          { "throws", TokenType::Keyword_Throws },
+          { "transient", TokenType::Keyword_Transient },
+          { "try", TokenType::Keyword_Try },
+          { "typeof", TokenType::Keyword_Typeof },
+          { "while", TokenType::Keyword_While },
+          { "with", TokenType::Keyword_With },
+          { "alert", TokenType::Keyword_Alert },
+          { "arguments", TokenType::Keyword_Arguments },
+          { "Array", TokenType::Keyword_Array },
+          { "blur", TokenType::Keyword_Blur },
+          { "callee", TokenType::Keyword_Callee },
+          { "caller", TokenType::Keyword_Caller },
+          { "captureEvents", TokenType::Keyword_Captureevents },
+          { "clearInterval", TokenType::Keyword_Clearinterval },
+          { "clearTimeout", TokenType::Keyword_Cleartimeout },
+          { "close", TokenType::Keyword_Close },
+          { "closed", TokenType::Keyword_Closed },
+          { "confirm", TokenType::Keyword_Confirm },
+          { "constructor", TokenType::Keyword_Constructor },
+          { "Date", TokenType::Keyword_Date },
+          { "defaultStatus", TokenType::Keyword_Defaultstatus },
+          { "document", TokenType::Keyword_Document },
+          { "escape", TokenType::Keyword_Escape },
+          { "eval", TokenType::Keyword_Eval },
+          { "find", TokenType::Keyword_Find },
+          { "focus", TokenType::Keyword_Focus },
+          { "frames", TokenType::Keyword_Frames },
+          { "history", TokenType::Keyword_History },
+          { "home", TokenType::Keyword_Home },
+          { "Infinity", TokenType::Keyword_Infinity },
+          { "innerHeight", TokenType::Keyword_Innerheight },
+          { "innerWidth", TokenType::Keyword_Innerwidth },
+          { "isFinite", TokenType::Keyword_Isfinite },
+          { "isNaN", TokenType::Keyword_Isnan },
+          { "java", TokenType::Keyword_Java },
+          { "length", TokenType::Keyword_Length },
+          { "location", TokenType::Keyword_Location },
+          { "locationbar", TokenType::Keyword_Locationbar },
+          { "Math", TokenType::Keyword_Math },
+          { "menubar", TokenType::Keyword_Menubar },
+          { "moveBy", TokenType::Keyword_Moveby },
+          { "name", TokenType::Keyword_Name },
+          { "netscape", TokenType::Keyword_Netscape },
+          { "open", TokenType::Keyword_Open },
+          { "opener", TokenType::Keyword_Opener },
+          { "outerHeight", TokenType::Keyword_Outerheight },
+          { "outerWidth", TokenType::Keyword_Outerwidth },
+          { "Packages", TokenType::Keyword_Packages },
+          { "pageXOffset", TokenType::Keyword_Pagexoffset },
+          { "pageYOffset", TokenType::Keyword_Pageyoffset },
+          { "parent", TokenType::Keyword_Parent },
+          { "parseFloat", TokenType::Keyword_Parsefloat },
+          { "parseInt", TokenType::Keyword_Parseint },
+          { "personalbar", TokenType::Keyword_Personalbar },
+          { "print", TokenType::Keyword_Print },
+          { "prompt", TokenType::Keyword_Prompt },
+          { "prototype", TokenType::Keyword_Prototype },
+          { "RegExp", TokenType::Keyword_Regexp },
+          { "releaseEvents", TokenType::Keyword_Releaseevents },
+          { "resizeBy", TokenType::Keyword_Resizeby },
+          { "resizeTo", TokenType::Keyword_Resizeto },
+          { "routeEvent", TokenType::Keyword_Routeevent },
+          { "scroll", TokenType::Keyword_Scroll },
+          { "scrollbars", TokenType::Keyword_Scrollbars },
+          { "scrollBy", TokenType::Keyword_Scrollby },
+          { "scrollTo", TokenType::Keyword_Scrollto },
+          { "self", TokenType::Keyword_Self },
+          { "setInterval", TokenType::Keyword_Setinterval },
+          { "setTimeout", TokenType::Keyword_Settimeout },
+          { "status", TokenType::Keyword_Status },
+          { "statusbar", TokenType::Keyword_Statusbar },
+          { "stop", TokenType::Keyword_Stop },
+          { "toolbar", TokenType::Keyword_Toolbar },
+          { "top", TokenType::Keyword_Top },
+          { "toString", TokenType::Keyword_Tostring },
+          { "unescape", TokenType::Keyword_Unescape },
+          { "unwatch", TokenType::Keyword_Unwatch },
+          { "valueOf", TokenType::Keyword_Valueof },
+          { "watc", TokenType::Keyword_Watc },
+          { "win", TokenType::Keyword_Win },
+          { "false", TokenType::Constant_False },
+          { "true", TokenType::Constant_True },
+          { "null", TokenType::Constant_Null },
+          { "NaN", TokenType::Constant_Nan },
+          { "Boolean", TokenType::DataType_Boolean },
+          { "byte", TokenType::DataType_Byte },
+          { "char", TokenType::DataType_Char },
+          { "float", TokenType::DataType_Float },
+          { "int", TokenType::DataType_Int },
+          { "long", TokenType::DataType_Long },
+          { "short", TokenType::DataType_Short },
+          { "var", TokenType::DataType_Var },
+          { "void", TokenType::DataType_Void },
+          { "let", TokenType::DataType_Let },
+          { "Number", TokenType::DataType_Number },
+          { "String", TokenType::DataType_String },
+          { "Object", TokenType::DataType_Object },
+    });
+} // namespace Words
 
 namespace Operators
 {
-
-    struct OperatorPair
-    {
-        uint32 tokenType;
-        uint32 hash;
-    };
-
-    uint8 chars_ids[128]          = { 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0,  0, 0,  0,
-                                      0, 13, 0, 0, 0, 6, 9, 0, 0, 0, 4, 2, 0, 3, 16, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 0, 7,  1, 8,  12,
-                                      0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0,  0, 10, 0,
-                                      0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0, 11, 0, 14, 0 };
-    constexpr uint32 HASH_DEVIDER = 265;
-    OperatorPair operator_hash_table[HASH_DEVIDER] = { { TokenType::None, 0 },
-                                                       { TokenType::Operator_Assignment, 0x00000001 },
-                                                       { TokenType::Operator_Plus, 0x00000002 },
-                                                       { TokenType::Operator_Minus, 0x00000003 },
-                                                       { TokenType::Operator_Multiply, 0x00000004 },
-                                                       { TokenType::Operator_Division, 0x00000005 },
-                                                       { TokenType::Operator_Modulo, 0x00000006 },
-                                                       { TokenType::Operator_Smaller, 0x00000007 },
-                                                       { TokenType::Operator_Bigger, 0x00000008 },
-                                                       { TokenType::Operator_AND, 0x00000009 },
-                                                       { TokenType::Operator_XOR, 0x0000000a },
-                                                       { TokenType::Operator_OR, 0x0000000b },
-                                                       { TokenType::Operator_Condition, 0x0000000c },
-                                                       { TokenType::Operator_LogicalNOT, 0x0000000d },
-                                                       { TokenType::Operator_NOT, 0x0000000e },
-                                                       { TokenType::Operator_TWO_POINTS, 0x0000000f },
-                                                       { TokenType::Operator_MemberAccess, 0x00000010 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_AndAssignment, 0x00000121 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_UnsignedRightShiftAssignment, 0x00042101 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_LogicAND, 0x00000129 },
-                                                       { TokenType::Operator_Equal, 0x00000021 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_ArrowFunction, 0x00000028 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_XorAssignment, 0x00000141 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_PlusAssignment, 0x00000041 },
-                                                       { TokenType::Operator_Increment, 0x00000042 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_OrAssignment, 0x00000161 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_StrictDifferent, 0x00003421 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_MinusAssignment, 0x00000061 },
-                                                       { TokenType::Operator_LogicOR, 0x0000016b },
-                                                       { TokenType::Operator_Decrement, 0x00000063 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_MupliplyAssignment, 0x00000081 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_Exponential, 0x00000084 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_Different, 0x000001a1 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_DivisionAssignment, 0x000000a1 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_ModuloAssignment, 0x000000c1 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_LogicNullishAssignment, 0x00003181 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_LogicORAssignment, 0x00002d61 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_SmallerOrEQ, 0x000000e1 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_LogicANDAssignment, 0x00002521 },
-                                                       { TokenType::Operator_LeftShift, 0x000000e7 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_RightShiftAssignment, 0x00002101 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_LeftShiftAssignment, 0x00001ce1 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_SignRightShift, 0x00002108 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_ExponentiationAssignment, 0x00001081 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_BiggerOrEq, 0x00000101 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_StrictEqual, 0x00000421 },
-                                                       { TokenType::None, 0 },
-                                                       { TokenType::Operator_RightShift, 0x00000108 } };
-
-    uint32 TextToOperatorID(const char16* txt, uint32 size, uint32& opSize)
-    {
-        // compute the hashes over the entire 3 cases
-        uint32 hash1 = 0, hash2 = 0, hash3 = 0, hash4 = 0;
-        if (((*txt) < 128) && (chars_ids[*txt] != 0))
-        {
-            hash1 = chars_ids[*txt];
-            txt++;
-            if ((size > 1) && ((*txt) < 128) && (chars_ids[*txt] != 0))
-            {
-                hash2 = (hash1 << 5) + chars_ids[*txt];
-                txt++;
-                if ((size > 2) && ((*txt) < 128) && (chars_ids[*txt] != 0))
-                {
-                    hash3 = (hash2 << 5) + chars_ids[*txt];
-                    txt++;
-                    if ((size > 3) && ((*txt) < 128) && (chars_ids[*txt] != 0))
-                        hash4 = (hash3 << 5) + chars_ids[*txt];
-                }
-            }
-        }
-        {
-            auto op = operator_hash_table[hash4 % HASH_DEVIDER];
-            if ((op.tokenType != TokenType::None) && (op.hash == hash4))
-            {
-                opSize = 4;
-                return op.tokenType;
-            }
-        }
-        {
-            auto op = operator_hash_table[hash3 % HASH_DEVIDER];
-            if ((op.tokenType != TokenType::None) && (op.hash == hash3))
-            {
-                opSize = 3;
-                return op.tokenType;
-            }
-        }
-        {
-            auto op = operator_hash_table[hash2 % HASH_DEVIDER];
-            if ((op.tokenType != TokenType::None) && (op.hash == hash2))
-            {
-                opSize = 2;
-                return op.tokenType;
-            }
-        }
-        {
-            auto op = operator_hash_table[hash1 % HASH_DEVIDER];
-            if ((op.tokenType != TokenType::None) && (op.hash == hash1))
-            {
-                opSize = 1;
-                return op.tokenType;
-            }
-        }
-        return TokenType::None; // invalid operator
-    }
+    constexpr LexicalTable list({
+          { "=", TokenType::Operator_Assignment },
+          { "+=", TokenType::Operator_PlusAssignment },
+          { "-=", TokenType::Operator_MinusAssignment },
+          { "*=", TokenType::Operator_MupliplyAssignment },
+          { "/=", TokenType::Operator_DivisionAssignment },
+          { "%=", TokenType::Operator_ModuloAssignment },
+          { "**=", TokenType::Operator_ExponentiationAssignment },
+          { "<<=", TokenType::Operator_LeftShiftAssignment },
+          { ">>=", TokenType::Operator_RightShiftAssignment },
+          { ">>>=", TokenType::Operator_UnsignedRightShiftAssignment },
+          { "&=", TokenType::Operator_AndAssignment },
+          { "^=", TokenType::Operator_XorAssignment },
+          { "|=", TokenType::Operator_OrAssignment },
+          { "&&=", TokenType::Operator_LogicANDAssignment },
+          { "||=", TokenType::Operator_LogicORAssignment },
+          { "??=", TokenType::Operator_LogicNullishAssignment },
+          { ">", TokenType::Operator_Bigger },
+          { "<", TokenType::Operator_Smaller },
+          { ">=", TokenType::Operator_BiggerOrEq },
+          { "<=", TokenType::Operator_SmallerOrEQ },
+          { "==", TokenType::Operator_Equal },
+          { "===", TokenType::Operator_StrictEqual },
+          { "!=", TokenType::Operator_Different },
+          { "!==", TokenType::Operator_StrictDifferent },
+          { "++", TokenType::Operator_Increment },
+          { "--", TokenType::Operator_Decrement },
+          { "+", TokenType::Operator_Plus },
+          { "-", TokenType::Operator_Minus },
+          { "*", TokenType::Operator_Multiply },
+          { "/", TokenType::Operator_Division },
+          { "%", TokenType::Operator_Modulo },
+          { "**", TokenType::Operator_Exponential },
+          { "&", TokenType::Operator_AND },
+          { "|", TokenType::Operator_OR },
+          { "^", TokenType::Operator_XOR },
+          { "~", TokenType::Operator_NOT },
+          { "<<", TokenType::Operator_LeftShift },
+          { ">>", TokenType::Operator_RightShift },
+          { ">>>", TokenType::Operator_SignRightShift },
+          { "&&", TokenType::Operator_LogicAND },
+          { "||", TokenType::Operator_LogicOR },
+          { "!", TokenType::Operator_LogicalNOT },
+          { "?", TokenType::Operator_Condition },
+          { ":", TokenType::Operator_TWO_POINTS },
+          { ".", TokenType::Operator_MemberAccess },
+          { "=>", TokenType::Operator_ArrowFunction },
+    });
 } // namespace Operators
 
+// the tables are built at compile time --> so they can be checked at compile time as well
+static_assert([] { uint32 id = 0; return Words::list.Find(u"function", id) && (id == TokenType::Keyword_Function); }());
+static_assert([] { uint32 id = 0; return !Words::list.Find(u"functions", id) && !Words::list.Find(u"Function", id); }());
+static_assert(
+      []
+      {
+          uint32 id = 0, sz = 0;
+          return Operators::list.FindLongestPrefix(u">>>=1", id, sz) && (id == TokenType::Operator_UnsignedRightShiftAssignment) && (sz == 4);
+      }());
+
 namespace CharType
 {
     constexpr uint8 Word              = 0;
@@ -434,36 +228,35 @@ namespace CharType
     constexpr uint8 ExpressionClose   = 12;
     constexpr uint8 Space             = 13;
     constexpr uint8 Invalid           = 14;
-    constexpr uint8 SingleLineComment = 15; // virtual (not in Cpp_Groups_IDs)
-    constexpr uint8 Comment           = 16; // virtual (not in Cpp_Groups_IDs)
+    constexpr uint8 SingleLineComment = 15; // virtual (not in classes)
+    constexpr uint8 Comment           = 16; // virtual (not in classes)
     constexpr uint8 Backquote         = 17;
     constexpr uint8 NewLine           = 18;
 
-    uint8 Cpp_Groups_IDs[] = { Invalid,    Invalid,  Invalid,    Invalid,    Invalid,   Invalid,        Invalid,
-                               Invalid,    Invalid,  Space,      NewLine,    Invalid,   Invalid,        NewLine,
-                               Invalid,    Invalid,  Invalid,    Invalid,    Invalid,   Invalid,        Invalid,
-                               Invalid,    Invalid,  Invalid,    Invalid,    Invalid,   Invalid,        Invalid,
-                               Invalid,    Invalid,  Invalid,    Invalid,    Space,     Operator,       String,
-                               Preprocess, Invalid,  Operator,   Operator,   String,    ExpressionOpen, ExpressionClose,
-                               Operator,   Operator, Comma,      Operator,   Operator,  Operator,       Number,
-                               Number,     Number,   Number,     Number,     Number,    Number,         Number,
-                               Number,     Number,   Operator,   Semicolumn, Operator,  Operator,       Operator,
-                               Operator,   Invalid,  Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               ArrayOpen,  Operator, ArrayClose, Operator,   Word,      Backquote,      Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       Word,      Word,           Word,
-                               Word,       Word,     Word,       Word,       BlockOpen, Operator,       BlockClose,
-                               Operator,   Invalid };
+    constexpr CharacterClasses classes = CharacterClasses(Invalid, Invalid)
+                                               .Set('a', 'z', Word)
+                                               .Set('A', 'Z', Word)
+                                               .Set("_", Word)
+                                               .Set('0', '9', Number)
+                                               .Set("!%+-=^&|*:?~\\/><.", Operator)
+                                               .Set(",", Comma)
+                                               .Set(";", Semicolumn)
+                                               .Set("#", Preprocess)
+                                               .Set("\"'", String)
+                                               .Set("`", Backquote)
+                                               .Set("{", BlockOpen)
+                                               .Set("}", BlockClose)
+                                               .Set("[", ArrayOpen)
+                                               .Set("]", ArrayClose)
+                                               .Set("(", ExpressionOpen)
+                                               .Set(")", ExpressionClose)
+                                               .Set(" \t", Space)
+                                               .Set("\n\r", NewLine);
+    constexpr uint64 WordCharacters = CharacterClasses::Mask(Word) | CharacterClasses::Mask(Number);
 
     inline uint32 GetCharType(char16 c)
     {
-        if (c < ARRAY_LEN(Cpp_Groups_IDs))
-            return Cpp_Groups_IDs[c];
-        return Invalid;
+        return classes[c];
     }
 } // namespace CharType
 
@@ -477,26 +270,17 @@ bool JSFile::Update()
 }
 uint32 JSFile::TokenizeWord(const GView::View::LexicalViewer::TextParser& text, TokensList& tokenList, uint32 pos)
 {
-    auto next = text.Parse(
-          pos,
-          [](char16 ch)
-          {
-              auto type = CharType::GetCharType(ch);
-              return (type == CharType::Word) || (type == CharType::Number);
-          });
     auto tokColor = TokenColor::Word;
-    auto tokType  = Keyword::TextToKeywordID(text, pos, next);
+    auto tokType  = TokenType::None;
     auto align    = TokenAlignament::None;
     auto opID     = 0U;
     auto flags    = TokenFlags::None;
-
-    if (tokType == TokenType::None)
+    auto next     = Words::list.ScanWord(text, pos, CharType::classes, CharType::WordCharacters, tokType);
+    if (!TokenType::IsKeyword(tokType))
     {
-        tokType = Constant::TextToConstantID(text, pos, next);
-        if (tokType == TokenType::None)
+        if (!TokenType::IsConstant(tokType))
         {
-            tokType = Datatype::TextToDatatypeID(text, pos, next);
-            if (tokType == TokenType::None)
+            if (!TokenType::IsDatatype(tokType))
             {
                 tokType              = TokenType::Word;
                 const auto lastToken = tokenList.GetLastTokenID();
@@ -575,12 +359,9 @@ int32 JSFile::ParseRegEx(const GView::View::LexicalViewer::TextParser& text, Tok
 }
 uint32 JSFile::TokenizeOperator(const GView::View::LexicalViewer::TextParser& text, TokensList& tokenList, uint32 pos)
 {
-    auto next = text.ParseSameGroupID(pos, CharType::GetCharType);
     uint32 next2;
-    auto txt = text.GetSubString(pos, next);
-    uint32 tokenType, sz;
-    tokenType = Operators::TextToOperatorID(txt.data(), (uint32) txt.size(), sz);
-    if (tokenType != TokenType::None)
+    uint32 tokenType, next;
+    if (Operators::list.ScanOperator(text, pos, CharType::classes, tokenType, next))
     {
         TokenAlignament align = TokenAlignament::AddSpaceBefore | TokenAlignament::AddSpaceAfter;
         switch (tokenType)
@@ -639,8 +420,8 @@ uint32 JSFile::TokenizeOperator(const GView::View::LexicalViewer::TextParser& te
         }
 
         align = align | TokenAlignament::WrapToNextLine;
-        tokenList.Add(tokenType, pos, pos + sz, TokenColor::Operator, TokenDataType::None, align, TokenFlags::DisableSimilaritySearch);
-        return pos + sz;
+        tokenList.Add(tokenType, pos, next, TokenColor::Operator, TokenDataType::None, align, TokenFlags::DisableSimilaritySearch);
+        return next;
     }
     else
     {
@@ -717,14 +498,13 @@ uint32 JSFile::TokenizeList(const TextParser& text, TokensList& tokenList, uint3
 }
 uint32 JSFile::TokenizePreprocessDirective(const TextParser& text, TokensList& list, BlocksList& blocks, uint32 pos)
 {
-    auto eol   = text.ParseUntillEndOfLine(pos);
-    auto start = pos;
-    pos        = text.ParseSpace(pos + 1, SpaceType::SpaceAndTabs);
-    if ((CharType::GetCharType(text[pos])) != CharType::Word)
+    bool validName;
+    auto eol = text.ParseDirective(pos, CharType::classes, CharType::Word, validName);
+    if (!validName)
     {
         // we have an error
         list.Add(TokenType::Preprocess,
-                 start,
+                 pos,
                  eol,
                  TokenColor::Preprocesor,
                  TokenAlignament::StartsOnNewLine | TokenAlignament::NewLineAfter)
@@ -732,25 +512,12 @@ uint32 JSFile::TokenizePreprocessDirective(const TextParser& text, TokensList& l
         return eol;
     }
     // we have a good preprocess directive ==> lets formalize it
-    auto next = text.ParseSameGroupID(pos, CharType::GetCharType);
     list.Add(
           TokenType::Preprocess,
-          start,
-          eol /*next*/,
+          pos,
+          eol,
           TokenColor::Preprocesor,
           TokenAlignament::StartsOnNewLine | TokenAlignament::AddSpaceAfter | TokenAlignament::NewLineAfter);
-
-    // auto tknIndex = list.Len();
-    // Tokenize(next, eol, text, list, blocks);
-    // auto tknCount = list.Len();
-    //// change the color of every added token
-    // for (auto index = tknIndex; index < tknCount; index++)
-    //     list[index].SetTokenColor(TokenColor::Preprocesor);
-    //// make sure that last token has a new line after it
-    // list.GetLastToken().UpdateAlignament(TokenAlignament::NewLineAfter);
-    //// crete a block
-    // blocks.Add(tknIndex - 1, tknCount-1, BlockAlignament::AsBlockStartToken);
-
     return eol;
 }
 void JSFile::BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax)
@@ -964,7 +731,7 @@ void JSFile::Tokenize(uint32 start, uint32 end, const TextParser& text, TokensLi
             idx = TokenizeOperator(text, tokenList, idx);
             break;
         default:
-            next = text.ParseSameGroupID(idx, CharType::GetCharType);
+            next = text.ParseSameGroupID(idx, CharType::classes);
             tokenList.Add(TokenType::Word, idx, next, TokenColor::Word, TokenDataType::MetaInformation)
                   .SetError("Invalid character sequance");
             idx = next;
@@ -19,8 +19,25 @@ namespace Type
             constexpr uint32 open_bracket   = 6;
             constexpr uint32 closed_bracket = 7;
             constexpr uint32 invalid        = 8;
+            constexpr uint32 unparsed       = 9; // the content of an object or array that is analyzed when its block is expanded
         } // namespace TokenType
 
+        // the braces, brackets, colons, commas and strings of a text (in the order they appear) - the strings are skipped and
+        // the braces (and brackets) are matched before any token is created
+        class StructuralIndex
+        {
+          public:
+            static constexpr uint32 NO_PAIR = 0xFFFFFFFF;
+            struct Entry
+            {
+                uint32 offset;
+                uint32 pair; // braces and brackets: the index of the matching entry; strings: the offset where the string ends
+            };
+            std::vector<Entry> entries;
+
+            void Build(std::u16string_view text);
+        };
+
         namespace Plugins
         {
             class UpperCase : public GView::View::LexicalViewer::Plugin
@@ -36,7 +53,10 @@ namespace Type
         class JSONFile : public TypeInterface, public GView::View::LexicalViewer::ParseInterface
         {
             void ParseFile(GView::View::LexicalViewer::SyntaxManager& syntax);
+            void ParseValues(GView::View::LexicalViewer::SyntaxManager& syntax, uint32 start, uint32 end);
             void BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax);
+            GView::View::LexicalViewer::BlockFlags GetBlockFlags(
+                  GView::View::LexicalViewer::SyntaxManager& syntax, uint32 start, uint32 end);
           public:
             Plugins::UpperCase upper_case_plugin;
 
@@ -6,38 +6,34 @@ using namespace GView::View::LexicalViewer;
 
 namespace CharacterType
 {
-    constexpr uint32 open_brace          = 0;
-    constexpr uint32 closed_brace        = 1;
-    constexpr uint32 double_quotes       = 2;
-    constexpr uint32 colon               = 3;
-    constexpr uint32 alphanum_characters = 4;
-    constexpr uint32 comma               = 5;
-    constexpr uint32 spaces              = 6;
-    constexpr uint32 open_bracket        = 7;
-    constexpr uint32 closed_bracket      = 8;
-    constexpr uint32 invalid             = 9;
+    constexpr uint8 open_brace          = 0;
+    constexpr uint8 closed_brace        = 1;
+    constexpr uint8 double_quotes       = 2;
+    constexpr uint8 colon               = 3;
+    constexpr uint8 alphanum_characters = 4;
+    constexpr uint8 comma               = 5;
+    constexpr uint8 spaces              = 6;
+    constexpr uint8 open_bracket        = 7;
+    constexpr uint8 closed_bracket      = 8;
+    constexpr uint8 invalid             = 9;
 
-    uint32 GetCharacterType(char16 ch)
+    constexpr CharacterClasses classes = CharacterClasses(invalid, invalid)
+                                               .Set("{", open_brace)
+                                               .Set("}", closed_brace)
+                                               .Set("\"", double_quotes)
+                                               .Set(":", colon)
+                                               .Set('a', 'z', alphanum_characters)
+                                               .Set('A', 'Z', alphanum_characters)
+                                               .Set('0', '9', alphanum_characters)
+                                               .Set("_-", alphanum_characters)
+                                               .Set(",", comma)
+                                               .Set(" \t\n\r", spaces)
+                                               .Set("[", open_bracket)
+                                               .Set("]", closed_bracket);
+
+    inline uint32 GetCharacterType(char16 ch)
     {
-        if (ch == '{')
-            return open_brace;
-        if (ch == '}')
-            return closed_brace;
-        if (ch == '"')
-            return double_quotes;
-        if (ch == ':')
-            return colon;
-        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '-')
-            return alphanum_characters;
-        if (ch == ',')
-            return comma;
-        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
-            return spaces;
-        if (ch == '[')
-            return open_bracket;
-        if (ch == ']')
-            return closed_bracket;
-        return invalid;
+        return classes[ch];
     }
 } // namespace CharacterType
 
@@ -54,31 +50,95 @@ namespace CharacterType
         pos++;                                                                                                                             \
         break;
 
+constexpr uint32 DEFERRED_TEXT_SIZE  = 0x100000; // in a text with more characters than this, the content of the objects (or arrays)
+constexpr uint32 DEFERRED_BLOCK_SIZE = 0x400;    // larger than this is analyzed only when their block is expanded
+
 JSONFile::JSONFile()
 {
 }
 
-void JSONFile::ParseFile(GView::View::LexicalViewer::SyntaxManager& syntax)
+void JSONFile::ParseValues(GView::View::LexicalViewer::SyntaxManager& syntax, uint32 pos, uint32 end)
 {
-    auto len  = syntax.text.Len();
-    auto pos  = 0u;
+    // between two structural characters there can only be spaces and values (numbers, true, false or null)
     auto next = 0u;
-    while (pos < len)
+    while (pos < end)
     {
         auto char_type = CharacterType::GetCharacterType(syntax.text[pos]);
         switch (char_type)
         {
-            CHAR_CASE(open_brace, TokenAlignament::StartsOnNewLine | TokenAlignament::NewLineAfter);
+        case CharacterType::spaces:
+            pos = syntax.text.ParseSpace(pos, SpaceType::All);
+            break;
+        case CharacterType::alphanum_characters:
+            next = syntax.text.ParseSameGroupID(pos, CharacterType::classes);
+            syntax.tokens.Add(TokenType::value, pos, next, TokenColor::Word, TokenAlignament::AddSpaceBefore);
+            pos = next;
+            break;
+        default:
+            next = syntax.text.ParseSameGroupID(pos, CharacterType::classes);
+            syntax.tokens.Add(TokenType::invalid, pos, next, TokenColor::Error, TokenAlignament::AddSpaceBefore)
+                  .SetError("Invalid character for json file");
+            pos = next;
+            break;
+        }
+    }
+}
+void JSONFile::ParseFile(GView::View::LexicalViewer::SyntaxManager& syntax)
+{
+    // the structural characters are found first --> the tokens are created only for them (and for the values between them)
+    StructuralIndex index;
+    auto len = syntax.text.Len();
+    index.Build(syntax.text.GetSubString(0, len));
+
+    const auto& entries = index.entries;
+    const auto count    = static_cast<uint32>(entries.size());
+    const auto deferred = len >= DEFERRED_TEXT_SIZE;
+    auto depth          = 0u;
+    auto pos            = 0u;
+    auto next           = 0u;
+    for (auto idx = 0u; idx < count; idx++)
+    {
+        ParseValues(syntax, pos, entries[idx].offset);
+        pos            = entries[idx].offset;
+        auto char_type = CharacterType::GetCharacterType(syntax.text[pos]);
+        switch (char_type)
+        {
+        case CharacterType::open_brace:
+        case CharacterType::open_bracket:
+            syntax.tokens.Add(
+                  char_type == CharacterType::open_brace ? TokenType::open_brace : TokenType::open_bracket,
+                  pos,
+                  pos + 1,
+                  TokenColor::Operator,
+                  TokenDataType::None,
+                  char_type == CharacterType::open_brace ? TokenAlignament::StartsOnNewLine | TokenAlignament::NewLineAfter
+                                                         : TokenAlignament::None,
+                  TokenFlags::DisableSimilaritySearch);
+            pos++;
+            // the content of a large object (or array) that is not the outermost one is kept in one token until it is expanded
+            if ((deferred) && (depth > 0) && (entries[idx].pair != StructuralIndex::NO_PAIR) &&
+                (entries[entries[idx].pair].offset - pos > DEFERRED_BLOCK_SIZE))
+            {
+                next = entries[entries[idx].pair].offset;
+                syntax.tokens.Add(
+                      TokenType::unparsed,
+                      pos,
+                      next,
+                      TokenColor::Word,
+                      TokenDataType::None,
+                      TokenAlignament::None,
+                      TokenFlags::DisableSimilaritySearch);
+                idx = entries[idx].pair - 1;
+                pos = next;
+            }
+            depth++;
+            break;
             CHAR_CASE(closed_brace, TokenAlignament::StartsOnNewLine | TokenAlignament::NewLineAfter);
-            CHAR_CASE(open_bracket, TokenAlignament::None);
             CHAR_CASE(closed_bracket, TokenAlignament::NewLineAfter);
             CHAR_CASE(colon, TokenAlignament::AddSpaceBefore | TokenAlignament::AddSpaceAfter | TokenAlignament::SameColumn);
             CHAR_CASE(comma, TokenAlignament::NewLineAfter | TokenAlignament::AfterPreviousToken);
-        case CharacterType::spaces:
-            pos = syntax.text.ParseSpace(pos, SpaceType::All);
-            break;
         case CharacterType::double_quotes:
-            next = syntax.text.ParseString(pos, StringFormat::DoubleQuotes);
+            next = entries[idx].pair;
             if (syntax.tokens.GetLastTokenID() == TokenType::colon)
             {
                 syntax.tokens.Add(TokenType::value, pos, next, TokenColor::Word, TokenAlignament::AddSpaceBefore);
@@ -90,19 +150,18 @@ void JSONFile::ParseFile(GView::View::LexicalViewer::SyntaxManager& syntax)
             }
             pos = next;
             break;
-        case CharacterType::alphanum_characters:
-            next = syntax.text.ParseSameGroupID(pos, CharacterType::GetCharacterType);
-            syntax.tokens.Add(TokenType::value, pos, next, TokenColor::Word, TokenAlignament::AddSpaceBefore);
-            pos = next;
-            break;
-        default:
-            next = syntax.text.ParseSameGroupID(pos, CharacterType::GetCharacterType);
-            syntax.tokens.Add(TokenType::invalid, pos, next, TokenColor::Error, TokenAlignament::AddSpaceBefore)
-                  .SetError("Invalid character for json file");
-            pos = next;
-            break;
         }
+        if (((char_type == CharacterType::closed_brace) || (char_type == CharacterType::closed_bracket)) && (depth > 0))
+            depth--;
     }
+    ParseValues(syntax, pos, len);
+}
+BlockFlags JSONFile::GetBlockFlags(GView::View::LexicalViewer::SyntaxManager& syntax, uint32 start, uint32 end)
+{
+    // a block with only one (unparsed) token starts folded and its content is analyzed when it is expanded
+    if ((end == start + 2) && (syntax.tokens[start + 1].GetTypeID(TokenType::invalid) == TokenType::unparsed))
+        return BlockFlags::EndMarker | BlockFlags::DeferredContent;
+    return BlockFlags::EndMarker;
 }
 void JSONFile::BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax)
 {
@@ -125,7 +184,7 @@ void JSONFile::BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax)
             if (!braces.Empty())
             {
                 last_val = braces.Pop();
-                syntax.blocks.Add(last_val, pos, BlockAlignament::ParentBlockWithIndent, BlockFlags::EndMarker);
+                syntax.blocks.Add(last_val, pos, BlockAlignament::ParentBlockWithIndent, GetBlockFlags(syntax, last_val, pos));
             }
             else
             {
@@ -136,7 +195,7 @@ void JSONFile::BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax)
             if (!brackets.Empty())
             {
                 last_val = brackets.Pop();
-                syntax.blocks.Add(last_val, pos, BlockAlignament::CurrentToken, BlockFlags::EndMarker);
+                syntax.blocks.Add(last_val, pos, BlockAlignament::CurrentToken, GetBlockFlags(syntax, last_val, pos));
                 for (auto index = last_val + 1; index < pos; index++)
                 {
                     auto block = syntax.tokens[index].GetBlock();
@@ -164,7 +223,11 @@ void JSONFile::BuildBlocks(GView::View::LexicalViewer::SyntaxManager& syntax)
     for (auto index = 0u; index < len; index++)
     {
         auto block = syntax.blocks[index];
-        block.SetFoldMessage(tmp.Format("Tokens: %d", block.GetEndToken().GetIndex() - block.GetStartToken().GetIndex()));
+        auto start = block.GetStartToken();
+        if (start.Next().GetTypeID(TokenType::invalid) == TokenType::unparsed)
+            block.SetFoldMessage(tmp.Format("Characters: %u", static_cast<uint32>(start.Next().GetText().size())));
+        else
+            block.SetFoldMessage(tmp.Format("Tokens: %d", block.GetEndToken().GetIndex() - start.GetIndex()));
     }
 }
 
@@ -0,0 +1,144 @@
+#include "json.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define JSON_STRUCTURAL_INDEX_SSE2
+#endif
+
+namespace GView::Type::JSON
+{
+constexpr uint32 BLOCK_SIZE = 64; // characters classified at once (one bit for each of them)
+
+namespace
+{
+    struct BlockMasks
+    {
+        uint64 structural; // braces, brackets, colons, commas and quotes
+        uint64 string;     // the characters that can end a string (quotes, backslashes and new lines)
+    };
+    inline bool IsStructural(char16 ch)
+    {
+        return (ch == '{') || (ch == '}') || (ch == '[') || (ch == ']') || (ch == ':') || (ch == ',') || (ch == '"');
+    }
+    inline bool IsStringSpecial(char16 ch)
+    {
+        return (ch == '"') || (ch == '\\') || (ch == '\n') || (ch == '\r');
+    }
+    BlockMasks ClassifyBlock(const char16* p, uint32 count)
+    {
+        BlockMasks masks{ 0, 0 };
+        auto idx = 0U;
+#ifdef JSON_STRUCTURAL_INDEX_SSE2
+        // 16 characters are packed in 16 bytes (the ones that are not ASCII become 0x7F or 0x80 - none of them is a special one)
+        for (; idx + 16 <= count; idx += 16)
+        {
+            const auto lo     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx));
+            const auto hi     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx + 8));
+            const auto v      = _mm_packs_epi16(lo, hi);
+            const auto quotes = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+            auto structural   = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('}')));
+            structural        = _mm_or_si128(structural, _mm_cmpeq_epi8(v, _mm_set1_epi8('[')));
+            structural        = _mm_or_si128(structural, _mm_cmpeq_epi8(v, _mm_set1_epi8(']')));
+            structural        = _mm_or_si128(structural, _mm_cmpeq_epi8(v, _mm_set1_epi8(':')));
+            structural        = _mm_or_si128(structural, _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+            auto special      = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+            special           = _mm_or_si128(special, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+            masks.structural |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(structural, quotes)))) << idx;
+            masks.string |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(special, quotes)))) << idx;
+        }
+#endif
+        for (; idx < count; idx++)
+        {
+            if (IsStructural(p[idx]))
+                masks.structural |= 1ULL << idx;
+            if (IsStringSpecial(p[idx]))
+                masks.string |= 1ULL << idx;
+        }
+        return masks;
+    }
+} // namespace
+
+void StructuralIndex::Build(u16string_view text)
+{
+    /*
+    The text is classified in blocks of 64 characters (a bit for every character) and only the characters with a bit set are
+    visited. Outside a string all structural characters are added; inside a string only the characters that can end it matter:
+    - a quote (the string ends after it)
+    - a backslash (the next character is skipped)
+    - a new line (the string ends before it)
+    Braces and brackets are matched separately (just like the blocks are built).
+    */
+    std::vector<uint32> braces, brackets;
+    const auto* start = text.data();
+    const auto size   = static_cast<uint32>(text.size());
+    auto inString     = false;
+    auto stringIndex  = 0U; // the entry of the string that is not closed yet
+    auto skipUntil    = 0U; // the character after a backslash is skipped
+    this->entries.clear();
+    for (auto base = 0U; base < size; base += BLOCK_SIZE)
+    {
+        const auto masks = ClassifyBlock(start + base, std::min<>(BLOCK_SIZE, size - base));
+        auto pending     = masks.structural | masks.string;
+        while (pending)
+        {
+            const auto bit = static_cast<uint32>(std::countr_zero(pending));
+            const auto pos = base + bit;
+            pending &= pending - 1;
+            if (pos < skipUntil)
+                continue;
+            const auto ch = start[pos];
+            if (inString)
+            {
+                if ((masks.string & (1ULL << bit)) == 0)
+                    continue;
+                if (ch == '\\')
+                {
+                    skipUntil = pos + 2;
+                    continue;
+                }
+                this->entries[stringIndex].pair = ch == '"' ? pos + 1 : pos;
+                inString                        = false;
+                continue;
+            }
+            if ((masks.structural & (1ULL << bit)) == 0)
+                continue;
+            const auto index = static_cast<uint32>(this->entries.size());
+            this->entries.push_back(Entry{ pos, NO_PAIR });
+            switch (ch)
+            {
+            case '{':
+                braces.push_back(index);
+                break;
+            case '[':
+                brackets.push_back(index);
+                break;
+            case '}':
+                if (!braces.empty())
+                {
+                    this->entries[braces.back()].pair = index;
+                    this->entries[index].pair         = braces.back();
+                    braces.pop_back();
+                }
+                break;
+            case ']':
+                if (!brackets.empty())
+                {
+                    this->entries[brackets.back()].pair = index;
+                    this->entries[index].pair           = brackets.back();
+                    brackets.pop_back();
+                }
+                break;
+            case '"':
+                inString    = true;
+                stringIndex = index;
+                break;
+            }
+        }
+    }
+    // a string that is not closed ends with the text
+    if (inString)
+        this->entries[stringIndex].pair = size;
+}
+} // namespace GView::Type::JSON